@@ -0,0 +1,109 @@
+#include "fr3_container.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/util/Assert.h"
+#include "common/util/compress.h"
+
+#include "fmt/core.h"
+#include "third-party/zstd/lib/zstd.h"
+
+namespace tfrag3 {
+
+namespace {
+constexpr char kFr3Magic[8] = {'O', 'G', 'F', 'R', '3', 'C', 'N', 'T'};
+
+size_t align_section(size_t offset) {
+  return (offset + FR3_SECTION_ALIGN - 1) & ~(FR3_SECTION_ALIGN - 1);
+}
+}  // namespace
+
+std::vector<u8> pack_fr3(const u8* data, size_t size, size_t section_size) {
+  ASSERT(section_size > 0);
+  std::vector<std::vector<u8>> section_data;
+  std::vector<Fr3Section> sections;
+  for (size_t offset = 0; offset < size; offset += section_size) {
+    size_t len = std::min(section_size, size - offset);
+    auto& sec = sections.emplace_back();
+    memset(&sec, 0, sizeof(Fr3Section));
+    sec.data_size = len;
+    auto compressed = compression::compress_zstd_no_header(data + offset, len);
+    if (compressed.size() < len) {
+      sec.compression = Fr3Compression::ZSTD;
+      section_data.push_back(std::move(compressed));
+    } else {
+      // not worth decompressing, store it as-is.
+      sec.compression = Fr3Compression::NONE;
+      section_data.emplace_back(data + offset, data + offset + len);
+    }
+    sec.file_size = section_data.back().size();
+  }
+
+  Fr3Header header;
+  memset(&header, 0, sizeof(Fr3Header));
+  memcpy(header.magic, kFr3Magic, sizeof(kFr3Magic));
+  header.container_version = FR3_CONTAINER_VERSION;
+  header.section_count = sections.size();
+  header.data_size = size;
+
+  size_t file_size = align_section(sizeof(Fr3Header) + sections.size() * sizeof(Fr3Section));
+  for (auto& sec : sections) {
+    sec.file_offset = file_size;
+    file_size = align_section(file_size + sec.file_size);
+  }
+
+  std::vector<u8> result(file_size, 0);
+  memcpy(result.data(), &header, sizeof(Fr3Header));
+  memcpy(result.data() + sizeof(Fr3Header), sections.data(), sections.size() * sizeof(Fr3Section));
+  for (size_t i = 0; i < sections.size(); i++) {
+    memcpy(result.data() + sections[i].file_offset, section_data[i].data(), section_data[i].size());
+  }
+  return result;
+}
+
+std::vector<u8> unpack_fr3(const u8* file_data, size_t file_size) {
+  if (file_size < sizeof(Fr3Header) || memcmp(file_data, kFr3Magic, sizeof(kFr3Magic)) != 0) {
+    // old format, the whole file is one zstd frame.
+    return compression::decompress_zstd(file_data, file_size);
+  }
+
+  Fr3Header header;
+  memcpy(&header, file_data, sizeof(Fr3Header));
+  ASSERT_MSG(header.container_version == FR3_CONTAINER_VERSION,
+             fmt::format("fr3 container version mismatch. Got {}, expected {}, did you forget to "
+                         "re-decompile?",
+                         header.container_version, FR3_CONTAINER_VERSION));
+  ASSERT(sizeof(Fr3Header) + header.section_count * sizeof(Fr3Section) <= file_size);
+
+  std::vector<u8> result(header.data_size);
+  size_t data_offset = 0;
+  for (u32 i = 0; i < header.section_count; i++) {
+    Fr3Section sec;
+    memcpy(&sec, file_data + sizeof(Fr3Header) + i * sizeof(Fr3Section), sizeof(Fr3Section));
+    ASSERT(sec.file_offset + sec.file_size <= file_size);
+    ASSERT(data_offset + sec.data_size <= result.size());
+    const u8* src = file_data + sec.file_offset;
+    u8* dst = result.data() + data_offset;
+    switch (sec.compression) {
+      case Fr3Compression::NONE:
+        ASSERT(sec.file_size == sec.data_size);
+        memcpy(dst, src, sec.data_size);
+        break;
+      case Fr3Compression::ZSTD: {
+        auto got = ZSTD_decompress(dst, sec.data_size, src, sec.file_size);
+        if (ZSTD_isError(got)) {
+          ASSERT_MSG(false, fmt::format("ZSTD error: {}", ZSTD_getErrorName(got)));
+        }
+        ASSERT(got == sec.data_size);
+      } break;
+      default:
+        ASSERT_MSG(false, fmt::format("unknown fr3 section compression {}", (u32)sec.compression));
+    }
+    data_offset += sec.data_size;
+  }
+  ASSERT(data_offset == result.size());
+  return result;
+}
+
+}  // namespace tfrag3
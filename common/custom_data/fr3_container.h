@@ -0,0 +1,51 @@
+#pragma once
+
+/*!
+ * @file fr3_container.h
+ * The file format of .fr3 files. This wraps the serialized tfrag3::Level data.
+ *
+ * The data is split into sections, each compressed separately (or stored as-is, if it doesn't
+ * compress). Sections start at 64-byte aligned offsets in the file, so the loader can memory map the
+ * file and decompress each section directly from the mapping into the final buffer, without
+ * reading the whole compressed file into memory first.
+ *
+ * The older format (a single zstd frame with an 8-byte size header) can still be read.
+ */
+
+#include <cstddef>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace tfrag3 {
+
+constexpr u32 FR3_CONTAINER_VERSION = 2;
+constexpr size_t FR3_SECTION_ALIGN = 64;
+
+enum class Fr3Compression : u32 { NONE = 0, ZSTD = 1 };
+
+struct Fr3Header {
+  char magic[8];
+  u32 container_version;
+  u32 section_count;
+  u64 data_size;  // size of all sections, after decompression.
+  u8 pad[40];
+};
+static_assert(sizeof(Fr3Header) == FR3_SECTION_ALIGN);
+
+struct Fr3Section {
+  u64 file_offset;
+  u64 file_size;
+  u64 data_size;
+  Fr3Compression compression;
+  u32 pad;
+};
+static_assert(sizeof(Fr3Section) == 32);
+
+// build an fr3 file from the serialized level data.
+std::vector<u8> pack_fr3(const u8* data, size_t size, size_t section_size = 1024 * 1024);
+
+// get the serialized level data back from an fr3 file, in either format.
+std::vector<u8> unpack_fr3(const u8* file_data, size_t file_size);
+
+}  // namespace tfrag3
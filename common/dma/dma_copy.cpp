@@ -87,20 +87,25 @@ void FixedChunkDmaCopier::set_input_data(const void* memory, u32 offset, bool ru
 }
 
 const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool verify) {
+  run(memory, offset, &m_result, verify);
+  return m_result;
+}
+
+void FixedChunkDmaCopier::run(const void* memory, u32 offset, DmaData* out, bool verify) {
   Timer timer;
   m_input_offset = offset;
   m_input_data = memory;
   std::fill(m_chunk_mask.begin(), m_chunk_mask.end(), false);
   m_fixups.clear();
-  m_result.data.clear();
-  m_result.stats = DmaStats();
-  m_result.start_offset = 0;
+  // every output chunk is fully overwritten below, so the old contents don't need to be cleared.
+  out->stats = DmaStats();
+  out->start_offset = 0;
 
   DmaFollower dma(memory, offset);
   while (!dma.ended()) {
     auto tag_offset = dma.current_tag_offset();
     auto tag = dma.current_tag();
-    m_result.stats.num_tags++;
+    out->stats.num_tags++;
 
     // first, make sure we get this tag:
     u32 tag_chunk_idx = tag_offset / chunk_size;
@@ -124,7 +129,7 @@ const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool ver
 
     auto transfer = dma.read_and_advance();
     if (transfer.size_bytes) {
-      m_result.stats.num_data_bytes += transfer.size_bytes;
+      out->stats.num_data_bytes += transfer.size_bytes;
       u32 initial_chunk = transfer.data_offset / chunk_size;
       u32 end_addr = transfer.data_offset + transfer.size_bytes;
       m_chunk_mask.at(initial_chunk) = true;
@@ -147,16 +152,16 @@ const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool ver
     }
   }
 
-  m_result.data.resize(current_out_chunk * chunk_size);
-  m_result.stats.num_chunks = current_out_chunk;
-  m_result.stats.num_copied_bytes = m_result.data.size();
-  m_result.stats.num_fixups = m_fixups.size();
+  out->data.resize(current_out_chunk * chunk_size);
+  out->stats.num_chunks = current_out_chunk;
+  out->stats.num_copied_bytes = out->data.size();
+  out->stats.num_fixups = m_fixups.size();
 
   // copy
   for (u32 chunk_idx = 0; chunk_idx < m_chunk_mask.size(); chunk_idx++) {
     u32 dest_idx = m_chunk_mask[chunk_idx];
     if (dest_idx != UINT32_MAX) {
-      memcpy(m_result.data.data() + (dest_idx * chunk_size),
+      memcpy(out->data.data() + (dest_idx * chunk_size),
              (const u8*)memory + (chunk_idx * chunk_size), chunk_size);
     }
   }
@@ -165,15 +170,15 @@ const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool ver
   for (const auto& fu : m_fixups) {
     u32 tag_addr = m_chunk_mask.at(fu.source_chunk) * chunk_size + fu.offset_in_source_chunk + 4;
     u32 dest_addr = m_chunk_mask.at(fu.dest_chunk) * chunk_size + fu.offset_in_dest_chunk;
-    memcpy(m_result.data.data() + tag_addr, &dest_addr, 4);
+    memcpy(out->data.data() + tag_addr, &dest_addr, 4);
   }
 
   // setup final offset
-  m_result.start_offset = m_chunk_mask.at(offset / chunk_size) * chunk_size + (offset % chunk_size);
+  out->start_offset = m_chunk_mask.at(offset / chunk_size) * chunk_size + (offset % chunk_size);
 
   if (verify) {
     auto ref = flatten_dma(DmaFollower(memory, offset));
-    auto v2 = flatten_dma(DmaFollower(m_result.data.data(), m_result.start_offset));
+    auto v2 = flatten_dma(DmaFollower(out->data.data(), out->start_offset));
 
     if (ref != v2) {
       lg::error("Verification has failed.");
@@ -186,13 +191,12 @@ const DmaData& FixedChunkDmaCopier::run(const void* memory, u32 offset, bool ver
         }
       }
       diff_dma_chains(DmaFollower(memory, offset),
-                      DmaFollower(m_result.data.data(), m_result.start_offset));
+                      DmaFollower(out->data.data(), out->start_offset));
       ASSERT(false);
     } else {
       lg::debug("verification ok: {} bytes", ref.size());
     }
   }
 
-  m_result.stats.sync_time_ms = timer.getMs();
-  return m_result;
+  out->stats.sync_time_ms = timer.getMs();
 }
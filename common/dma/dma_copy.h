@@ -26,6 +26,12 @@ class FixedChunkDmaCopier {
 
   const DmaData& run(const void* memory, u32 offset, bool verify = false);
 
+  /*!
+   * Copy into a caller-owned result instead of the internal one. The storage of out is reused, so
+   * keeping a few DmaData around and alternating between them avoids reallocating every frame.
+   */
+  void run(const void* memory, u32 offset, DmaData* out, bool verify = false);
+
   void serialize_last_result(Serializer& serializer);
 
   const DmaData& get_last_result() const { return m_result; }
@@ -51,6 +51,14 @@ void GlobalProfiler::set_waiting_for_event(const std::string& event_name) {
 }
 
 void GlobalProfiler::event(const char* name, ProfNode::Kind kind) {
+  if (!m_enabled && !m_waiting_for_event) {
+    // don't read the clock if the event won't be recorded.
+    return;
+  }
+  event_at(name, kind, get_current_ts() - m_t0, get_current_tid());
+}
+
+void GlobalProfiler::event_at(const char* name, ProfNode::Kind kind, u64 ts, u64 tid) {
   if (m_waiting_for_event && m_waiting_for_event.value() == name) {
     m_ignore_events = true;
   }
@@ -59,13 +67,17 @@ void GlobalProfiler::event(const char* name, ProfNode::Kind kind) {
   }
   size_t my_idx = (m_next_idx++ % m_nodes.size());
   auto& node = m_nodes[my_idx];
-  node.ts = get_current_ts() - m_t0;
-  node.tid = get_current_tid();
+  node.ts = ts;
+  node.tid = tid;
   node.kind = kind;
   strncpy(node.name, name, sizeof(node.name));
   node.name[sizeof(node.name) - 1] = '\0';
 }
 
+u64 GlobalProfiler::timestamp() const {
+  return get_current_ts() - m_t0;
+}
+
 void GlobalProfiler::instant_event(const char* name) {
   event(name, ProfNode::INSTANT);
 }
@@ -139,6 +151,14 @@ void GlobalProfiler::dump_to_json() {
   u32 i = 0;
   for (auto& info : info_per_thread) {
     info.second.short_id = i++;
+    if (info.first == (u32)GPU_TRACK_TID) {
+      auto& name_event = trace_events.emplace_back();
+      name_event["name"] = "thread_name";
+      name_event["ph"] = "M";
+      name_event["pid"] = 1;
+      name_event["tid"] = info.second.short_id;
+      name_event["args"]["name"] = "GPU";
+    }
   }
 
   for (size_t event_idx = 0; event_idx < m_nodes.size(); event_idx++) {
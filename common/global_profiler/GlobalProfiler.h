@@ -16,6 +16,9 @@ struct ProfNode {
 
 class GlobalProfiler {
  public:
+  // thread id used for events that happen on the GPU.
+  static constexpr u64 GPU_TRACK_TID = 0xffff'fff0;
+
   GlobalProfiler();
   size_t get_max_events() { return m_max_events; }
   void update_event_buffer_size(size_t new_size);
@@ -23,6 +26,9 @@ class GlobalProfiler {
   void instant_event(const char* name);
   void begin_event(const char* name);
   void event(const char* name, ProfNode::Kind kind);
+  // add an event that happened at a different time (from timestamp()), or on a different thread.
+  void event_at(const char* name, ProfNode::Kind kind, u64 ts, u64 tid);
+  u64 timestamp() const;
   void end_event();
   void clear();
   void set_enable(bool en);
@@ -124,7 +124,7 @@ void Interpreter::init_builtin_forms(
     const std::unordered_map<std::string,
                              Object (Interpreter::*)(const Object&,
                                                      Arguments&,
-                                                     const std::shared_ptr<EnvironmentObject>&)>&
+                                                     const HeapPtr<EnvironmentObject>&)>&
         forms) {
   for (const auto& [name, fn] : forms) {
     builtin_forms[(void*)intern_ptr(name).name_ptr] = fn;
@@ -135,7 +135,7 @@ void Interpreter::init_special_forms(
     const std::unordered_map<std::string,
                              Object (Interpreter::*)(const Object&,
                                                      const Object&,
-                                                     const std::shared_ptr<EnvironmentObject>&)>&
+                                                     const HeapPtr<EnvironmentObject>&)>&
         forms) {
   for (const auto& [name, fn] : forms) {
     special_forms.push_back(std::make_pair((void*)intern_ptr(name).name_ptr, fn));
@@ -149,7 +149,7 @@ void Interpreter::init_special_forms(
 void Interpreter::register_form(
     const std::string& name,
     const std::function<
-        Object(const Object&, Arguments&, const std::shared_ptr<EnvironmentObject>&)>& form) {
+        Object(const Object&, Arguments&, const HeapPtr<EnvironmentObject>&)>& form) {
   m_custom_forms.push_back(std::make_pair((void*)intern_ptr(name).name_ptr, form));
 }
 
@@ -230,7 +230,7 @@ void Interpreter::throw_eval_error(const Object& o, const std::string& err) {
  * and if possible what file/line "obj" comes from.
  */
 Object Interpreter::eval_with_rewind(const Object& obj,
-                                     const std::shared_ptr<EnvironmentObject>& env) {
+                                     const HeapPtr<EnvironmentObject>& env) {
   try {
     return eval(obj, env);
   } catch (std::runtime_error& e) {
@@ -408,7 +408,7 @@ Arguments Interpreter::get_args_no_named(const Object& form,
  *
  * Note that in varargs mode, all unnamed arguments are put in unnamed, not rest.
  */
-void Interpreter::eval_args(Arguments* args, const std::shared_ptr<EnvironmentObject>& env) {
+void Interpreter::eval_args(Arguments* args, const HeapPtr<EnvironmentObject>& env) {
   for (auto& arg : args->unnamed) {
     arg = eval_with_rewind(arg, env);
   }
@@ -523,7 +523,7 @@ void Interpreter::vararg_check(
  */
 Object Interpreter::eval_list_return_last(const Object& /*form*/,
                                           Object rest,
-                                          const std::shared_ptr<EnvironmentObject>& env) {
+                                          const HeapPtr<EnvironmentObject>& env) {
   if (rest.is_empty_list()) {
     return rest;
   }
@@ -554,7 +554,7 @@ void Interpreter::expect_env(const Object& form, const Object& o) {
 /*!
  * Highest-level evaluation dispatch.
  */
-Object Interpreter::eval(Object obj, const std::shared_ptr<EnvironmentObject>& env) {
+Object Interpreter::eval(Object obj, const HeapPtr<EnvironmentObject>& env) {
   switch (obj.type) {
     case ObjectType::SYMBOL:
       return eval_symbol(obj, env);
@@ -578,7 +578,7 @@ namespace {
  * return false.
  */
 bool try_symbol_lookup(const Object& sym,
-                       const std::shared_ptr<EnvironmentObject>& env,
+                       const HeapPtr<EnvironmentObject>& env,
                        Object* dest) {
   // booleans are hard-coded here
   if (sym.as_symbol() == "#t" || sym.as_symbol() == "#f") {
@@ -608,7 +608,7 @@ bool try_symbol_lookup(const Object& sym,
 /*!
  * Evaluate a symbol by finding the closest scoped variable with matching name.
  */
-Object Interpreter::eval_symbol(const Object& sym, const std::shared_ptr<EnvironmentObject>& env) {
+Object Interpreter::eval_symbol(const Object& sym, const HeapPtr<EnvironmentObject>& env) {
   Object result;
   if (!try_symbol_lookup(sym, env, &result)) {
     throw_eval_error(sym, "symbol is not defined");
@@ -617,26 +617,26 @@ Object Interpreter::eval_symbol(const Object& sym, const std::shared_ptr<Environ
 }
 
 bool Interpreter::eval_symbol(const Object& sym,
-                              const std::shared_ptr<EnvironmentObject>& env,
+                              const HeapPtr<EnvironmentObject>& env,
                               Object* result) {
   return try_symbol_lookup(sym, env, result);
 }
 
 Object Interpreter::eval_let_star(const goos::Object& form,
                                   const goos::Object& rest,
-                                  const std::shared_ptr<EnvironmentObject>& env) {
+                                  const HeapPtr<EnvironmentObject>& env) {
   return eval_let_common(form, rest, env, true);
 }
 
 Object Interpreter::eval_let(const goos::Object& form,
                              const goos::Object& rest,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   return eval_let_common(form, rest, env, false);
 }
 
 Object Interpreter::eval_let_common(const goos::Object& form,
                                     const goos::Object& rest,
-                                    const std::shared_ptr<EnvironmentObject>& env,
+                                    const HeapPtr<EnvironmentObject>& env,
                                     bool is_star) {
   if (!rest.is_pair()) {
     throw_eval_error(form, "first argument to let must be bindings");
@@ -649,7 +649,7 @@ Object Interpreter::eval_let_common(const goos::Object& form,
     throw_eval_error(form, "let cannot have empty bindings");
   }
 
-  std::shared_ptr<EnvironmentObject> new_env = std::make_shared<EnvironmentObject>();
+  HeapPtr<EnvironmentObject> new_env = make_heap<EnvironmentObject>();
   new_env->parent_env = env;
 
   while (!bindings_iter->is_empty_list()) {
@@ -678,7 +678,7 @@ Object Interpreter::eval_let_common(const goos::Object& form,
 /*!
  * Evaluate a pair, either as special form, builtin form, macro application, or lambda application.
  */
-Object Interpreter::eval_pair(const Object& obj, const std::shared_ptr<EnvironmentObject>& env) {
+Object Interpreter::eval_pair(const Object& obj, const HeapPtr<EnvironmentObject>& env) {
   const auto& pair = obj.as_pair();
   const Object& head = pair->car;
   const Object& rest = pair->cdr;
@@ -749,7 +749,7 @@ Object Interpreter::eval_pair(const Object& obj, const std::shared_ptr<Environme
 void Interpreter::set_args_in_env(const Object& form,
                                   const Arguments& args,
                                   const ArgumentSpec& arg_spec,
-                                  const std::shared_ptr<EnvironmentObject>& env) {
+                                  const HeapPtr<EnvironmentObject>& env) {
   if (arg_spec.rest.empty() && args.unnamed.size() != arg_spec.unnamed.size()) {
     throw_eval_error(form, "did not get the expected number of unnamed arguments (got " +
                                std::to_string(args.unnamed.size()) + ", expected " +
@@ -786,7 +786,7 @@ void Interpreter::set_args_in_env(const Object& form,
  */
 Object Interpreter::eval_define(const Object& form,
                                 const Object& rest,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   auto args = get_args(form, rest, make_varargs());
   vararg_check(form, args, {ObjectType::SYMBOL, {}}, {{"env", {false, {}}}});
 
@@ -808,13 +808,13 @@ Object Interpreter::eval_define(const Object& form,
  */
 Object Interpreter::eval_set(const Object& form,
                              const Object& rest,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   auto args = get_args(form, rest, make_varargs());
   vararg_check(form, args, {ObjectType::SYMBOL, {}}, {});
   auto to_define = args.unnamed.at(0);
   Object to_set = eval_with_rewind(args.unnamed.at(1), env);
 
-  std::shared_ptr<EnvironmentObject> search_env = env;
+  HeapPtr<EnvironmentObject> search_env = env;
   for (;;) {
     auto kv = search_env->vars.lookup(to_define.as_symbol());
     if (kv) {
@@ -836,7 +836,7 @@ Object Interpreter::eval_set(const Object& form,
  */
 Object Interpreter::eval_lambda(const Object& form,
                                 const Object& rest,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   if (!rest.is_pair()) {
     throw_eval_error(form, "lambda must receive two arguments");
   }
@@ -865,7 +865,7 @@ Object Interpreter::eval_lambda(const Object& form,
  */
 Object Interpreter::eval_macro(const Object& form,
                                const Object& rest,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   if (!rest.is_pair()) {
     throw_eval_error(form, "macro must receive two arguments");
   }
@@ -894,7 +894,7 @@ Object Interpreter::eval_macro(const Object& form,
  */
 Object Interpreter::eval_quote(const Object& form,
                                const Object& rest,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   auto args = get_args_no_named(form, rest, make_varargs());
   if (args.unnamed.size() != 1) {
@@ -908,7 +908,7 @@ Object build_list_with_spliced_tail(std::vector<Object>&& objects, const Object&
     return tail;
   }
 
-  std::shared_ptr<PairObject> head = std::make_shared<PairObject>(objects.back(), tail);
+  HeapPtr<PairObject> head = make_heap<PairObject>(objects.back(), tail);
 
   s64 idx = ((s64)objects.size()) - 2;
   while (idx >= 0) {
@@ -916,7 +916,7 @@ Object build_list_with_spliced_tail(std::vector<Object>&& objects, const Object&
     next.type = ObjectType::PAIR;
     next.heap_obj = std::move(head);
 
-    head = std::make_shared<PairObject>();
+    head = make_heap<PairObject>();
     head->car = std::move(objects[idx]);
     head->cdr = std::move(next);
 
@@ -933,7 +933,7 @@ Object build_list_with_spliced_tail(std::vector<Object>&& objects, const Object&
  * Recursive quasi-quote evaluation
  */
 Object Interpreter::quasiquote_helper(const Object& form,
-                                      const std::shared_ptr<EnvironmentObject>& env) {
+                                      const HeapPtr<EnvironmentObject>& env) {
   const Object* lst_iter = &form;
   std::vector<Object> result;
   for (;;) {
@@ -1004,7 +1004,7 @@ Object Interpreter::quasiquote_helper(const Object& form,
  */
 Object Interpreter::eval_quasiquote(const Object& form,
                                     const Object& rest,
-                                    const std::shared_ptr<EnvironmentObject>& env) {
+                                    const HeapPtr<EnvironmentObject>& env) {
   if (rest.type != ObjectType::PAIR || rest.as_pair()->cdr.type != ObjectType::EMPTY_LIST)
     throw_eval_error(form, "quasiquote must have one argument!");
   return quasiquote_helper(rest.as_pair()->car, env);
@@ -1019,7 +1019,7 @@ bool Interpreter::truthy(const Object& o) {
  */
 Object Interpreter::eval_cond(const Object& form,
                               const Object& rest,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   if (rest.type != ObjectType::PAIR)
     throw_eval_error(form, "cond must have at least one clause, which must be a form");
   Object result;
@@ -1056,7 +1056,7 @@ Object Interpreter::eval_cond(const Object& form,
  */
 Object Interpreter::eval_or(const Object& form,
                             const Object& rest,
-                            const std::shared_ptr<EnvironmentObject>& env) {
+                            const HeapPtr<EnvironmentObject>& env) {
   if (rest.type != ObjectType::PAIR) {
     throw_eval_error(form, "or must have at least one argument!");
   }
@@ -1082,7 +1082,7 @@ Object Interpreter::eval_or(const Object& form,
  */
 Object Interpreter::eval_and(const Object& form,
                              const Object& rest,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   if (rest.type != ObjectType::PAIR) {
     throw_eval_error(form, "and must have at least one argument!");
   }
@@ -1109,7 +1109,7 @@ Object Interpreter::eval_and(const Object& form,
  */
 Object Interpreter::eval_while(const Object& form,
                                const Object& rest,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   if (rest.type != ObjectType::PAIR) {
     throw_eval_error(form, "while must have condition and body");
   }
@@ -1133,7 +1133,7 @@ Object Interpreter::eval_while(const Object& form,
  */
 Object Interpreter::eval_exit(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)form;
   (void)args;
   (void)env;
@@ -1146,7 +1146,7 @@ Object Interpreter::eval_exit(const Object& form,
  */
 Object Interpreter::eval_begin(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   if (!args.named.empty()) {
     throw_eval_error(form, "begin form cannot have keyword arguments");
@@ -1164,7 +1164,7 @@ Object Interpreter::eval_begin(const Object& form,
  */
 Object Interpreter::eval_read(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
 
@@ -1182,7 +1182,7 @@ Object Interpreter::eval_read(const Object& form,
  */
 Object Interpreter::eval_read_data_file(const Object& form,
                                         Arguments& args,
-                                        const std::shared_ptr<EnvironmentObject>& env) {
+                                        const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
 
@@ -1199,7 +1199,7 @@ Object Interpreter::eval_read_data_file(const Object& form,
  */
 Object Interpreter::eval_read_file(const Object& form,
                                    Arguments& args,
-                                   const std::shared_ptr<EnvironmentObject>& env) {
+                                   const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
 
@@ -1216,7 +1216,7 @@ Object Interpreter::eval_read_file(const Object& form,
  */
 Object Interpreter::eval_load_file(const Object& form,
                                    Arguments& args,
-                                   const std::shared_ptr<EnvironmentObject>& env) {
+                                   const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
 
@@ -1240,7 +1240,7 @@ Object Interpreter::eval_load_file(const Object& form,
  */
 Object Interpreter::eval_try_load_file(const Object& form,
                                        Arguments& args,
-                                       const std::shared_ptr<EnvironmentObject>& env) {
+                                       const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
 
@@ -1270,7 +1270,7 @@ Object Interpreter::eval_try_load_file(const Object& form,
  */
 Object Interpreter::eval_print(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}}, {});
 
@@ -1286,7 +1286,7 @@ Object Interpreter::eval_print(const Object& form,
  */
 Object Interpreter::eval_inspect(const Object& form,
                                  Arguments& args,
-                                 const std::shared_ptr<EnvironmentObject>& env) {
+                                 const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}}, {});
 
@@ -1310,7 +1310,7 @@ const Object& Interpreter::true_or_false(bool val) {
  */
 Object Interpreter::eval_equals(const Object& form,
                                 Arguments& args,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}, {}}, {});
   return true_or_false(args.unnamed[0] == args.unnamed[1]);
@@ -1370,7 +1370,7 @@ IntType Interpreter::number(const Object& obj) {
 template <typename T>
 Object Interpreter::num_plus(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   (void)form;
   T result = 0;
@@ -1385,7 +1385,7 @@ Object Interpreter::num_plus(const Object& form,
  */
 Object Interpreter::eval_plus(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   if (!args.named.empty() || args.unnamed.empty()) {
     throw_eval_error(form, "+ must receive at least one unnamed argument!");
   }
@@ -1409,7 +1409,7 @@ Object Interpreter::eval_plus(const Object& form,
 template <typename T>
 Object Interpreter::num_times(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   (void)form;
   T result = 1;
@@ -1424,7 +1424,7 @@ Object Interpreter::num_times(const Object& form,
  */
 Object Interpreter::eval_times(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   if (!args.named.empty() || args.unnamed.empty()) {
     throw_eval_error(form, "* must receive at least one unnamed argument!");
   }
@@ -1448,7 +1448,7 @@ Object Interpreter::eval_times(const Object& form,
 template <typename T>
 Object Interpreter::num_minus(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   (void)form;
   T result;
@@ -1468,7 +1468,7 @@ Object Interpreter::num_minus(const Object& form,
  */
 Object Interpreter::eval_minus(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   if (!args.named.empty() || args.unnamed.empty()) {
     throw_eval_error(form, "- must receive at least one unnamed argument!");
   }
@@ -1492,7 +1492,7 @@ Object Interpreter::eval_minus(const Object& form,
 template <typename T>
 Object Interpreter::num_divide(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   (void)form;
   T result = number<T>(args.unnamed[0]) / number<T>(args.unnamed[1]);
@@ -1504,7 +1504,7 @@ Object Interpreter::num_divide(const Object& form,
  */
 Object Interpreter::eval_divide(const Object& form,
                                 Arguments& args,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}, {}}, {});
   switch (args.unnamed.front().type) {
     case ObjectType::INTEGER:
@@ -1524,7 +1524,7 @@ Object Interpreter::eval_divide(const Object& form,
  */
 Object Interpreter::eval_numequals(const Object& form,
                                    Arguments& args,
-                                   const std::shared_ptr<EnvironmentObject>& env) {
+                                   const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   if (!args.named.empty() || args.unnamed.size() < 2) {
     throw_eval_error(form, "= must receive at least two unnamed arguments!");
@@ -1563,7 +1563,7 @@ Object Interpreter::eval_numequals(const Object& form,
 template <typename T>
 Object Interpreter::num_lt(const Object& form,
                            Arguments& args,
-                           const std::shared_ptr<EnvironmentObject>& env) {
+                           const HeapPtr<EnvironmentObject>& env) {
   (void)form;
   (void)env;
   T a = number<T>(args.unnamed[0]);
@@ -1573,7 +1573,7 @@ Object Interpreter::num_lt(const Object& form,
 
 Object Interpreter::eval_lt(const Object& form,
                             Arguments& args,
-                            const std::shared_ptr<EnvironmentObject>& env) {
+                            const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}, {}}, {});
   switch (args.unnamed.front().type) {
     case ObjectType::INTEGER:
@@ -1591,7 +1591,7 @@ Object Interpreter::eval_lt(const Object& form,
 template <typename T>
 Object Interpreter::num_gt(const Object& form,
                            Arguments& args,
-                           const std::shared_ptr<EnvironmentObject>& env) {
+                           const HeapPtr<EnvironmentObject>& env) {
   (void)form;
   (void)env;
   T a = number<T>(args.unnamed[0]);
@@ -1601,7 +1601,7 @@ Object Interpreter::num_gt(const Object& form,
 
 Object Interpreter::eval_gt(const Object& form,
                             Arguments& args,
-                            const std::shared_ptr<EnvironmentObject>& env) {
+                            const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}, {}}, {});
   switch (args.unnamed.front().type) {
     case ObjectType::INTEGER:
@@ -1619,7 +1619,7 @@ Object Interpreter::eval_gt(const Object& form,
 template <typename T>
 Object Interpreter::num_leq(const Object& form,
                             Arguments& args,
-                            const std::shared_ptr<EnvironmentObject>& env) {
+                            const HeapPtr<EnvironmentObject>& env) {
   (void)form;
   (void)env;
   T a = number<T>(args.unnamed[0]);
@@ -1629,7 +1629,7 @@ Object Interpreter::num_leq(const Object& form,
 
 Object Interpreter::eval_leq(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}, {}}, {});
   switch (args.unnamed.front().type) {
     case ObjectType::INTEGER:
@@ -1647,7 +1647,7 @@ Object Interpreter::eval_leq(const Object& form,
 template <typename T>
 Object Interpreter::num_geq(const Object& form,
                             Arguments& args,
-                            const std::shared_ptr<EnvironmentObject>& env) {
+                            const HeapPtr<EnvironmentObject>& env) {
   (void)form;
   (void)env;
   T a = number<T>(args.unnamed[0]);
@@ -1657,7 +1657,7 @@ Object Interpreter::num_geq(const Object& form,
 
 Object Interpreter::eval_geq(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}, {}}, {});
   switch (args.unnamed.front().type) {
     case ObjectType::INTEGER:
@@ -1674,14 +1674,14 @@ Object Interpreter::eval_geq(const Object& form,
 
 Object Interpreter::eval_eval(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   vararg_check(form, args, {{}}, {});
   return eval(args.unnamed[0], env);
 }
 
 Object Interpreter::eval_car(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::PAIR}, {});
   return args.unnamed[0].as_pair()->car;
@@ -1689,7 +1689,7 @@ Object Interpreter::eval_car(const Object& form,
 
 Object Interpreter::eval_set_car(const Object& form,
                                  Arguments& args,
-                                 const std::shared_ptr<EnvironmentObject>& env) {
+                                 const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::PAIR, {}}, {});
   args.unnamed[0].as_pair()->car = args.unnamed[1];
@@ -1698,7 +1698,7 @@ Object Interpreter::eval_set_car(const Object& form,
 
 Object Interpreter::eval_set_cdr(const Object& form,
                                  Arguments& args,
-                                 const std::shared_ptr<EnvironmentObject>& env) {
+                                 const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::PAIR, {}}, {});
   args.unnamed[0].as_pair()->cdr = args.unnamed[1];
@@ -1707,7 +1707,7 @@ Object Interpreter::eval_set_cdr(const Object& form,
 
 Object Interpreter::eval_cdr(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::PAIR}, {});
   return args.unnamed[0].as_pair()->cdr;
@@ -1715,7 +1715,7 @@ Object Interpreter::eval_cdr(const Object& form,
 
 Object Interpreter::eval_gensym(const Object& form,
                                 Arguments& args,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {}, {});
   return Object::make_symbol(&reader.symbolTable, ("gensym" + std::to_string(gensym_id++)).c_str());
@@ -1723,7 +1723,7 @@ Object Interpreter::eval_gensym(const Object& form,
 
 Object Interpreter::eval_cons(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}, {}}, {});
   return PairObject::make_new(args.unnamed[0], args.unnamed[1]);
@@ -1731,7 +1731,7 @@ Object Interpreter::eval_cons(const Object& form,
 
 Object Interpreter::eval_null(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}}, {});
   return true_or_false(args.unnamed[0].is_empty_list());
@@ -1739,7 +1739,7 @@ Object Interpreter::eval_null(const Object& form,
 
 Object Interpreter::eval_type(const Object& form,
                               Arguments& args,
-                              const std::shared_ptr<EnvironmentObject>& env) {
+                              const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{ObjectType::SYMBOL}, {}}, {});
 
@@ -1757,7 +1757,7 @@ Object Interpreter::eval_type(const Object& form,
 
 Object Interpreter::eval_format(const Object& form,
                                 Arguments& args,
-                                const std::shared_ptr<EnvironmentObject>& env) {
+                                const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   if (args.unnamed.size() < 2) {
     throw_eval_error(form, "format must get at least two arguments");
@@ -1798,7 +1798,7 @@ Object Interpreter::eval_format(const Object& form,
 
 Object Interpreter::eval_error(const Object& form,
                                Arguments& args,
-                               const std::shared_ptr<EnvironmentObject>& env) {
+                               const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
   throw_eval_error(form, "Error: " + args.unnamed.at(0).as_string()->data);
@@ -1807,7 +1807,7 @@ Object Interpreter::eval_error(const Object& form,
 
 Object Interpreter::eval_string_ref(const Object& form,
                                     Arguments& args,
-                                    const std::shared_ptr<EnvironmentObject>& env) {
+                                    const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING, ObjectType::INTEGER}, {});
   auto str = args.unnamed.at(0).as_string();
@@ -1821,7 +1821,7 @@ Object Interpreter::eval_string_ref(const Object& form,
 
 Object Interpreter::eval_string_length(const Object& form,
                                        Arguments& args,
-                                       const std::shared_ptr<EnvironmentObject>& env) {
+                                       const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING}, {});
   auto str = args.unnamed.at(0).as_string();
@@ -1830,7 +1830,7 @@ Object Interpreter::eval_string_length(const Object& form,
 
 Object Interpreter::eval_string_append(const Object& form,
                                        Arguments& args,
-                                       const std::shared_ptr<EnvironmentObject>& env) {
+                                       const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   if (!args.named.empty()) {
     throw_eval_error(form, "string-append does not accept named arguments");
@@ -1849,7 +1849,7 @@ Object Interpreter::eval_string_append(const Object& form,
 
 Object Interpreter::eval_string_starts_with(const Object& form,
                                             Arguments& args,
-                                            const std::shared_ptr<EnvironmentObject>& env) {
+                                            const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING, ObjectType::STRING}, {});
   auto& str = args.unnamed.at(0).as_string()->data;
@@ -1863,7 +1863,7 @@ Object Interpreter::eval_string_starts_with(const Object& form,
 
 Object Interpreter::eval_string_ends_with(const Object& form,
                                           Arguments& args,
-                                          const std::shared_ptr<EnvironmentObject>& env) {
+                                          const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING, ObjectType::STRING}, {});
   auto& str = args.unnamed.at(0).as_string()->data;
@@ -1877,7 +1877,7 @@ Object Interpreter::eval_string_ends_with(const Object& form,
 
 Object Interpreter::eval_string_split(const Object& form,
                                       Arguments& args,
-                                      const std::shared_ptr<EnvironmentObject>& env) {
+                                      const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING, ObjectType::STRING}, {});
   auto& str = args.unnamed.at(0).as_string()->data;
@@ -1888,7 +1888,7 @@ Object Interpreter::eval_string_split(const Object& form,
 
 Object Interpreter::eval_string_substr(const Object& form,
                                        Arguments& args,
-                                       const std::shared_ptr<EnvironmentObject>& env) {
+                                       const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {ObjectType::STRING, ObjectType::INTEGER, ObjectType::INTEGER}, {});
   auto& str = args.unnamed.at(0).as_string()->data;
@@ -1900,7 +1900,7 @@ Object Interpreter::eval_string_substr(const Object& form,
 
 Object Interpreter::eval_ash(const Object& form,
                              Arguments& args,
-                             const std::shared_ptr<EnvironmentObject>& env) {
+                             const HeapPtr<EnvironmentObject>& env) {
   (void)env;
   vararg_check(form, args, {{}, {}}, {});
   auto val = number_to_integer(args.unnamed.at(0));
@@ -1917,28 +1917,28 @@ Object Interpreter::eval_ash(const Object& form,
 
 Object Interpreter::eval_symbol_to_string(const Object& form,
                                           Arguments& args,
-                                          const std::shared_ptr<EnvironmentObject>&) {
+                                          const HeapPtr<EnvironmentObject>&) {
   vararg_check(form, args, {ObjectType::SYMBOL}, {});
   return StringObject::make_new(args.unnamed.at(0).as_symbol().name_ptr);
 }
 
 Object Interpreter::eval_string_to_symbol(const Object& form,
                                           Arguments& args,
-                                          const std::shared_ptr<EnvironmentObject>&) {
+                                          const HeapPtr<EnvironmentObject>&) {
   vararg_check(form, args, {ObjectType::STRING}, {});
   return Object::make_symbol(&reader.symbolTable, args.unnamed.at(0).as_string()->data.c_str());
 }
 
 Object Interpreter::eval_int_to_string(const Object& form,
                                        Arguments& args,
-                                       const std::shared_ptr<EnvironmentObject>&) {
+                                       const HeapPtr<EnvironmentObject>&) {
   vararg_check(form, args, {ObjectType::INTEGER}, {});
   return StringObject::make_new(std::to_string(args.unnamed.at(0).as_int()));
 }
 
 Object Interpreter::eval_get_env(const Object& form,
                                  Arguments& args,
-                                 const std::shared_ptr<EnvironmentObject>&) {
+                                 const HeapPtr<EnvironmentObject>&) {
   vararg_check(form, args, {ObjectType::STRING}, {{"default", {false, ObjectType::STRING}}});
   const std::string var_name = args.unnamed.at(0).as_string()->data;
   auto env_p = get_env(var_name);
@@ -1958,7 +1958,7 @@ Object Interpreter::eval_get_env(const Object& form,
  */
 Object Interpreter::eval_make_string_hash_table(const Object& form,
                                                 Arguments& args,
-                                                const std::shared_ptr<EnvironmentObject>& /*env*/) {
+                                                const HeapPtr<EnvironmentObject>& /*env*/) {
   vararg_check(form, args, {}, {});
   return StringHashTableObject::make_new();
 }
@@ -1969,7 +1969,7 @@ Object Interpreter::eval_make_string_hash_table(const Object& form,
  */
 Object Interpreter::eval_hash_table_set(const Object& form,
                                         Arguments& args,
-                                        const std::shared_ptr<EnvironmentObject>& /*env*/) {
+                                        const HeapPtr<EnvironmentObject>& /*env*/) {
   vararg_check(form, args, {ObjectType::STRING_HASH_TABLE, {}, {}}, {});
   const char* str = nullptr;
   if (args.unnamed.at(1).is_symbol()) {
@@ -1989,7 +1989,7 @@ Object Interpreter::eval_hash_table_set(const Object& form,
  */
 Object Interpreter::eval_hash_table_try_ref(const Object& form,
                                             Arguments& args,
-                                            const std::shared_ptr<EnvironmentObject>& /*env*/) {
+                                            const HeapPtr<EnvironmentObject>& /*env*/) {
   vararg_check(form, args, {ObjectType::STRING_HASH_TABLE, {}}, {});
   const auto* table = args.unnamed.at(0).as_string_hash_table();
 
@@ -4,8 +4,8 @@
  * There are different types of objects, as represented by ObjectType.
  * An "Object" is an efficient wrapper around any of these types.
  * Some types are "heap allocated", and have reference semantics, and others are
- * "fixed" and have value semantics.  Heap allocated objects implement reference counting with
- * std::shared_ptr.
+ * "fixed" and have value semantics.  Heap allocated objects are reference counted with HeapPtr,
+ * which keeps the count inside the object. Pairs are allocated from a per-thread pool.
  *
  * To create a new Object for a heap allocated type, use the make_new static method of the type of
  * object you want to make. This will return a correctly setup Object. For fixed objects, use
@@ -42,6 +42,7 @@
 
 #include <cinttypes>
 #include <cstring>
+#include <mutex>
 
 #include "common/util/FileUtil.h"
 #include "common/util/crc32.h"
@@ -219,6 +220,111 @@ std::string fixed_to_string(InternedSymbolPtr x) {
   return x.name_ptr;
 }
 
+namespace {
+/*!
+ * Pairs are by far the most common heap object (every list cell is one), so they are allocated from
+ * a free list. Each thread has its own free list, so allocation and freeing don't need a lock.
+ * A pair freed on a different thread than it was allocated on just goes on the freeing thread's
+ * list. When a thread exits, its free pairs go to a shared list that other threads refill from.
+ * Chunks are never returned to the system.
+ */
+union PairSlot {
+  PairSlot* next;
+  alignas(PairObject) u8 data[sizeof(PairObject)];
+};
+
+constexpr int kPairsPerChunk = 512;
+
+struct SharedPairs {
+  std::mutex mutex;
+  PairSlot* free_list = nullptr;
+};
+
+SharedPairs& shared_pairs() {
+  // leaked, so it's still around if pairs are freed during static destruction.
+  static auto* pairs = new SharedPairs;
+  return *pairs;
+}
+
+// trivially destructible, so it's safe to use from other thread_local destructors.
+thread_local PairSlot* t_free_pairs = nullptr;
+
+struct ThreadPairsReturner {
+  bool active = false;
+  ~ThreadPairsReturner() {
+    if (!t_free_pairs) {
+      return;
+    }
+    PairSlot* last = t_free_pairs;
+    while (last->next) {
+      last = last->next;
+    }
+    auto& shared = shared_pairs();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    last->next = shared.free_list;
+    shared.free_list = t_free_pairs;
+    t_free_pairs = nullptr;
+  }
+};
+thread_local ThreadPairsReturner t_pairs_returner;
+
+void refill_pairs() {
+  t_pairs_returner.active = true;  // make sure this thread's returner is constructed.
+  {
+    auto& shared = shared_pairs();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    if (shared.free_list) {
+      // take up to a chunk's worth.
+      PairSlot* head = shared.free_list;
+      PairSlot* last = head;
+      for (int i = 1; i < kPairsPerChunk && last->next; i++) {
+        last = last->next;
+      }
+      shared.free_list = last->next;
+      last->next = nullptr;
+      t_free_pairs = head;
+      return;
+    }
+  }
+
+  auto* chunk = new PairSlot[kPairsPerChunk];
+  for (int i = 0; i < kPairsPerChunk - 1; i++) {
+    chunk[i].next = &chunk[i + 1];
+  }
+  chunk[kPairsPerChunk - 1].next = nullptr;
+  t_free_pairs = chunk;
+}
+}  // namespace
+
+void* PairObject::operator new(size_t size) {
+  ASSERT(size == sizeof(PairObject));
+  if (!t_free_pairs) {
+    refill_pairs();
+  }
+  PairSlot* slot = t_free_pairs;
+  t_free_pairs = slot->next;
+  return slot;
+}
+
+void PairObject::operator delete(void* ptr, size_t size) {
+  ASSERT(size == sizeof(PairObject));
+  if (!t_free_pairs) {
+    t_pairs_returner.active = true;  // this thread may only free pairs, never allocate them.
+  }
+  auto* slot = static_cast<PairSlot*>(ptr);
+  slot->next = t_free_pairs;
+  t_free_pairs = slot;
+}
+
+PairObject::~PairObject() {
+  // free the rest of a list in a loop, rather than recursively through each cdr, which could
+  // overflow the stack on a long list.
+  while (cdr.type == ObjectType::PAIR && cdr.heap_obj.use_count() == 1) {
+    Object next = std::move(cdr.as_pair()->cdr);
+    cdr = std::move(next);
+  }
+}
+
 /*!
  * Build a list of objects from a vector of objects.
  */
@@ -228,9 +334,8 @@ Object build_list(const std::vector<Object>& objects) {
   }
 
   // this is by far the most expensive part of parsing, so this is done a bit carefully.
-  // we maintain a std::shared_ptr<PairObject> that represents the list, built from back to front.
-  std::shared_ptr<PairObject> head =
-      std::make_shared<PairObject>(objects.back(), Object::make_empty_list());
+  // we maintain a HeapPtr<PairObject> that represents the list, built from back to front.
+  HeapPtr<PairObject> head = make_heap<PairObject>(objects.back(), Object::make_empty_list());
 
   s64 idx = ((s64)objects.size()) - 2;
   while (idx >= 0) {
@@ -238,7 +343,7 @@ Object build_list(const std::vector<Object>& objects) {
     next.type = ObjectType::PAIR;
     next.heap_obj = std::move(head);
 
-    head = std::make_shared<PairObject>();
+    head = make_heap<PairObject>();
     head->car = objects[idx];
     head->cdr = std::move(next);
 
@@ -257,9 +362,8 @@ Object build_list(std::vector<Object>&& objects) {
   }
 
   // this is by far the most expensive part of parsing, so this is done a bit carefully.
-  // we maintain a std::shared_ptr<PairObject> that represents the list, built from back to front.
-  std::shared_ptr<PairObject> head =
-      std::make_shared<PairObject>(objects.back(), Object::make_empty_list());
+  // we maintain a HeapPtr<PairObject> that represents the list, built from back to front.
+  HeapPtr<PairObject> head = make_heap<PairObject>(objects.back(), Object::make_empty_list());
 
   s64 idx = ((s64)objects.size()) - 2;
   while (idx >= 0) {
@@ -267,7 +371,7 @@ Object build_list(std::vector<Object>&& objects) {
     next.type = ObjectType::PAIR;
     next.heap_obj = std::move(head);
 
-    head = std::make_shared<PairObject>();
+    head = make_heap<PairObject>();
     head->car = std::move(objects[idx]);
     head->cdr = std::move(next);
 
@@ -6,8 +6,8 @@
  * There are different types of objects, as represented by ObjectType.
  * An "Object" is an efficient wrapper around any of these types.
  * Some types are "heap allocated", and have reference semantics, and others are
- * "fixed" and have value semantics.  Heap allocated objects implement reference counting with
- * std::shared_ptr.
+ * "fixed" and have value semantics.  Heap allocated objects are reference counted with HeapPtr,
+ * which keeps the count inside the object. Pairs are allocated from a per-thread pool.
  *
  * To create a new Object for a heap allocated type, use the make_new static method of the type of
  * object you want to make. This will return a correctly setup Object. For fixed objects, use
@@ -43,11 +43,13 @@
  *
  */
 
+#include <atomic>
 #include <cstring>
 #include <map>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -204,11 +206,125 @@ using SymbolObject = FixedObject<InternedSymbolPtr>;
 
 class HeapObject {
  public:
+  HeapObject() = default;
+  // the reference count belongs to the allocation, so copies start out unreferenced.
+  HeapObject(const HeapObject&) {}
+  HeapObject& operator=(const HeapObject&) { return *this; }
   virtual std::string print() const = 0;
   virtual std::string inspect() const = 0;
   virtual ~HeapObject() = default;
+
+ private:
+  template <typename T>
+  friend class HeapPtr;
+  mutable std::atomic<u32> m_ref_count = 0;
+};
+
+/*!
+ * Reference counting pointer to a HeapObject. Works like a std::shared_ptr, but the count is stored
+ * in the object, so there is no separate control block or weak count and the pointer is 8 bytes.
+ * The count is atomic because objects are shared between threads (decompiler and make workers).
+ */
+template <typename T>
+class HeapPtr {
+ public:
+  HeapPtr() = default;
+  HeapPtr(std::nullptr_t) {}
+  explicit HeapPtr(T* ptr) : m_ptr(ptr) { retain(); }
+  HeapPtr(const HeapPtr& other) : m_ptr(other.m_ptr) { retain(); }
+  HeapPtr(HeapPtr&& other) noexcept : m_ptr(other.m_ptr) { other.m_ptr = nullptr; }
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  HeapPtr(const HeapPtr<U>& other) : m_ptr(other.m_ptr) {
+    retain();
+  }
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  HeapPtr(HeapPtr<U>&& other) noexcept : m_ptr(other.m_ptr) {
+    other.m_ptr = nullptr;
+  }
+  ~HeapPtr() { release(); }
+
+  HeapPtr& operator=(const HeapPtr& other) {
+    HeapPtr(other).swap(*this);
+    return *this;
+  }
+  HeapPtr& operator=(HeapPtr&& other) noexcept {
+    HeapPtr(std::move(other)).swap(*this);
+    return *this;
+  }
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  HeapPtr& operator=(const HeapPtr<U>& other) {
+    HeapPtr(other).swap(*this);
+    return *this;
+  }
+  template <typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+  HeapPtr& operator=(HeapPtr<U>&& other) noexcept {
+    HeapPtr(std::move(other)).swap(*this);
+    return *this;
+  }
+  HeapPtr& operator=(std::nullptr_t) {
+    reset();
+    return *this;
+  }
+
+  T* get() const { return m_ptr; }
+  T* operator->() const { return m_ptr; }
+  T& operator*() const { return *m_ptr; }
+  explicit operator bool() const { return m_ptr != nullptr; }
+  u32 use_count() const { return m_ptr ? m_ptr->m_ref_count.load(std::memory_order_relaxed) : 0; }
+
+  void reset() { HeapPtr().swap(*this); }
+  void swap(HeapPtr& other) noexcept { std::swap(m_ptr, other.m_ptr); }
+
+ private:
+  template <typename U>
+  friend class HeapPtr;
+
+  void retain() {
+    if (m_ptr) {
+      m_ptr->m_ref_count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  void release() {
+    if (m_ptr && m_ptr->m_ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete m_ptr;
+    }
+  }
+
+  T* m_ptr = nullptr;
 };
 
+template <typename T, typename U>
+bool operator==(const HeapPtr<T>& a, const HeapPtr<U>& b) {
+  return a.get() == b.get();
+}
+
+template <typename T, typename U>
+bool operator!=(const HeapPtr<T>& a, const HeapPtr<U>& b) {
+  return a.get() != b.get();
+}
+
+template <typename T>
+bool operator==(const HeapPtr<T>& a, std::nullptr_t) {
+  return !a;
+}
+
+template <typename T>
+bool operator!=(const HeapPtr<T>& a, std::nullptr_t) {
+  return (bool)a;
+}
+
+template <typename T, typename... Args>
+HeapPtr<T> make_heap(Args&&... args) {
+  return HeapPtr<T>(new T(std::forward<Args>(args)...));
+}
+
+// like std::static_pointer_cast. The caller must have checked the type.
+template <typename T, typename U>
+HeapPtr<T> static_heap_cast(const HeapPtr<U>& ptr) {
+  return HeapPtr<T>(static_cast<T*>(ptr.get()));
+}
+
 // forward declare all HeapObjects
 class PairObject;
 class EnvironmentObject;
@@ -221,7 +337,7 @@ class StringHashTableObject;
 // Wrapper Object class for all objects
 class Object {
  public:
-  std::shared_ptr<HeapObject> heap_obj = nullptr;
+  HeapPtr<HeapObject> heap_obj = nullptr;
   friend Object build_list(const std::vector<Object>& objects);
   friend Object build_list(std::vector<Object>&& objects);
 
@@ -307,7 +423,7 @@ class Object {
 
   PairObject* as_pair() const;
   EnvironmentObject* as_env() const;
-  std::shared_ptr<EnvironmentObject> as_env_ptr() const;
+  HeapPtr<EnvironmentObject> as_env_ptr() const;
   StringObject* as_string() const;
   LambdaObject* as_lambda() const;
   MacroObject* as_macro() const;
@@ -391,7 +507,7 @@ class StringObject : public HeapObject {
   static Object make_new(const std::string& text) {
     Object obj;
     obj.type = ObjectType::STRING;
-    obj.heap_obj = std::make_shared<StringObject>(text);
+    obj.heap_obj = make_heap<StringObject>(text);
     return obj;
   }
 
@@ -411,10 +527,14 @@ class PairObject : public HeapObject {
   static Object make_new(const Object& a, const Object& b) {
     Object obj;
     obj.type = ObjectType::PAIR;
-    obj.heap_obj = std::make_shared<PairObject>(a, b);
+    obj.heap_obj = make_heap<PairObject>(a, b);
     return obj;
   }
 
+  // pairs come from a per-thread free list instead of the general heap.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
   std::string print() const override {
     std::pair<Object, Object> to_print_pair = std::make_pair(car, cdr);
 
@@ -434,9 +554,9 @@ class PairObject : public HeapObject {
 
     for (;;) {
       if (to_print.type == ObjectType::PAIR) {
-        Object to_print_car = std::dynamic_pointer_cast<PairObject>(to_print.heap_obj)->car;
+        Object to_print_car = to_print.as_pair()->car;
         result += to_print_car.print();
-        to_print = std::dynamic_pointer_cast<PairObject>(to_print.heap_obj)->cdr;
+        to_print = to_print.as_pair()->cdr;
         if (to_print.type == ObjectType::EMPTY_LIST) {
           result += ")";
           return result;
@@ -454,7 +574,7 @@ class PairObject : public HeapObject {
 
   std::string inspect() const override { return "[pair] " + print() + "\n"; }
 
-  ~PairObject() = default;
+  ~PairObject() override;
 };
 
 template <typename T>
@@ -574,7 +694,7 @@ using EnvironmentMap = InternedPtrMap<Object>;
 class EnvironmentObject : public HeapObject {
  public:
   std::string name;
-  std::shared_ptr<EnvironmentObject> parent_env;
+  HeapPtr<EnvironmentObject> parent_env;
 
   // note: this is keyed on the address in the symbol table.
   EnvironmentMap vars;
@@ -588,15 +708,15 @@ class EnvironmentObject : public HeapObject {
   static Object make_new() {
     Object obj;
     obj.type = ObjectType::ENVIRONMENT;
-    obj.heap_obj = std::make_shared<EnvironmentObject>();
+    obj.heap_obj = make_heap<EnvironmentObject>();
     return obj;
   }
 
   static Object make_new(std::string name,
-                         std::shared_ptr<EnvironmentObject> parent_env = nullptr) {
+                         HeapPtr<EnvironmentObject> parent_env = nullptr) {
     Object obj;
     obj.type = ObjectType::ENVIRONMENT;
-    auto env = std::make_shared<EnvironmentObject>();
+    auto env = make_heap<EnvironmentObject>();
     env->name = std::move(name);
     env->parent_env = std::move(parent_env);
     obj.heap_obj = std::move(env);
@@ -652,7 +772,7 @@ struct Arguments {
 class LambdaObject : public HeapObject {
  public:
   std::string name;
-  std::shared_ptr<EnvironmentObject> parent_env;
+  HeapPtr<EnvironmentObject> parent_env;
   Object body;
   ArgumentSpec args;
 
@@ -661,7 +781,7 @@ class LambdaObject : public HeapObject {
   static Object make_new() {
     Object obj;
     obj.type = ObjectType::LAMBDA;
-    obj.heap_obj = std::make_shared<LambdaObject>();
+    obj.heap_obj = make_heap<LambdaObject>();
     return obj;
   }
 
@@ -679,7 +799,7 @@ class LambdaObject : public HeapObject {
 class MacroObject : public HeapObject {
  public:
   std::string name;
-  std::shared_ptr<EnvironmentObject> parent_env;
+  HeapPtr<EnvironmentObject> parent_env;
   Object body;
   ArgumentSpec args;
 
@@ -688,7 +808,7 @@ class MacroObject : public HeapObject {
   static Object make_new() {
     Object obj;
     obj.type = ObjectType::MACRO;
-    obj.heap_obj = std::make_shared<MacroObject>();
+    obj.heap_obj = make_heap<MacroObject>();
     return obj;
   }
 
@@ -710,7 +830,7 @@ class ArrayObject : public HeapObject {
   static Object make_new(std::vector<Object> objects) {
     Object obj;
     obj.type = ObjectType::ARRAY;
-    obj.heap_obj = std::make_shared<ArrayObject>(std::move(objects));
+    obj.heap_obj = make_heap<ArrayObject>(std::move(objects));
     return obj;
   }
 
@@ -744,7 +864,7 @@ class StringHashTableObject : public HeapObject {
   static Object make_new() {
     Object obj;
     obj.type = ObjectType::STRING_HASH_TABLE;
-    obj.heap_obj = std::make_shared<StringHashTableObject>();
+    obj.heap_obj = make_heap<StringHashTableObject>();
     return obj;
   }
 
@@ -787,11 +907,11 @@ inline EnvironmentObject* Object::as_env() const {
   return static_cast<EnvironmentObject*>(heap_obj.get());
 }
 
-inline std::shared_ptr<EnvironmentObject> Object::as_env_ptr() const {
+inline HeapPtr<EnvironmentObject> Object::as_env_ptr() const {
   if (type != ObjectType::ENVIRONMENT) {
     throw std::runtime_error("as_env called on a " + object_type_to_string(type) + " " + print());
   }
-  return std::dynamic_pointer_cast<EnvironmentObject>(heap_obj);
+  return static_heap_cast<EnvironmentObject>(heap_obj);
 }
 
 inline StringObject* Object::as_string() const {
@@ -832,3 +952,8 @@ inline StringHashTableObject* Object::as_string_hash_table() const {
   return static_cast<StringHashTableObject*>(heap_obj.get());
 }
 }  // namespace goos
+
+template <typename T>
+struct std::hash<goos::HeapPtr<T>> {
+  size_t operator()(const goos::HeapPtr<T>& ptr) const { return std::hash<T*>()(ptr.get()); }
+};
@@ -465,8 +465,8 @@ bool Reader::read_array(TextStream& stream, Object& o) {
 
 struct ListBuilder {
   Object head;
-  std::shared_ptr<PairObject> prev_tail;
-  std::shared_ptr<PairObject> tail;
+  HeapPtr<PairObject> prev_tail;
+  HeapPtr<PairObject> tail;
   int size = 0;
 
   ListBuilder() { head = Object::make_empty_list(); }
@@ -474,11 +474,11 @@ struct ListBuilder {
   void push_back(Object&& o) {
     size++;
     if (!tail) {
-      tail = std::make_shared<PairObject>(o, Object{});
+      tail = make_heap<PairObject>(o, Object{});
       head.type = ObjectType::PAIR;
       head.heap_obj = tail;
     } else {
-      auto next = std::make_shared<PairObject>(o, Object{});
+      auto next = make_heap<PairObject>(o, Object{});
       tail->cdr.type = ObjectType::PAIR;
       tail->cdr.heap_obj = next;
       prev_tail = std::move(tail);
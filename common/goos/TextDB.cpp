@@ -176,7 +176,7 @@ std::optional<TextDb::ShortInfo> TextDb::get_short_info_for(const std::shared_pt
 }
 
 std::optional<TextDb::ShortInfo> TextDb::try_get_short_info(
-    const std::shared_ptr<goos::HeapObject>& heap_obj) const {
+    const goos::HeapPtr<goos::HeapObject>& heap_obj) const {
   auto it = m_map.find(heap_obj);
   if (it != m_map.end()) {
     auto& frag = it->second.frag;
@@ -112,7 +112,7 @@ class TextDb {
   std::optional<ShortInfo> get_short_info_for(const std::shared_ptr<SourceText>& frag,
                                               int offset) const;
   std::optional<ShortInfo> try_get_short_info(const Object& o) const;
-  std::optional<ShortInfo> try_get_short_info(const std::shared_ptr<goos::HeapObject>& o) const;
+  std::optional<ShortInfo> try_get_short_info(const goos::HeapPtr<goos::HeapObject>& o) const;
 
   bool has_info(const Object& o) const;
   void inherit_info(const Object& parent, const Object& child);
@@ -120,6 +120,6 @@ class TextDb {
 
  private:
   std::vector<std::shared_ptr<SourceText>> m_fragments;
-  std::unordered_map<std::shared_ptr<goos::HeapObject>, TextRef> m_map;
+  std::unordered_map<goos::HeapPtr<goos::HeapObject>, TextRef> m_map;
 };
 }  // namespace goos
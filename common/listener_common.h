@@ -40,7 +40,9 @@ enum ListenerToTargetMsgKind : u16 {
   LTT_MSG_RESET = 8,          //! Reset the game
   LTT_MSG_CODE = 9,           //! Send code to patch into the game
   // below here are added
-  LTT_MSG_SHUTDOWN = 10  //! Shut down the runtime.
+  LTT_MSG_SHUTDOWN = 10,    //! Shut down the runtime.
+  LTT_MSG_CODE_CHUNK = 11,  //! Part of a code object too big for one message, the rest follows
+  LTT_MSG_CODE_ZSTD = 12    //! Like CODE, but the object is compressed with compress_zstd
 };
 
 /*!
@@ -58,6 +60,12 @@ struct ListenerMessageHeader {
   u64 msg_id;    //! Message ID number, target echoes this back.
 };
 
+/*!
+ * Code objects larger than this are sent as a series of LTT_MSG_CODE_CHUNK messages followed by a
+ * final LTT_MSG_CODE/LTT_MSG_CODE_ZSTD. Must fit in the runtime's debug message buffer.
+ */
+constexpr u32 LISTENER_CODE_CHUNK_SIZE = 256 * 1024;
+
 constexpr int DECI2_PORT = 8112;  // TODO - is this a good choice?
 
 constexpr u16 DECI2_PROTOCOL = 0xe042;
@@ -14,6 +14,7 @@ void to_json(json& j, const Config& obj) {
       {"keybinds", obj.keybinds},
       {"perGameHistory", obj.per_game_history},
       {"permissiveRedefinitions", obj.permissive_redefinitions},
+      {"makeJobs", obj.make_jobs},
   };
 }
 
@@ -64,6 +65,9 @@ void from_json(const json& j, Config& obj) {
   if (j.contains("permissiveRedefinitions")) {
     j.at("permissiveRedefinitions").get_to(obj.permissive_redefinitions);
   }
+  if (j.contains("makeJobs")) {
+    j.at("makeJobs").get_to(obj.make_jobs);
+  }
   // if there is game specific configuration, override any values we just set
   if (j.contains(version_to_game_name(obj.game_version))) {
     from_json(j.at(version_to_game_name(obj.game_version)), obj);
@@ -49,6 +49,8 @@ struct Config {
       {KeyBind::Modifier::CTRL, "N", "Full build of the game", "(mi)"}};
   bool per_game_history = true;
   bool permissive_redefinitions = false;
+  // number of threads used by the make system for steps that can run in parallel.
+  int make_jobs = 1;
 
   int get_nrepl_port() {
     if (temp_nrepl_port != -1) {
@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <cstdio> /* defines FILENAME_MAX */
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <iostream>
 #include <sstream>
@@ -651,21 +652,15 @@ void assert_file_exists(const char* path, const char* error_message) {
 /*!
  * Check if the given DGO header (or entire file) is compressed.
  */
-bool dgo_header_is_compressed(const std::vector<u8>& data) {
+bool dgo_header_is_compressed(std::span<const u8> data) {
   const char compressed_header[] = "oZlB";
-  bool is_compressed = true;
-  for (int i = 0; i < 4; i++) {
-    if (compressed_header[i] != data.at(i)) {
-      is_compressed = false;
-    }
-  }
-  return is_compressed;
+  return data.size() >= 4 && !memcmp(data.data(), compressed_header, 4);
 }
 
 /*!
  * Decompress a DGO. Resulting data will start at the DGO header.
  */
-std::vector<u8> decompress_dgo(const std::vector<u8>& data_in) {
+std::vector<u8> decompress_dgo(std::span<const u8> data_in) {
   constexpr int MAX_CHUNK_SIZE = 0x8000;
   BinaryReader compressed_reader(data_in);
   // seek past oZlB
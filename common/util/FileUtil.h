@@ -18,6 +18,7 @@
 
 #include <optional>
 #include <regex>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -66,8 +67,8 @@ std::string convert_to_unix_path_separators(const std::string& path);
 void MakeISOName(char* dst, const char* src);
 void ISONameFromAnimationName(char* dst, const char* src);
 void assert_file_exists(const char* path, const char* error_message);
-bool dgo_header_is_compressed(const std::vector<u8>& data);
-std::vector<u8> decompress_dgo(const std::vector<u8>& data_in);
+bool dgo_header_is_compressed(std::span<const u8> data);
+std::vector<u8> decompress_dgo(std::span<const u8> data_in);
 FILE* open_file(const fs::path& path, const std::string& mode);
 std::vector<fs::path> find_files_in_dir(const fs::path& dir, const std::regex& pattern);
 std::vector<fs::path> find_files_recursively(const fs::path& base_dir, const std::regex& pattern);
@@ -0,0 +1,138 @@
+#include "MappedFile.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <cerrno>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "fmt/core.h"
+
+/*!
+ * Map a file. Throws std::runtime_error if the file can't be opened, like read_binary_file.
+ */
+MappedFile::MappedFile(const fs::path& path) {
+  auto status = fs::status(path);
+  if (!fs::exists(status)) {
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: does not exist.", path.string()));
+  }
+  if (status.type() != fs::file_type::regular && status.type() != fs::file_type::symlink) {
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: not a regular file or symlink.", path.string()));
+  }
+
+#ifdef _WIN32
+  HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                            OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: error {}", path.string(), GetLastError()));
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw std::runtime_error(
+        fmt::format("File {} cannot be opened: error {}", path.string(), GetLastError()));
+  }
+  m_file = file;
+  m_size = size.QuadPart;
+  if (m_size == 0) {
+    // can't map an empty file.
+    return;
+  }
+  m_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (m_mapping) {
+    m_data = (const u8*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0);
+  }
+  if (!m_data) {
+    auto error = GetLastError();
+    if (m_mapping) {
+      CloseHandle(m_mapping);
+    }
+    CloseHandle(file);
+    throw std::runtime_error(
+        fmt::format("File {} cannot be mapped: error {}", path.string(), error));
+  }
+#else
+  int fd = open(path.string().c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw std::runtime_error("File " + path.string() +
+                             " cannot be opened: " + std::string(strerror(errno)));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    close(fd);
+    throw std::runtime_error("File " + path.string() +
+                             " cannot be opened: " + std::string(strerror(errno)));
+  }
+  m_size = st.st_size;
+  if (m_size == 0) {
+    close(fd);
+    return;
+  }
+  void* mem = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps its own reference to the file.
+  close(fd);
+  if (mem == MAP_FAILED) {
+    throw std::runtime_error("File " + path.string() +
+                             " cannot be mapped: " + std::string(strerror(errno)));
+  }
+  m_data = (const u8*)mem;
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef _WIN32
+  if (m_data) {
+    UnmapViewOfFile(m_data);
+  }
+  if (m_mapping) {
+    CloseHandle(m_mapping);
+  }
+  if (m_file) {
+    CloseHandle(m_file);
+  }
+#else
+  if (m_data) {
+    munmap((void*)m_data, m_size);
+  }
+#endif
+}
+
+/*!
+ * Hint that the whole file will be read in order, so the OS can read ahead more aggressively.
+ */
+void MappedFile::advise_sequential() const {
+#ifndef _WIN32
+  if (m_data) {
+    madvise((void*)m_data, m_size, MADV_SEQUENTIAL);
+  }
+#endif
+}
+
+/*!
+ * Hint that this range will be read soon, so the OS can start loading it in the background.
+ */
+void MappedFile::advise_will_need(size_t offset, size_t len) const {
+#ifndef _WIN32
+  if (!m_data || offset >= m_size) {
+    return;
+  }
+  len = std::min(len, m_size - offset);
+  size_t page = sysconf(_SC_PAGESIZE);
+  size_t start = offset & ~(page - 1);
+  madvise((void*)(m_data + start), len + (offset - start), MADV_WILLNEED);
+#endif
+}
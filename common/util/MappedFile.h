@@ -0,0 +1,39 @@
+#pragma once
+
+/*!
+ * @file MappedFile.h
+ * Read-only memory mapping of a file.
+ */
+
+#include <span>
+
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+
+/*!
+ * A whole file, mapped read-only into memory. Pages are only read from disk when they are
+ * touched, and are shared with the OS file cache instead of being copied into the heap.
+ * The span is valid until the MappedFile is destroyed.
+ */
+class MappedFile {
+ public:
+  explicit MappedFile(const fs::path& path);
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  std::span<const u8> span() const { return {m_data, m_size}; }
+  size_t size() const { return m_size; }
+
+  // hints for the OS about how the mapping will be read. They don't do anything on Windows.
+  void advise_sequential() const;
+  void advise_will_need(size_t offset, size_t len) const;
+
+ private:
+  const u8* m_data = nullptr;
+  size_t m_size = 0;
+#ifdef _WIN32
+  void* m_file = nullptr;
+  void* m_mapping = nullptr;
+#endif
+};
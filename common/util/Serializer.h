@@ -52,6 +52,15 @@ class Serializer {
     memcpy(m_data, data, size);
   }
 
+  /*!
+   * Construct a serializer that reads from the given data.
+   * The serializer takes ownership of the buffer, so this doesn't need to copy it.
+   */
+  explicit Serializer(std::vector<u8>&& data)
+      : m_size(data.size()), m_writing(false), m_owns_data(false), m_owned_data(std::move(data)) {
+    m_data = m_owned_data.data();
+  }
+
   // don't allow copying, assigning, or move constructing.
   Serializer(const Serializer& other) = delete;
   Serializer& operator=(const Serializer& other) = delete;
@@ -63,18 +72,29 @@ class Serializer {
       return *this;
     }
 
+    if (m_owns_data) {
+      free(m_data);
+    }
+
     m_data = other.m_data;
     m_size = other.m_size;
     m_offset = other.m_offset;
     m_writing = other.m_writing;
+    m_owns_data = other.m_owns_data;
+    m_owned_data = std::move(other.m_owned_data);
 
     other.m_data = nullptr;
     other.m_size = 0;
+    other.m_owns_data = false;
 
     return *this;
   }
 
-  ~Serializer() { free(m_data); }
+  ~Serializer() {
+    if (m_owns_data) {
+      free(m_data);
+    }
+  }
 
   /*!
    * Save or load the thing pointed to by ptr.
@@ -230,4 +250,8 @@ class Serializer {
   size_t m_size = 0;
   size_t m_offset = 0;
   bool m_writing = false;
+  // if set, m_data was malloc'd by this serializer and must be freed. Otherwise, it points into
+  // m_owned_data (which may be empty).
+  bool m_owns_data = true;
+  std::vector<u8> m_owned_data;
 };
@@ -32,6 +32,28 @@ void SimpleThreadGroup::run(const std::function<void(int)>& func, int num_runs,
   m_joined = false;
 }
 
+void SimpleThreadGroup::run_dynamic(const std::function<void(int)>& func,
+                                    int num_runs,
+                                    int num_workers) {
+  ASSERT(m_joined);
+  m_func = func;
+  m_next_run = 0;
+
+  for (int thread_idx = 0; thread_idx < num_workers; thread_idx++) {
+    m_threads.emplace_back([&, num_runs]() {
+      while (true) {
+        int i = m_next_run.fetch_add(1);
+        if (i >= num_runs) {
+          break;
+        }
+        m_func(i);
+      }
+    });
+  }
+
+  m_joined = false;
+}
+
 void SimpleThreadGroup::join() {
   ASSERT(!m_joined);
   for (auto& t : m_threads) {
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <functional>
 #include <thread>
 #include <vector>
@@ -20,10 +21,17 @@ class SimpleThreadGroup {
  public:
   void run(const std::function<void(int)>& func, int num_runs, int num_workers);
   void run(const std::function<void(int)>& func, int num_runs);
+  /*!
+   * Like run, but instead of splitting the runs into equal sized ranges up front, each worker grabs
+   * the next index when it finishes its current one. Use this when the runs take very different
+   * amounts of time. Indices are still started in increasing order.
+   */
+  void run_dynamic(const std::function<void(int)>& func, int num_runs, int num_workers);
   void join();
 
  private:
   bool m_joined = true;
+  std::atomic<int> m_next_run = 0;
   std::vector<std::thread> m_threads;
   std::function<void(int)> m_func;
 };
\ No newline at end of file
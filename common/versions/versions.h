@@ -13,7 +13,7 @@
 namespace versions {
 // language version (OpenGOAL)
 constexpr s32 GOAL_VERSION_MAJOR = 1;
-constexpr s32 GOAL_VERSION_MINOR = 0;
+constexpr s32 GOAL_VERSION_MINOR = 1;
 
 namespace jak1 {
 // these versions are from the game
@@ -61,6 +61,14 @@ struct LinkHeaderV5 {
   char name[59];                   // 21 (really??)
 };
 
+/*!
+ * Bounds-checked access to the raw object data.
+ */
+static const uint8_t& byte_at(std::span<const uint8_t> data, size_t offset) {
+  ASSERT(offset < data.size());
+  return data[offset];
+}
+
 // The types of symbol links
 enum class SymbolLinkKind {
   EMPTY_LIST,  // link to the empty list
@@ -72,7 +80,7 @@ enum class SymbolLinkKind {
  * Handle symbol links for a single symbol in a V2/V4 object file.
  */
 static uint32_t c_symlink2(LinkedObjectFile& f,
-                           const std::vector<uint8_t>& data,
+                           std::span<const uint8_t> data,
                            uint32_t code_ptr_offset,
                            uint32_t link_ptr_offset,
                            SymbolLinkKind kind,
@@ -82,8 +90,8 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
   dts.add_symbol(name);
   auto initial_offset = code_ptr_offset;
   do {
-    auto table_value = data.at(link_ptr_offset);
-    const uint8_t* relocPtr = &data.at(link_ptr_offset);
+    auto table_value = byte_at(data, link_ptr_offset);
+    const uint8_t* relocPtr = &byte_at(data, link_ptr_offset);
 
     // link table has a series of variable-length-encoded integers indicating the seek amount to hit
     // each reference to the symbol.  It ends when the seek is 0, and all references to this symbol
@@ -113,7 +121,7 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
     code_ptr_offset += (seek & 0xfffffffc);
 
     // the value of the code gives us more information
-    uint32_t code_value = *(const uint32_t*)(&data.at(code_ptr_offset));
+    uint32_t code_value = *(const uint32_t*)(&byte_at(data, code_ptr_offset));
     if (code_value == 0xffffffff) {
       // absolute link - replace entire word with a pointer.
       LinkedWord::Kind word_kind;
@@ -146,7 +154,7 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
                            (code_value & 0xffff) == 0xffff);
     }
 
-  } while (data.at(link_ptr_offset));
+  } while (byte_at(data, link_ptr_offset));
 
   // seek past terminating 0.
   return link_ptr_offset + 1;
@@ -156,7 +164,7 @@ static uint32_t c_symlink2(LinkedObjectFile& f,
  * Handle symbol links for a single symbol in a V3 object file.
  */
 static uint32_t c_symlink3(LinkedObjectFile& f,
-                           const std::vector<uint8_t>& data,
+                           std::span<const uint8_t> data,
                            uint32_t code_ptr,
                            uint32_t link_ptr,
                            SymbolLinkKind kind,
@@ -169,13 +177,13 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
     // seek, with a variable length encoding that sucks.
     uint8_t c;
     do {
-      c = data.at(link_ptr);
+      c = byte_at(data, link_ptr);
       link_ptr++;
       code_ptr += c * 4;
     } while (c == 0xff);
 
     // identical logic to symlink 2
-    uint32_t code_value = *(const uint32_t*)(&data.at(code_ptr));
+    uint32_t code_value = *(const uint32_t*)(&byte_at(data, code_ptr));
     if (code_value == 0xffffffff) {
       f.stats.v3_symbol_link_word++;
       LinkedWord::Kind word_kind;
@@ -203,7 +211,7 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
       f.symbol_link_offset(seg, code_ptr - initial_offset, name, lower == 0xffff);
     }
 
-  } while (data.at(link_ptr));
+  } while (byte_at(data, link_ptr));
   return link_ptr + 1;
 }
 
@@ -226,12 +234,12 @@ static uint32_t c_symlink3(LinkedObjectFile& f,
  * frame and level data is ~10 MB.
  */
 static void link_v2_or_v4(LinkedObjectFile& f,
-                          const std::vector<uint8_t>& data,
+                          std::span<const uint8_t> data,
                           const std::string& name,
                           DecompilerTypeSystem& dts,
                           GameVersion version) {
   (void)name;
-  const auto* header = (const LinkHeaderV4*)&data.at(0);
+  const auto* header = (const LinkHeaderV4*)&byte_at(data, 0);
   ASSERT(header->version == 4 || header->version == 2);
 
   // these are different depending on the version.
@@ -259,9 +267,9 @@ static void link_v2_or_v4(LinkedObjectFile& f,
   f.stats.total_v2_code_bytes += code_size;
 
   // add all code
-  const uint8_t* code_start = &data.at(code_offset);
+  const uint8_t* code_start = &byte_at(data, code_offset);
   const uint8_t* code_end =
-      &data.at(code_offset + code_size - 1) + 1;  // get the pointer to one past the end.
+      &byte_at(data, code_offset + code_size - 1) + 1;  // get the pointer to one past the end.
 
   if (version >= GameVersion::Jak2) {
     while (((code_end - code_start) % 4)) {
@@ -276,7 +284,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
   }
 
   // read v2 header after the code
-  const uint8_t* link_data = &data.at(link_data_offset);
+  const uint8_t* link_data = &byte_at(data, link_data_offset);
   uint32_t link_ptr_offset = link_data_offset;
   link_ptr_offset += sizeof(LinkHeaderV2);
   auto* link_header_v2 = (const LinkHeaderV2*)(link_data);
@@ -286,7 +294,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
   f.stats.total_v2_link_bytes += link_header_v2->length;
 
   // first "section" of link data is a list of where all the pointer are.
-  if (data.at(link_ptr_offset) == 0) {
+  if (byte_at(data, link_ptr_offset) == 0) {
     // there are no pointers.
     link_ptr_offset++;
   } else {
@@ -301,7 +309,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
     while (true) {    // loop over entire table
       while (true) {  // loop over current mode (fixing/seeking)
         // get count from table
-        auto count = data.at(link_ptr_offset);
+        auto count = byte_at(data, link_ptr_offset);
         link_ptr_offset++;
 
         if (!fixing) {
@@ -312,7 +320,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
           // then we are fixing consecutive pointers
           for (uint8_t i = 0; i < count; i++) {
             if (!f.pointer_link_word(0, code_ptr_offset - code_offset, 0,
-                                     *((const uint32_t*)(&data.at(code_ptr_offset))))) {
+                                     *((const uint32_t*)(&byte_at(data, code_ptr_offset))))) {
               // was this just a bug in the linker??
               // lg::error("Skipping link in {} because it is out of range!", name.c_str());
             }
@@ -327,7 +335,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
 
         // when we "end" an encoded integer on an 0xff, we need an explicit zero byte to change
         // modes. this handles this special case.
-        if (data.at(link_ptr_offset) == 0) {
+        if (byte_at(data, link_ptr_offset) == 0) {
           link_ptr_offset++;
           fixing = !fixing;
         }
@@ -337,18 +345,18 @@ static void link_v2_or_v4(LinkedObjectFile& f,
       fixing = !fixing;
 
       // we got a zero, that means we're done with pointer fixing.
-      if (data.at(link_ptr_offset) == 0)
+      if (byte_at(data, link_ptr_offset) == 0)
         break;
     }
     link_ptr_offset++;
   }
 
   // second "section" of link data is a list of symbols to fix up.
-  if (data.at(link_ptr_offset) == 0) {
+  if (byte_at(data, link_ptr_offset) == 0) {
     // no symbols
   } else {
     while (true) {
-      uint32_t reloc = data.at(link_ptr_offset);
+      uint32_t reloc = byte_at(data, link_ptr_offset);
       link_ptr_offset++;
 
       const char* s_name;
@@ -363,14 +371,14 @@ static void link_v2_or_v4(LinkedObjectFile& f,
           ASSERT(false);
         }
 
-        s_name = (const char*)(&data.at(link_ptr_offset));
+        s_name = (const char*)(&byte_at(data, link_ptr_offset));
         kind = SymbolLinkKind::SYMBOL;
 
       } else {
         // it's a type
         kind = SymbolLinkKind::TYPE;
         uint8_t method_count = reloc & 0x7f;
-        s_name = (const char*)(&data.at(link_ptr_offset));
+        s_name = (const char*)(&byte_at(data, link_ptr_offset));
         if (method_count == 0) {
           method_count = 1;
           // hack which will add 44 methods to _newly created_ types
@@ -391,7 +399,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
       link_ptr_offset += strlen(s_name) + 1;
       f.stats.total_v2_symbol_count++;
       link_ptr_offset = c_symlink2(f, data, code_offset, link_ptr_offset, kind, s_name, 0, dts);
-      if (data.at(link_ptr_offset) == 0)
+      if (byte_at(data, link_ptr_offset) == 0)
         break;
     }
   }
@@ -400,7 +408,7 @@ static void link_v2_or_v4(LinkedObjectFile& f,
   ASSERT(link_header_v2->length == align64(link_ptr_offset - link_data_offset + 1));
   size_t expected_end = header->version == 4 ? data.size() : link_header_v2->length;
   while (link_ptr_offset < expected_end) {
-    ASSERT(data.at(link_ptr_offset) == 0);
+    ASSERT(byte_at(data, link_ptr_offset) == 0);
     link_ptr_offset++;
   }
 }
@@ -416,10 +424,10 @@ static void assert_string_empty_after(const char* str, int size) {
 }
 
 static void link_v5(LinkedObjectFile& f,
-                    const std::vector<uint8_t>& data,
+                    std::span<const uint8_t> data,
                     const std::string& name,
                     DecompilerTypeSystem& dts) {
-  auto header = (const LinkHeaderV5*)(&data.at(0));
+  auto header = (const LinkHeaderV5*)(&byte_at(data, 0));
 
   // for jak 3, both code and data use a "v5" format for linking.
   // code has 3 segments (top-level, main, debug), and data has just 1.
@@ -505,27 +513,27 @@ static void link_v5(LinkedObjectFile& f,
     ASSERT((segment_size % 4) == 0);
 
     // add data to the decompiler.
-    auto code_start = (const uint32_t*)(&data.at(data_ptr + 4));
-    auto code_end = ((const uint32_t*)(&data.at(data_ptr + segment_size))) + 1;
+    auto code_start = (const uint32_t*)(&byte_at(data, data_ptr + 4));
+    auto code_end = ((const uint32_t*)(&byte_at(data, data_ptr + segment_size))) + 1;
     for (auto x = code_start; x < code_end; x++) {
       f.push_back_word_to_segment(*((const uint32_t*)x), seg_id);
     }
 
     // pointer linking.
     bool fixing = false;
-    if (data.at(link_ptr)) {
+    if (byte_at(data, link_ptr)) {
       // we have pointers
       while (true) {
         while (true) {
           if (!fixing) {
             // seeking
-            data_ptr += 4 * data.at(link_ptr);
+            data_ptr += 4 * byte_at(data, link_ptr);
             f.stats.v3_pointer_seeks++;
           } else {
             // fixing.
-            for (uint32_t i = 0; i < data.at(link_ptr); i++) {
+            for (uint32_t i = 0; i < byte_at(data, link_ptr); i++) {
               f.stats.v3_pointers++;
-              uint32_t old_code = *(const uint32_t*)(&data.at(data_ptr));
+              uint32_t old_code = *(const uint32_t*)(&byte_at(data, data_ptr));
               if ((old_code >> 24) == 0) {
                 f.stats.v3_word_pointers++;
                 if (!f.pointer_link_word(seg_id, data_ptr - base_ptr, seg_id, old_code)) {
@@ -539,7 +547,7 @@ static void link_v5(LinkedObjectFile& f,
                 ASSERT(lo_hi_offset);
                 ASSERT(dest_seg < 3);
                 auto offset_upper = old_code & 0xff;
-                uint32_t low_code = *(const uint32_t*)(&data.at(data_ptr + 4 * lo_hi_offset));
+                uint32_t low_code = *(const uint32_t*)(&byte_at(data, data_ptr + 4 * lo_hi_offset));
                 uint32_t offset = low_code & 0xffff;
                 if (offset_upper) {
                   offset += (offset_upper << 16);
@@ -551,10 +559,10 @@ static void link_v5(LinkedObjectFile& f,
             }
           }
 
-          if (data.at(link_ptr) != 0xff)
+          if (byte_at(data, link_ptr) != 0xff)
             break;
           link_ptr++;
-          if (data.at(link_ptr) == 0) {
+          if (byte_at(data, link_ptr) == 0) {
             link_ptr++;
             fixing = !fixing;
           }
@@ -562,24 +570,24 @@ static void link_v5(LinkedObjectFile& f,
 
         link_ptr++;
         fixing = !fixing;
-        if (data.at(link_ptr) == 0)
+        if (byte_at(data, link_ptr) == 0)
           break;
       }
     }
     link_ptr++;
 
     // symbol linking.
-    if (data.at(link_ptr)) {
+    if (byte_at(data, link_ptr)) {
       auto sub_link_ptr = link_ptr;
 
       while (true) {
-        auto reloc = data.at(sub_link_ptr);
+        auto reloc = byte_at(data, sub_link_ptr);
         auto next_link_ptr = sub_link_ptr + 1;
         link_ptr = next_link_ptr;
 
         if ((reloc & 0x80) == 0) {
           link_ptr = sub_link_ptr + 3;  //
-          const char* sname = (const char*)(&data.at(link_ptr));
+          const char* sname = (const char*)(&byte_at(data, link_ptr));
           link_ptr += strlen(sname) + 1;
           // todo segment data offsets...
 
@@ -601,14 +609,14 @@ static void link_v5(LinkedObjectFile& f,
           }
           */
           link_ptr += 2;  // ghidra misses some aliasing here and would have you think this is +1!
-          const char* sname = (const char*)(&data.at(link_ptr));
+          const char* sname = (const char*)(&byte_at(data, link_ptr));
           link_ptr += strlen(sname) + 1;
           link_ptr = c_symlink2(f, data, segment_data_offsets[seg_id], link_ptr,
                                 SymbolLinkKind::TYPE, sname, seg_id, dts);
         }
 
         sub_link_ptr = link_ptr;
-        if (!data.at(sub_link_ptr))
+        if (!byte_at(data, sub_link_ptr))
           break;
       }
     }
@@ -635,11 +643,11 @@ static void link_v5(LinkedObjectFile& f,
 }
 
 static void link_v3(LinkedObjectFile& f,
-                    const std::vector<uint8_t>& data,
+                    std::span<const uint8_t> data,
                     const std::string& name,
                     DecompilerTypeSystem& dts,
                     GameVersion game_version) {
-  auto header = (const LinkHeaderV3*)(&data.at(0));
+  auto header = (const LinkHeaderV3*)(&byte_at(data, 0));
   ASSERT(name == header->name);
   ASSERT(header->segments == 3);
 
@@ -702,26 +710,26 @@ static void link_v3(LinkedObjectFile& f,
     ASSERT((data_ptr % 4) == 0);
     ASSERT((segment_size % 4) == 0);
 
-    auto code_start = (const uint32_t*)(&data.at(data_ptr + 4));
-    auto code_end = ((const uint32_t*)(&data.at(data_ptr + segment_size))) + 1;
+    auto code_start = (const uint32_t*)(&byte_at(data, data_ptr + 4));
+    auto code_end = ((const uint32_t*)(&byte_at(data, data_ptr + segment_size))) + 1;
     for (auto x = code_start; x < code_end; x++) {
       f.push_back_word_to_segment(*((const uint32_t*)x), seg_id);
     }
     bool fixing = false;
 
-    if (data.at(link_ptr)) {
+    if (byte_at(data, link_ptr)) {
       // we have pointers
       while (true) {
         while (true) {
           if (!fixing) {
             // seeking
-            data_ptr += 4 * data.at(link_ptr);
+            data_ptr += 4 * byte_at(data, link_ptr);
             f.stats.v3_pointer_seeks++;
           } else {
             // fixing.
-            for (uint32_t i = 0; i < data.at(link_ptr); i++) {
+            for (uint32_t i = 0; i < byte_at(data, link_ptr); i++) {
               f.stats.v3_pointers++;
-              uint32_t old_code = *(const uint32_t*)(&data.at(data_ptr));
+              uint32_t old_code = *(const uint32_t*)(&byte_at(data, data_ptr));
               if ((old_code >> 24) == 0) {
                 f.stats.v3_word_pointers++;
                 if (!f.pointer_link_word(seg_id, data_ptr - base_ptr, seg_id, old_code)) {
@@ -735,7 +743,7 @@ static void link_v3(LinkedObjectFile& f,
                 ASSERT(dest_seg < 3);
                 auto offset_upper = old_code & 0xff;
                 //                ASSERT(offset_upper == 0);
-                uint32_t low_code = *(const uint32_t*)(&data.at(data_ptr + 4 * lo_hi_offset));
+                uint32_t low_code = *(const uint32_t*)(&byte_at(data, data_ptr + 4 * lo_hi_offset));
                 uint32_t offset = low_code & 0xffff;
                 if (offset_upper) {
                   // seems to work fine, no need to warn.
@@ -749,10 +757,10 @@ static void link_v3(LinkedObjectFile& f,
             }
           }
 
-          if (data.at(link_ptr) != 0xff)
+          if (byte_at(data, link_ptr) != 0xff)
             break;
           link_ptr++;
-          if (data.at(link_ptr) == 0) {
+          if (byte_at(data, link_ptr) == 0) {
             link_ptr++;
             fixing = !fixing;
           }
@@ -760,15 +768,15 @@ static void link_v3(LinkedObjectFile& f,
 
         link_ptr++;
         fixing = !fixing;
-        if (data.at(link_ptr) == 0)
+        if (byte_at(data, link_ptr) == 0)
           break;
       }
     }
 
     link_ptr++;
 
-    while (data.at(link_ptr)) {
-      auto reloc = data.at(link_ptr);
+    while (byte_at(data, link_ptr)) {
+      auto reloc = byte_at(data, link_ptr);
       SymbolLinkKind kind;
       link_ptr++;
 
@@ -777,9 +785,9 @@ static void link_v3(LinkedObjectFile& f,
         // it's a symbol
         kind = SymbolLinkKind::SYMBOL;
         link_ptr--;
-        s_name = (const char*)(&data.at(link_ptr));
+        s_name = (const char*)(&byte_at(data, link_ptr));
       } else {
-        s_name = (const char*)(&data.at(link_ptr));
+        s_name = (const char*)(&byte_at(data, link_ptr));
         switch (game_version) {
           case GameVersion::Jak1:
             dts.ts.forward_declare_type_method_count(s_name, (reloc & 0x7f));
@@ -825,12 +833,12 @@ static void link_v3(LinkedObjectFile& f,
 /*!
  * Main function to generate LinkedObjectFiles from raw object data.
  */
-LinkedObjectFile to_linked_object_file(const std::vector<uint8_t>& data,
+LinkedObjectFile to_linked_object_file(std::span<const uint8_t> data,
                                        const std::string& name,
                                        DecompilerTypeSystem& dts,
                                        GameVersion game_version) {
   LinkedObjectFile result(game_version);
-  const auto* header = (const LinkHeaderCommon*)&data.at(0);
+  const auto* header = (const LinkHeaderCommon*)&byte_at(data, 0);
 
   // use appropriate linker
   if (header->version == 3) {
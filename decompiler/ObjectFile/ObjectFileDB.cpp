@@ -11,6 +11,7 @@
 #include <cstring>
 #include <map>
 #include <set>
+#include <thread>
 
 #include "LinkedObjectFileCreation.h"
 
@@ -20,6 +21,7 @@
 #include "common/util/BinaryReader.h"
 #include "common/util/BitUtils.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/Timer.h"
 #include "common/util/crc32.h"
 #include "common/util/dgo_util.h"
@@ -140,13 +142,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
   }
 
   lg::info("-Loading {} DGOs...", _dgos.size());
-  for (auto& dgo : _dgos) {
-    try {
-      get_objs_from_dgo(dgo, config);
-    } catch (std::runtime_error& e) {
-      lg::warn("Error when reading DGOs: {} on {}", e.what(), dgo.string());
-    }
-  }
+  load_dgos(_dgos, config);
 
   lg::info("-Loading {} plain object files...", object_files.size());
   for (auto& obj : object_files) {
@@ -205,7 +201,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
         free(out_buf);
       }
     }
-    add_obj_from_dgo(name, name, data.data(), data.size(), "NO-XGO", config);
+    add_obj_from_dgo(name, name, std::move(data), "NO-XGO", config);
   }
 
   if (config.read_spools) {
@@ -219,8 +215,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
       for (int i = 0; i < reader.chunk_count(); i++) {
         // append the chunk ID to the full name
         std::string name = obj_name + fmt::format("+{}", i);
-        auto& data = reader.get_chunk(i);
-        add_obj_from_dgo(name, name, data.data(), data.size(), "ALLSPOOL", config, obj_name);
+        add_obj_from_dgo(name, name, reader.take_chunk(i), "ALLSPOOL", config, obj_name);
       }
     }
   }
@@ -233,8 +228,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
       std::string base_name = obj_filename_to_name(obj.string());
       ASSERT(reader.chunk_count() == 1);
       auto name = reader.get_texture_name();
-      add_obj_from_dgo(name, name, reader.get_chunk(0).data(), reader.get_chunk(0).size(),
-                       "TEXSPOOL", config, name);
+      add_obj_from_dgo(name, name, reader.take_chunk(0), "TEXSPOOL", config, name);
     }
   }
 
@@ -244,8 +238,7 @@ ObjectFileDB::ObjectFileDB(const std::vector<fs::path>& _dgos,
       StrFileReader reader(obj, version());
       for (int i = 0; i < reader.chunk_count(); i++) {
         auto name = reader.get_chunk_art_name(i);
-        add_obj_from_dgo(name, name, reader.get_chunk(i).data(), reader.get_chunk(i).size(),
-                         "ARTSPOOL", config, name);
+        add_obj_from_dgo(name, name, reader.take_chunk(i), "ARTSPOOL", config, name);
       }
     }
   }
@@ -287,22 +280,62 @@ void ObjectFileDB::load_map_file(const std::string& map_data) {
   }
 }
 
+namespace {
+/*!
+ * Should this object be added, according to the banned and allowed object lists?
+ */
+bool object_is_allowed(const std::string& obj_name, const Config& config) {
+  if (config.banned_objects.find(obj_name) != config.banned_objects.end()) {
+    return false;
+  }
+  return config.allowed_objects.empty() ||
+         config.allowed_objects.find(obj_name) != config.allowed_objects.end();
+}
+
+/*!
+ * An object file inside of a DGO. The data points into the DGO's buffer.
+ */
+struct DgoObject {
+  std::string name;
+  std::string name_in_dgo;
+  std::span<const u8> data;
+  u32 hash = 0;
+  // set when the object is deduplicated
+  int version = -1;
+  bool added = false;
+  std::vector<u8> copy;  // for new objects from compressed DGOs
+};
+
+struct LoadedDgo {
+  std::string name;
+  u64 file_size = 0;
+  std::unique_ptr<MappedFile> mapped;
+  std::vector<u8> decompressed;  // only used for compressed DGOs
+  std::vector<DgoObject> objects;
+  std::string error;
+};
+
 /*!
- * Load the objects stored in the given DGO into the ObjectFileDB
+ * Map a DGO and find the objects stored in it.
+ * This doesn't touch the ObjectFileDB, so DGOs can be read in parallel.
  */
-void ObjectFileDB::get_objs_from_dgo(const fs::path& filename, const Config& config) {
-  auto dgo_data = file_util::read_binary_file(filename);
-  stats.total_dgo_bytes += dgo_data.size();
+void read_dgo(const fs::path& filename, const Config& config, LoadedDgo* dgo) {
+  dgo->name = filename.filename().string();
+  dgo->mapped = std::make_unique<MappedFile>(filename);
+  dgo->file_size = dgo->mapped->size();
+  std::span<const u8> dgo_data = dgo->mapped->span();
 
   if (file_util::dgo_header_is_compressed(dgo_data)) {
-    dgo_data = file_util::decompress_dgo(dgo_data);
+    // objects will point into the decompressed copy instead.
+    dgo->decompressed = file_util::decompress_dgo(dgo_data);
+    dgo->mapped.reset();
+    dgo_data = dgo->decompressed;
   }
 
   BinaryReader reader(dgo_data);
   auto header = reader.read<DgoHeader>();
 
-  auto dgo_base_name = filename.filename().string();
-  ASSERT(header.name == dgo_base_name);
+  ASSERT(header.name == dgo->name);
   assert_string_empty_after(header.name, 60);
 
   // get all obj files...
@@ -313,7 +346,7 @@ void ObjectFileDB::get_objs_from_dgo(const fs::path& filename, const Config& con
       if (reader.bytes_left() == obj_header.object_count - 0x30) {
         if (config.is_pal) {
           lg::warn("Skipping {} in {} because it is a broken PAL object", obj_header.name,
-                   dgo_base_name);
+                   dgo->name);
           reader.ffwd(reader.bytes_left());
           continue;
         } else {
@@ -333,15 +366,21 @@ void ObjectFileDB::get_objs_from_dgo(const fs::path& filename, const Config& con
     }
 
     auto name = get_object_file_name(obj_header.name, reader.here(), obj_header.object_count);
-
-    add_obj_from_dgo(name, obj_header.name, reader.here(), obj_header.object_count, dgo_base_name,
-                     config);
+    if (object_is_allowed(name, config)) {
+      ASSERT(obj_header.object_count > 128);
+      auto& obj = dgo->objects.emplace_back();
+      obj.name = name;
+      obj.name_in_dgo = obj_header.name;
+      obj.data = std::span<const u8>(reader.here(), obj_header.object_count);
+      obj.hash = crc32(obj.data.data(), obj.data.size());
+    }
     reader.ffwd(align16(obj_header.object_count));
   }
 
   // check we're at the end
   ASSERT(0 == reader.bytes_left());
 }
+}  // namespace
 
 /*!
  * Are two object files the same?
@@ -393,64 +432,156 @@ bool are_objects_the_same(const std::string& obj_name,
 }
 
 /*!
- * Add an object file to the ObjectFileDB
+ * Load the objects stored in the given DGOs into the ObjectFileDB.
+ * DGOs are loaded in batches of one per worker. Each DGO in a batch is mapped, split, and hashed in
+ * parallel, then duplicates are found in parallel for each object name. Copies of an object are
+ * still compared in DGO order and the results are merged in DGO order, so versions and names are
+ * the same as loading the DGOs one at a time.
+ *
+ * Objects from uncompressed DGOs point into the mapped file. Compressed DGOs have to be
+ * decompressed into memory, so their new objects are copied out and the DGO is freed at the end of
+ * the batch. Peak memory is the unique objects plus one decompressed DGO per worker.
  */
-void ObjectFileDB::add_obj_from_dgo(const std::string& obj_name,
-                                    const std::string& name_in_dgo,
-                                    const uint8_t* obj_data,
-                                    uint32_t obj_size,
-                                    const std::string& dgo_name,
-                                    const Config& config,
-                                    const std::string& cut_name) {
-  if (config.banned_objects.find(obj_name) != config.banned_objects.end()) {
-    return;
+void ObjectFileDB::load_dgos(const std::vector<fs::path>& dgo_paths, const Config& config) {
+  Timer timer;
+  int num_workers = config.dgo_load_jobs;
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
   }
-  if (!config.allowed_objects.empty()) {
-    if (config.allowed_objects.find(obj_name) == config.allowed_objects.end()) {
-      return;
+
+  SimpleThreadGroup threads;
+  for (size_t batch_start = 0; batch_start < dgo_paths.size(); batch_start += num_workers) {
+    std::vector<LoadedDgo> dgos(std::min((size_t)num_workers, dgo_paths.size() - batch_start));
+    threads.run_dynamic(
+        [&](int i) {
+          try {
+            read_dgo(dgo_paths[batch_start + i], config, &dgos[i]);
+          } catch (std::runtime_error& e) {
+            dgos[i].error = e.what();
+            dgos[i].objects.clear();
+          }
+        },
+        dgos.size(), num_workers);
+    threads.join();
+
+    // group the copies of each object by name
+    struct NameGroup {
+      std::vector<ObjectFileData>* versions = nullptr;
+      std::vector<std::pair<DgoObject*, const LoadedDgo*>> objects;
+    };
+    std::vector<NameGroup> groups;
+    std::unordered_map<std::string, size_t> group_by_name;
+    for (size_t i = 0; i < dgos.size(); i++) {
+      auto& dgo = dgos[i];
+      if (!dgo.error.empty()) {
+        lg::warn("Error when reading DGOs: {} on {}", dgo.error,
+                 dgo_paths[batch_start + i].string());
+        continue;
+      }
+      stats.total_dgo_bytes += dgo.file_size;
+      for (auto& obj : dgo.objects) {
+        stats.total_obj_files++;
+        auto [it, inserted] = group_by_name.try_emplace(obj.name, groups.size());
+        if (inserted) {
+          auto& versions = obj_files_by_name[obj.name];
+          if (versions.empty()) {
+            // if this is the first time we've seen this object file name, add it in the order.
+            obj_file_order.push_back(obj.name);
+          }
+          groups.push_back({&versions, {}});
+        }
+        groups[it->second].objects.emplace_back(&obj, &dgo);
+      }
+    }
+
+    threads.run_dynamic(
+        [&](int i) {
+          auto& group = groups[i];
+          for (auto& [obj, dgo] : group.objects) {
+            obj->version = add_obj_version(*group.versions, obj->name, obj->name_in_dgo, obj->data,
+                                           obj->hash, dgo->name, config, "", &obj->added);
+            if (obj->added && !dgo->mapped) {
+              // the decompressed DGO is freed after this batch.
+              obj->copy.assign(obj->data.begin(), obj->data.end());
+              group.versions->at(obj->version).data = obj->copy;
+            }
+          }
+        },
+        groups.size(), num_workers);
+    threads.join();
+
+    for (auto& dgo : dgos) {
+      bool referenced = false;
+      for (auto& obj : dgo.objects) {
+        obj_files_by_dgo[dgo.name].push_back(
+            obj_files_by_name.at(obj.name).at(obj.version).record);
+        if (obj.added) {
+          referenced = true;
+          stats.unique_obj_files++;
+          stats.unique_obj_bytes += obj.data.size();
+          if (!obj.copy.empty()) {
+            // moving the vector keeps its buffer, so the version's data stays valid.
+            m_object_buffers.push_back(std::move(obj.copy));
+          }
+        }
+      }
+
+      // only keep mapped DGOs that have the bytes of an object.
+      if (referenced && dgo.mapped) {
+        m_mapped_files.push_back(std::move(dgo.mapped));
+      }
     }
   }
-  stats.total_obj_files++;
-  ASSERT(obj_size > 128);
-  uint16_t version = *(const uint16_t*)(obj_data + 8);
-  auto hash = crc32(obj_data, obj_size);
 
-  bool duplicated = false;
+  lg::info("-Loaded {} objects ({} unique, {:.2f} MB) from {:.2f} MB of DGOs in {:.2f} ms",
+           stats.total_obj_files, stats.unique_obj_files, stats.unique_obj_bytes / (1024. * 1024.),
+           stats.total_dgo_bytes / (1024. * 1024.), timer.getMs());
+}
+
+/*!
+ * Add a copy of an object file to the versions of the object with that name, or find the version
+ * that it's the same as. Returns the index of the version.
+ * This only modifies versions, so different names can be added in parallel.
+ */
+int ObjectFileDB::add_obj_version(std::vector<ObjectFileData>& versions,
+                                  const std::string& obj_name,
+                                  const std::string& name_in_dgo,
+                                  std::span<const u8> obj_data,
+                                  uint32_t hash,
+                                  const std::string& dgo_name,
+                                  const Config& config,
+                                  const std::string& cut_name,
+                                  bool* added) const {
+  *added = false;
+  // art groups may differ in padding bytes, so their hashes don't have to match.
+  bool is_art_group = obj_name.size() > 3 && !obj_name.compare(obj_name.length() - 3, 3, "-ag");
+
   // first, check to see if we already got it...
-  for (auto& e : obj_files_by_name[obj_name]) {
-    if (are_objects_the_same(obj_name, e.data.size(), e.data.data(), obj_size, obj_data)) {
+  for (size_t i = 0; i < versions.size(); i++) {
+    auto& e = versions[i];
+    if ((e.record.hash == hash || is_art_group) &&
+        are_objects_the_same(obj_name, e.data.size(), e.data.data(), obj_data.size(),
+                             obj_data.data())) {
       // already got it!
       e.reference_count++;
-      auto& rec = e.record;
       ASSERT(name_in_dgo == e.name_in_dgo);
       e.dgo_names.push_back(dgo_name);
-      obj_files_by_dgo[dgo_name].push_back(rec);
-      duplicated = true;
-      break;
+      return i;
     } else {
       e.has_multiple_versions = true;
     }
   }
 
-  if (duplicated) {
-    return;
-  }
-
   // nope, have to add a new one.
   ObjectFileData data(config.game_version);
-  data.data.resize(obj_size);
-  memcpy(data.data.data(), obj_data, obj_size);
+  data.data = obj_data;
   data.record.hash = hash;
   data.record.name = obj_name;
   data.dgo_names.push_back(dgo_name);
-  if (obj_files_by_name[obj_name].empty()) {
-    // if this is the first time we've seen this object file name, add it in the order.
-    obj_file_order.push_back(obj_name);
-  }
   data.base_name_from_chunk = cut_name;
-  data.record.version = obj_files_by_name[obj_name].size();
+  data.record.version = versions.size();
   data.name_in_dgo = name_in_dgo;
-  data.obj_version = version;
+  data.obj_version = *(const uint16_t*)(obj_data.data() + 8);
   if (!dgo_obj_name_map.empty()) {
     auto dgo_kv = dgo_obj_name_map.find(strip_dgo_extension(dgo_name));
     if (dgo_kv == dgo_obj_name_map.end()) {
@@ -465,16 +596,50 @@ void ObjectFileDB::add_obj_from_dgo(const std::string& obj_name,
     }
     data.name_from_map = name_kv->second;
   }
-  obj_files_by_dgo[dgo_name].push_back(data.record);
-  obj_files_by_name[obj_name].emplace_back(std::move(data));
-  stats.unique_obj_files++;
-  stats.unique_obj_bytes += obj_size;
+  versions.emplace_back(std::move(data));
+  *added = true;
 
-  if (obj_files_by_name[obj_name].size() > 1) {
-    for (auto& e : obj_files_by_name[obj_name]) {
+  if (versions.size() > 1) {
+    for (auto& e : versions) {
       e.has_multiple_versions = true;
     }
   }
+  return versions.size() - 1;
+}
+
+/*!
+ * Add an object file that isn't part of a DGO to the ObjectFileDB.
+ * If it isn't a duplicate, the ObjectFileDB keeps the data.
+ */
+void ObjectFileDB::add_obj_from_dgo(const std::string& obj_name,
+                                    const std::string& name_in_dgo,
+                                    std::vector<u8>&& obj_data,
+                                    const std::string& dgo_name,
+                                    const Config& config,
+                                    const std::string& cut_name) {
+  if (!object_is_allowed(obj_name, config)) {
+    return;
+  }
+  stats.total_obj_files++;
+  ASSERT(obj_data.size() > 128);
+
+  auto& versions = obj_files_by_name[obj_name];
+  if (versions.empty()) {
+    // if this is the first time we've seen this object file name, add it in the order.
+    obj_file_order.push_back(obj_name);
+  }
+  bool added = false;
+  int version = add_obj_version(versions, obj_name, name_in_dgo, obj_data,
+                                crc32(obj_data.data(), obj_data.size()), dgo_name, config,
+                                cut_name, &added);
+  obj_files_by_dgo[dgo_name].push_back(versions.at(version).record);
+
+  if (added) {
+    stats.unique_obj_files++;
+    stats.unique_obj_bytes += obj_data.size();
+    // moving the vector keeps its buffer, so the new version's data stays valid.
+    m_object_buffers.push_back(std::move(obj_data));
+  }
 }
 
 /*!
@@ -7,6 +7,8 @@
  * (there may be different object files with the same name sometimes)
  */
 
+#include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -16,6 +18,7 @@
 #include "common/common_types.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
 
 #include "decompiler/analysis/symbol_def_map.h"
 #include "decompiler/data/TextureDB.h"
@@ -38,9 +41,9 @@ struct ObjectFileRecord {
  */
 struct ObjectFileData {
   ObjectFileData(GameVersion version) : linked_data(version) {}
-  std::vector<uint8_t> data;     // raw bytes
-  LinkedObjectFile linked_data;  // data including linking annotations
-  ObjectFileRecord record;       // name
+  std::span<const uint8_t> data;  // raw bytes, stored in the ObjectFileDB's input buffers
+  LinkedObjectFile linked_data;   // data including linking annotations
+  ObjectFileRecord record;        // name
   std::vector<std::string> dgo_names;
   int obj_version = -1;
   bool has_multiple_versions = false;
@@ -186,12 +189,21 @@ class ObjectFileDB {
                          bool disassemble_code,
                          bool print_hex);
 
+  // results of IR2 analysis of a single object that need to be combined with other objects.
+  // these are merged in object order, so the output doesn't depend on the order that objects
+  // were processed in.
+  struct Ir2ObjectResult {
+    LetRewriteStats let;
+    SymbolMapBuilder::ObjectSymbolList symbols;
+  };
+
   void process_object_file_data(
       ObjectFileData& data,
       const fs::path& output_dir,
       const Config& config,
       const std::unordered_set<std::string>& skip_functions,
-      const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states);
+      const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states,
+      Ir2ObjectResult* result);
   void analyze_functions_ir2(
       const fs::path& output_dir,
       const Config& config,
@@ -209,17 +221,19 @@ class ObjectFileDB {
   void ir2_cfg_build_pass(int seg, ObjectFileData& data);
   // void ir2_store_current_forms(int seg);
   void ir2_build_expressions(int seg, const Config& config, ObjectFileData& data);
-  void ir2_insert_lets(int seg, ObjectFileData& data);
+  void ir2_insert_lets(int seg, ObjectFileData& data, LetRewriteStats& let_stats);
   void ir2_add_store_errors(int seg, ObjectFileData& data);
   void ir2_rewrite_inline_asm_instructions(int seg, ObjectFileData& data);
   void ir2_insert_anonymous_functions(int seg, ObjectFileData& data);
-  void ir2_symbol_definition_map(ObjectFileData& data);
   void ir2_write_results(const fs::path& output_dir,
                          const Config& config,
                          const std::vector<std::string>& imports,
                          ObjectFileData& data);
   void ir2_do_segment_analysis_phase1(int seg, const Config& config, ObjectFileData& data);
-  void ir2_do_segment_analysis_phase2(int seg, const Config& config, ObjectFileData& data);
+  void ir2_do_segment_analysis_phase2(int seg,
+                                      const Config& config,
+                                      ObjectFileData& data,
+                                      LetRewriteStats& let_stats);
   void ir2_setup_labels(const Config& config, ObjectFileData& data);
   void ir2_run_mips2c(const Config& config, ObjectFileData& data);
   struct PerObjectAllTypeInfo {
@@ -272,14 +286,22 @@ class ObjectFileDB {
                             TypeSpec* result);
 
   void load_map_file(const std::string& map_data);
-  void get_objs_from_dgo(const fs::path& filename, const Config& config);
+  void load_dgos(const std::vector<fs::path>& dgos, const Config& config);
   void add_obj_from_dgo(const std::string& obj_name,
                         const std::string& name_in_dgo,
-                        const uint8_t* obj_data,
-                        uint32_t obj_size,
+                        std::vector<u8>&& obj_data,
                         const std::string& dgo_name,
                         const Config& config,
                         const std::string& cut_name = "");
+  int add_obj_version(std::vector<ObjectFileData>& versions,
+                      const std::string& obj_name,
+                      const std::string& name_in_dgo,
+                      std::span<const u8> obj_data,
+                      uint32_t hash,
+                      const std::string& dgo_name,
+                      const Config& config,
+                      const std::string& cut_name,
+                      bool* added) const;
 
   /*!
    * Apply f to all ObjectFileData's. Does it in the right order.
@@ -387,16 +409,20 @@ class ObjectFileDB {
 
   struct {
     LetRewriteStats let;
-    uint32_t total_dgo_bytes = 0;
+    u64 total_dgo_bytes = 0;
     uint32_t total_obj_files = 0;
     uint32_t unique_obj_files = 0;
-    uint32_t unique_obj_bytes = 0;
+    u64 unique_obj_bytes = 0;
   } stats;
 
   GameVersion version() const { return m_version; }
 
  private:
   GameVersion m_version;
+  // the bytes that ObjectFileData::data points into. Uncompressed DGOs stay mapped. Objects from
+  // compressed DGOs, plain object files, and streaming chunks are stored in their own buffers.
+  std::vector<std::unique_ptr<MappedFile>> m_mapped_files;
+  std::vector<std::vector<u8>> m_object_buffers;
 };
 
 std::string print_art_elt_for_dump(const std::string& group_name, const std::string& name, int idx);
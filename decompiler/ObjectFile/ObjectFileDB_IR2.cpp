@@ -5,11 +5,16 @@
 
 #include "ObjectFileDB.h"
 
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 #include "common/formatter/formatter.h"
 #include "common/goos/PrettyPrinter.h"
 #include "common/link_types.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/Timer.h"
 #include "common/util/string_util.h"
 #include <common/formatter/formatter.h>
@@ -41,13 +46,14 @@ void ObjectFileDB::process_object_file_data(
     const fs::path& output_dir,
     const Config& config,
     const std::unordered_set<std::string>& skip_functions,
-    const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states) {
+    const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states,
+    Ir2ObjectResult* result) {
   Timer file_timer;
   ir2_do_segment_analysis_phase1(TOP_LEVEL_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(DEBUG_SEGMENT, config, data);
   ir2_do_segment_analysis_phase1(MAIN_SEGMENT, config, data);
   ir2_setup_labels(config, data);
-  ir2_do_segment_analysis_phase2(TOP_LEVEL_SEGMENT, config, data);
+  ir2_do_segment_analysis_phase2(TOP_LEVEL_SEGMENT, config, data, result->let);
   if (data.linked_data.functions_by_seg.size() == 3) {
     enum { DEFPART, DEFSTATE, DEFSKELGROUP } step = DEFPART;
     try {
@@ -71,8 +77,8 @@ void ObjectFileDB::process_object_file_data(
       }
     }
   }
-  ir2_do_segment_analysis_phase2(DEBUG_SEGMENT, config, data);
-  ir2_do_segment_analysis_phase2(MAIN_SEGMENT, config, data);
+  ir2_do_segment_analysis_phase2(DEBUG_SEGMENT, config, data, result->let);
+  ir2_do_segment_analysis_phase2(MAIN_SEGMENT, config, data, result->let);
 
   ir2_insert_anonymous_functions(DEBUG_SEGMENT, data);
   ir2_insert_anonymous_functions(MAIN_SEGMENT, data);
@@ -80,7 +86,7 @@ void ObjectFileDB::process_object_file_data(
 
   ir2_run_mips2c(config, data);
 
-  ir2_symbol_definition_map(data);
+  result->symbols = SymbolMapBuilder::collect_object(data);
 
   // TODO - insert the game_name into the import line automatically
   // instead of `goal_src/jak1/import/something.gc`
@@ -132,21 +138,80 @@ void ObjectFileDB::analyze_functions_ir2(
     const std::optional<std::function<void()>> postfile_callback,
     const std::unordered_set<std::string>& skip_functions,
     const std::unordered_map<std::string, std::unordered_set<std::string>>& skip_states) {
-  int total_file_count = 0;
-  for (auto& f : obj_files_by_name) {
-    total_file_count += f.second.size();
-  }
-  int file_idx = 1;
-  for_each_obj([&](ObjectFileData& data) {
-    if (prefile_callback) {
-      prefile_callback.value()(data.to_unique_name());
+  std::vector<ObjectFileData*> objs;
+  for_each_obj([&](ObjectFileData& data) { objs.push_back(&data); });
+  const int total_file_count = objs.size();
+  std::vector<Ir2ObjectResult> results(total_file_count);
+
+  if (config.decompile_jobs <= 1) {
+    for (int i = 0; i < total_file_count; i++) {
+      auto& data = *objs[i];
+      if (prefile_callback) {
+        prefile_callback.value()(data.to_unique_name());
+      }
+      lg::info("[{:3d}/{}]------ {}", i + 1, total_file_count, data.to_unique_name());
+      process_object_file_data(data, output_dir, config, skip_functions, skip_states, &results[i]);
+      if (postfile_callback) {
+        postfile_callback.value()();
+      }
     }
-    lg::info("[{:3d}/{}]------ {}", file_idx++, total_file_count, data.to_unique_name());
-    process_object_file_data(data, output_dir, config, skip_functions, skip_states);
-    if (postfile_callback) {
-      postfile_callback.value()();
+  } else {
+    // Objects are independent at this point: the type system is only read (aside from the reader,
+    // which is locked), and everything else is stored per-object. Start with the biggest objects
+    // so a large file at the end of the list doesn't leave the other workers idle.
+    std::vector<int> schedule(total_file_count);
+    for (int i = 0; i < total_file_count; i++) {
+      schedule[i] = i;
     }
-  });
+    std::stable_sort(schedule.begin(), schedule.end(), [&](int a, int b) {
+      return objs[a]->data.size() > objs[b]->data.size();
+    });
+
+    std::mutex callback_mutex;
+    std::exception_ptr first_error = nullptr;
+    std::atomic<int> files_started = 0;
+    SimpleThreadGroup threads;
+    threads.run_dynamic(
+        [&](int run_idx) {
+          const int i = schedule[run_idx];
+          auto& data = *objs[i];
+          {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            if (first_error) {
+              return;
+            }
+            if (prefile_callback) {
+              prefile_callback.value()(data.to_unique_name());
+            }
+          }
+          lg::info("[{:3d}/{}]------ {}", ++files_started, total_file_count,
+                   data.to_unique_name());
+          try {
+            process_object_file_data(data, output_dir, config, skip_functions, skip_states,
+                                     &results[i]);
+          } catch (...) {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            if (!first_error) {
+              first_error = std::current_exception();
+            }
+            return;
+          }
+          if (postfile_callback) {
+            std::lock_guard<std::mutex> lock(callback_mutex);
+            postfile_callback.value()();
+          }
+        },
+        total_file_count, std::min(config.decompile_jobs, std::max(total_file_count, 1)));
+    threads.join();
+    if (first_error) {
+      std::rethrow_exception(first_error);
+    }
+  }
+
+  for (auto& result : results) {
+    stats.let += result.let;
+    map_builder.add_collected_object(result.symbols);
+  }
 
   lg::info("{}", stats.let.print());
 
@@ -168,7 +233,8 @@ void ObjectFileDB::ir2_do_segment_analysis_phase1(int seg,
 
 void ObjectFileDB::ir2_do_segment_analysis_phase2(int seg,
                                                   const Config& config,
-                                                  ObjectFileData& data) {
+                                                  ObjectFileData& data,
+                                                  LetRewriteStats& let_stats) {
   ir2_type_analysis_pass(seg, config, data);
   ir2_register_usage_pass(seg, data);
   ir2_variable_pass(seg, data);
@@ -177,7 +243,7 @@ void ObjectFileDB::ir2_do_segment_analysis_phase2(int seg,
   ir2_build_expressions(seg, config, data);
   ir2_rewrite_inline_asm_instructions(seg, data);
 
-  ir2_insert_lets(seg, data);
+  ir2_insert_lets(seg, data, let_stats);
 
   ir2_add_store_errors(seg, data);
 }
@@ -559,10 +625,6 @@ void ObjectFileDB::ir2_atomic_op_pass(int seg, const Config& config, ObjectFileD
   });
 }
 
-void ObjectFileDB::ir2_symbol_definition_map(ObjectFileData& data) {
-  map_builder.add_object(data);
-}
-
 template <typename Key, typename Value>
 Value try_lookup(const std::unordered_map<Key, Value>& map, const Key& key) {
   auto lookup = map.find(key);
@@ -807,11 +869,11 @@ void ObjectFileDB::ir2_build_expressions(int seg, const Config& config, ObjectFi
   });
 }
 
-void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data) {
+void ObjectFileDB::ir2_insert_lets(int seg, ObjectFileData& data, LetRewriteStats& let_stats) {
   for_each_function_in_seg_in_obj(seg, data, [&](Function& func) {
     if (func.ir2.expressions_succeeded) {
       try {
-        insert_lets(func, func.ir2.env, *func.ir2.form_pool, func.ir2.top_form, stats.let);
+        insert_lets(func, func.ir2.env, *func.ir2.form_pool, func.ir2.top_form, let_stats);
       } catch (const std::exception& e) {
         const auto err = fmt::format(
             "Error while inserting lets: {}. Make sure that the return type is not "
@@ -526,7 +526,7 @@ bool block_requires_label(const Function* f,
 
 namespace {
 // hack counter for total number of unknown instruction. TODO remove
-int g_unknown = 0;
+thread_local int g_unknown = 0;
 }  // namespace
 
 /*!
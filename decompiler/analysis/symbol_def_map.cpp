@@ -14,19 +14,45 @@ void SymbolMapBuilder::add_object(const ObjectFileData& data) {
   if (data.obj_version != 3) {
     return;
   }
-  m_first_detections.emplace_back();
-  m_first_detections.back().object_file_name = data.name_from_map;
+  add_collected_object(collect_object(data));
+}
+
+SymbolMapBuilder::ObjectSymbolList SymbolMapBuilder::collect_object(const ObjectFileData& data) {
+  ObjectSymbolList result;
+  // skip non-code files
+  if (data.obj_version != 3) {
+    return result;
+  }
+  result.object_file_name = data.name_from_map;
   // add load/stores from all functions
+  std::unordered_set<std::string> seen_symbols;
   for (const auto& seg_functions : data.linked_data.functions_by_seg) {
     for (const auto& function : seg_functions) {
-      add_load_store_from_function(function, &m_first_detections.back());
+      add_load_store_from_function(function, &seen_symbols, &result);
     }
   }
 
   // add deftypes in the top level function
+  std::unordered_set<std::string> seen_types;
   const auto& top_level_functions = data.linked_data.functions_by_seg.at(TOP_LEVEL_SEGMENT);
   ASSERT(top_level_functions.size() == 1);
-  add_deftypes_from_top_level_function(top_level_functions.at(0), &m_first_detections.back());
+  add_deftypes_from_top_level_function(top_level_functions.at(0), &seen_types, &result);
+  return result;
+}
+
+void SymbolMapBuilder::add_collected_object(const ObjectSymbolList& list) {
+  if (list.object_file_name.empty()) {
+    return;  // not a code file
+  }
+  // only keep the first detection of each symbol, over all objects.
+  auto& output = m_first_detections.emplace_back();
+  output.object_file_name = list.object_file_name;
+  for (const auto& sym : list.symbols) {
+    auto& seen = sym.is_type ? m_seen_types : m_seen_symbols;
+    if (seen.insert(sym.name).second) {
+      output.symbols.push_back(sym);
+    }
+  }
 }
 
 void SymbolMapBuilder::build_map() {
@@ -94,7 +120,9 @@ std::optional<std::string> get_loaded_or_stored_symbol_name(const AtomicOp* op)
 }
 }  // namespace
 
-void SymbolMapBuilder::add_load_store_from_function(const Function& f, ObjectSymbolList* output) {
+void SymbolMapBuilder::add_load_store_from_function(const Function& f,
+                                                    std::unordered_set<std::string>* seen,
+                                                    ObjectSymbolList* output) {
   if (!f.ir2.atomic_ops_succeeded) {
     if (!f.suspected_asm) {
       // some asm functions will use mips2c which doesn't require atomic ops.
@@ -108,26 +136,27 @@ void SymbolMapBuilder::add_load_store_from_function(const Function& f, ObjectSym
   for (const auto& op : f.ir2.atomic_ops->ops) {
     const auto sym = get_loaded_or_stored_symbol_name(op.get());
     if (sym) {
-      if (m_seen_symbols.find(*sym) == m_seen_symbols.end()) {
+      if (seen->find(*sym) == seen->end()) {
         SymbolInfo info;
         info.name = *sym;
         info.is_type = false;
         output->symbols.push_back(info);
-        m_seen_symbols.insert(*sym);
+        seen->insert(*sym);
       }
     }
   }
 }
 
 void SymbolMapBuilder::add_deftypes_from_top_level_function(const Function& f,
+                                                            std::unordered_set<std::string>* seen,
                                                             ObjectSymbolList* output) {
   for (const auto& name : f.types_defined) {
-    if (m_seen_types.find(name) == m_seen_types.end()) {
+    if (seen->find(name) == seen->end()) {
       SymbolInfo info;
       info.name = name;
       info.is_type = true;
       output->symbols.push_back(info);
-      m_seen_types.insert(name);
+      seen->insert(name);
     }
   }
 }
@@ -11,11 +11,6 @@ class Function;
 
 class SymbolMapBuilder {
  public:
-  void add_object(const ObjectFileData& data);
-  void build_map();
-  std::string convert_to_json() const;
-
- private:
   struct SymbolInfo {
     std::string name;
     bool is_type = false;
@@ -26,6 +21,20 @@ class SymbolMapBuilder {
     std::vector<SymbolInfo> symbols;
   };
 
+  void add_object(const ObjectFileData& data);
+  void build_map();
+  std::string convert_to_json() const;
+
+  /*!
+   * Find the symbols used by a single object, without looking at other objects. This is safe to
+   * call from multiple threads. The result must be passed to add_collected_object, in the same
+   * order the objects would have been passed to add_object.
+   */
+  static ObjectSymbolList collect_object(const ObjectFileData& data);
+  void add_collected_object(const ObjectSymbolList& list);
+
+ private:
+
   // symbols that we've seen load/store
   std::unordered_set<std::string> m_seen_symbols;
   // symbol that we've seen used in a deftype
@@ -40,8 +49,12 @@ class SymbolMapBuilder {
   // - other symbols do not appear.
   std::vector<ObjectSymbolList> m_result;
 
-  void add_load_store_from_function(const Function& f, ObjectSymbolList* output);
-  void add_deftypes_from_top_level_function(const Function& f, ObjectSymbolList* output);
+  static void add_load_store_from_function(const Function& f,
+                                           std::unordered_set<std::string>* seen,
+                                           ObjectSymbolList* output);
+  static void add_deftypes_from_top_level_function(const Function& f,
+                                                   std::unordered_set<std::string>* seen,
+                                                   ObjectSymbolList* output);
 };
 
 }  // namespace decompiler
\ No newline at end of file
@@ -93,6 +93,9 @@ Config make_config_via_json(nlohmann::json& json) {
   if (json.contains("obj_file_name_map_file")) {
     config.obj_file_name_map_file = json.at("obj_file_name_map_file").get<std::string>();
   }
+  if (json.contains("dgo_load_jobs")) {
+    config.dgo_load_jobs = json.at("dgo_load_jobs").get<int>();
+  }
   config.disassemble_code = json.at("disassemble_code").get<bool>();
   config.decompile_code = json.at("decompile_code").get<bool>();
   if (json.contains("format_code")) {
@@ -317,6 +320,12 @@ Config make_config_via_json(nlohmann::json& json) {
 
   config.levels_to_extract = inputs_json.at("levels_to_extract").get<std::vector<std::string>>();
   config.levels_extract = json.at("levels_extract").get<bool>();
+  if (json.contains("levels_extract_jobs")) {
+    config.levels_extract_jobs = json.at("levels_extract_jobs").get<int>();
+  }
+  if (json.contains("levels_extract_memory_budget_mb")) {
+    config.levels_extract_memory_budget_mb = json.at("levels_extract_memory_budget_mb").get<int>();
+  }
   if (json.contains("save_texture_pngs")) {
     config.save_texture_pngs = json.at("save_texture_pngs").get<bool>();
   }
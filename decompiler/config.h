@@ -109,6 +109,8 @@ struct Config {
 
   bool disassemble_code = false;
   bool decompile_code = false;
+  int decompile_jobs = 1;  // number of threads for IR2 analysis
+  int dgo_load_jobs = 0;   // number of threads for loading DGOs, 0 = one per core
   bool format_code = false;
   bool write_scripts = false;
   bool disassemble_data = false;
@@ -172,6 +174,8 @@ struct Config {
 
   std::vector<std::string> levels_to_extract;
   bool levels_extract;
+  int levels_extract_jobs = 0;                // 0 = one per core
+  int levels_extract_memory_budget_mb = 4096;  // 0 = no limit
   bool save_texture_pngs = false;
   bool rip_streamed_audio = false;
 
@@ -129,6 +129,10 @@ const std::vector<u8>& StrFileReader::get_chunk(int idx) const {
   return m_chunks.at(idx);
 }
 
+std::vector<u8> StrFileReader::take_chunk(int idx) {
+  return std::move(m_chunks.at(idx));
+}
+
 namespace {
 bool find_string_in_data(const u8* data, int data_size, const std::string& str, int* result) {
   for (int i = 0; i < data_size - int(str.length()); i++) {
@@ -19,6 +19,8 @@ class StrFileReader {
   explicit StrFileReader(const fs::path& file_path, GameVersion version);
   int chunk_count() const;
   const std::vector<u8>& get_chunk(int idx) const;
+  // move the chunk's data out of the reader. The chunk is empty after this.
+  std::vector<u8> take_chunk(int idx);
   std::string get_chunk_art_name(int idx) const;
 
   std::string get_full_name(const std::string& short_name) const;
@@ -1,12 +1,17 @@
 #include "extract_level.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <set>
 #include <thread>
 
+#include "common/custom_data/fr3_container.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
 #include "common/util/SimpleThreadGroup.h"
-#include "common/util/compress.h"
+#include "common/util/Timer.h"
 #include "common/util/string_util.h"
 
 #include "decompiler/level_extractor/BspHeader.h"
@@ -310,8 +315,7 @@ void extract_common(const ObjectFileDB& db,
 
   Serializer ser;
   tfrag_level.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  auto compressed = tfrag3::pack_fr3(ser.get_save_result().first, ser.get_save_result().second);
 
   lg::info("stats for {}", dgo_name);
   print_memory_usage(tfrag_level, ser.get_save_result().second);
@@ -350,8 +354,7 @@ void extract_from_level(const ObjectFileDB& db,
 
   Serializer ser;
   level_data.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  auto compressed = tfrag3::pack_fr3(ser.get_save_result().first, ser.get_save_result().second);
   lg::info("stats for {}", level_data.level_name);
   print_memory_usage(level_data, ser.get_save_result().second);
   lg::info("compressed: {} -> {} ({:.2f}%)", ser.get_save_result().second, compressed.size(),
@@ -375,23 +378,132 @@ void extract_from_level(const ObjectFileDB& db,
                              extract_actors_to_json(bsp_header.actors));
 }
 
+namespace {
+/*!
+ * Rough estimate of the peak memory used to extract a level.
+ * The level holds a copy of each of its textures, exactly as big as in the TextureDB. The geometry
+ * is unpacked from the compact PS2 formats into 28 to 64 byte vertices, so it's assumed to grow by
+ * kUnpackedBytesPerDgoByte. Everything is copied once more when the level is serialized.
+ */
+u64 estimate_extract_memory(const ObjectFileDB& db,
+                            const TextureDB& tex_db,
+                            const std::string& dgo_name) {
+  constexpr u64 kUnpackedBytesPerDgoByte = 4;
+  u64 texture_bytes = 0;
+  auto tex_it = tex_db.texture_ids_per_level.find(dgo_name);
+  if (tex_it != tex_db.texture_ids_per_level.end()) {
+    for (auto id : tex_it->second) {
+      texture_bytes += tex_db.textures.at(id).rgba_bytes.size() * sizeof(u32);
+    }
+  }
+
+  // the tpages are already counted as textures.
+  u64 other_bytes = 0;
+  auto it = db.obj_files_by_dgo.find(dgo_name);
+  if (it != db.obj_files_by_dgo.end()) {
+    for (auto& rec : it->second) {
+      if (!str_util::starts_with(rec.name, "tpage-")) {
+        other_bytes += db.lookup_record(rec).data.size();
+      }
+    }
+  }
+  return 2 * (texture_bytes + other_bytes * kUnpackedBytesPerDgoByte);
+}
+
+/*!
+ * Limit on the total estimated memory of levels being extracted at once.
+ * A level that's bigger than the whole budget may still run, but only by itself.
+ */
+class MemoryBudget {
+ public:
+  explicit MemoryBudget(u64 budget) : m_budget(budget) {}
+
+  /*!
+   * Memory taken from the budget, which is given back when this is destroyed.
+   */
+  class Reservation {
+   public:
+    Reservation(MemoryBudget& budget, u64 bytes) : m_budget(budget), m_bytes(bytes) {
+      m_budget.acquire(m_bytes);
+    }
+    ~Reservation() { m_budget.release(m_bytes); }
+    Reservation(const Reservation&) = delete;
+    Reservation& operator=(const Reservation&) = delete;
+
+   private:
+    MemoryBudget& m_budget;
+    u64 m_bytes = 0;
+  };
+
+ private:
+  void acquire(u64 bytes) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_cv.wait(lock, [&] { return m_used == 0 || m_budget == 0 || m_used + bytes <= m_budget; });
+    m_used += bytes;
+  }
+  void release(u64 bytes) {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_used -= bytes;
+    }
+    m_cv.notify_all();
+  }
+
+  u64 m_budget = 0;
+  u64 m_used = 0;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+};
+}  // namespace
+
 void extract_all_levels(const ObjectFileDB& db,
                         const TextureDB& tex_db,
                         const std::vector<std::string>& dgo_names,
                         const std::string& common_name,
                         const Config& config,
                         const fs::path& output_path) {
+  Timer total_timer;
   extract_common(db, tex_db, common_name, output_path, config);
   auto entities_dir = file_util::get_jak_project_dir() / "decompiler_out" /
                       game_version_names[config.game_version] / "entities";
   file_util::create_dir_if_needed(entities_dir);
+
+  // start the biggest levels first, so one big level doesn't run by itself at the end.
+  struct LevelJob {
+    std::string dgo_name;
+    u64 memory = 0;
+  };
+  std::vector<LevelJob> jobs;
+  for (auto& dgo_name : dgo_names) {
+    jobs.push_back({dgo_name, estimate_extract_memory(db, tex_db, dgo_name)});
+  }
+  std::stable_sort(jobs.begin(), jobs.end(),
+                   [](const LevelJob& a, const LevelJob& b) { return a.memory > b.memory; });
+
+  int num_workers = config.levels_extract_jobs;
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+  num_workers = std::min(num_workers, std::max((int)jobs.size(), 1));
+  MemoryBudget budget((u64)std::max(config.levels_extract_memory_budget_mb, 0) * 1024 * 1024);
+  std::atomic<int> num_done = 0;
+  lg::info("Extracting {} levels with {} threads", jobs.size(), num_workers);
+
   SimpleThreadGroup threads;
-  threads.run(
+  threads.run_dynamic(
       [&](int idx) {
-        extract_from_level(db, tex_db, dgo_names[idx], config, output_path, entities_dir);
+        auto& job = jobs[idx];
+        Timer timer;
+        {
+          MemoryBudget::Reservation reservation(budget, job.memory);
+          extract_from_level(db, tex_db, job.dgo_name, config, output_path, entities_dir);
+        }
+        lg::info("[{:3d}/{}] Extracted {} in {:.2f}s", ++num_done, jobs.size(), job.dgo_name,
+                 timer.getSeconds());
       },
-      dgo_names.size());
+      jobs.size(), num_workers);
   threads.join();
+  lg::info("Extracted all levels in {:.2f}s", total_timer.getSeconds());
 }
 
 }  // namespace decompiler
@@ -20,6 +20,7 @@ int main(int argc, char** argv) {
 
   std::string config_game_version = "";
   std::string config_override = "{}";
+  int jobs = 1;
 
   CLI::App app{"OpenGOAL Decompiler"};
   app.add_option("config-path", config_path,
@@ -40,6 +41,9 @@ int main(int argc, char** argv) {
       ->required();
   app.add_option("--config-override", config_override,
                  "JSON provided will be merged with the specified config, use to override options");
+  app.add_option("-j,--jobs", jobs,
+                 "Number of object files to decompile in parallel. Output is the same for any "
+                 "number of jobs.");
   define_common_cli_arguments(app);
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
@@ -71,6 +75,8 @@ int main(int argc, char** argv) {
     return 1;
   }
 
+  config.decompile_jobs = std::max(jobs, 1);
+
   // these options imply read_spools
   config.read_spools |= config.process_subtitle_text || config.process_subtitle_images;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "common/goos/Reader.h"
 #include "common/goos/TextDB.h"
 #include "common/type_system/TypeSystem.h"
@@ -92,15 +94,19 @@ class DecompilerTypeSystem {
   }
 
   // todo - totally eliminate this.
-  struct {
+  // This is per-thread, so multiple functions can be type checked at the same time.
+  struct TypePropSettings {
     std::string current_method_type;
     void reset() { current_method_type.clear(); }
-  } type_prop_settings;
+  };
+  static thread_local TypePropSettings type_prop_settings;
 
   GameVersion version() const { return m_version; }
 
  private:
   GameVersion m_version;
   mutable goos::Reader m_reader;
+  // the reader isn't thread safe, and parse_type_spec is used during analysis.
+  mutable std::mutex m_reader_mutex;
 };
 }  // namespace decompiler
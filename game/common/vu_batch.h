@@ -0,0 +1,188 @@
+#pragma once
+
+/*!
+ * @file vu_batch.h
+ * Helpers for running a VU program on several independent vertices at once.
+ * Each VU register holds the same register for kVuBatchWidth vertices, stored as one SIMD register
+ * per component (x, y, z, w). The operations are done in the same order as the single vertex
+ * versions in vu.h, so the results are bit-for-bit identical.
+ */
+
+#include "game/common/vu.h"
+
+#ifdef __AVX__
+constexpr int kVuBatchWidth = 8;
+using VuLanes = __m256;
+
+static inline REALLY_INLINE VuLanes lanes_splat(float val) {
+  return _mm256_set1_ps(val);
+}
+static inline REALLY_INLINE VuLanes lanes_add(VuLanes a, VuLanes b) {
+  return _mm256_add_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_sub(VuLanes a, VuLanes b) {
+  return _mm256_sub_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_mul(VuLanes a, VuLanes b) {
+  return _mm256_mul_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_div(VuLanes a, VuLanes b) {
+  return _mm256_div_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_rsqrt(VuLanes a) {
+  return _mm256_rsqrt_ps(a);
+}
+#else
+constexpr int kVuBatchWidth = 4;
+using VuLanes = __m128;
+
+static inline REALLY_INLINE VuLanes lanes_splat(float val) {
+  return _mm_set1_ps(val);
+}
+static inline REALLY_INLINE VuLanes lanes_add(VuLanes a, VuLanes b) {
+  return _mm_add_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_sub(VuLanes a, VuLanes b) {
+  return _mm_sub_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_mul(VuLanes a, VuLanes b) {
+  return _mm_mul_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_div(VuLanes a, VuLanes b) {
+  return _mm_div_ps(a, b);
+}
+static inline REALLY_INLINE VuLanes lanes_rsqrt(VuLanes a) {
+  return _mm_rsqrt_ps(a);
+}
+#endif
+
+/*!
+ * A VU register, for kVuBatchWidth vertices.
+ */
+struct VfBatch {
+  VuLanes x, y, z, w;
+
+  // the same value in every lane.
+  static REALLY_INLINE VfBatch splat(const Vf& v) {
+    return {lanes_splat(v.x()), lanes_splat(v.y()), lanes_splat(v.z()), lanes_splat(v.w())};
+  }
+
+  // load kVuBatchWidth consecutive quadwords, one per lane.
+  static REALLY_INLINE VfBatch load(const Vf* src) { return load(src, 1); }
+
+  // load lane i from src[i * stride].
+  static REALLY_INLINE VfBatch load(const Vf* src, int stride) {
+    VfBatch result;
+#ifdef __AVX__
+    __m128 r0 = src[0].load(), r1 = src[stride].load(), r2 = src[2 * stride].load();
+    __m128 r3 = src[3 * stride].load(), r4 = src[4 * stride].load(), r5 = src[5 * stride].load();
+    __m128 r6 = src[6 * stride].load(), r7 = src[7 * stride].load();
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _MM_TRANSPOSE4_PS(r4, r5, r6, r7);
+    result.x = _mm256_insertf128_ps(_mm256_castps128_ps256(r0), r4, 1);
+    result.y = _mm256_insertf128_ps(_mm256_castps128_ps256(r1), r5, 1);
+    result.z = _mm256_insertf128_ps(_mm256_castps128_ps256(r2), r6, 1);
+    result.w = _mm256_insertf128_ps(_mm256_castps128_ps256(r3), r7, 1);
+#else
+    result.x = src[0].load();
+    result.y = src[stride].load();
+    result.z = src[2 * stride].load();
+    result.w = src[3 * stride].load();
+    _MM_TRANSPOSE4_PS(result.x, result.y, result.z, result.w);
+#endif
+    return result;
+  }
+
+  // store lane i to dst[i * stride]. (the sq in a vertex loop is usually to a strided buffer)
+  REALLY_INLINE void store(Vf* dst, int stride) const {
+#ifdef __AVX__
+    __m128 r0 = _mm256_castps256_ps128(x), r1 = _mm256_castps256_ps128(y);
+    __m128 r2 = _mm256_castps256_ps128(z), r3 = _mm256_castps256_ps128(w);
+    __m128 r4 = _mm256_extractf128_ps(x, 1), r5 = _mm256_extractf128_ps(y, 1);
+    __m128 r6 = _mm256_extractf128_ps(z, 1), r7 = _mm256_extractf128_ps(w, 1);
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _MM_TRANSPOSE4_PS(r4, r5, r6, r7);
+    _mm_store_ps(dst[0].data, r0);
+    _mm_store_ps(dst[stride].data, r1);
+    _mm_store_ps(dst[2 * stride].data, r2);
+    _mm_store_ps(dst[3 * stride].data, r3);
+    _mm_store_ps(dst[4 * stride].data, r4);
+    _mm_store_ps(dst[5 * stride].data, r5);
+    _mm_store_ps(dst[6 * stride].data, r6);
+    _mm_store_ps(dst[7 * stride].data, r7);
+#else
+    __m128 r0 = x, r1 = y, r2 = z, r3 = w;
+    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+    _mm_store_ps(dst[0].data, r0);
+    _mm_store_ps(dst[stride].data, r1);
+    _mm_store_ps(dst[2 * stride].data, r2);
+    _mm_store_ps(dst[3 * stride].data, r3);
+#endif
+  }
+
+  // mul.xyzw dest, this, other
+  REALLY_INLINE VfBatch mul(const VfBatch& other) const {
+    return {lanes_mul(x, other.x), lanes_mul(y, other.y), lanes_mul(z, other.z),
+            lanes_mul(w, other.w)};
+  }
+};
+
+/*!
+ * The VU accumulator, for kVuBatchWidth vertices.
+ * The vector operand is the same for all lanes (a constant register, like a matrix row) and the
+ * broadcast operand is different per lane, which is how vertex transforms are usually written.
+ */
+struct AccBatch {
+  VfBatch data;
+
+  // mulaN.xyzw ACC, a, b.N
+  REALLY_INLINE void mula(const VfBatch& a, VuLanes b) {
+    data.x = lanes_mul(a.x, b);
+    data.y = lanes_mul(a.y, b);
+    data.z = lanes_mul(a.z, b);
+    data.w = lanes_mul(a.w, b);
+  }
+
+  // maddaN.xyzw ACC, a, b.N
+  REALLY_INLINE void madda(const VfBatch& a, VuLanes b) {
+    data.x = lanes_add(data.x, lanes_mul(a.x, b));
+    data.y = lanes_add(data.y, lanes_mul(a.y, b));
+    data.z = lanes_add(data.z, lanes_mul(a.z, b));
+    data.w = lanes_add(data.w, lanes_mul(a.w, b));
+  }
+
+  // maddN.xyzw dest, a, b.N
+  REALLY_INLINE VfBatch madd(const VfBatch& a, VuLanes b) const {
+    return {lanes_add(data.x, lanes_mul(a.x, b)), lanes_add(data.y, lanes_mul(a.y, b)),
+            lanes_add(data.z, lanes_mul(a.z, b)), lanes_add(data.w, lanes_mul(a.w, b))};
+  }
+
+  // mula.xyzw ACC, a, b
+  REALLY_INLINE void mula(const VfBatch& a, const VfBatch& b) { data = a.mul(b); }
+
+  // madd.xyzw dest, a, b
+  REALLY_INLINE VfBatch madd(const VfBatch& a, const VfBatch& b) const {
+    return {lanes_add(data.x, lanes_mul(a.x, b.x)), lanes_add(data.y, lanes_mul(a.y, b.y)),
+            lanes_add(data.z, lanes_mul(a.z, b.z)), lanes_add(data.w, lanes_mul(a.w, b.w))};
+  }
+
+  /*!
+   * The usual 4 instruction matrix multiply:
+   *   mulax.xyzw  ACC, c0, v
+   *   madday.xyzw ACC, c1, v
+   *   maddaz.xyzw ACC, c2, v
+   *   maddw.xyzw  dest, c3, v
+   */
+  REALLY_INLINE VfBatch transform(const VfBatch* c, const VfBatch& v) {
+    mula(c[0], v.x);
+    madda(c[1], v.y);
+    madda(c[2], v.z);
+    return madd(c[3], v.w);
+  }
+};
+
+// erleng.xyz P, v  (see erleng in the ocean renderers)
+static inline REALLY_INLINE VuLanes erleng_batch(const VfBatch& v) {
+  return lanes_rsqrt(
+      lanes_add(lanes_add(lanes_mul(v.x, v.x), lanes_mul(v.y, v.y)), lanes_mul(v.z, v.z)));
+}
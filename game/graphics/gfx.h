@@ -85,6 +85,9 @@ struct GfxGlobalSettings {
   // frame timing things
   bool experimental_accurate_lag = false;
   bool sleep_in_frame_limiter = true;
+  // copy the DMA chain so the game can run the next frame while the renderer draws this one.
+  // experimental: some renderers still read EE memory directly.
+  bool pipelined_dma = false;
 
   // fancy effect things
   bool hack_no_tex = false;
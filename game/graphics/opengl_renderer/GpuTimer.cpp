@@ -0,0 +1,116 @@
+#include "GpuTimer.h"
+
+#include "common/global_profiler/GlobalProfiler.h"
+
+GpuBucketTimer::~GpuBucketTimer() {
+  for (auto& frame : m_frames) {
+    for (auto& q : frame.queries) {
+      glDeleteQueries(1, &q.begin);
+      glDeleteQueries(1, &q.end);
+    }
+  }
+}
+
+const std::vector<GpuBucketTimer::Result>& GpuBucketTimer::begin_frame() {
+  m_results.clear();
+
+  // frames finish in order, so stop at the first one that isn't done.
+  for (int i = 0; i < kFramesInFlight; i++) {
+    auto& frame = m_frames[(m_frame_idx + i) % kFramesInFlight];
+    if (!frame.pending) {
+      continue;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.used - 1].end, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available) {
+      read_frame(frame);
+    } else {
+      if (i == 0) {
+        // we're about to reuse these queries, and waiting would stall.
+        frame.pending = false;
+        m_dropped_frames++;
+      }
+      break;
+    }
+  }
+
+  m_in_frame = m_enabled;
+  if (m_in_frame) {
+    auto& frame = m_frames[m_frame_idx];
+    frame.used = 0;
+    GLint64 gpu_now = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpu_now);
+    frame.gpu_to_prof_ns = (s64)prof().timestamp() - gpu_now;
+  }
+  return m_results;
+}
+
+void GpuBucketTimer::begin_bucket(int bucket, const std::string& name) {
+  if (!m_in_frame) {
+    return;
+  }
+  auto& frame = m_frames[m_frame_idx];
+  if (frame.used == (int)frame.queries.size()) {
+    auto& q = frame.queries.emplace_back();
+    glGenQueries(1, &q.begin);
+    glGenQueries(1, &q.end);
+  }
+  auto& q = frame.queries[frame.used++];
+  q.bucket = bucket;
+  glQueryCounter(q.begin, GL_TIMESTAMP);
+
+  if (bucket >= (int)m_names.size()) {
+    m_names.resize(bucket + 1);
+    m_last_duration.resize(bucket + 1, -1.f);
+  }
+  m_names[bucket] = name;
+}
+
+void GpuBucketTimer::end_bucket() {
+  if (!m_in_frame) {
+    return;
+  }
+  auto& frame = m_frames[m_frame_idx];
+  glQueryCounter(frame.queries[frame.used - 1].end, GL_TIMESTAMP);
+}
+
+void GpuBucketTimer::end_frame() {
+  if (!m_in_frame) {
+    return;
+  }
+  m_frames[m_frame_idx].pending = m_frames[m_frame_idx].used > 0;
+  m_frame_idx = (m_frame_idx + 1) % kFramesInFlight;
+  m_in_frame = false;
+}
+
+void GpuBucketTimer::read_frame(Frame& frame) {
+  auto& gprof = prof();
+  bool add_events = gprof.is_enabled();
+  for (int i = 0; i < frame.used; i++) {
+    auto& q = frame.queries[i];
+    GLuint64 begin = 0, end = 0;
+    glGetQueryObjectui64v(q.begin, GL_QUERY_RESULT, &begin);
+    glGetQueryObjectui64v(q.end, GL_QUERY_RESULT, &end);
+    float duration = (end - begin) * 1e-9f;
+    m_results.push_back({q.bucket, duration});
+    m_last_duration[q.bucket] = duration;
+
+    if (add_events) {
+      u64 ts_begin = begin + frame.gpu_to_prof_ns;
+      if (i == 0) {
+        gprof.event_at("ROOT", ProfNode::INSTANT, ts_begin, GlobalProfiler::GPU_TRACK_TID);
+      }
+      gprof.event_at(m_names[q.bucket].c_str(), ProfNode::BEGIN, ts_begin,
+                     GlobalProfiler::GPU_TRACK_TID);
+      gprof.event_at("", ProfNode::END, end + frame.gpu_to_prof_ns, GlobalProfiler::GPU_TRACK_TID);
+    }
+  }
+  frame.pending = false;
+}
+
+float GpuBucketTimer::last_duration(int bucket) const {
+  if (bucket < (int)m_last_duration.size()) {
+    return m_last_duration[bucket];
+  }
+  return -1.f;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+
+#include "game/graphics/pipelines/opengl.h"
+
+/*!
+ * Measures how long each bucket takes to run on the GPU, using timestamp queries.
+ * Results are read a few frames later, and only once the GPU has finished them, so this never
+ * waits on the GPU. If the GPU falls too far behind, the oldest frame's results are dropped.
+ * Finished results are also added to the GPU track of the global profiler, if it's recording.
+ */
+class GpuBucketTimer {
+ public:
+  struct Result {
+    int bucket;
+    float duration;  // seconds
+  };
+
+  GpuBucketTimer() = default;
+  ~GpuBucketTimer();
+  GpuBucketTimer(const GpuBucketTimer&) = delete;
+  GpuBucketTimer& operator=(const GpuBucketTimer&) = delete;
+
+  // if disabled, no new queries are made.
+  void set_enabled(bool en) { m_enabled = en; }
+
+  // call at the start of a frame. Returns results that finished since the last call.
+  const std::vector<Result>& begin_frame();
+  void begin_bucket(int bucket, const std::string& name);
+  void end_bucket();
+  void end_frame();
+
+  // the most recent GPU time of a bucket in seconds, or negative if there is none yet.
+  float last_duration(int bucket) const;
+  int dropped_frames() const { return m_dropped_frames; }
+
+ private:
+  static constexpr int kFramesInFlight = 3;
+
+  struct Query {
+    GLuint begin = 0;
+    GLuint end = 0;
+    int bucket = -1;
+  };
+
+  struct Frame {
+    std::vector<Query> queries;
+    int used = 0;
+    bool pending = false;
+    s64 gpu_to_prof_ns = 0;  // add to a GPU timestamp to get a GlobalProfiler timestamp.
+  };
+
+  void read_frame(Frame& frame);
+
+  bool m_enabled = false;
+  bool m_in_frame = false;
+  int m_frame_idx = 0;
+  int m_dropped_frames = 0;
+  Frame m_frames[kFramesInFlight];
+  std::vector<Result> m_results;
+  std::vector<float> m_last_duration;
+  std::vector<std::string> m_names;
+};
@@ -946,7 +946,13 @@ void OpenGLRenderer::render(DmaFollower dma, const RenderOptions& settings) {
   // render the buckets!
   {
     auto prof = m_profiler.root()->make_scoped_child("buckets");
+    // GPU timing results from earlier frames.
+    m_gpu_timer.set_enabled(settings.draw_profiler_window || ::prof().is_enabled());
+    for (auto& result : m_gpu_timer.begin_frame()) {
+      m_profiler.add_bucket_gpu_time(result.bucket, result.duration);
+    }
     dispatch_buckets(dma, prof, settings.gpu_sync);
+    m_gpu_timer.end_frame();
     if (m_texture_animator) {
       // if animation requests weren't made, assume the level is unloaded and the textures should
       // reset.
@@ -1257,7 +1263,9 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_renderer = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_renderer);
+    m_gpu_timer.begin_bucket(bucket_id, g_current_renderer);
     renderer->render(dma, &m_render_state, bucket_prof);
+    m_gpu_timer.end_bucket();
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
       glFinish();
@@ -1269,6 +1277,8 @@ void OpenGLRenderer::dispatch_buckets_jak1(DmaFollower dma,
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id);
     m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
+    m_profiler.add_bucket_cpu_time(bucket_id, g_current_renderer, bucket_prof.get_elapsed_time());
+    bucket_prof.set_gpu_duration(m_gpu_timer.last_duration(bucket_id));
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id == 31 - 1 && Gfx::g_global_settings.collision_enable) {
@@ -1297,7 +1307,9 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_renderer = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_renderer);
+    m_gpu_timer.begin_bucket(bucket_id, g_current_renderer);
     renderer->render(dma, &m_render_state, bucket_prof);
+    m_gpu_timer.end_bucket();
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
       glFinish();
@@ -1309,6 +1321,8 @@ void OpenGLRenderer::dispatch_buckets_jak2(DmaFollower dma,
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id + 1);
     m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
+    m_profiler.add_bucket_cpu_time(bucket_id, g_current_renderer, bucket_prof.get_elapsed_time());
+    bucket_prof.set_gpu_duration(m_gpu_timer.last_duration(bucket_id));
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id + 1 == (int)jak2::BucketId::TEX_L0_ALPHA &&
@@ -1339,7 +1353,9 @@ void OpenGLRenderer::dispatch_buckets_jak3(DmaFollower dma,
     auto bucket_prof = prof.make_scoped_child(renderer->name_and_id());
     g_current_renderer = renderer->name_and_id();
     // lg::info("Render: {} start", g_current_renderer);
+    m_gpu_timer.begin_bucket(bucket_id, g_current_renderer);
     renderer->render(dma, &m_render_state, bucket_prof);
+    m_gpu_timer.end_bucket();
     if (sync_after_buckets) {
       auto pp = scoped_prof("finish");
       glFinish();
@@ -1351,6 +1367,8 @@ void OpenGLRenderer::dispatch_buckets_jak3(DmaFollower dma,
     m_render_state.next_bucket += 16;
     vif_interrupt_callback(bucket_id + 1);
     m_category_times[(int)m_bucket_categories[bucket_id]] += bucket_prof.get_elapsed_time();
+    m_profiler.add_bucket_cpu_time(bucket_id, g_current_renderer, bucket_prof.get_elapsed_time());
+    bucket_prof.set_gpu_duration(m_gpu_timer.last_duration(bucket_id));
 
     // hack to draw the collision mesh in the middle the drawing
     if (bucket_id + 1 == (int)jak3::BucketId::TEX_L0_ALPHA &&
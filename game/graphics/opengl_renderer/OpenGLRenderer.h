@@ -8,6 +8,7 @@
 #include "game/graphics/opengl_renderer/BucketRenderer.h"
 #include "game/graphics/opengl_renderer/CollideMeshRenderer.h"
 #include "game/graphics/opengl_renderer/Fbo.h"
+#include "game/graphics/opengl_renderer/GpuTimer.h"
 #include "game/graphics/opengl_renderer/Profiler.h"
 #include "game/graphics/opengl_renderer/Shader.h"
 #include "game/graphics/opengl_renderer/TextureAnimator.h"
@@ -106,6 +107,7 @@ class OpenGLRenderer {
 
   SharedRenderState m_render_state;
   Profiler m_profiler;
+  GpuBucketTimer m_gpu_timer;
   SmallProfiler m_small_profiler;
   SubtitleEditor* m_subtitle_editor = nullptr;
   FiltersMenu m_filters_menu;
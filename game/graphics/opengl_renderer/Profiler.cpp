@@ -84,11 +84,83 @@ void Profiler::draw() {
   m_root.sort((ProfilerSort)m_mode_selector);
   ImGui::SameLine();
   bool all = ImGui::Button("Expand All");
+  if (ImGui::CollapsingHeader("Bucket Percentiles")) {
+    draw_bucket_times();
+  }
   ImGui::Dummy(ImVec2(0.0f, 80.0f));
   draw_node(m_root, all, 0, 0.f);
   ImGui::End();
 }
 
+void Profiler::add_bucket_cpu_time(int bucket, const std::string& name, float seconds) {
+  if (bucket >= (int)m_bucket_times.size()) {
+    m_bucket_times.resize(bucket + 1);
+  }
+  auto& times = m_bucket_times[bucket];
+  // the renderer for a bucket never changes, so the name only needs to be copied once.
+  if (times.name.empty()) {
+    times.name = name;
+  }
+  times.cpu.push(seconds);
+}
+
+void Profiler::add_bucket_gpu_time(int bucket, float seconds) {
+  if (bucket >= (int)m_bucket_times.size()) {
+    m_bucket_times.resize(bucket + 1);
+  }
+  m_bucket_times[bucket].gpu.push(seconds);
+}
+
+void Profiler::draw_bucket_times() {
+  struct Row {
+    const BucketTimes* times;
+    float cpu50, cpu99, gpu50, gpu99;
+  };
+  std::vector<Row> rows;
+  for (auto& times : m_bucket_times) {
+    if (times.cpu.empty()) {
+      continue;
+    }
+    rows.push_back({&times, times.cpu.percentile(0.5f), times.cpu.percentile(0.99f),
+                    times.gpu.percentile(0.5f), times.gpu.percentile(0.99f)});
+  }
+  // slowest on the GPU first, since that's usually the problem.
+  std::sort(rows.begin(), rows.end(), [](const Row& a, const Row& b) {
+    return std::max(a.gpu99, a.cpu99) > std::max(b.gpu99, b.cpu99);
+  });
+
+  if (ImGui::BeginTable("bucket-times", 5,
+                        ImGuiTableFlags_Borders | ImGuiTableFlags_ScrollY |
+                            ImGuiTableFlags_SizingFixedFit,
+                        ImVec2(0, 300))) {
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableSetupColumn("bucket");
+    ImGui::TableSetupColumn("cpu p50");
+    ImGui::TableSetupColumn("cpu p99");
+    ImGui::TableSetupColumn("gpu p50");
+    ImGui::TableSetupColumn("gpu p99");
+    ImGui::TableHeadersRow();
+    for (auto& row : rows) {
+      ImGui::TableNextRow();
+      ImGui::TableNextColumn();
+      ImGui::TextUnformatted(row.times->name.c_str());
+      for (float val : {row.cpu50, row.cpu99}) {
+        ImGui::TableNextColumn();
+        ImGui::Text("%.3f ms", val * 1000);
+      }
+      for (float val : {row.gpu50, row.gpu99}) {
+        ImGui::TableNextColumn();
+        if (row.times->gpu.empty()) {
+          ImGui::TextUnformatted("-");
+        } else {
+          ImGui::Text("%.3f ms", val * 1000);
+        }
+      }
+    }
+    ImGui::EndTable();
+  }
+}
+
 u32 name_to_color(const std::string& name) {
   u64 val = std::hash<std::string>{}(name);
   return colors::common_colors[val % colors::COLOR_COUNT] | 0xff000000;
@@ -110,6 +182,9 @@ void Profiler::draw_node(ProfilerNode& node, bool expand, int depth, float start
   auto str =
       fmt::format("{:20s} {:.2f}ms {:6d} tri {:4d} draw", node.m_name, node.m_stats.duration * 1000,
                   node.m_stats.triangles, node.m_stats.draw_calls);
+  if (node.m_stats.gpu_duration >= 0) {
+    str += fmt::format(" {:.2f}ms gpu", node.m_stats.gpu_duration * 1000);
+  }
   if (node.m_children.empty()) {
     ImGui::Text("   %s", str.c_str());
     color_orange = ImGui::IsItemHovered();
@@ -160,6 +235,25 @@ void ProfilerNode::to_string_helper(std::string& str, int depth) const {
   }
 }
 
+void RollingSamples::push(float val) {
+  m_buffer[m_idx++] = val;
+  if (m_idx == SIZE) {
+    m_idx = 0;
+  }
+  m_count = std::min(m_count + 1, SIZE);
+}
+
+float RollingSamples::percentile(float p) const {
+  if (m_count == 0) {
+    return 0;
+  }
+  float sorted[SIZE];
+  std::copy(m_buffer, m_buffer + m_count, sorted);
+  int idx = std::clamp((int)(p * m_count), 0, m_count - 1);
+  std::nth_element(sorted, sorted + idx, sorted + m_count);
+  return sorted[idx];
+}
+
 void FramePlot::push(float val) {
   m_buffer[m_idx++] = val;
   if (m_idx == SIZE) {
@@ -13,7 +13,8 @@
 enum class ProfilerSort { NONE = 0, TIME = 1, DRAW_CALLS = 2, TRIANGLES = 3 };
 
 struct ProfilerStats {
-  float duration = 0;  // seconds
+  float duration = 0;       // seconds
+  float gpu_duration = -1;  // seconds, from a few frames ago. Negative if not measured.
   u32 draw_calls = 0;
   u32 triangles = 0;
 
@@ -38,6 +39,7 @@ class ProfilerNode {
 
   void add_draw_call(int count = 1) { m_stats.draw_calls += count; }
   void add_tri(int count = 1) { m_stats.triangles += count; }
+  void set_gpu_duration(float seconds) { m_stats.gpu_duration = seconds; }
   float get_elapsed_time() const { return m_timer.getSeconds(); }
   const ProfilerStats& stats() const { return m_stats; }
 
@@ -66,6 +68,7 @@ class ScopedProfilerNode {
 
   void add_draw_call(int count = 1) { m_node->add_draw_call(count); }
   void add_tri(int count = 1) { m_node->add_tri(count); }
+  void set_gpu_duration(float seconds) { m_node->set_gpu_duration(seconds); }
   float get_elapsed_time() const { return m_node->get_elapsed_time(); }
 
  private:
@@ -73,6 +76,23 @@ class ScopedProfilerNode {
   ScopedEvent m_global_event;
 };
 
+/*!
+ * The last few seconds of samples of a value, for percentiles.
+ */
+class RollingSamples {
+ public:
+  static constexpr int SIZE = 60 * 5;
+  void push(float val);
+  // p is from 0 to 1. Returns 0 if there are no samples.
+  float percentile(float p) const;
+  bool empty() const { return m_count == 0; }
+
+ private:
+  float m_buffer[SIZE] = {};
+  int m_idx = 0;
+  int m_count = 0;
+};
+
 class Profiler {
  public:
   Profiler();
@@ -80,6 +100,10 @@ class Profiler {
   void draw();
   void finish();
 
+  // per-bucket times, kept across frames for percentiles.
+  void add_bucket_cpu_time(int bucket, const std::string& name, float seconds);
+  void add_bucket_gpu_time(int bucket, float seconds);
+
   float root_time() const { return m_root.m_stats.duration; }
 
   std::string to_string();
@@ -93,8 +117,15 @@ class Profiler {
     float rgba[4];
   };
 
+  struct BucketTimes {
+    std::string name;
+    RollingSamples cpu, gpu;
+  };
+  void draw_bucket_times();
+
   int m_mode_selector = 0;
   ProfilerNode m_root;
+  std::vector<BucketTimes> m_bucket_times;
 };
 
 class FramePlot {
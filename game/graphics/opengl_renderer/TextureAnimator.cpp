@@ -1,5 +1,11 @@
 #include "TextureAnimator.h"
 
+#ifdef __aarch64__
+#include "third-party/sse2neon/sse2neon.h"
+#else
+#include <immintrin.h>
+#endif
+
 #include "common/global_profiler/GlobalProfiler.h"
 #include "common/log/log.h"
 #include "common/texture/texture_slots.h"
@@ -282,48 +288,88 @@ ClutBlender::ClutBlender(const std::string& dest,
   // opengl texture that we'll write to
   m_texture = tpool->allocate(m_dest->w, m_dest->h);
   m_temp_rgba.resize(m_dest->w * m_dest->h);
+  m_clut_cache.resize(CLUT_CACHE_SIZE);
 
   // default to the first one.
-  std::vector<float> init_weights(m_current_weights.size(), 0);
-  init_weights.at(0) = 1.f;
-  run(init_weights.data());
+  run(0.f);
 }
 
 /*!
- * Blend cluts and create an output texture.
+ * Blend two cluts, 4 entries at a time. Gives the same result as blend_cluts_reference.
  */
-GLuint ClutBlender::run(const float* weights) {
-  bool needs_run = false;
-
-  // check if weights changed or not.
-  for (size_t i = 0; i < m_current_weights.size(); i++) {
-    if (weights[i] != m_current_weights[i]) {
-      needs_run = true;
-      break;
+void blend_cluts(Clut* out, const Clut& a, const Clut& b, float weight_a, float weight_b) {
+  const __m128 wa = _mm_set1_ps(weight_a);
+  const __m128 wb = _mm_set1_ps(weight_b);
+  const u8* a_data = a[0].data();
+  const u8* b_data = b[0].data();
+  u8* out_data = (*out)[0].data();
+  static_assert(sizeof(Clut) == 256 * 4);
+
+  for (int i = 0; i < 256 * 4; i += 16) {
+    __m128i a_bytes = _mm_loadu_si128((const __m128i*)(a_data + i));
+    __m128i b_bytes = _mm_loadu_si128((const __m128i*)(b_data + i));
+    __m128i result[4];
+    for (int j = 0; j < 4; j++) {
+      __m128 af = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(a_bytes));
+      __m128 bf = _mm_cvtepi32_ps(_mm_cvtepu8_epi32(b_bytes));
+      // truncate, like casting to u8
+      result[j] = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(af, wa), _mm_mul_ps(bf, wb)));
+      a_bytes = _mm_srli_si128(a_bytes, 4);
+      b_bytes = _mm_srli_si128(b_bytes, 4);
     }
+    __m128i lo = _mm_packus_epi32(result[0], result[1]);
+    __m128i hi = _mm_packus_epi32(result[2], result[3]);
+    _mm_storeu_si128((__m128i*)(out_data + i), _mm_packus_epi16(lo, hi));
   }
+}
 
-  if (!needs_run) {
+void blend_cluts_reference(Clut* out,
+                           const Clut& a,
+                           const Clut& b,
+                           float weight_a,
+                           float weight_b) {
+  for (int i = 0; i < 256; i++) {
+    math::Vector4f v = math::Vector4f::zero();
+    v += a[i].cast<float>() * weight_a;
+    v += b[i].cast<float>() * weight_b;
+    (*out)[i] = v.cast<u8>();
+  }
+}
+
+/*!
+ * Blend cluts and create an output texture.
+ */
+GLuint ClutBlender::run(float f) {
+  // round the weight of the second clut, and only do work if that changes.
+  int key = (int)std::round(std::clamp(f, 0.f, 1.f) * CLUT_BLEND_WEIGHT_STEPS);
+  if (key == m_current_weight_key) {
     return m_texture;
   }
+  bool first_run = m_current_weight_key < 0;
+  m_current_weight_key = key;
+  m_current_weights[1] = (float)key / CLUT_BLEND_WEIGHT_STEPS;
+  m_current_weights[0] = 1.f - m_current_weights[1];
 
-  // update weights
-  for (size_t i = 0; i < m_current_weights.size(); i++) {
-    m_current_weights[i] = weights[i];
+  // blend cluts, or reuse the result from the last time we had this weight.
+  auto& cached = m_clut_cache[key % CLUT_CACHE_SIZE];
+  if (cached.weight_key != key) {
+    blend_cluts(&cached.clut, *m_cluts[0], *m_cluts[1], m_current_weights[0],
+                m_current_weights[1]);
+    cached.weight_key = key;
   }
 
-  // blend cluts
-  for (int i = 0; i < 256; i++) {
-    math::Vector4f v = math::Vector4f::zero();
-    for (size_t j = 0; j < m_current_weights.size(); j++) {
-      v += (*m_cluts[j])[i].cast<float>() * m_current_weights[j];
-    }
-    m_temp_clut[i] = v.cast<u8>();
+  // different weights often round to the same colors, so skip the upload if nothing changed.
+  if (!first_run && !memcmp(m_uploaded_clut.data(), cached.clut.data(), sizeof(Clut))) {
+    return m_texture;
   }
+  m_uploaded_clut = cached.clut;
 
   // do texture lookups
+  u32 clut_u32s[256];
+  memcpy(clut_u32s, m_uploaded_clut.data(), sizeof(clut_u32s));
+  const u8* index_data = m_dest->index_data.data();
   for (size_t i = 0; i < m_temp_rgba.size(); i++) {
-    memcpy(&m_temp_rgba[i], m_temp_clut[m_dest->index_data[i]].data(), 4);
+    m_temp_rgba[i] = clut_u32s[index_data[i]];
   }
 
   // send to GPU.
@@ -576,6 +622,7 @@ void imgui_show_tex(GLuint tex) {
 
 void TextureAnimator::draw_debug_window() {
   ImGui::Checkbox("fast-scrambler", &m_debug.use_fast_scrambler);
+  ImGui::Checkbox("parallel-scrambler", &m_debug.parallel_scrambler);
 
   ImGui::Text("Slime:");
   ImGui::Text("dests %d %d", m_debug_slime_input.dest, m_debug_slime_input.scroll_dest);
@@ -1485,11 +1532,10 @@ void TextureAnimator::run_clut_blender_group(DmaTransfer& tf, int idx, u64 frame
   float f;
   ASSERT(tf.size_bytes == 16);
   memcpy(&f, tf.data, sizeof(float));
-  float weights[2] = {1.f - f, f};
   auto& blender = m_clut_blender_groups.at(idx);
   blender.last_updated_frame = frame_idx;
   for (size_t i = 0; i < blender.blenders.size(); i++) {
-    m_private_output_slots[blender.outputs[i]] = blender.blenders[i].run(weights);
+    m_private_output_slots[blender.outputs[i]] = blender.blenders[i].run(f);
   }
 }
 
@@ -1567,8 +1613,7 @@ void TextureAnimator::clear_stale_textures(u64 frame_idx) {
     if (frame_idx > group.last_updated_frame) {
       for (auto& blender : group.blenders) {
         if (!blender.at_default()) {
-          float weights[2] = {1, 0};
-          blender.run(weights);
+          blender.run(0.f);
         }
       }
     }
@@ -1974,6 +2019,7 @@ GLuint TextureAnimator::make_or_get_gpu_texture_for_current_shader(TexturePool&
             // also needs clut lookup
             load_clut_to_converter();
             {
+              m_converter.set_parallel(m_debug.parallel_scrambler);
               m_converter.download_rgba8888(
                   (u8*)rgba_data.data(), m_current_shader.tex0.tbp0(), m_current_shader.tex0.tbw(),
                   w, h, (int)m_current_shader.tex0.psm(), (int)m_current_shader.tex0.cpsm(),
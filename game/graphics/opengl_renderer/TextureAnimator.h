@@ -66,6 +66,17 @@ struct OpenGLTexturePool {
   std::unordered_map<u64, std::vector<GLuint>> textures;
 };
 
+using Clut = std::array<math::Vector4<u8>, 256>;
+
+void blend_cluts(Clut* out, const Clut& a, const Clut& b, float weight_a, float weight_b);
+void blend_cluts_reference(Clut* out, const Clut& a, const Clut& b, float weight_a, float weight_b);
+
+/*!
+ * Blend weights are rounded to this many steps. The output is only 8 bits, so finer steps don't
+ * change the result by more than 1, and this lets us skip work when the weights barely move.
+ */
+constexpr int CLUT_BLEND_WEIGHT_STEPS = 256;
+
 class ClutBlender {
  public:
   ClutBlender(const std::string& dest,
@@ -73,17 +84,28 @@ class ClutBlender {
               const std::optional<std::string>& level_name,
               const tfrag3::Level* level,
               OpenGLTexturePool* tpool);
-  GLuint run(const float* weights);
+  // f is the weight of the second clut. The first gets 1 - f.
+  GLuint run(float f);
   GLuint texture() const { return m_texture; }
   bool at_default() const { return m_current_weights[0] == 1.f && m_current_weights[1] == 0.f; }
 
  private:
   const tfrag3::IndexTexture* m_dest;
-  std::array<const std::array<math::Vector4<u8>, 256>*, 2> m_cluts;
+  std::array<const Clut*, 2> m_cluts;
   std::array<float, 2> m_current_weights;
+  int m_current_weight_key = -1;
   GLuint m_texture;
-  std::array<math::Vector4<u8>, 256> m_temp_clut;
+  Clut m_uploaded_clut;
   std::vector<u32> m_temp_rgba;
+
+  // blended cluts for recently used weights. Animations tend to cycle through the same weights, so
+  // this is indexed by the rounded weight, and a slot is replaced when another weight maps to it.
+  static constexpr int CLUT_CACHE_SIZE = 32;
+  struct CachedClut {
+    int weight_key = -1;
+    Clut clut;
+  };
+  std::vector<CachedClut> m_clut_cache;
 };
 
 struct Psm32ToPsm8Scrambler {
@@ -369,6 +391,7 @@ class TextureAnimator {
 
   struct {
     bool use_fast_scrambler = true;
+    bool parallel_scrambler = false;
   } m_debug;
 
   GLuint m_shader_id;
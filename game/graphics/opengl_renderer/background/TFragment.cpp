@@ -297,6 +297,7 @@ void TFragment::update_load(const std::vector<tfrag3::TFragmentTreeKind>& tree_k
         tree_cache.draws = &tree.draws;  // todo - should we just copy this?
         tree_cache.colors = &tree.colors;
         tree_cache.vis = &tree.bvh;
+        tree_cache.cull_data.init(tree.bvh.vis_nodes);
         tree_cache.index_data = tree.unpacked.indices.data();
         tree_cache.draw_mode = tree.use_strips ? GL_TRIANGLE_STRIP : GL_TRIANGLES;
         vis_temp_len = std::max(vis_temp_len, tree.bvh.vis_nodes.size());
@@ -437,8 +438,8 @@ void TFragment::render_tree(int geom,
   glEnable(GL_PRIMITIVE_RESTART);
   glPrimitiveRestartIndex(UINT32_MAX);
 
-  cull_check_all_slow(settings.camera.planes, tree.vis->vis_nodes, settings.occlusion_culling,
-                      m_cache.vis_temp.data());
+  cull_check_all(settings.camera.planes, tree.cull_data, settings.occlusion_culling,
+                 m_cache.vis_temp.data());
 
   u32 total_tris;
   if (render_state->no_multidraw) {
@@ -124,6 +124,7 @@ class TFragment : public BucketRenderer {
     const std::vector<tfrag3::StripDraw>* draws = nullptr;
     const tfrag3::PackedTimeOfDay* colors = nullptr;
     const tfrag3::BVH* vis = nullptr;
+    VisNodeCullData cull_data;
     const u32* index_data = nullptr;
     u64 draw_mode = 0;
 
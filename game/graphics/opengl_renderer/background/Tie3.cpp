@@ -189,6 +189,7 @@ void Tie3::load_from_fr3_data(const LevelData* loader_data) {
       glBindVertexArray(0);
 
       lod_tree[l_tree].vis_temp.resize(tree.bvh.vis_nodes.size());
+      lod_tree[l_tree].cull_data.init(tree.bvh.vis_nodes);
 
       lod_tree[l_tree].draw_idx_temp.resize(tree.static_draws.size());
       lod_tree[l_tree].index_temp.resize(tree.unpacked.indices.size());
@@ -439,8 +440,8 @@ void Tie3::setup_tree(int idx,
 
   if (!m_debug_all_visible) {
     // need culling data
-    cull_check_all_slow(settings.camera.planes, tree.vis->vis_nodes, settings.occlusion_culling,
-                        tree.vis_temp.data());
+    cull_check_all(settings.camera.planes, tree.cull_data, settings.occlusion_culling,
+                   tree.vis_temp.data());
   }
 
   u32 num_tris = 0;
@@ -117,6 +117,7 @@ class Tie3 : public BucketRenderer {
     const std::vector<tfrag3::TieWindInstance>* instance_info = nullptr;
     const tfrag3::PackedTimeOfDay* colors = nullptr;
     const tfrag3::BVH* vis = nullptr;
+    VisNodeCullData cull_data;
     const u32* index_data = nullptr;
     std::vector<std::array<math::Vector4f, 4>> wind_matrix_cache;
     GLuint wind_vertex_index_buffer;
@@ -51,6 +51,21 @@ void interp_time_of_day(const math::Vector<s32, 4> itimes[4],
                         const tfrag3::PackedTimeOfDay& packed_colors,
                         math::Vector<u8, 4>* out);
 
+/*!
+ * Bounding spheres of a tree's vis nodes, split into separate arrays so they can be culled 8 at a
+ * time. Built once, when the level is loaded.
+ */
+struct VisNodeCullData {
+  std::vector<float> x, y, z, neg_r;  // padded to a multiple of 8
+  std::vector<u16> ids;
+  u32 size = 0;
+  void init(const std::vector<tfrag3::VisNode>& nodes);
+};
+
+void cull_check_all(const math::Vector4f* planes,
+                    const VisNodeCullData& nodes,
+                    const u8* level_occlusion_string,
+                    u8* out);
 void cull_check_all_slow(const math::Vector4f* planes,
                          const std::vector<tfrag3::VisNode>& nodes,
                          const u8* level_occlusion_string,
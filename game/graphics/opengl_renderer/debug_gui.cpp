@@ -6,6 +6,7 @@
 #include "game/graphics/display.h"
 #include "game/graphics/gfx.h"
 #include "game/graphics/screenshot.h"
+#include "game/mips2c/mips2c_native.h"
 #include "game/system/hid/sdl_util.h"
 
 #include "fmt/core.h"
@@ -26,7 +27,7 @@ void FrameTimeRecorder::start_frame() {
   m_fps_timer.start();
 }
 
-void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
+void FrameTimeRecorder::draw_window(const DmaStats& dma_stats) {
   auto* p_open = &m_open;
   ImGuiWindowFlags window_flags = ImGuiWindowFlags_NoDecoration |
                                   ImGuiWindowFlags_AlwaysAutoResize |
@@ -46,9 +47,11 @@ void FrameTimeRecorder::draw_window(const DmaStats& /*dma_stats*/) {
 
   ImGui::SetNextWindowBgAlpha(0.85f);  // Transparent background
   if (ImGui::Begin("Frame Timing", p_open, window_flags)) {
-    //    ImGui::Text("DMA: sync ms %.1f, tc %4d, sz %3d KB, ch %d", dma_stats.sync_time_ms,
-    //                dma_stats.num_tags, (dma_stats.num_data_bytes) / (1 << 10),
-    //                dma_stats.num_chunks);
+    if (Gfx::g_global_settings.pipelined_dma) {
+      ImGui::Text("DMA: copy ms %.2f, tc %4d, sz %4d KB, ch %d", dma_stats.sync_time_ms,
+                  dma_stats.num_tags, (dma_stats.num_copied_bytes) / (1 << 10),
+                  dma_stats.num_chunks);
+    }
     float worst = 0, total = 0;
     for (auto x : m_frame_times) {
       worst = std::max(x, worst);
@@ -96,6 +99,34 @@ void OpenGlDebugGui::finish_frame() {
   m_frame_timer.finish_frame();
 }
 
+void OpenGlDebugGui::draw_native_mips2c_menu() {
+  auto& table = Mips2C::gNativeFunctionTable;
+  auto mode = table.mode();
+  if (ImGui::RadioButton("Mips2C", mode == Mips2C::NativeMode::MIPS2C)) {
+    table.set_mode(Mips2C::NativeMode::MIPS2C);
+  }
+  ImGui::SameLine();
+  if (ImGui::RadioButton("Native", mode == Mips2C::NativeMode::NATIVE)) {
+    table.set_mode(Mips2C::NativeMode::NATIVE);
+  }
+  ImGui::SameLine();
+  if (ImGui::RadioButton("Differential", mode == Mips2C::NativeMode::DIFFERENTIAL)) {
+    table.set_mode(Mips2C::NativeMode::DIFFERENTIAL);
+  }
+
+  for (const auto& stats : table.stats()) {
+    ImGui::Text("%s", fmt::format("{}: {} calls, {} mismatches", stats.name, stats.calls,
+                                  stats.mismatches)
+                          .c_str());
+    if (stats.native_ms > 0) {
+      ImGui::Text("%s", fmt::format("  mips2c {:.3f} ms, native {:.3f} ms ({:.1f}x)",
+                                    stats.mips2c_ms, stats.native_ms,
+                                    stats.mips2c_ms / stats.native_ms)
+                            .c_str());
+    }
+  }
+}
+
 void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
   if (ImGui::BeginMainMenuBar()) {
     if (ImGui::BeginMenu("Debugging")) {
@@ -104,6 +135,10 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
       ImGui::MenuItem("Profiler", nullptr, &m_draw_profiler);
       ImGui::MenuItem("Small Profiler", nullptr, &small_profiler);
       ImGui::MenuItem("Loader", nullptr, &m_draw_loader);
+      if (ImGui::BeginMenu("Native Mips2C")) {
+        draw_native_mips2c_menu();
+        ImGui::EndMenu();
+      }
       if (ImGui::MenuItem("Reboot In Debug Mode!")) {
         want_reboot_in_debug = true;
       }
@@ -149,6 +184,7 @@ void OpenGlDebugGui::draw(const DmaStats& dma_stats) {
         ImGui::Separator();
         ImGui::Checkbox("Accurate Lag Mode", &Gfx::g_global_settings.experimental_accurate_lag);
         ImGui::Checkbox("Sleep in Frame Limiter", &Gfx::g_global_settings.sleep_in_frame_limiter);
+        ImGui::Checkbox("Pipelined DMA", &Gfx::g_global_settings.pipelined_dma);
         ImGui::TreePop();
       }
       ImGui::Checkbox("Treat Pad0 as Pad1", &Gfx::g_debug_settings.treat_pad0_as_pad1);
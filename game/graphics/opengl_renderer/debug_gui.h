@@ -72,6 +72,8 @@ class OpenGlDebugGui {
   bool master_enable = false;
 
  private:
+  void draw_native_mips2c_menu();
+
   FrameTimeRecorder m_frame_timer;
   bool m_draw_frame_time = false;
   bool m_draw_profiler = false;
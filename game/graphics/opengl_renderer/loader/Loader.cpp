@@ -1,14 +1,43 @@
 #include "Loader.h"
 
+#include "common/custom_data/fr3_container.h"
 #include "common/global_profiler/GlobalProfiler.h"
+#include "common/log/log.h"
 #include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
 #include "common/util/Timer.h"
-#include "common/util/compress.h"
 
 #include "game/graphics/opengl_renderer/loader/LoaderStages.h"
 
 #include "third-party/imgui/imgui.h"
 
+namespace {
+/*!
+ * Read-only memory mapping of an fr3 file, so sections can be decompressed straight from the page
+ * cache, without reading the compressed file into a buffer first.
+ * If the file can't be mapped, it is read instead.
+ */
+class Fr3FileView {
+ public:
+  explicit Fr3FileView(const fs::path& path) {
+    try {
+      m_map = std::make_unique<MappedFile>(path);
+      m_map->advise_sequential();
+    } catch (std::runtime_error& e) {
+      lg::warn("Failed to map {}, will read it instead: {}", path.string(), e.what());
+      m_fallback = file_util::read_binary_file(path);
+    }
+  }
+
+  const u8* data() const { return m_map ? m_map->span().data() : m_fallback.data(); }
+  size_t size() const { return m_map ? m_map->size() : m_fallback.size(); }
+
+ private:
+  std::unique_ptr<MappedFile> m_map;
+  std::vector<u8> m_fallback;
+};
+}  // namespace
+
 Loader::Loader(const fs::path& base_path, int max_levels)
     : m_base_path(base_path), m_max_levels(max_levels) {
   m_loader_thread = std::thread(&Loader::loader_thread, this);
@@ -182,17 +211,18 @@ void Loader::loader_thread() {
       // simulate slower hard drive (so that the loader thread can lose to the game loads)
       // std::this_thread::sleep_for(std::chrono::milliseconds(1500));
 
-      // load the fr3 file
+      // map the fr3 file
       prof().begin_event("read-file");
       Timer disk_timer;
-      auto data = file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", lev));
+      auto file = std::make_unique<Fr3FileView>(m_base_path / fmt::format("{}.fr3", lev));
       double disk_load_time = disk_timer.getSeconds();
       prof().end_event();
 
-      // the FR3 files are compressed
+      // the FR3 files are compressed. This also reads the file from the mapping.
       prof().begin_event("decompress-file");
       Timer decomp_timer;
-      auto decomp_data = compression::decompress_zstd(data.data(), data.size());
+      auto decomp_data = tfrag3::unpack_fr3(file->data(), file->size());
+      file.reset();
       double decomp_time = decomp_timer.getSeconds();
       prof().end_event();
 
@@ -200,7 +230,7 @@ void Loader::loader_thread() {
       prof().begin_event("deserialize");
       Timer import_timer;
       auto result = std::make_unique<tfrag3::Level>();
-      Serializer ser(decomp_data.data(), decomp_data.size());
+      Serializer ser(std::move(decomp_data));
       result->serialize(ser);
       double import_time = import_timer.getSeconds();
       prof().end_event();
@@ -255,10 +285,8 @@ void Loader::loader_thread() {
  * This should be called during initialization, before any threaded loading goes on.
  */
 const tfrag3::Level& Loader::load_common(TexturePool& tex_pool, const std::string& name) {
-  auto data = file_util::read_binary_file(m_base_path / fmt::format("{}.fr3", name));
-
-  auto decomp_data = compression::decompress_zstd(data.data(), data.size());
-  Serializer ser(decomp_data.data(), decomp_data.size());
+  Fr3FileView file(m_base_path / fmt::format("{}.fr3", name));
+  Serializer ser(tfrag3::unpack_fr3(file.data(), file.size()));
   m_common_level.level = std::make_unique<tfrag3::Level>();
   m_common_level.level->serialize(ser);
   for (auto& tex : m_common_level.level->textures) {
@@ -2,6 +2,8 @@
 
 #include "common/log/log.h"
 
+#include "third-party/imgui/imgui.h"
+
 static bool is_end_tag(const DmaTag& tag, const VifCode& v0, const VifCode& v1) {
   return tag.qwc == 2 && tag.kind == DmaTag::Kind::CNT && v0.kind == VifCode::Kind::NOP &&
          v1.kind == VifCode::Kind::DIRECT;
@@ -14,6 +16,10 @@ OceanMid::OceanMid() {
   vu.vf25 = Vf(1, 1, 1, 1);
 }
 
+void OceanMid::draw_debug_window() {
+  ImGui::Checkbox("Batch vertex loop", &m_use_vertex_batch);
+}
+
 void OceanMid::run(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof) {
   m_common_ocean_renderer.init_for_mid();
   // first is setting base and offset
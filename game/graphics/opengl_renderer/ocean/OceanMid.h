@@ -10,8 +10,11 @@ class OceanMid {
   OceanMid();
   void run(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof);
   void run_jak2(DmaFollower& dma, SharedRenderState* render_state, ScopedProfilerNode& prof);
+  void draw_debug_window();
 
  private:
+  friend class OceanMidTest;
+
   void run_call0();
   void run_call0_vu2c();
   void run_call41_vu2c();
@@ -20,6 +23,9 @@ class OceanMid {
   void run_call73_vu2c();
   void run_call73_vu2c_jak2();
   void run_call107_vu2c();
+  void run_call107_vertex_batch(bool jak2);
+  void run_L17_vu2c();
+  void run_L17_vu2c_jak2();
   void run_call107_vu2c_jak2();
   void run_call275_vu2c();
   void run_call275_vu2c_jak2();
@@ -35,6 +41,7 @@ class OceanMid {
 
   CommonOceanRenderer m_common_ocean_renderer;
   bool m_buffer_toggle = false;
+  bool m_use_vertex_batch = true;
   static constexpr int VU1_INPUT_BUFFER_BASE = 0;
   static constexpr int VU1_INPUT_BUFFER_OFFSET = 0x76;
 
@@ -8,6 +8,7 @@ OceanMidAndFar::OceanMidAndFar(const std::string& name, int my_id)
 void OceanMidAndFar::draw_debug_window() {
   m_texture_renderer.draw_debug_window();
   m_direct.draw_debug_window();
+  m_mid_renderer.draw_debug_window();
 }
 
 void OceanMidAndFar::init_textures(TexturePool& pool, GameVersion version) {
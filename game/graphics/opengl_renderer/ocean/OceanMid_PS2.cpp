@@ -1,5 +1,8 @@
 #include "OceanMid.h"
 
+#include "game/common/vu_batch.h"
+#include "game/graphics/opengl_renderer/ocean/ocean_vu_batch.h"
+
 namespace {
 u32 clip(const Vf& vector, float val, u32 old_clip) {
   u32 result = (old_clip << 6);
@@ -491,32 +494,30 @@ L15:
   return;
 }
 
-void OceanMid::run_call107_vu2c() {
+/*!
+ * The vertex loop in call107 (L17) transforms each vertex independently. Run all but the last
+ * iteration in batches, then let the normal loop run the rest, so the registers end up the same.
+ */
+void OceanMid::run_call107_vertex_batch(bool jak2) {
+  int iterations = std::max(1, (int)(s16)vu.vi05);
+  int batched = ((iterations - 1) / kVuBatchWidth) * kVuBatchWidth;
+  if (batched == 0) {
+    return;
+  }
+  const Vf vf08_to_vf15[8] = {vu.vf08, vu.vf09, vu.vf10, vu.vf11,
+                              vu.vf12, vu.vf13, vu.vf14, vu.vf15};
+  ocean_mid_call107_vertex_batch(m_vu_data, vu.vi02, vu.vi03, vu.vi04, batched, vu.vf01, vu.vf05,
+                                 vu.vf06, vf08_to_vf15, jak2);
+  vu.vi03 += batched;
+  vu.vi04 += 4 * batched;
+  vu.vi05 -= batched;
+}
+
+void OceanMid::run_L17_vu2c() {
   bool bc;
-  // xtop vi02                  |  nop                            107
-  vu.vi02 = xtop();
-  // xtop vi03                  |  nop                            108
-  vu.vi03 = vu.vi02;  // xtop();
-  // ior vi04, vi00, vi00       |  nop                            109
-  vu.vi04 = 0;
-  // ilw.x vi05, 8(vi02)        |  nop                            110
-  ilw_buffer(Mask::x, vu.vi05, vu.vi02 + 8);
-  // lq.xyzw vf08, 0(vi02)      |  nop                            111
-  lq_buffer(Mask::xyzw, vu.vf08, vu.vi02);
-  // lq.xyzw vf09, 1(vi02)      |  nop                            112
-  lq_buffer(Mask::xyzw, vu.vf09, vu.vi02 + 1);
-  // lq.xyzw vf10, 2(vi02)      |  nop                            113
-  lq_buffer(Mask::xyzw, vu.vf10, vu.vi02 + 2);
-  // lq.xyzw vf11, 3(vi02)      |  nop                            114
-  lq_buffer(Mask::xyzw, vu.vf11, vu.vi02 + 3);
-  // lq.xyzw vf12, 4(vi02)      |  nop                            115
-  lq_buffer(Mask::xyzw, vu.vf12, vu.vi02 + 4);
-  // lq.xyzw vf13, 5(vi02)      |  nop                            116
-  lq_buffer(Mask::xyzw, vu.vf13, vu.vi02 + 5);
-  // lq.xyzw vf14, 6(vi02)      |  nop                            117
-  lq_buffer(Mask::xyzw, vu.vf14, vu.vi02 + 6);
-  // lq.xyzw vf15, 7(vi02)      |  nop                            118
-  lq_buffer(Mask::xyzw, vu.vf15, vu.vi02 + 7);
+  if (m_use_vertex_batch) {
+    run_call107_vertex_batch(false);
+  }
 L17:
   // lq.xyzw vf16, 17(vi03)     |  nop                            119
   lq_buffer(Mask::xyzw, vu.vf16, vu.vi03 + 17);
@@ -602,6 +603,127 @@ L17:
   if (bc) {
     goto L17;
   }
+}
+
+void OceanMid::run_L17_vu2c_jak2() {
+  bool bc;
+  if (m_use_vertex_batch) {
+    run_call107_vertex_batch(true);
+  }
+L17:
+  // lq.xyzw vf16, 17(vi03)     |  nop                            119
+  lq_buffer(Mask::xyzw, vu.vf16, vu.vi03 + 17);
+  // lq.xyzw vf28, 765(vi00)    |  nop                            120
+  lq_buffer(Mask::xyzw, vu.vf28, 765);
+  // lq.xyzw vf29, 766(vi00)    |  nop                            121
+  lq_buffer(Mask::xyzw, vu.vf29, 766);
+  // lq.xyzw vf30, 767(vi00)    |  nop                            122
+  lq_buffer(Mask::xyzw, vu.vf30, 767);
+  // lq.xyzw vf31, 768(vi00)    |  nop                            123
+  lq_buffer(Mask::xyzw, vu.vf31, 768);
+  // lq.xyzw vf24, 9(vi02)      |  mulax.xyzw ACC, vf28, vf16     124
+  vu.acc.mula(Mask::xyzw, vu.vf28, vu.vf16.x());
+  lq_buffer(Mask::xyzw, vu.vf24, vu.vi02 + 9);
+  // lq.xyzw vf25, 10(vi02)     |  madday.xyzw ACC, vf29, vf16    125
+  vu.acc.madda(Mask::xyzw, vu.vf29, vu.vf16.y());
+  lq_buffer(Mask::xyzw, vu.vf25, vu.vi02 + 10);
+  // lq.xyzw vf26, 11(vi02)     |  maddaz.xyzw ACC, vf30, vf16    126
+  vu.acc.madda(Mask::xyzw, vu.vf30, vu.vf16.z());
+  lq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 11);
+  // lq.xyzw vf27, 12(vi02)     |  maddw.xyzw vf28, vf31, vf16    127
+  vu.acc.madd(Mask::xyzw, vu.vf28, vu.vf31, vu.vf16.w());
+  lq_buffer(Mask::xyzw, vu.vf27, vu.vi02 + 12);
+  // lq.xyzw vf22, 13(vi02)     |  mulax.xyzw ACC, vf24, vf16     128
+  vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf16.x());
+  lq_buffer(Mask::xyzw, vu.vf22, vu.vi02 + 13);
+  // lq.xyzw vf23, 14(vi02)     |  madday.xyzw ACC, vf25, vf16    129
+  vu.acc.madda(Mask::xyzw, vu.vf25, vu.vf16.y());
+  lq_buffer(Mask::xyzw, vu.vf23, vu.vi02 + 14);
+  // lq.xyzw vf18, 15(vi02)     |  maddaz.xyzw ACC, vf26, vf16    130
+  vu.acc.madda(Mask::xyzw, vu.vf26, vu.vf16.z());
+  lq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 15);
+  // lq.xyzw vf19, 16(vi02)     |  maddw.xyzw vf20, vf27, vf16    131
+  vu.acc.madd(Mask::xyzw, vu.vf20, vu.vf27, vu.vf16.w());
+  lq_buffer(Mask::xyzw, vu.vf19, vu.vi02 + 16);
+  // iaddi vi05, vi05, -0x1     |  mulax.xyzw ACC, vf08, vf28     132
+  vu.acc.mula(Mask::xyzw, vu.vf08, vu.vf28.x());
+  vu.vi05 = vu.vi05 + -1;
+  // nop                        |  madday.xyzw ACC, vf09, vf28    133
+  vu.acc.madda(Mask::xyzw, vu.vf09, vu.vf28.y());
+  // nop                        |  maddaz.xyzw ACC, vf10, vf28    134
+  vu.acc.madda(Mask::xyzw, vu.vf10, vu.vf28.z());
+  // nop                        |  maddw.xyzw vf24, vf11, vf00    135
+  vu.acc.madd(Mask::xyzw, vu.vf24, vu.vf11, vu.vf00.w());
+  // nop                        |  mulax.xyzw ACC, vf12, vf28     136
+  vu.acc.mula(Mask::xyzw, vu.vf12, vu.vf28.x());
+  // nop                        |  madday.xyzw ACC, vf13, vf28    137
+  vu.acc.madda(Mask::xyzw, vu.vf13, vu.vf28.y());
+  // nop                        |  maddaz.xyzw ACC, vf14, vf28    138
+  vu.acc.madda(Mask::xyzw, vu.vf14, vu.vf28.z());
+  // erleng.xyz P, vf24         |  maddw.xyzw vf28, vf15, vf00    139
+  vu.acc.madd(Mask::xyzw, vu.vf28, vu.vf15, vu.vf00.w());
+  vu.P = erleng(vu.vf24);
+  // waitp                      |  nop                            140
+
+  // nop                        |  mul.xyzw vf28, vf28, vf01      141
+  vu.vf28.mul(Mask::xyzw, vu.vf28, vu.vf01);
+  // mfp.w vf24, P              |  mulax.xyzw ACC, vf22, vf16     142
+  vu.acc.mula(Mask::xyzw, vu.vf22, vu.vf16.x());
+  vu.vf24.mfp(Mask::w, vu.P);
+  // iaddi vi03, vi03, 0x1      |  madday.xyzw ACC, vf23, vf16    143
+  vu.acc.madda(Mask::xyzw, vu.vf23, vu.vf16.y());
+  vu.vi03 = vu.vi03 + 1;
+  // nop                        |  maddaz.xyzw ACC, vf18, vf16    144
+  vu.acc.madda(Mask::xyzw, vu.vf18, vu.vf16.z());
+  // sq.xyzw vf20, 791(vi04)    |  maddw.xyzw vf22, vf19, vf16    145
+  vu.acc.madd(Mask::xyzw, vu.vf22, vu.vf19, vu.vf16.w());
+  sq_buffer(Mask::xyzw, vu.vf20, vu.vi04 + 791);
+  // sq.xyzw vf28, 793(vi04)    |  mulw.xy vf24, vf24, vf24       146
+  vu.vf24.mul(Mask::xy, vu.vf24, vu.vf24.w());
+  sq_buffer(Mask::xyzw, vu.vf28, vu.vi04 + 793);
+  // sq.xyzw vf22, 792(vi04)    |  mula.xyzw ACC, vf24, vf05      147
+  vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf05);
+  sq_buffer(Mask::xyzw, vu.vf22, vu.vi04 + 792);
+  // iaddi vi04, vi04, 0x4      |  maddw.xyzw vf24, vf06, vf00    148
+  vu.acc.madd(Mask::xyzw, vu.vf24, vu.vf06, vu.vf00.w());
+  vu.vi04 = vu.vi04 + 4;
+  // BRANCH!
+  // ibgtz vi05, L17            |  nop                            149
+  bc = ((s16)vu.vi05) > 0;
+  // sq.xyzw vf24, 790(vi04)    |  nop                            150
+  sq_buffer(Mask::xyzw, vu.vf24, vu.vi04 + 790);
+  if (bc) {
+    goto L17;
+  }
+}
+
+void OceanMid::run_call107_vu2c() {
+  bool bc;
+  // xtop vi02                  |  nop                            107
+  vu.vi02 = xtop();
+  // xtop vi03                  |  nop                            108
+  vu.vi03 = vu.vi02;  // xtop();
+  // ior vi04, vi00, vi00       |  nop                            109
+  vu.vi04 = 0;
+  // ilw.x vi05, 8(vi02)        |  nop                            110
+  ilw_buffer(Mask::x, vu.vi05, vu.vi02 + 8);
+  // lq.xyzw vf08, 0(vi02)      |  nop                            111
+  lq_buffer(Mask::xyzw, vu.vf08, vu.vi02);
+  // lq.xyzw vf09, 1(vi02)      |  nop                            112
+  lq_buffer(Mask::xyzw, vu.vf09, vu.vi02 + 1);
+  // lq.xyzw vf10, 2(vi02)      |  nop                            113
+  lq_buffer(Mask::xyzw, vu.vf10, vu.vi02 + 2);
+  // lq.xyzw vf11, 3(vi02)      |  nop                            114
+  lq_buffer(Mask::xyzw, vu.vf11, vu.vi02 + 3);
+  // lq.xyzw vf12, 4(vi02)      |  nop                            115
+  lq_buffer(Mask::xyzw, vu.vf12, vu.vi02 + 4);
+  // lq.xyzw vf13, 5(vi02)      |  nop                            116
+  lq_buffer(Mask::xyzw, vu.vf13, vu.vi02 + 5);
+  // lq.xyzw vf14, 6(vi02)      |  nop                            117
+  lq_buffer(Mask::xyzw, vu.vf14, vu.vi02 + 6);
+  // lq.xyzw vf15, 7(vi02)      |  nop                            118
+  lq_buffer(Mask::xyzw, vu.vf15, vu.vi02 + 7);
+  run_L17_vu2c();
 
   // ior vi14, vi00, vi00       |  nop                            151
   vu.vi14 = 0;
@@ -930,91 +1052,7 @@ void OceanMid::run_call107_vu2c_jak2() {
   lq_buffer(Mask::xyzw, vu.vf14, vu.vi02 + 6);
   // lq.xyzw vf15, 7(vi02)      |  nop                            118
   lq_buffer(Mask::xyzw, vu.vf15, vu.vi02 + 7);
-L17:
-  // lq.xyzw vf16, 17(vi03)     |  nop                            119
-  lq_buffer(Mask::xyzw, vu.vf16, vu.vi03 + 17);
-  // lq.xyzw vf28, 765(vi00)    |  nop                            120
-  lq_buffer(Mask::xyzw, vu.vf28, 765);
-  // lq.xyzw vf29, 766(vi00)    |  nop                            121
-  lq_buffer(Mask::xyzw, vu.vf29, 766);
-  // lq.xyzw vf30, 767(vi00)    |  nop                            122
-  lq_buffer(Mask::xyzw, vu.vf30, 767);
-  // lq.xyzw vf31, 768(vi00)    |  nop                            123
-  lq_buffer(Mask::xyzw, vu.vf31, 768);
-  // lq.xyzw vf24, 9(vi02)      |  mulax.xyzw ACC, vf28, vf16     124
-  vu.acc.mula(Mask::xyzw, vu.vf28, vu.vf16.x());
-  lq_buffer(Mask::xyzw, vu.vf24, vu.vi02 + 9);
-  // lq.xyzw vf25, 10(vi02)     |  madday.xyzw ACC, vf29, vf16    125
-  vu.acc.madda(Mask::xyzw, vu.vf29, vu.vf16.y());
-  lq_buffer(Mask::xyzw, vu.vf25, vu.vi02 + 10);
-  // lq.xyzw vf26, 11(vi02)     |  maddaz.xyzw ACC, vf30, vf16    126
-  vu.acc.madda(Mask::xyzw, vu.vf30, vu.vf16.z());
-  lq_buffer(Mask::xyzw, vu.vf26, vu.vi02 + 11);
-  // lq.xyzw vf27, 12(vi02)     |  maddw.xyzw vf28, vf31, vf16    127
-  vu.acc.madd(Mask::xyzw, vu.vf28, vu.vf31, vu.vf16.w());
-  lq_buffer(Mask::xyzw, vu.vf27, vu.vi02 + 12);
-  // lq.xyzw vf22, 13(vi02)     |  mulax.xyzw ACC, vf24, vf16     128
-  vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf16.x());
-  lq_buffer(Mask::xyzw, vu.vf22, vu.vi02 + 13);
-  // lq.xyzw vf23, 14(vi02)     |  madday.xyzw ACC, vf25, vf16    129
-  vu.acc.madda(Mask::xyzw, vu.vf25, vu.vf16.y());
-  lq_buffer(Mask::xyzw, vu.vf23, vu.vi02 + 14);
-  // lq.xyzw vf18, 15(vi02)     |  maddaz.xyzw ACC, vf26, vf16    130
-  vu.acc.madda(Mask::xyzw, vu.vf26, vu.vf16.z());
-  lq_buffer(Mask::xyzw, vu.vf18, vu.vi02 + 15);
-  // lq.xyzw vf19, 16(vi02)     |  maddw.xyzw vf20, vf27, vf16    131
-  vu.acc.madd(Mask::xyzw, vu.vf20, vu.vf27, vu.vf16.w());
-  lq_buffer(Mask::xyzw, vu.vf19, vu.vi02 + 16);
-  // iaddi vi05, vi05, -0x1     |  mulax.xyzw ACC, vf08, vf28     132
-  vu.acc.mula(Mask::xyzw, vu.vf08, vu.vf28.x());
-  vu.vi05 = vu.vi05 + -1;
-  // nop                        |  madday.xyzw ACC, vf09, vf28    133
-  vu.acc.madda(Mask::xyzw, vu.vf09, vu.vf28.y());
-  // nop                        |  maddaz.xyzw ACC, vf10, vf28    134
-  vu.acc.madda(Mask::xyzw, vu.vf10, vu.vf28.z());
-  // nop                        |  maddw.xyzw vf24, vf11, vf00    135
-  vu.acc.madd(Mask::xyzw, vu.vf24, vu.vf11, vu.vf00.w());
-  // nop                        |  mulax.xyzw ACC, vf12, vf28     136
-  vu.acc.mula(Mask::xyzw, vu.vf12, vu.vf28.x());
-  // nop                        |  madday.xyzw ACC, vf13, vf28    137
-  vu.acc.madda(Mask::xyzw, vu.vf13, vu.vf28.y());
-  // nop                        |  maddaz.xyzw ACC, vf14, vf28    138
-  vu.acc.madda(Mask::xyzw, vu.vf14, vu.vf28.z());
-  // erleng.xyz P, vf24         |  maddw.xyzw vf28, vf15, vf00    139
-  vu.acc.madd(Mask::xyzw, vu.vf28, vu.vf15, vu.vf00.w());
-  vu.P = erleng(vu.vf24);
-  // waitp                      |  nop                            140
-
-  // nop                        |  mul.xyzw vf28, vf28, vf01      141
-  vu.vf28.mul(Mask::xyzw, vu.vf28, vu.vf01);
-  // mfp.w vf24, P              |  mulax.xyzw ACC, vf22, vf16     142
-  vu.acc.mula(Mask::xyzw, vu.vf22, vu.vf16.x());
-  vu.vf24.mfp(Mask::w, vu.P);
-  // iaddi vi03, vi03, 0x1      |  madday.xyzw ACC, vf23, vf16    143
-  vu.acc.madda(Mask::xyzw, vu.vf23, vu.vf16.y());
-  vu.vi03 = vu.vi03 + 1;
-  // nop                        |  maddaz.xyzw ACC, vf18, vf16    144
-  vu.acc.madda(Mask::xyzw, vu.vf18, vu.vf16.z());
-  // sq.xyzw vf20, 791(vi04)    |  maddw.xyzw vf22, vf19, vf16    145
-  vu.acc.madd(Mask::xyzw, vu.vf22, vu.vf19, vu.vf16.w());
-  sq_buffer(Mask::xyzw, vu.vf20, vu.vi04 + 791);
-  // sq.xyzw vf28, 793(vi04)    |  mulw.xy vf24, vf24, vf24       146
-  vu.vf24.mul(Mask::xy, vu.vf24, vu.vf24.w());
-  sq_buffer(Mask::xyzw, vu.vf28, vu.vi04 + 793);
-  // sq.xyzw vf22, 792(vi04)    |  mula.xyzw ACC, vf24, vf05      147
-  vu.acc.mula(Mask::xyzw, vu.vf24, vu.vf05);
-  sq_buffer(Mask::xyzw, vu.vf22, vu.vi04 + 792);
-  // iaddi vi04, vi04, 0x4      |  maddw.xyzw vf24, vf06, vf00    148
-  vu.acc.madd(Mask::xyzw, vu.vf24, vu.vf06, vu.vf00.w());
-  vu.vi04 = vu.vi04 + 4;
-  // BRANCH!
-  // ibgtz vi05, L17            |  nop                            149
-  bc = ((s16)vu.vi05) > 0;
-  // sq.xyzw vf24, 790(vi04)    |  nop                            150
-  sq_buffer(Mask::xyzw, vu.vf24, vu.vi04 + 790);
-  if (bc) {
-    goto L17;
-  }
+  run_L17_vu2c_jak2();
 
   // ior vi14, vi00, vi00       |  nop                            151
   vu.vi14 = 0;
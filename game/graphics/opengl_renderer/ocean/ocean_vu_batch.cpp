@@ -0,0 +1,81 @@
+#include "ocean_vu_batch.h"
+
+#include "game/common/vu_batch.h"
+
+void ocean_mid_call107_vertex_batch(Vf* vu_data,
+                                    u16 vi02,
+                                    u16 vi03,
+                                    u16 vi04,
+                                    int count,
+                                    const Vf& vf01,
+                                    const Vf& vf05,
+                                    const Vf& vf06,
+                                    const Vf* vf08_to_vf15,
+                                    bool jak2) {
+  ASSERT(count % kVuBatchWidth == 0);
+  ASSERT(vi03 + 17 + count <= 1024);
+  ASSERT(vi04 + 791 + 4 * count <= 1024);
+
+  // registers that are the same for every vertex.
+  VfBatch m28[4], m24[4], m22[4], m08[4], m12[4];
+  for (int i = 0; i < 4; i++) {
+    m28[i] = VfBatch::splat(vu_data[765 + i]);
+    m24[i] = VfBatch::splat(vu_data[vi02 + 9 + i]);
+    m08[i] = VfBatch::splat(vf08_to_vf15[i]);
+    m12[i] = VfBatch::splat(vf08_to_vf15[4 + i]);
+  }
+  // vf22, vf23, vf18, vf19
+  for (int i = 0; i < 4; i++) {
+    m22[i] = VfBatch::splat(vu_data[vi02 + 13 + i]);
+  }
+  const VfBatch b01 = VfBatch::splat(vf01);
+  const VfBatch b05 = VfBatch::splat(vf05);
+  const VfBatch b06 = VfBatch::splat(vf06);
+  const VuLanes one = lanes_splat(1.f);
+  const VuLanes zero = lanes_splat(0.f);
+
+  for (int i = 0; i < count; i += kVuBatchWidth) {
+    AccBatch acc;
+    // lq.xyzw vf16, 17(vi03)
+    VfBatch vf16 = VfBatch::load(vu_data + vi03 + 17 + i);
+    // vf28 = [vf28, vf29, vf30, vf31] * vf16
+    VfBatch vf28 = acc.transform(m28, vf16);
+    // vf20 = [vf24, vf25, vf26, vf27] * vf16
+    VfBatch vf20 = acc.transform(m24, vf16);
+    // vf24 = [vf08, vf09, vf10, vf11] * vf28.xyz1
+    acc.mula(m08[0], vf28.x);
+    acc.madda(m08[1], vf28.y);
+    acc.madda(m08[2], vf28.z);
+    VfBatch vf24 = acc.madd(m08[3], one);
+    // vf28 = [vf12, vf13, vf14, vf15] * vf28.xyz1
+    acc.mula(m12[0], vf28.x);
+    acc.madda(m12[1], vf28.y);
+    acc.madda(m12[2], vf28.z);
+    vf28 = acc.madd(m12[3], one);
+    // erleng.xyz P, vf24
+    VuLanes P = erleng_batch(vf24);
+    if (!jak2) {
+      // addz.y vf24, vf00, vf24
+      vf24.y = lanes_add(zero, vf24.z);
+    }
+    // mul.xyzw vf28, vf28, vf01
+    vf28 = vf28.mul(b01);
+    // mfp.w vf24, P
+    vf24.w = P;
+    // vf22 = [vf22, vf23, vf18, vf19] * vf16
+    VfBatch vf22 = acc.transform(m22, vf16);
+    // mulw.xy vf24, vf24, vf24
+    vf24.x = lanes_mul(vf24.x, vf24.w);
+    vf24.y = lanes_mul(vf24.y, vf24.w);
+    // mula.xyzw ACC, vf24, vf05
+    acc.mula(vf24, b05);
+    // maddw.xyzw vf24, vf06, vf00
+    vf24 = acc.madd(b06, one);
+
+    Vf* out = vu_data + vi04 + 4 * i;
+    vf20.store(out + 791, 4);
+    vf22.store(out + 792, 4);
+    vf28.store(out + 793, 4);
+    vf24.store(out + 794, 4);
+  }
+}
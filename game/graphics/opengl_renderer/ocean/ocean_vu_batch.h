@@ -0,0 +1,19 @@
+#pragma once
+
+#include "game/common/vu.h"
+
+/*!
+ * Batched version of the vertex loop at L17 in the call107 program of the ocean-mid renderer.
+ * Runs count iterations, which must be a multiple of kVuBatchWidth, starting at the given values of
+ * vi03 and vi04. The vf registers are the values they have in the loop.
+ */
+void ocean_mid_call107_vertex_batch(Vf* vu_data,
+                                    u16 vi02,
+                                    u16 vi03,
+                                    u16 vi04,
+                                    int count,
+                                    const Vf& vf01,
+                                    const Vf& vf05,
+                                    const Vf& vf06,
+                                    const Vf* vf08_to_vf15,
+                                    bool jak2);
@@ -61,6 +61,16 @@ struct GraphicsData {
   bool has_data_to_render = false;
   FixedChunkDmaCopier dma_copier;
 
+  // pipelined mode: the chain is copied into one of these snapshots, so the game can start on the
+  // next frame as soon as the renderer has taken the copy. The renderer owns
+  // dma_snapshots[render_snapshot_idx], the game thread copies into the other one.
+  DmaData dma_snapshots[2];
+  int render_snapshot_idx = 0;
+  // if the pending chain (has_data_to_render) is a snapshot, or points into EE memory.
+  bool pending_is_snapshot = false;
+  // stats of the last chain taken by the renderer, for the debug gui.
+  DmaStats last_dma_stats;
+
   // texture pool
   std::shared_ptr<TexturePool> texture_pool;
 
@@ -367,12 +377,27 @@ void render_game_frame(int game_width,
                        bool take_screenshot) {
   // wait for a copied chain.
   bool got_chain = false;
+  bool chain_is_snapshot = false;
   {
     auto p = scoped_prof("wait-for-dma");
     std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
     // there's a timeout here, so imgui can still be responsive even if we don't render anything
     got_chain = g_gfx_data->dma_cv.wait_for(lock, std::chrono::milliseconds(40),
                                             [=] { return g_gfx_data->has_data_to_render; });
+    if (got_chain && g_gfx_data->pending_is_snapshot) {
+      // take the snapshot. The game no longer needs to wait for us, and can copy the next frame's
+      // chain into the other buffer while we render this one.
+      chain_is_snapshot = true;
+      g_gfx_data->render_snapshot_idx ^= 1;
+      g_gfx_data->last_dma_stats =
+          g_gfx_data->dma_snapshots[g_gfx_data->render_snapshot_idx].stats;
+      g_gfx_data->engine_timer.start();
+      g_gfx_data->has_data_to_render = false;
+    }
+  }
+  if (chain_is_snapshot) {
+    std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
+    g_gfx_data->sync_cv.notify_all();
   }
   // render that chain.
   if (got_chain) {
@@ -426,7 +451,11 @@ void render_game_frame(int game_width,
       options.msaa_samples = msaa_max;
     }
 
-    if constexpr (run_dma_copy) {
+    if (chain_is_snapshot) {
+      auto p = scoped_prof("ogl-render");
+      auto& chain = g_gfx_data->dma_snapshots[g_gfx_data->render_snapshot_idx];
+      g_gfx_data->ogl_renderer.render(DmaFollower(chain.data.data(), chain.start_offset), options);
+    } else if constexpr (run_dma_copy) {
       auto& chain = g_gfx_data->dma_copier.get_last_result();
       g_gfx_data->ogl_renderer.render(DmaFollower(chain.data.data(), chain.start_offset), options);
     } else {
@@ -437,13 +466,16 @@ void render_game_frame(int game_width,
     }
   }
 
-  // before vsync, mark the chain as rendered.
-  {
+  // before vsync, mark the chain as rendered. (a snapshot was already released when we took it)
+  if (!chain_is_snapshot) {
     // should be fine to remove this mutex if the game actually waits for vsync to call
     // send_chain again. but let's be safe for now.
     std::unique_lock<std::mutex> lock(g_gfx_data->dma_mutex);
     g_gfx_data->engine_timer.start();
-    g_gfx_data->has_data_to_render = false;
+    // if we timed out, a snapshot may have arrived in the meantime. Leave it for the next frame.
+    if (!g_gfx_data->pending_is_snapshot) {
+      g_gfx_data->has_data_to_render = false;
+    }
     g_gfx_data->sync_cv.notify_all();
   }
 }
@@ -548,7 +580,7 @@ void GLDisplay::render() {
   // render debug
   if (is_imgui_visible()) {
     auto p = scoped_prof("debug-gui");
-    g_gfx_data->debug_gui.draw(g_gfx_data->dma_copier.get_last_result().stats);
+    g_gfx_data->debug_gui.draw(g_gfx_data->last_dma_stats);
   }
   {
     auto p = scoped_prof("imgui-render");
@@ -623,6 +655,16 @@ u32 gl_vsync() {
     return 0;
   }
   std::unique_lock<std::mutex> lock(g_gfx_data->sync_mutex);
+  if (Gfx::g_global_settings.pipelined_dma) {
+    // the renderer draws from its own copy of the DMA chain, so the game is allowed to run one
+    // frame ahead. sync_path already waited for the renderer to take the last chain, which paces
+    // us. Some renderers still read EE memory directly and may see the next frame's data, which is
+    // why this mode is experimental.
+    g_gfx_data->sync_cv.wait(lock, [=] {
+      return (MasterExit != RuntimeExitStatus::RUNNING) || !g_gfx_data->has_data_to_render;
+    });
+    return g_gfx_data->frame_idx & 1;
+  }
   auto init_frame = g_gfx_data->frame_idx_of_input_data;
   g_gfx_data->sync_cv.wait(lock, [=] {
     return (MasterExit != RuntimeExitStatus::RUNNING) || g_gfx_data->frame_idx > init_frame;
@@ -639,7 +681,11 @@ u32 gl_sync_path() {
   if (!g_gfx_data->has_data_to_render) {
     return 0;
   }
-  g_gfx_data->sync_cv.wait(lock, [=] { return !g_gfx_data->has_data_to_render; });
+  // in pipelined mode, has_data_to_render is cleared once the renderer has taken the snapshot,
+  // instead of once it is done rendering.
+  g_gfx_data->sync_cv.wait(lock, [=] {
+    return (MasterExit != RuntimeExitStatus::RUNNING) || !g_gfx_data->has_data_to_render;
+  });
   return 0;
 }
 
@@ -670,7 +716,22 @@ void gl_send_chain(const void* data, u32 offset) {
     // The renderers should just operate on DMA chains, so eliminating this step in the future
     // may be easy.
 
-    g_gfx_data->dma_copier.set_input_data(data, offset, run_dma_copy);
+    // In pipelined mode, the copy is done unconditionally, into the snapshot the renderer isn't
+    // using. This lets the game run the next frame while the renderer draws this one.
+    // The renderer only takes a snapshot while holding dma_mutex, and won't look at the back
+    // buffer until we set has_data_to_render, so it's safe to hold the lock during the copy.
+    if (Gfx::g_global_settings.pipelined_dma) {
+      auto p = scoped_prof("dma-copy");
+      auto& snapshot = g_gfx_data->dma_snapshots[g_gfx_data->render_snapshot_idx ^ 1];
+      g_gfx_data->dma_copier.run(data, offset, &snapshot);
+      g_gfx_data->pending_is_snapshot = true;
+    } else {
+      g_gfx_data->dma_copier.set_input_data(data, offset, run_dma_copy);
+      g_gfx_data->pending_is_snapshot = false;
+      if constexpr (run_dma_copy) {
+        g_gfx_data->last_dma_stats = g_gfx_data->dma_copier.get_last_result().stats;
+      }
+    }
 
     g_gfx_data->has_data_to_render = true;
     g_gfx_data->dma_cv.notify_all();
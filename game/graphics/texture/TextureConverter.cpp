@@ -1,15 +1,259 @@
 #include "TextureConverter.h"
 
+#include <algorithm>
+#include <cstring>
+
+#ifdef __aarch64__
+#include "third-party/sse2neon/sse2neon.h"
+#else
+#include <immintrin.h>
+#endif
+
 #include "common/texture/texture_conversion.h"
 #include "common/util/Assert.h"
 #include "common/util/FileUtil.h"
 
 #include "fmt/core.h"
+#include "third-party/BS_thread_pool.hpp"
+
+namespace {
+
+/*!
+ * The GS stores each row of a block inside a single 64-byte column, in a scrambled order.
+ * These tables let us unswizzle a whole row of a block with four 16-byte loads and byte shuffles,
+ * instead of computing the full address of every pixel.
+ */
+struct RowShuffle {
+  u32 column_offset = 0;  // bytes from the start of the block to the column holding this row
+  u8 masks[2][4][16];     // [output vector][input vector] shuffle masks, 0x80 to zero the lane
+  u8 high_nibble[2][16];  // PSMT4 only, 0xff if the pixel is the high nibble of its byte
+};
+
+struct SwizzleTables {
+  RowShuffle psmt8[16];   // blocks are 16x16, 1 output vector per row
+  RowShuffle psmt4[16];   // blocks are 32x16, 2 output vectors per row
+  RowShuffle psmct16[8];  // blocks are 16x8, 2 output vectors per row
+  u8 expand_5_to_8[32];   // matches rgba16_to_rgba32
+};
+
+void clear_masks(RowShuffle* row) {
+  memset(row->masks, 0x80, sizeof(row->masks));
+  memset(row->high_nibble, 0, sizeof(row->high_nibble));
+}
+
+void set_mask(RowShuffle* row, u32 out_byte, u32 in_byte) {
+  ASSERT(in_byte < 64);
+  row->masks[out_byte / 16][in_byte / 16][out_byte % 16] = in_byte % 16;
+}
+
+SwizzleTables build_swizzle_tables() {
+  SwizzleTables tables;
+  // the first block of a page starts at address 0, so the address functions with a small x, y
+  // give us the position within the block.
+  for (u32 y = 0; y < 16; y++) {
+    auto& row = tables.psmt8[y];
+    clear_masks(&row);
+    row.column_offset = (y / 4) * 64;
+    for (u32 x = 0; x < 16; x++) {
+      set_mask(&row, x, psmt8_addr(x, y, 128) - row.column_offset);
+    }
+  }
+
+  for (u32 y = 0; y < 16; y++) {
+    auto& row = tables.psmt4[y];
+    clear_masks(&row);
+    row.column_offset = (y / 4) * 64;
+    for (u32 x = 0; x < 32; x++) {
+      u32 addr4 = psmt4_addr_half_byte(x, y, 128);
+      set_mask(&row, x, addr4 / 2 - row.column_offset);
+      row.high_nibble[x / 16][x % 16] = (addr4 & 1) ? 0xff : 0;
+    }
+  }
+
+  for (u32 y = 0; y < 8; y++) {
+    auto& row = tables.psmct16[y];
+    clear_masks(&row);
+    row.column_offset = (y / 2) * 64;
+    for (u32 x = 0; x < 16; x++) {
+      u32 addr = psmct16_addr(x, y, 64) - row.column_offset;
+      set_mask(&row, 2 * x, addr);
+      set_mask(&row, 2 * x + 1, addr + 1);
+    }
+  }
+
+  for (u32 i = 0; i < 32; i++) {
+    tables.expand_5_to_8[i] = rgba16_to_rgba32(i) & 0xff;
+  }
+  return tables;
+}
+
+const SwizzleTables& swizzle_tables() {
+  static const SwizzleTables tables = build_swizzle_tables();
+  return tables;
+}
+
+/*!
+ * Gather one 16-byte output vector of a row from its 64-byte column.
+ */
+__m128i shuffle_row(const u8* column, const u8 (&masks)[4][16]) {
+  __m128i result = _mm_setzero_si128();
+  for (int i = 0; i < 4; i++) {
+    __m128i in = _mm_loadu_si128((const __m128i*)(column + 16 * i));
+    __m128i mask = _mm_loadu_si128((const __m128i*)masks[i]);
+    result = _mm_or_si128(result, _mm_shuffle_epi8(in, mask));
+  }
+  return result;
+}
+
+u32 rgba16_to_rgba32_fast(const SwizzleTables& tables, u16 in) {
+  u32 r = tables.expand_5_to_8[in & 0b11111];
+  u32 g = tables.expand_5_to_8[(in >> 5) & 0b11111];
+  u32 b = tables.expand_5_to_8[(in >> 10) & 0b11111];
+  u32 a = (in & 0x8000) ? 0x80 : 0;
+  return (a << 24) | (b << 16) | (g << 8) | r;
+}
+
+/*!
+ * Read a CLUT into a palette of RGBA colors, indexed by the value stored in the texture.
+ */
+void decode_clut(const u8* vram, u32* palette, u32 psm, u32 clut_psm, u32 clut_vram_addr) {
+  int count = psm == int(PSM::PSMT8) ? 256 : 16;
+  for (int value = 0; value < count; value++) {
+    u32 clx, cly;
+    if (psm == int(PSM::PSMT8)) {
+      // See GS manual 2.7.3 CLUT Storage Mode, IDTEX8 in CSM1 mode.
+      u32 clut_chunk = value / 16;
+      u32 off_in_chunk = value % 16;
+      clx = (clut_chunk & 1) ? 8 : 0;
+      cly = (clut_chunk >> 1) * 2;
+      if (off_in_chunk >= 8) {
+        off_in_chunk -= 8;
+        cly++;
+      }
+      clx += off_in_chunk;
+    } else {
+      // IDTEX4 in CSM1 mode.
+      clx = value & 0x7;
+      cly = value >> 3;
+    }
+
+    if (clut_psm == int(CPSM::PSMCT32)) {
+      memcpy(&palette[value], vram + psmct32_addr(clx, cly, 64) + clut_vram_addr * 256, 4);
+    } else {
+      u16 clut_value;
+      memcpy(&clut_value, vram + psmct16_addr(clx, cly, 64) + clut_vram_addr * 256, 2);
+      palette[value] = rgba16_to_rgba32(clut_value);
+    }
+  }
+}
+
+struct DownloadParams {
+  u32 vram_addr;
+  u32 read_width;
+  u32 w;
+  u32 psm;
+  const u32* palette;
+};
+
+/*!
+ * Convert rows [y0, y1) of a texture. Rows are independent, so this can be run on several threads.
+ * Full rows of a block are unswizzled from their column. If the texture is narrower than a block,
+ * the last pixels are read one at a time, so we only touch the bytes the texture uses.
+ */
+void convert_rows(const u8* vram, u8* result, const DownloadParams& params, u32 y0, u32 y1) {
+  const auto& tables = swizzle_tables();
+  const u32 w = params.w;
+  const u32 base = params.vram_addr * 256;
+  alignas(16) u8 values[32];
+
+  for (u32 y = y0; y < y1; y++) {
+    u8* out = result + 4 * y * w;
+    if (params.psm == int(PSM::PSMT8)) {
+      const auto& row = tables.psmt8[y % 16];
+      for (u32 x0 = 0; x0 < w; x0 += 16) {
+        u32 n = std::min(16u, w - x0);
+        if (n == 16) {
+          u32 block = psmt8_addr(x0, y & ~15, params.read_width) + base;
+          __m128i idx = shuffle_row(vram + block + row.column_offset, row.masks[0]);
+          _mm_store_si128((__m128i*)values, idx);
+        } else {
+          for (u32 i = 0; i < n; i++) {
+            values[i] = vram[psmt8_addr(x0 + i, y, params.read_width) + base];
+          }
+        }
+        for (u32 i = 0; i < n; i++) {
+          memcpy(out + 4 * (x0 + i), &params.palette[values[i]], 4);
+        }
+      }
+    } else if (params.psm == int(PSM::PSMT4)) {
+      const auto& row = tables.psmt4[y % 16];
+      const __m128i low_bits = _mm_set1_epi8(0x0f);
+      for (u32 x0 = 0; x0 < w; x0 += 32) {
+        u32 n = std::min(32u, w - x0);
+        if (n == 32) {
+          u32 block = psmt4_addr_half_byte(x0, y & ~15, params.read_width) / 2 + base;
+          const u8* column = vram + block + row.column_offset;
+          for (int half = 0; half < 2; half++) {
+            __m128i bytes = shuffle_row(column, row.masks[half]);
+            __m128i lo = _mm_and_si128(bytes, low_bits);
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_bits);
+            __m128i select = _mm_loadu_si128((const __m128i*)row.high_nibble[half]);
+            _mm_store_si128((__m128i*)(values + 16 * half), _mm_blendv_epi8(lo, hi, select));
+          }
+        } else {
+          for (u32 i = 0; i < n; i++) {
+            u32 addr4 = psmt4_addr_half_byte(x0 + i, y, params.read_width);
+            u8 byte = vram[addr4 / 2 + base];
+            values[i] = (addr4 & 1) ? (byte >> 4) : (byte & 0x0f);
+          }
+        }
+        for (u32 i = 0; i < n; i++) {
+          memcpy(out + 4 * (x0 + i), &params.palette[values[i]], 4);
+        }
+      }
+    } else {
+      const auto& row = tables.psmct16[y % 8];
+      for (u32 x0 = 0; x0 < w; x0 += 16) {
+        u32 n = std::min(16u, w - x0);
+        if (n == 16) {
+          u32 block = psmct16_addr(x0, y & ~7, params.read_width) + base;
+          const u8* column = vram + block + row.column_offset;
+          _mm_store_si128((__m128i*)values, shuffle_row(column, row.masks[0]));
+          _mm_store_si128((__m128i*)(values + 16), shuffle_row(column, row.masks[1]));
+        } else {
+          for (u32 i = 0; i < n; i++) {
+            memcpy(values + 2 * i, vram + psmct16_addr(x0 + i, y, params.read_width) + base, 2);
+          }
+        }
+        for (u32 i = 0; i < n; i++) {
+          u16 value;
+          memcpy(&value, values + 2 * i, 2);
+          u32 val32 = rgba16_to_rgba32_fast(tables, value);
+          memcpy(out + 4 * (x0 + i), &val32, 4);
+        }
+      }
+    }
+  }
+}
+
+// below this many pixels, handing rows to the worker threads costs more than the conversion.
+constexpr u32 PARALLEL_DOWNLOAD_MIN_PIXELS = 256 * 256;
+}  // namespace
 
 TextureConverter::TextureConverter() {
   m_vram.resize(4 * 1024 * 1024);
 }
 
+TextureConverter::~TextureConverter() = default;
+
+void TextureConverter::set_parallel(bool parallel) {
+  m_parallel = parallel;
+  if (m_parallel && !m_thread_pool) {
+    // started once and kept, so a download doesn't pay for creating threads.
+    m_thread_pool = std::make_unique<BS::thread_pool>();
+  }
+}
+
 void TextureConverter::upload(const u8* data, u32 dest, u32 size_vram_words) {
   // all textures are copied to vram 128 pixels wide, regardless of actual width
   int copy_width = 128;
@@ -35,6 +279,10 @@ void TextureConverter::upload_width(const u8* data, u32 dest, u32 width, u32 hei
   }
 }
 
+/*!
+ * Convert a texture in VRAM to RGBA8888. Each row of a block is unswizzled with byte shuffles, and
+ * the CLUT is decoded into a palette once, instead of per pixel.
+ */
 void TextureConverter::download_rgba8888(u8* result,
                                          u32 vram_addr,
                                          u32 goal_tex_width,
@@ -44,6 +292,45 @@ void TextureConverter::download_rgba8888(u8* result,
                                          u32 clut_psm,
                                          u32 clut_vram_addr,
                                          u32 expected_size_bytes) {
+  u32 palette[256];
+  DownloadParams params;
+  params.vram_addr = vram_addr;
+  // width is like the TEX0 register, in 64 texel units.
+  params.read_width = 64 * goal_tex_width;
+  params.w = w;
+  params.psm = psm;
+  params.palette = palette;
+
+  if ((psm == int(PSM::PSMT8) || psm == int(PSM::PSMT4)) &&
+      (clut_psm == int(CPSM::PSMCT32) || clut_psm == int(CPSM::PSMCT16))) {
+    decode_clut(m_vram.data(), palette, psm, clut_psm, clut_vram_addr);
+  } else if (psm != int(PSM::PSMCT16) || clut_psm != 0) {
+    ASSERT(false);
+  }
+  ASSERT(w * h * 4 == expected_size_bytes);
+
+  if (m_parallel && w * h >= PARALLEL_DOWNLOAD_MIN_PIXELS) {
+    auto rows = m_thread_pool->parallelize_loop(
+        0u, h, [&](u32 y0, u32 y1) { convert_rows(m_vram.data(), result, params, y0, y1); });
+    rows.wait();
+  } else {
+    convert_rows(m_vram.data(), result, params, 0, h);
+  }
+}
+
+/*!
+ * Convert a texture in VRAM to RGBA8888, one pixel at a time. This is much slower than
+ * download_rgba8888 and is kept as a reference for testing.
+ */
+void TextureConverter::download_rgba8888_reference(u8* result,
+                                                   u32 vram_addr,
+                                                   u32 goal_tex_width,
+                                                   u32 w,
+                                                   u32 h,
+                                                   u32 psm,
+                                                   u32 clut_psm,
+                                                   u32 clut_vram_addr,
+                                                   u32 expected_size_bytes) {
   u32 out_offset = 0;
   if (psm == int(PSM::PSMT8) && clut_psm == int(CPSM::PSMCT32)) {
     // width is like the TEX0 register, in 64 texel units.
@@ -1,12 +1,18 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 
 #include "common/common_types.h"
 
+namespace BS {
+class thread_pool;
+}
+
 class TextureConverter {
  public:
   TextureConverter();
+  ~TextureConverter();
   void upload(const u8* data, u32 dest, u32 size_vram_words);
   void upload_width(const u8* data, u32 dest, u32 width, u32 height);
   void download_rgba8888(u8* result,
@@ -18,7 +24,23 @@ class TextureConverter {
                          u32 clut_psm,
                          u32 clut_vram_addr,
                          u32 expected_size_bytes);
+  void download_rgba8888_reference(u8* result,
+                                   u32 vram_addr,
+                                   u32 goal_tex_width,
+                                   u32 w,
+                                   u32 h,
+                                   u32 psm,
+                                   u32 clut_psm,
+                                   u32 clut_vram_addr,
+                                   u32 expected_size_bytes);
+
+  /*!
+   * Allow large downloads to be split across worker threads.
+   */
+  void set_parallel(bool parallel);
 
  private:
   std::vector<u8> m_vram;
+  bool m_parallel = false;
+  std::unique_ptr<BS::thread_pool> m_thread_pool;
 };
@@ -22,6 +22,7 @@ struct GoalProtoBlock {
   // size of pending receive to process.
   s32 last_receive_size = 0;
   s32 receive_progress = 0;
+  bool holding_message = false;  // the last message may still be in use, don't receive yet.
   u32 most_recent_event = 0;
   u32 most_recent_param = 0;
   u32 msg_kind = 0;
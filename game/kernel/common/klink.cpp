@@ -16,6 +16,11 @@ bool is_opengoal_object(const void* data) {
   auto* header = (const LinkHeaderV2*)data;
   return !(header->type_tag == 0xffffffff && (header->version == 2 || header->version == 4));
 }
+
+// scratch space for decoded link tables. Linking only happens on the main thread, and reusing
+// these avoids an allocation for every object.
+std::vector<LinkFixupRun> g_pointer_fixup_runs;
+std::vector<u32> g_symbol_fixup_offsets;
 }  // namespace
 
 // space to store a single in-progress linking state.
@@ -38,6 +43,8 @@ void link_control::jak1_jak2_begin(Ptr<uint8_t> object_file,
                                    int32_t size,
                                    Ptr<kheapinfo> heap,
                                    uint32_t flags) {
+  m_work_ms = 0;
+  m_work_calls = 0;
   if (is_opengoal_object(object_file.c())) {
     // save data from call to begin
     m_object_data = object_file;
@@ -223,9 +230,83 @@ void link_control::jak1_jak2_begin(Ptr<uint8_t> object_file,
   }
 }
 
+/*!
+ * Decode a v2/v4 pointer link table into runs of words to relocate.
+ * The table alternates between "number of words to skip" and "number of words to fix up". A count
+ * of 0xff continues the current mode with the next byte, unless that byte is 0, which flips the
+ * mode. The table ends with a 0 where a new mode would begin. The caller must check for an empty
+ * table (a single 0) first. Adjacent runs are merged.
+ * Returns a pointer to the byte after the end of the table.
+ */
+Ptr<u8> decode_v2_pointer_table(Ptr<u8> table, std::vector<LinkFixupRun>* runs) {
+  u8* reloc = table.c();
+  u32 loc = 0;
+  bool fixing = false;
+  runs->clear();
+
+  while (true) {
+    while (true) {
+      u8 count = *reloc++;
+      if (fixing && count) {
+        if (!runs->empty() && runs->back().offset + runs->back().count == loc) {
+          runs->back().count += count;
+        } else {
+          runs->push_back({loc, count});
+        }
+      }
+      loc += count;
+
+      if (count != 0xff) {
+        break;
+      }
+
+      if (*reloc == 0) {
+        reloc++;
+        fixing = !fixing;
+      }
+    }
+
+    fixing = !fixing;
+    if (*reloc == 0) {
+      break;
+    }
+  }
+
+  return make_ptr(reloc + 1);
+}
+
+/*!
+ * Relocate all the pointers in a v2/v4 object, by adding the address of the object data.
+ * The original game walked the table in place and checked the clock as it went so it could resume
+ * on a later frame. Decoding it first leaves a simple loop over each run, which is fast enough to
+ * link even the largest level files in one go.
+ * Returns a pointer to the byte after the end of the table.
+ */
+Ptr<u8> link_v2_pointer_table(Ptr<u8> objData, Ptr<u8> table) {
+  ASSERT((objData.offset & 3) == 0);
+  auto end = decode_v2_pointer_table(table, &g_pointer_fixup_runs);
+
+  u32* words = objData.cast<u32>().c();
+  const u32 base = objData.offset;
+  for (const auto& run : g_pointer_fixup_runs) {
+    u32* dst = words + run.offset;
+    for (u32 i = 0; i < run.count; i++) {
+      dst[i] += base;
+    }
+  }
+  return end;
+}
+
+/*!
+ * Link all references to a symbol or type in a v2/v4 object. The table is a list of byte offsets,
+ * each relative to the previous, stored in 1 to 4 bytes. The low bits of each byte say if another
+ * byte follows. The table ends with a 0.
+ * Returns a pointer to the byte after the end of the table.
+ */
 Ptr<u8> c_symlink2(Ptr<u8> objData, Ptr<u8> linkObj, Ptr<u8> relocTable) {
   u8* relocPtr = relocTable.c();
-  Ptr<u8> objPtr = objData;
+  u32 offset = 0;
+  g_symbol_fixup_offsets.clear();
 
   do {
     u8 table_value = *relocPtr;
@@ -246,18 +327,23 @@ Ptr<u8> c_symlink2(Ptr<u8> objData, Ptr<u8> linkObj, Ptr<u8> relocTable) {
     }
 
     relocPtr = next_reloc;
-    objPtr = objPtr + (result & 0xfffffffc);
-    u32 objValue = *(objPtr.cast<u32>());
+    offset += result & 0xfffffffc;
+    g_symbol_fixup_offsets.push_back(offset);
+  } while (*relocPtr);
+
+  for (u32 fixup : g_symbol_fixup_offsets) {
+    auto objPtr = (objData + fixup).cast<u32>();
+    u32 objValue = *objPtr;
     if (objValue == 0xffffffff) {
-      *(objPtr.cast<u32>()) = linkObj.offset;
+      *objPtr = linkObj.offset;
     } else {
       // I don't think we should hit this ever.
       // if this is hit - there's a good chance something has overwritten the object file data
       // after linking has started.
-      printf("val is 0x%x ptr %p\n", objValue, relocPtr - 1);
+      printf("val is 0x%x at offset 0x%x\n", objValue, fixup);
       ASSERT(false);
     }
-  } while (*relocPtr);
+  }
 
   return make_ptr(relocPtr + 1);
 }
@@ -1,5 +1,6 @@
 #pragma once
 #include <cstring>
+#include <vector>
 
 #include "common/common_types.h"
 #include "common/link_types.h"
@@ -61,9 +62,10 @@ struct link_control {
   int m_heap_gap;
   Ptr<uint8_t> m_original_object_location;
   Ptr<u8> m_reloc_ptr;
-  Ptr<u8> m_base_ptr;
-  Ptr<u8> m_loc_ptr;
-  int m_table_toggle;
+
+  // link time instrumentation, reported in finish.
+  double m_work_ms = 0;
+  int m_work_calls = 0;
 
   bool m_opengoal;
   bool m_busy;  // only in jak2, but doesn't hurt to set it in jak 1.
@@ -122,10 +124,23 @@ struct link_control {
     m_segment_process = 0;
     m_version = 0;
     m_busy = false;
+    m_work_ms = 0;
+    m_work_calls = 0;
   }
 };
 
+/*!
+ * A run of consecutive words to relocate, as decoded from a v2/v4 pointer link table.
+ * The offset is in words from the start of the object data.
+ */
+struct LinkFixupRun {
+  u32 offset;
+  u32 count;
+};
+
 void klink_init_globals();
+Ptr<u8> decode_v2_pointer_table(Ptr<u8> table, std::vector<LinkFixupRun>* runs);
+Ptr<u8> link_v2_pointer_table(Ptr<u8> objData, Ptr<u8> table);
 Ptr<u8> c_symlink2(Ptr<u8> objData, Ptr<u8> linkObj, Ptr<u8> relocTable);
 
 extern link_control saved_link_control;
@@ -2,20 +2,30 @@
 
 #include <cstdio>
 #include <cstring>
+#include <vector>
 
 #include "common/listener_common.h"
 #include "common/log/log.h"
+#include "common/util/compress.h"
 
 #include "game/kernel/common/kdsnetm.h"
+#include "game/kernel/common/kmalloc.h"
 #include "game/kernel/common/kprint.h"
 #include "game/kernel/common/ksocket.h"
 
+static_assert(LISTENER_CODE_CHUNK_SIZE + sizeof(ListenerMessageHeader) < DEBUG_MESSAGE_BUFFER_SIZE,
+              "listener code chunks must fit in the message buffer");
+
 Ptr<u32> print_column;
 u32 ListenerStatus;
 
+// pieces of a code object from LTT_MSG_CODE_CHUNK messages, waiting for the final piece.
+std::vector<u8> ListenerCodeChunks;
+
 void klisten_init_globals() {
   print_column.offset = 0;
   ListenerStatus = 0;
+  ListenerCodeChunks.clear();
 }
 
 /*!
@@ -85,3 +95,36 @@ void SendAck() {
                     strlen(AckBufArea + sizeof(ListenerMessageHeader)));
   }
 }
+
+/*!
+ * Stash a piece of a code object that was too big to send in a single message.
+ * The pieces are put back together once the final LTT_MSG_CODE or LTT_MSG_CODE_ZSTD arrives.
+ */
+void StashListenerCodeChunk(Ptr<char> msg, s32 size) {
+  ListenerCodeChunks.insert(ListenerCodeChunks.end(), (u8*)msg.c(), (u8*)msg.c() + size);
+}
+
+/*!
+ * Copy the code object from a LTT_MSG_CODE or LTT_MSG_CODE_ZSTD message, plus any chunks stashed
+ * before it, to a new buffer on the debug heap for the linker. Decompresses if needed.
+ */
+Ptr<u8> ReceiveListenerCode(Ptr<char> msg, s32 size, bool compressed) {
+  const u8* data = (const u8*)msg.c();
+  if (!ListenerCodeChunks.empty()) {
+    StashListenerCodeChunk(msg, size);
+    data = ListenerCodeChunks.data();
+    size = ListenerCodeChunks.size();
+  }
+
+  std::vector<u8> decompressed;
+  if (compressed) {
+    decompressed = compression::decompress_zstd(data, size);
+    data = decompressed.data();
+    size = decompressed.size();
+  }
+
+  auto buffer = kmalloc(kdebugheap, size, 0, "listener-link-block");
+  memcpy(buffer.c(), data, size);
+  ListenerCodeChunks.clear();
+  return buffer;
+}
@@ -9,4 +9,6 @@ extern u32 ListenerStatus;
 
 void klisten_init_globals();
 void ClearPending();
-void SendAck();
\ No newline at end of file
+void SendAck();
+void StashListenerCodeChunk(Ptr<char> msg, s32 size);
+Ptr<u8> ReceiveListenerCode(Ptr<char> msg, s32 size, bool compressed);
\ No newline at end of file
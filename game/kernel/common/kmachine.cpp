@@ -10,6 +10,7 @@
 #include "third-party/miniaudio.h"
 
 #include "common/global_profiler/GlobalProfiler.h"
+#include "common/goal_constants.h"
 #include "common/log/log.h"
 #include "common/symbols.h"
 #include "common/util/FileUtil.h"
@@ -1017,6 +1018,21 @@ void pc_screen_shot() {
   g_want_screenshot = true;
 }
 
+/*!
+ * Write all of EE memory to a file, for memory_dump_tool. The memory is copied right away so the
+ * dump is consistent, and the file is written from another thread so the game doesn't stop.
+ */
+void pc_dump_memory(u32 filepath) {
+  auto path = std::string(Ptr<String>(filepath).c()->data());
+  auto snapshot =
+      std::make_shared<std::vector<u8>>(g_ee_main_mem, g_ee_main_mem + EE_MAIN_MEM_SIZE);
+  std::thread([path, snapshot]() {
+    file_util::create_dir_if_needed_for_file(path);
+    file_util::write_binary_file(path, snapshot->data(), snapshot->size());
+    lg::info("Wrote memory dump to {}", path);
+  }).detach();
+}
+
 void pc_register_screen_shot_settings(u32 ptr) {
   register_screen_shot_settings(Ptr<ScreenShotSettings>(ptr).c());
 }
@@ -1139,4 +1155,5 @@ void init_common_pc_port_functions(
   make_func_symbol_func("pc-screen-shot", (void*)pc_screen_shot);
   make_func_symbol_func("pc-register-screen-shot-settings",
                         (void*)pc_register_screen_shot_settings);
+  make_func_symbol_func("pc-dump-memory", (void*)pc_dump_memory);
 }
@@ -1,5 +1,10 @@
 #pragma once
 
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
 #include "common/common_types.h"
 
 #include "game/kernel/common/Ptr.h"
@@ -26,6 +31,20 @@ struct String {
 
 struct Function {};
 
+/*!
+ * Hash for SymbolIndex that allows lookups by C string without building a std::string.
+ */
+struct SymbolNameHash {
+  using is_transparent = void;
+  size_t operator()(std::string_view name) const { return std::hash<std::string_view>()(name); }
+};
+
+/*!
+ * Index of the symbol table kept on the C++ side, mapping a symbol's name to its offset from s7.
+ * Lets name lookups skip probing the GOAL symbol table. Must be updated whenever a symbol is named.
+ */
+using SymbolIndex = std::unordered_map<std::string, int, SymbolNameHash, std::equal_to<>>;
+
 void init_crc();
 u32 crc32(const u8* data, s32 size);
 u64 delete_illegal(u32 obj);
@@ -3,6 +3,7 @@
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/kdsnetm.h"
 #include "game/kernel/common/kprint.h"
+#include "game/sce/deci2.h"
 
 /*!
  * Update GOAL message header after receiving and verify message is ok.
@@ -17,6 +18,11 @@ u32 ReceiveToBuffer(char* buff) {
   // if we received less than the size of the message header, we either got nothing, or there was an
   // error
   if (protoBlock.last_receive_size < (int)sizeof(ListenerMessageHeader)) {
+    if (protoBlock.last_receive_size >= 0) {
+      // got a broken message, drop it so the next one can be received.
+      protoBlock.last_receive_size = -1;
+      protoBlock.holding_message = true;
+    }
     return -1;
   }
 
@@ -33,6 +39,7 @@ u32 ReceiveToBuffer(char* buff) {
     protoBlock.msg_id = gbuff->msg_id;
     // and mark message as received!
     protoBlock.last_receive_size = -1;
+    protoBlock.holding_message = true;
   } else {
     // not our protocol, something has gone wrong.
     MsgErr("dkernel: got a bad packet to goal proto (goal #x%lx bytes %d %d %d %ld %d)\n",
@@ -40,6 +47,7 @@ u32 ReceiveToBuffer(char* buff) {
            u32(protoBlock.receive_buffer->msg_kind), protoBlock.receive_buffer->u6,
            protoBlock.receive_buffer->msg_id, msg_size);
     protoBlock.last_receive_size = -1;
+    protoBlock.holding_message = true;
     return -1;
   }
   return msg_size;
@@ -77,12 +85,17 @@ void InitCheckListener() {}
  * More accurate name would be "CheckForMessage"
  * Returns pointer to the message.
  * Updates MessCount to be equal to the size of the new message
- * DONE, EXACT
+ * DONE, added the recv_done so the compiler can send several messages without waiting for acks.
  */
 Ptr<char> WaitForMessageAndAck() {
   if (!MasterDebug) {
     MessCount = -1;
   } else {
+    if (protoBlock.holding_message) {
+      // the previous message has been processed, the buffer can be reused for the next one.
+      protoBlock.holding_message = false;
+      ee::LIBRARY_sceDeci2_recv_done();
+    }
     MessCount = ReceiveToBuffer((char*)MessBufArea.c() + sizeof(ListenerMessageHeader));
   }
 
@@ -28,9 +28,12 @@ using namespace jak1_symbols;
 namespace jak1 {
 // where to put a new symbol for the most recently searched for symbol that wasn't found
 u32 symbol_slot;
+// name -> symbol, so find_symbol_from_c doesn't have to probe the table.
+SymbolIndex g_symbol_index;
 
 void kscheme_init_globals() {
   symbol_slot = 0;
+  g_symbol_index.clear();
 }
 
 /*!
@@ -607,6 +610,7 @@ Ptr<Symbol> set_fixed_symbol(u32 offset, const char* name, u32 value) {
 
   // set hash of the symbol
   info(sym)->hash = crc32((const u8*)name, (int)strlen(name));
+  g_symbol_index[name] = offset;
 
   // set value of the symbol
   sym->value = value;
@@ -663,12 +667,12 @@ Ptr<Symbol> find_symbol_in_area(u32 hash, const char* name, u32 start, u32 end)
 }
 
 /*!
- * Searches the table for a symbol.  If the symbol is found, returns it.
- * If not, returns 0, but symbol_slot will contain the slot for the symbol.
+ * Searches the table for a symbol by probing from the symbol's hash.  If the symbol is found,
+ * returns it. If not, returns 0, but symbol_slot will contain the slot for the symbol.
  * If both are 0, the symbol table is full and you are sad.
  * Also allows you to find the empty pair by searching for _empty_
  */
-Ptr<Symbol> find_symbol_from_c(const char* name) {
+Ptr<Symbol> find_symbol_from_c_probe(const char* name) {
   symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
   u32 hash = crc32((const u8*)name, (int)strlen(name));
 
@@ -721,6 +725,28 @@ Ptr<Symbol> find_symbol_from_c(const char* name) {
   }
 }
 
+/*!
+ * Searches for a symbol. Looks in g_symbol_index first, and probes the table if it's not there.
+ * Same results as find_symbol_from_c_probe, including symbol_slot for symbols that don't exist.
+ */
+Ptr<Symbol> find_symbol_from_c(const char* name) {
+  auto it = g_symbol_index.find(std::string_view(name));
+  if (it != g_symbol_index.end()) {
+    Ptr<Symbol> sym(s7.offset + it->second);
+#ifndef NDEBUG
+    // in debug builds, make sure the index agrees with the table.
+    ASSERT(find_symbol_from_c_probe(name) == sym);
+#endif
+    return sym;
+  }
+
+  auto sym = find_symbol_from_c_probe(name);
+  if (sym.offset) {
+    g_symbol_index.emplace(name, sym.offset - s7.offset);
+  }
+  return sym;
+}
+
 /*!
  * Returns a symbol with the given name.  If this is the first time, make a new symbol, otherwise it
  * returns the old one. Basically a LISP symbol intern
@@ -741,6 +767,7 @@ Ptr<Symbol> intern_from_c(const char* name) {
   auto str = make_string_from_c(name);
   info(symbol)->str = Ptr<String>(str);
   info(symbol)->hash = hash;
+  g_symbol_index[name] = symbol.offset - s7.offset;
 
   NumSymbols++;
   return symbol;
@@ -861,6 +888,7 @@ Ptr<Type> set_fixed_type(u32 offset,
   type_symbol.cast<u32>().c()[-1] = *(s7 + FIX_SYM_SYMBOL_TYPE);
   info(type_symbol)->str = Ptr<String>(make_string_from_c(name));
   info(type_symbol)->hash = crc32((const u8*)name, (int)strlen(name));
+  g_symbol_index[name] = offset;
 
   // increment
   NumSymbols++;
@@ -1463,6 +1491,7 @@ s32 InitHeapAndSymbol() {
   // the last symbol we will ever access.
   LastSymbol = symbol_table + SYM_TABLE_END * 8;
   NumSymbols = 0;
+  g_symbol_index.clear();
   // inform compiler the symbol table is reset, and where it is.
   reset_output();
 
@@ -52,6 +52,8 @@ struct Type {
   }
 };
 
+extern SymbolIndex g_symbol_index;
+
 void kscheme_init_globals();
 Ptr<Symbol> intern_from_c(const char* name);
 u64 load(u32 file_name_in, u32 heap_in);
@@ -63,6 +65,7 @@ u64 new_pair(u32 heap, u32 type, u32 car, u32 cdr);
 u64 inspect_object(u32 obj);
 u64 print_object(u32 obj);
 Ptr<Symbol> find_symbol_from_c(const char* name);
+Ptr<Symbol> find_symbol_from_c_probe(const char* name);
 u64 call_method_of_type(u64 arg, Ptr<Type> type, u32 method_id);
 Ptr<Type> intern_type_from_c(const char* name, u64 methods);
 u64 call_method_of_type_arg2(u32 arg, Ptr<Type> type, u32 method_id, u32 a1, u32 a2);
@@ -91,9 +91,13 @@ void ProcessListenerMessage(Ptr<char> msg) {
     case LTT_MSG_SHUTDOWN:
       MasterExit = RuntimeExitStatus::EXIT;
       break;
-    case LTT_MSG_CODE: {
-      auto buffer = kmalloc(kdebugheap, MessCount, 0, "listener-link-block");
-      memcpy(buffer.c(), msg.c(), MessCount);
+    case LTT_MSG_CODE_CHUNK:
+      // part of a large code object, hold on to it until the rest arrives.
+      StashListenerCodeChunk(msg, MessCount);
+      break;
+    case LTT_MSG_CODE:
+    case LTT_MSG_CODE_ZSTD: {
+      auto buffer = ReceiveListenerCode(msg, MessCount, protoBlock.msg_kind == LTT_MSG_CODE_ZSTD);
       ListenerLinkBlock->value() = buffer.offset + 4;
       // note - this will stash the linked code in the top level and free it.
       // it will then be used-after-free, but this is OK because nobody else will allocate.
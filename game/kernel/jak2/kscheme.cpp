@@ -28,6 +28,8 @@ namespace jak2 {
 using namespace jak2_symbols;
 // where to put a new symbol for the most recently searched for symbol that wasn't found
 u32 symbol_slot;
+// name -> symbol, so find_symbol_from_c doesn't have to probe the table.
+SymbolIndex g_symbol_index;
 
 Ptr<Symbol4<u32>> LevelTypeList;
 Ptr<Symbol4<u32>> CollapseQuote;
@@ -36,6 +38,7 @@ Ptr<u32> KernelDebug;
 
 void kscheme_init_globals() {
   symbol_slot = 0;
+  g_symbol_index.clear();
   LevelTypeList.offset = 0;
   CollapseQuote.offset = 0;
   SqlResult.offset = 0;
@@ -600,6 +603,7 @@ Ptr<Symbol4<u32>> set_fixed_symbol(u32 offset, const char* name, u32 value) {
 
   // set hash of the symbol
   *sym_to_hash(sym).c() = crc32((const u8*)name, strlen(name));
+  g_symbol_index[name] = offset;
 
   NumSymbols++;
   return sym;
@@ -653,12 +657,12 @@ Ptr<Symbol4<u32>> find_symbol_in_area(u32 hash, const char* name, u32 start, u32
 }
 
 /*!
- * Searches the table for a symbol.  If the symbol is found, returns it.
- * If not, returns 0, but symbol_slot will contain the slot for the symbol.
+ * Searches the table for a symbol by probing from the symbol's hash.  If the symbol is found,
+ * returns it. If not, returns 0, but symbol_slot will contain the slot for the symbol.
  * If both are 0, the symbol table is full and you are sad.
  * Also allows you to find the empty pair by searching for _empty_
  */
-Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
+Ptr<Symbol4<u32>> find_symbol_from_c_probe(const char* name) {
   symbol_slot = 0;  // nowhere to put the symbol yet, clear any old symbol_slot result.
   u32 hash = crc32((const u8*)name, (int)strlen(name));
 
@@ -710,6 +714,28 @@ Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
   }
 }
 
+/*!
+ * Searches for a symbol. Looks in g_symbol_index first, and probes the table if it's not there.
+ * Same results as find_symbol_from_c_probe, including symbol_slot for symbols that don't exist.
+ */
+Ptr<Symbol4<u32>> find_symbol_from_c(const char* name) {
+  auto it = g_symbol_index.find(std::string_view(name));
+  if (it != g_symbol_index.end()) {
+    Ptr<Symbol4<u32>> sym(s7.offset + it->second);
+#ifndef NDEBUG
+    // in debug builds, make sure the index agrees with the table.
+    ASSERT(find_symbol_from_c_probe(name) == sym);
+#endif
+    return sym;
+  }
+
+  auto sym = find_symbol_from_c_probe(name);
+  if (sym.offset) {
+    g_symbol_index.emplace(name, sym.offset - s7.offset);
+  }
+  return sym;
+}
+
 /*!
  * Returns a symbol with the given name.  If this is the first time, make a new symbol, otherwise it
  * returns the old one. Basically a LISP symbol intern
@@ -728,6 +754,7 @@ Ptr<Symbol4<u32>> intern_from_c(const char* name) {
   auto str = make_string_from_c(name);
   *sym_to_string_ptr(symbol) = Ptr<String>(str);
   *sym_to_hash(symbol) = hash;
+  g_symbol_index[name] = symbol.offset - s7.offset;
 
   NumSymbols++;
   return symbol;
@@ -880,6 +907,7 @@ Ptr<Type> set_fixed_type(u32 offset,
   // set the symbol's name and hash
   *sym_to_string_ptr(type_symbol) = Ptr<String>(make_string_from_c(name));
   *sym_to_hash(type_symbol) = crc32((const u8*)name, strlen(name));
+  g_symbol_index[name] = offset;
   NumSymbols++;
 
   if (symbol_value.offset == 0) {
@@ -1482,6 +1510,7 @@ int InitHeapAndSymbol() {
   SymbolTable2 = symbol_table + 5;
   s7 = symbol_table + 0x8001;
   NumSymbols = 0;
+  g_symbol_index.clear();
 
   // inform compiler of s7
   reset_output();
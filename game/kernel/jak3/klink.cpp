@@ -1,8 +1,11 @@
 #include "klink.h"
 
 #include "common/common_types.h"
+#include "common/global_profiler/GlobalProfiler.h"
 #include "common/goal_constants.h"
+#include "common/log/log.h"
 #include "common/symbols.h"
+#include "common/util/Timer.h"
 
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/klink.h"
@@ -28,6 +31,8 @@ void link_control::jak3_begin(Ptr<uint8_t> object_file,
                               int32_t size,
                               Ptr<kheapinfo> heap,
                               uint32_t flags) {
+  m_work_ms = 0;
+  m_work_calls = 0;
   if (is_opengoal_object(object_file.c())) {
     m_opengoal = true;
     // save data from call to begin
@@ -257,6 +262,8 @@ void link_control::jak3_begin(Ptr<uint8_t> object_file,
 }
 
 uint32_t link_control::jak3_work() {
+  Timer work_timer;
+  auto p = scoped_prof(m_object_name);
   auto old_debug_segment = DebugSegment;
   if (m_keep_debug) {
     DebugSegment = s7.offset + true_symbol_offset(g_game_version);
@@ -285,6 +292,8 @@ uint32_t link_control::jak3_work() {
     return 0;
   }
 
+  m_work_ms += work_timer.getMs();
+  m_work_calls++;
   DebugSegment = old_debug_segment;
   return rv;
 }
@@ -673,11 +682,12 @@ uint32_t link_control::jak3_work_opengoal() {
 
     m_state = 1;
     m_segment_process = 0;
-    return 0;
-  } else if (m_state == 1) {
-    // state 1: linking. For now all links are done at once. This is probably going to be fine on a
-    // modern computer.  But the game broke this into multiple steps.
-    if (m_segment_process < ofh->segment_count) {
+  }
+
+  if (m_state == 1) {
+    // state 1: linking. The game broke this into multiple steps, but linking every segment at once
+    // is fast enough on a modern computer.
+    for (; m_segment_process < ofh->segment_count; m_segment_process++) {
       if (ofh->code_infos[m_segment_process].offset) {
         Ptr<u8> lp(ofh->link_infos[m_segment_process].offset);
 
@@ -711,18 +721,12 @@ uint32_t link_control::jak3_work_opengoal() {
           }
         }
       }
-
-      m_segment_process++;
-    } else {
-      // all done, can set the entry point to the top-level.
-      m_entry = Ptr<u8>(ofh->code_infos[TOP_LEVEL_SEGMENT].offset) + 4;
-      return 1;
     }
 
-    return 0;
-  }
-
-  else {
+    // all done, can set the entry point to the top-level.
+    m_entry = Ptr<u8>(ofh->code_infos[TOP_LEVEL_SEGMENT].offset) + 4;
+    return 1;
+  } else {
     printf("WORK v3 INVALID STATE\n");
     return 1;
   }
@@ -741,7 +745,8 @@ void link_control::jak3_finish(bool jump_from_c_to_goal) {
 
   *EnableMethodSet = *EnableMethodSet + m_keep_debug;
 
-  // printf("finish %s\n", m_object_name);
+  lg::debug("link finish: {} ({:.3f} ms in {} work calls)", m_object_name, m_work_ms,
+            m_work_calls);
   if (m_opengoal) {
     // setup mips2c functions
     const auto& it = Mips2C::gMips2CLinkCallbacks[GameVersion::Jak3].find(m_object_name);
@@ -959,80 +964,17 @@ uint32_t link_control::jak3_work_v2_v4() {
     m_segment_process = 0;
   }
 
-  // init offset phase
-  if (m_state == LINK_V2_STATE_OFFSETS && m_segment_process == 0) {
+  if (m_state == LINK_V2_STATE_OFFSETS) {  // pointer fixup
+    // this table alternates between "seek amount" and "number of consecutive 4-byte words to fix
+    // up". The game walked it in place and checked the clock every 0x400 entries so it could
+    // resume on the next frame. We decode it up front and apply all the fixups at once instead.
     m_reloc_ptr = m_link_block_ptr + 8;  // seek to link table
     if (*m_reloc_ptr == 0) {             // do we have pointer links to do?
       m_reloc_ptr.offset++;              // if not, seek past the \0, and go to next state
-      m_state = LINK_V2_STATE_SYMBOL_TABLE;
-      m_segment_process = 0;
     } else {
-      m_base_ptr = m_object_data;  // base address for offsetting.
-      m_loc_ptr = m_object_data;   // pointer which seeks thru the code
-      m_table_toggle = 0;          // are we seeking or fixing?
-      m_segment_process = 1;       // we've done first time setup
-    }
-  }
-
-  if (m_state == LINK_V2_STATE_OFFSETS) {  // pointer fixup
-    // this state reads through a table. Values alternate between "seek amount" and "number of
-    // consecutive 4-byte
-    //  words to fix up".  The counts are encoded using a variable length encoding scheme.  They use
-    //  a very stupid
-    // method of encoding values which requires O(n) bytes to store the value n.
-
-    // to avoid dropping a frame, we check every 0x400 relocations to see if 0.5 milliseconds have
-    // elapsed.
-    u32 relocCounter = 0x400;
-    while (true) {    // loop over entire table
-      while (true) {  // loop over current mode
-
-        // read and seek table
-        u8 count = *m_reloc_ptr;
-        m_reloc_ptr.offset++;
-
-        if (!m_table_toggle) {  // seek mode
-          m_loc_ptr.offset +=
-              4 *
-              count;  // perform seek (MIPS instructions are 4 bytes, so we >> 2 the seek amount)
-        } else {      // offset mode
-          for (u32 i = 0; i < count; i++) {
-            if (m_loc_ptr.offset % 4) {
-              ASSERT(false);
-            }
-            u32 code = *(m_loc_ptr.cast<u32>());
-            code += m_base_ptr.offset;
-            *(m_loc_ptr.cast<u32>()) = code;
-            m_loc_ptr.offset += 4;
-          }
-        }
-
-        if (count != 0xff) {
-          break;
-        }
-
-        if (*m_reloc_ptr == 0) {
-          m_reloc_ptr.offset++;
-          m_table_toggle = m_table_toggle ^ 1;
-        }
-      }
-
-      // reached the end of the tableToggle mode
-      m_table_toggle = m_table_toggle ^ 1;
-      if (*m_reloc_ptr == 0) {
-        break;  // end of the state
-      }
-      relocCounter--;
-      if (relocCounter == 0) {
-        //        u32 clock_value = kernel.read_clock();
-        //        if(clock_value - startCycle > 150000) { // 0.5 milliseconds
-        //          return 0;
-        //        }
-        relocCounter = 0x400;
-      }
+      m_reloc_ptr = link_v2_pointer_table(m_object_data, m_reloc_ptr);
     }
-    m_reloc_ptr.offset++;
-    m_state = 2;
+    m_state = LINK_V2_STATE_SYMBOL_TABLE;
     m_segment_process = 0;
   }
 
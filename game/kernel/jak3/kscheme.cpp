@@ -38,7 +38,7 @@ Ptr<u32> KernelDebug;
 Ptr<Symbol4<u32>> SqlResult;
 
 #ifdef JAK3_HASH_TABLE
-std::unordered_map<std::string, int> g_symbol_hash_table;
+SymbolIndex g_symbol_hash_table;
 #endif
 
 void kscheme_init_globals() {
@@ -19,6 +19,7 @@
 #include "common/versions/versions.h"
 
 #include "game/common/game_common_types.h"
+#include "game/overlord/common/fake_iso_file.h"
 #include "graphics/gfx_test.h"
 
 #include "third-party/CLI11.hpp"
@@ -98,6 +99,7 @@ int main(int argc, char** argv) {
   bool enable_profiling = false;
   bool enable_portable = false;
   bool disable_save_location_override = false;
+  bool mmap_iso = false;
   std::string profile_until_event = "";
   std::string gpu_test = "";
   std::string gpu_test_out_path = "";
@@ -121,6 +123,9 @@ int main(int argc, char** argv) {
   app.add_flag("--disable_save_location_override", disable_save_location_override,
                "If --config-path is provided along with this flag, saves will still be loaded and "
                "stored to the default location");
+  app.add_flag("--mmap-iso", mmap_iso,
+               "Memory map game files (DGO, STR, ...) instead of reading them. Faster loads, but "
+               "rebuilding a file while the game is running may crash it");
   app.add_option("--profile-until-event", profile_until_event,
                  "Stops recording profile events once an event with this name is seen");
   app.add_option("--gpu-test", gpu_test,
@@ -165,6 +170,7 @@ int main(int argc, char** argv) {
     return 0;
   }
 
+  fake_iso_use_mmap = mmap_iso;
   prof().set_enable(enable_profiling);
   prof().set_waiting_for_event(profile_until_event);
 
@@ -0,0 +1,186 @@
+#include "mips2c_native.h"
+
+#include <cstring>
+#include <memory>
+#include <utility>
+
+#include "common/log/log.h"
+#include "common/util/Timer.h"
+
+#include "game/mips2c/mips2c_private.h"
+#include "game/runtime.h"
+
+// clang-format off
+namespace Mips2C {
+namespace jak1 {
+namespace native_load_mesh_from_spad_in_box { extern void link(); extern u64 execute(void*); extern int outputs(const void*, EeRange*); }
+}
+namespace jak2 {
+namespace native_bones_mtx_calc { extern u64 execute(void*); extern int outputs(const void*, EeRange*); }
+}
+// clang-format on
+
+NativeFunctionTable gNativeFunctionTable;
+PerGameVersion<std::vector<NativePort>> gNativePorts = {
+    //////// JAK 1
+    {{"(method 26 collide-cache)", jak1::native_load_mesh_from_spad_in_box::link,
+      jak1::native_load_mesh_from_spad_in_box::execute,
+      jak1::native_load_mesh_from_spad_in_box::outputs}},
+    //////// JAK 2
+    {{"bones-mtx-calc", nullptr, jak2::native_bones_mtx_calc::execute,
+      jak2::native_bones_mtx_calc::outputs}},
+    //////// JAK 3
+    {}};
+
+namespace {
+// the trampoline can only call a plain function pointer, so each slot gets its own dispatcher.
+template <int Slot>
+u64 dispatch(void* ctxt) {
+  return gNativeFunctionTable.run(Slot, ctxt);
+}
+
+template <int... Slots>
+constexpr std::array<Mips2CFunc, sizeof...(Slots)> make_dispatchers(
+    std::integer_sequence<int, Slots...>) {
+  return {&dispatch<Slots>...};
+}
+
+constexpr auto kDispatchers =
+    make_dispatchers(std::make_integer_sequence<int, NativeFunctionTable::kMaxFunctions>());
+
+// only log the first few mismatches of each function, a broken port would mismatch every frame.
+constexpr u64 kMaxLoggedMismatches = 10;
+
+void copy_from_ee(const EeRange* ranges, int count, u8* dst) {
+  for (int i = 0; i < count; i++) {
+    memcpy(dst, g_ee_main_mem + ranges[i].addr, ranges[i].size);
+    dst += ranges[i].size;
+  }
+}
+
+void copy_to_ee(const EeRange* ranges, int count, const u8* src) {
+  for (int i = 0; i < count; i++) {
+    memcpy(g_ee_main_mem + ranges[i].addr, src, ranges[i].size);
+    src += ranges[i].size;
+  }
+}
+}  // namespace
+
+/*!
+ * Get the function to register in place of a mips2c function. If there is a native port, this is
+ * a dispatcher that picks the version based on the mode, otherwise it's the mips2c function.
+ */
+Mips2CFunc NativeFunctionTable::wrap(const std::string& name, Mips2CFunc mips2c) {
+  for (const auto& port : gNativePorts[g_game_version]) {
+    if (name != port.name) {
+      continue;
+    }
+
+    // when the runtime restarts, the functions are registered again. Reuse their old slots.
+    int slot_idx = 0;
+    while (slot_idx < m_slot_count && name != m_slots[slot_idx].port.name) {
+      slot_idx++;
+    }
+
+    if (slot_idx == kMaxFunctions) {
+      lg::error("Too many native mips2c functions, not using native version of {}", name);
+      return mips2c;
+    }
+
+    auto& slot = m_slots[slot_idx];
+    slot.port = port;
+    slot.mips2c = mips2c;
+    if (port.link) {
+      port.link();
+    }
+    if (slot_idx == m_slot_count) {
+      lg::info("Using native version of mips2c function {}", name);
+      m_slot_count++;
+    }
+    return kDispatchers[slot_idx];
+  }
+  return mips2c;
+}
+
+u64 NativeFunctionTable::run(int slot_idx, void* ctxt) {
+  auto& slot = m_slots[slot_idx];
+  slot.calls++;
+  switch (m_mode.load(std::memory_order_relaxed)) {
+    case NativeMode::MIPS2C:
+      return slot.mips2c(ctxt);
+    case NativeMode::NATIVE:
+      return slot.port.execute(ctxt);
+    case NativeMode::DIFFERENTIAL:
+      return run_differential(slot_idx, ctxt);
+  }
+  ASSERT_NOT_REACHED();
+  return 0;
+}
+
+/*!
+ * Run the mips2c version, then put the outputs back the way they were and run the native version
+ * with the same arguments. The mips2c results are the ones that are kept.
+ */
+u64 NativeFunctionTable::run_differential(int slot_idx, void* ctxt) {
+  auto& slot = m_slots[slot_idx];
+  EeRange ranges[kMaxNativeOutputs];
+  int range_count = slot.port.outputs(ctxt, ranges);
+  ASSERT(range_count <= kMaxNativeOutputs);
+  u32 total_size = 0;
+  for (int i = 0; i < range_count; i++) {
+    total_size += ranges[i].size;
+  }
+
+  // these are not members: a mips2c function can call GOAL code that runs another port.
+  std::vector<u8> before(total_size), expected(total_size), result(total_size);
+  copy_from_ee(ranges, range_count, before.data());
+  auto native_ctxt = std::make_unique<ExecutionContext>(*(ExecutionContext*)ctxt);
+
+  Timer mips2c_timer;
+  u64 expected_v0 = slot.mips2c(ctxt);
+  slot.mips2c_ms += mips2c_timer.getMs();
+  copy_from_ee(ranges, range_count, expected.data());
+  copy_to_ee(ranges, range_count, before.data());
+
+  Timer native_timer;
+  u64 native_v0 = slot.port.execute(native_ctxt.get());
+  slot.native_ms += native_timer.getMs();
+  copy_from_ee(ranges, range_count, result.data());
+  copy_to_ee(ranges, range_count, expected.data());
+
+  if (native_v0 != expected_v0 || result != expected) {
+    if (++slot.mismatches <= kMaxLoggedMismatches) {
+      if (native_v0 != expected_v0) {
+        lg::error("native mips2c {}: returned 0x{:x}, expected 0x{:x}", slot.port.name, native_v0,
+                  expected_v0);
+      }
+      u32 offset = 0;
+      for (int i = 0; i < range_count; i++) {
+        for (u32 j = 0; j < ranges[i].size; j++) {
+          if (result[offset + j] != expected[offset + j]) {
+            lg::error("native mips2c {}: output differs at 0x{:x} (range 0x{:x} + 0x{:x})",
+                      slot.port.name, ranges[i].addr + j, ranges[i].addr, j);
+            break;
+          }
+        }
+        offset += ranges[i].size;
+      }
+    }
+  }
+  return expected_v0;
+}
+
+std::vector<NativeFunctionStats> NativeFunctionTable::stats() const {
+  std::vector<NativeFunctionStats> result;
+  for (int i = 0; i < m_slot_count; i++) {
+    auto& stats = result.emplace_back();
+    stats.name = m_slots[i].port.name;
+    stats.calls = m_slots[i].calls;
+    stats.mismatches = m_slots[i].mismatches;
+    stats.mips2c_ms = m_slots[i].mips2c_ms;
+    stats.native_ms = m_slots[i].native_ms;
+  }
+  return result;
+}
+
+}  // namespace Mips2C
@@ -0,0 +1,87 @@
+#pragma once
+
+/*!
+ * @file mips2c_native.h
+ * Hand-written native replacements for mips2c functions.
+ *
+ * A native port has the same calling convention as the mips2c execute function it replaces: it
+ * gets the ExecutionContext with the arguments in the usual registers and returns v0. When the
+ * mips2c function is registered with the LinkedFunctionTable, the trampoline is pointed at a
+ * dispatcher that can run either version, or both, depending on the current NativeMode.
+ */
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/versions/versions.h"
+
+namespace Mips2C {
+
+using Mips2CFunc = u64 (*)(void*);
+
+enum class NativeMode : u8 {
+  MIPS2C,        // only run the mips2c version
+  NATIVE,        // only run the native version
+  DIFFERENTIAL,  // run both on the same inputs, compare, and keep the mips2c result
+};
+
+// a range of EE memory, as a GOAL address and size in bytes.
+struct EeRange {
+  u32 addr = 0;
+  u32 size = 0;
+};
+
+constexpr int kMaxNativeOutputs = 4;
+
+struct NativePort {
+  const char* name;  // the name passed to LinkedFunctionTable::reg
+  void (*link)();    // look up symbols used by the port, like the mips2c link()
+  Mips2CFunc execute;
+  // fill out the EE memory written by the function, computed from the arguments before it runs.
+  // returns the number of ranges. Only used by the differential mode.
+  int (*outputs)(const void* ctxt, EeRange* ranges);
+};
+
+struct NativeFunctionStats {
+  std::string name;
+  u64 calls = 0;
+  u64 mismatches = 0;
+  double mips2c_ms = 0;  // time spent in each version, only measured in the differential mode
+  double native_ms = 0;
+};
+
+class NativeFunctionTable {
+ public:
+  Mips2CFunc wrap(const std::string& name, Mips2CFunc mips2c);
+  u64 run(int slot, void* ctxt);
+
+  NativeMode mode() const { return m_mode; }
+  void set_mode(NativeMode mode) { m_mode = mode; }
+  std::vector<NativeFunctionStats> stats() const;
+
+  static constexpr int kMaxFunctions = 16;
+
+ private:
+  u64 run_differential(int slot, void* ctxt);
+
+  struct Slot {
+    NativePort port;
+    Mips2CFunc mips2c = nullptr;
+    std::atomic<u64> calls = 0;
+    std::atomic<u64> mismatches = 0;
+    double mips2c_ms = 0;
+    double native_ms = 0;
+  };
+  std::array<Slot, kMaxFunctions> m_slots;
+  int m_slot_count = 0;
+  // the native ports are opt-in, from the debug menu, until they've been checked in more places.
+  std::atomic<NativeMode> m_mode = NativeMode::MIPS2C;
+};
+
+extern NativeFunctionTable gNativeFunctionTable;
+extern PerGameVersion<std::vector<NativePort>> gNativePorts;
+
+}  // namespace Mips2C
@@ -1,5 +1,7 @@
 #include "mips2c_table.h"
 
+#include "mips2c_native.h"
+
 #include "common/log/log.h"
 #include "common/symbols.h"
 
@@ -661,7 +663,11 @@ void LinkedFunctionTable::reg(const std::string& name, u64 (*exec)(void*), u32 s
   if (!it.second) {
     lg::error("MIPS2C Function {} is registered multiple times, ignoring later registrations.",
               name);
+  } else {
+    // if there's a native port of this function, call that through a dispatcher instead.
+    it.first->second.c_func = gNativeFunctionTable.wrap(name, exec);
   }
+  exec = it.first->second.c_func;
 
   // this is short stub that will jump to the appropriate function.
   Ptr<u8> jump_to_asm;
@@ -0,0 +1,206 @@
+/*!
+ * @file jak1_collide_cache.cpp
+ * Native version of load-mesh-from-spad-in-box, (method 26 collide-cache)
+ * (mips2c/jak1_functions/collide_cache.cpp).
+ *
+ * This fills the collide cache with the triangles of a background mesh that was unpacked to the
+ * scratchpad, keeping the ones whose bounding box overlaps the collide box. The triangle strips
+ * are walked the same way as the mips2c version, and the box test is done with SSE.
+ */
+
+#include <cstdio>
+#include <cstring>
+
+#include "game/kernel/jak1/kscheme.h"
+#include "game/mips2c/mips2c_native.h"
+#include "game/mips2c/mips2c_private.h"
+
+using ::jak1::intern_from_c;
+namespace Mips2C::jak1 {
+namespace native_load_mesh_from_spad_in_box {
+struct Cache {
+  void* already_printed_exeeded_max_cache_tris;  // *already-printed-exeeded-max-cache-tris*
+  void* cheat_mode;                              // *cheat-mode*
+  void* fake_scratchpad_data;                    // *fake-scratchpad-data*
+  void* collide_cache_max_tris;                  // *collide-cache-max-tris*
+} cache;
+
+namespace {
+// offsets in collide-cache
+constexpr int kNumTrisOffset = 0;
+constexpr int kIgnoreMaskOffset = 8;
+constexpr int kBoxMinOffset = 60;  // collide-box4w
+constexpr int kBoxMaxOffset = 76;
+constexpr int kTrisOffset = 4908;
+constexpr int kTriSize = 64;
+
+// offsets in collide-frag-mesh
+constexpr int kPackedDataOffset = 0;
+constexpr int kPatArrayOffset = 4;
+constexpr int kStripDataLenOffset = 8;
+constexpr int kVertexDataQwcOffset = 25;
+
+// each vertex in the scratchpad is an integer vector (for the box test), then a float vector.
+constexpr int kSpadVertexSize = 32;
+
+template <typename T>
+T read(u32 addr) {
+  T result;
+  memcpy(&result, g_ee_main_mem + addr, sizeof(T));
+  return result;
+}
+
+template <typename T>
+void write(u32 addr, T val) {
+  memcpy(g_ee_main_mem + addr, &val, sizeof(T));
+}
+
+u32 symbol_value(void* sym) {
+  u32 result;
+  memcpy(&result, sym, 4);
+  return result;
+}
+
+// true if the bounding box of the triangle is outside of the box, only checking xyz.
+inline REALLY_INLINE bool outside_box(const u8* v0,
+                                      const u8* v1,
+                                      const u8* v2,
+                                      __m128i bmin,
+                                      __m128i bmax) {
+  __m128i p0 = _mm_load_si128((const __m128i*)v0);
+  __m128i p1 = _mm_load_si128((const __m128i*)v1);
+  __m128i p2 = _mm_load_si128((const __m128i*)v2);
+  __m128i tmin = _mm_min_epi32(_mm_min_epi32(p0, p1), p2);
+  __m128i tmax = _mm_max_epi32(_mm_max_epi32(p0, p1), p2);
+  __m128i out = _mm_or_si128(_mm_cmpgt_epi32(tmin, bmax), _mm_cmpgt_epi32(bmin, tmax));
+  return _mm_movemask_ps(_mm_castsi128_ps(out)) & 0b111;
+}
+
+// write a collide-cache-tri: the float part of the vertices, then the pat.
+inline REALLY_INLINE void write_tri(u8* dst,
+                                     const u8* v0,
+                                     const u8* v1,
+                                     const u8* v2,
+                                     u32 pat) {
+  _mm_store_si128((__m128i*)dst, _mm_load_si128((const __m128i*)(v0 + 16)));
+  _mm_store_si128((__m128i*)(dst + 16), _mm_load_si128((const __m128i*)(v1 + 16)));
+  _mm_store_si128((__m128i*)(dst + 32), _mm_load_si128((const __m128i*)(v2 + 16)));
+  _mm_store_si128((__m128i*)(dst + 48), _mm_cvtsi32_si128(pat));
+}
+}  // namespace
+
+void link() {
+  cache.already_printed_exeeded_max_cache_tris =
+      intern_from_c("*already-printed-exeeded-max-cache-tris*").c();
+  cache.cheat_mode = intern_from_c("*cheat-mode*").c();
+  cache.fake_scratchpad_data = intern_from_c("*fake-scratchpad-data*").c();
+  cache.collide_cache_max_tris = intern_from_c("*collide-cache-max-tris*").c();
+}
+
+u64 execute(void* ctxt) {
+  auto* c = (ExecutionContext*)ctxt;
+  const u32 ccache = c->gprs[a0].du32[0];
+  const u32 mesh = c->gprs[a1].du32[0];
+  const s64 max_tris = (s32)symbol_value(cache.collide_cache_max_tris);
+  s64 num_tris = read<u32>(ccache + kNumTrisOffset);
+
+  bool overflow = max_tris - num_tris < 0;
+  if (!overflow) {
+    const u8* spad = g_ee_main_mem + symbol_value(cache.fake_scratchpad_data);
+    u32 strip_addr =
+        read<u32>(mesh + kPackedDataOffset) + 16 * read<u8>(mesh + kVertexDataQwcOffset);
+    const s8* strip = (const s8*)(g_ee_main_mem + strip_addr);
+    const u8* pat_idx = g_ee_main_mem + strip_addr + read<u16>(mesh + kStripDataLenOffset);
+    const u32 pat_array = read<u32>(mesh + kPatArrayOffset);
+    const u32 ignore_mask = read<u32>(ccache + kIgnoreMaskOffset);
+    const __m128i bmin = _mm_load_si128((const __m128i*)(g_ee_main_mem + ccache + kBoxMinOffset));
+    const __m128i bmax = _mm_load_si128((const __m128i*)(g_ee_main_mem + ccache + kBoxMaxOffset));
+    u8* tri = g_ee_main_mem + ccache + kTrisOffset + num_tris * kTriSize;
+
+    // each strip starts with 3 vertex indices, then each byte adds a vertex:
+    // positive continues the strip, negative keeps the first vertex (a fan), 0 ends the strip.
+    // a negative first index ends the mesh.
+    while (!overflow && strip[0] >= 0) {
+      const u8* v0 = spad + kSpadVertexSize * strip[0];
+      const u8* v1 = spad + kSpadVertexSize * strip[1];
+      const u8* v2 = spad + kSpadVertexSize * strip[2];
+      strip += 3;
+
+      // note that the first triangle checks for a full cache before the pat, and the rest check
+      // after, like the original.
+      if (!outside_box(v0, v1, v2, bmin, bmax)) {
+        u32 pat = read<u32>(pat_array + 4 * *pat_idx);
+        if (num_tris == max_tris) {
+          overflow = true;
+          break;
+        }
+        if (!(pat & ignore_mask)) {
+          write_tri(tri, v0, v1, v2, pat);
+          tri += kTriSize;
+          num_tris++;
+        }
+      }
+      pat_idx++;
+
+      bool flip = false;
+      int next;
+      while ((next = *strip++) != 0) {
+        if (next > 0) {
+          v0 = v1;
+          flip = !flip;
+        } else {
+          next = -next;
+        }
+        v1 = v2;
+        v2 = spad + kSpadVertexSize * (next - 1);
+
+        if (!outside_box(v0, v1, v2, bmin, bmax)) {
+          u32 pat = read<u32>(pat_array + 4 * *pat_idx);
+          if (!(pat & ignore_mask)) {
+            if (num_tris == max_tris) {
+              overflow = true;
+              break;
+            }
+            if (flip) {
+              write_tri(tri, v2, v1, v0, pat);
+            } else {
+              write_tri(tri, v0, v1, v2, pat);
+            }
+            tri += kTriSize;
+            num_tris++;
+          }
+        }
+        pat_idx++;
+      }
+    }
+  }
+
+  if (overflow) {
+    write<u32>(ccache + kNumTrisOffset, max_tris);
+    const u32 s7_val = c->gprs[s7].du32[0];
+    if (symbol_value(cache.already_printed_exeeded_max_cache_tris) == s7_val &&
+        symbol_value(cache.cheat_mode) == s7_val + 8) {
+      printf(
+          "exceeded maximum collide cache tris (should print on screen but too lazy for that "
+          "now)\n");
+    }
+  } else {
+    write<u32>(ccache + kNumTrisOffset, num_tris);
+  }
+  return 0;
+}
+
+int outputs(const void* ctxt, EeRange* ranges) {
+  auto* c = (const ExecutionContext*)ctxt;
+  const u32 ccache = c->gprs[a0].du32[0];
+  const s64 max_tris = (s32)symbol_value(cache.collide_cache_max_tris);
+  const s64 num_tris = read<u32>(ccache + kNumTrisOffset);
+  ranges[0].addr = ccache + kNumTrisOffset;
+  ranges[0].size = 4;
+  ranges[1].addr = ccache + kTrisOffset + num_tris * kTriSize;
+  ranges[1].size = max_tris > num_tris ? (max_tris - num_tris) * kTriSize : 0;
+  return 2;
+}
+
+}  // namespace native_load_mesh_from_spad_in_box
+}  // namespace Mips2C::jak1
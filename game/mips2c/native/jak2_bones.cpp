@@ -0,0 +1,136 @@
+/*!
+ * @file jak2_bones.cpp
+ * Native version of bones-mtx-calc (mips2c/jak2_functions/bones.cpp).
+ *
+ * The mips2c version DMAs the joints and bones to the scratchpad in groups of 16, runs the VU0
+ * program on one bone at a time, and DMAs the results back out. This does the same math on
+ * kVuBatchWidth bones at once, directly from EE memory. Each operation is done in the same order
+ * as the VU0 program, so the results are bit-for-bit identical.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "game/common/vu_batch.h"
+#include "game/mips2c/mips2c_native.h"
+#include "game/mips2c/mips2c_private.h"
+
+namespace Mips2C::jak2 {
+namespace native_bones_mtx_calc {
+
+namespace {
+constexpr int kJointStride = 5;   // in quadwords, only the first 4 (the bind pose) are used
+constexpr int kBoneStride = 5;    // in quadwords, only the first 4 (the transform) are used
+constexpr int kOutputStride = 8;  // pris-mtx: t-mtx, then n-mtx (3 quadwords), then a zero
+
+struct Args {
+  u32 output;
+  u32 joints;
+  u32 bones;
+  u32 count;
+  u32 camera;
+};
+
+Args get_args(const ExecutionContext* c) {
+  Args args;
+  args.output = c->gprs[a0].du32[0];
+  // the same address the mips2c version starts the joint DMA from.
+  args.joints = (c->gprs[a1].du32[0] & 0x7fffffff) + 12 - 80;
+  args.bones = c->gprs[a2].du32[0] & 0x7fffffff;
+  args.count = c->gprs[a3].du32[0];
+  args.camera = c->gprs[t0].du32[0];
+  return args;
+}
+
+// opmula.xyz ACC, a, b ; opmsub.xyz dest, b, a
+inline REALLY_INLINE VfBatch cross(const VfBatch& a, const VfBatch& b) {
+  return {lanes_sub(lanes_mul(a.y, b.z), lanes_mul(b.y, a.z)),
+          lanes_sub(lanes_mul(a.z, b.x), lanes_mul(b.z, a.x)),
+          lanes_sub(lanes_mul(a.x, b.y), lanes_mul(b.x, a.y)), lanes_splat(0)};
+}
+
+/*!
+ * Compute kVuBatchWidth pris-mtx's. See exec_mpg in mips2c/jak2_functions/bones.cpp.
+ */
+inline REALLY_INLINE void calc_batch(const Vf* joints,
+                                     const Vf* bones,
+                                     const VfBatch* camera,
+                                     Vf* out) {
+  VfBatch joint[4], bone[4], tmat[4];
+  for (int i = 0; i < 4; i++) {
+    joint[i] = VfBatch::load(joints + i, kJointStride);
+    bone[i] = VfBatch::load(bones + i, kBoneStride);
+  }
+
+  AccBatch acc;
+  for (int i = 0; i < 4; i++) {
+    tmat[i] = acc.transform(bone, joint[i]);
+  }
+
+  // inverse transpose of the rotation, from the cofactors
+  VfBatch nmat[3] = {cross(tmat[1], tmat[2]), cross(tmat[2], tmat[0]), cross(tmat[0], tmat[1])};
+
+  // mulax.w, madday.w, maddz.w with vf00 to sum the components, then div Q, vf00.w, vf12.w
+  VuLanes det =
+      lanes_add(lanes_add(lanes_mul(tmat[0].x, nmat[0].x), lanes_mul(tmat[0].y, nmat[0].y)),
+                lanes_mul(tmat[0].z, nmat[0].z));
+  VuLanes q = lanes_div(lanes_splat(1.f), det);
+
+  for (int i = 0; i < 4; i++) {
+    acc.transform(camera, tmat[i]).store(out + i, kOutputStride);
+  }
+  for (int i = 0; i < 3; i++) {
+    acc.mula(camera[0], lanes_mul(nmat[i].x, q));
+    acc.madda(camera[1], lanes_mul(nmat[i].y, q));
+    acc.madd(camera[2], lanes_mul(nmat[i].z, q)).store(out + 4 + i, kOutputStride);
+  }
+  for (int i = 0; i < kVuBatchWidth; i++) {
+    out[7 + i * kOutputStride].set_zero();
+  }
+}
+}  // namespace
+
+u64 execute(void* ctxt) {
+  auto args = get_args((ExecutionContext*)ctxt);
+  const Vf* joints = (const Vf*)(g_ee_main_mem + args.joints);
+  const Vf* bones = (const Vf*)(g_ee_main_mem + args.bones);
+  const Vf* camera_rows = (const Vf*)(g_ee_main_mem + args.camera);
+  Vf* out = (Vf*)(g_ee_main_mem + args.output);
+
+  VfBatch camera[4];
+  for (int i = 0; i < 4; i++) {
+    camera[i] = VfBatch::splat(camera_rows[i]);
+  }
+
+  u32 done = 0;
+  for (; done + kVuBatchWidth <= args.count; done += kVuBatchWidth) {
+    calc_batch(joints + done * kJointStride, bones + done * kBoneStride, camera,
+               out + done * kOutputStride);
+  }
+
+  // the leftover bones go through a temporary buffer, padded by repeating the last one.
+  u32 left = args.count - done;
+  if (left) {
+    Vf tmp_joints[kVuBatchWidth * kJointStride];
+    Vf tmp_bones[kVuBatchWidth * kBoneStride];
+    Vf tmp_out[kVuBatchWidth * kOutputStride];
+    for (u32 i = 0; i < kVuBatchWidth; i++) {
+      u32 src = done + std::min(i, left - 1);
+      memcpy(&tmp_joints[i * kJointStride], joints + src * kJointStride, 4 * sizeof(Vf));
+      memcpy(&tmp_bones[i * kBoneStride], bones + src * kBoneStride, 4 * sizeof(Vf));
+    }
+    calc_batch(tmp_joints, tmp_bones, camera, tmp_out);
+    memcpy(out + done * kOutputStride, tmp_out, left * kOutputStride * sizeof(Vf));
+  }
+  return 0;
+}
+
+int outputs(const void* ctxt, EeRange* ranges) {
+  auto args = get_args((const ExecutionContext*)ctxt);
+  ranges[0].addr = args.output;
+  ranges[0].size = args.count * kOutputStride * 16;
+  return 1;
+}
+
+}  // namespace native_bones_mtx_calc
+}  // namespace Mips2C::jak2
@@ -122,19 +122,12 @@ const char* get_file_path(FileRecord* fr) {
 }
 
 /*!
- * Determine the length of a file. This isn't very fast, but nobody checks file sizes extremely
- * quickly. This is an ISO FS API Function
+ * Determine the length of a file. This is an ISO FS API Function
  */
 uint32_t FS_GetLength(FileRecord* fr) {
   const char* path = get_file_path(fr);
   file_util::assert_file_exists(path, "fake_iso FS_GetLength");
-  FILE* fp = file_util::open_file(path, "rb");
-  ASSERT(fp);
-  fseek(fp, 0, SEEK_END);
-  uint32_t len = ftell(fp);
-  rewind(fp);
-  fclose(fp);
-  return len;
+  return fs::file_size(fs::path(path));
 }
 
 void LoadMusicTweaks() {
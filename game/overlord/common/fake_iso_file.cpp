@@ -0,0 +1,120 @@
+#include "fake_iso_file.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/log/log.h"
+#include "common/util/Assert.h"
+#include "common/util/FileUtil.h"
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <sys/stat.h>
+#endif
+
+bool fake_iso_use_mmap = false;
+
+std::unique_ptr<FakeIsoFile> FakeIsoFile::open(const char* path) {
+  std::unique_ptr<FakeIsoFile> result(new FakeIsoFile());
+#ifdef _WIN32
+  result->m_fd = _wopen(fs::path(path).wstring().c_str(), _O_RDONLY | _O_BINARY);
+  if (result->m_fd < 0) {
+    return nullptr;
+  }
+  result->m_size = _filelengthi64(result->m_fd);
+#else
+  result->m_fd = ::open(path, O_RDONLY);
+  if (result->m_fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (fstat(result->m_fd, &st)) {
+    return nullptr;
+  }
+  result->m_size = st.st_size;
+#endif
+
+  if (fake_iso_use_mmap && result->m_size) {
+    try {
+      result->m_map = std::make_unique<MappedFile>(fs::path(path));
+      result->m_size = result->m_map->size();
+    } catch (std::runtime_error& e) {
+      lg::warn("[OVERLORD] failed to map {}, will read it instead: {}", path, e.what());
+    }
+  }
+  return result;
+}
+
+FakeIsoFile::~FakeIsoFile() {
+  if (m_fd >= 0) {
+#ifdef _WIN32
+    _close(m_fd);
+#else
+    close(m_fd);
+#endif
+  }
+}
+
+u64 FakeIsoFile::read(void* dest, u64 offset, u64 len) {
+  if (offset >= m_size) {
+    return 0;
+  }
+  len = std::min(len, m_size - offset);
+
+  if (m_map) {
+    memcpy(dest, m_map->span().data() + offset, len);
+    return len;
+  }
+
+  u64 done = 0;
+  while (done < len) {
+#ifdef _WIN32
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = (DWORD)(offset + done);
+    overlapped.OffsetHigh = (DWORD)((offset + done) >> 32);
+    DWORD got = 0;
+    DWORD to_read = (DWORD)std::min<u64>(len - done, 1u << 30);
+    if (!ReadFile((HANDLE)_get_osfhandle(m_fd), (u8*)dest + done, to_read, &got, &overlapped)) {
+      break;
+    }
+#else
+    auto got = pread(m_fd, (u8*)dest + done, len - done, offset + done);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got < 0) {
+      lg::error("[OVERLORD] fake iso read failed: {}", strerror(errno));
+      break;
+    }
+#endif
+    if (got == 0) {
+      break;
+    }
+    done += got;
+  }
+  return done;
+}
+
+void FakeIsoFile::prefetch(u64 offset, u64 len) {
+  if (offset >= m_size) {
+    return;
+  }
+  len = std::min(len, m_size - offset);
+
+  // both of these only start the read, they don't wait for it.
+  if (m_map) {
+    m_map->advise_will_need(offset, len);
+    return;
+  }
+#ifdef __linux__
+  posix_fadvise(m_fd, offset, len, POSIX_FADV_WILLNEED);
+#endif
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+/*!
+ * @file fake_iso_file.h
+ * An open file in the fake iso.
+ * The size is found once when the file is opened, and reads are positional, so reading a batch of
+ * sectors is a single syscall (or a memcpy, if the file is memory mapped).
+ */
+
+#include <memory>
+
+#include "common/common_types.h"
+#include "common/util/MappedFile.h"
+
+// memory map files opened by the fake iso, instead of reading them. Off by default, because
+// rebuilding a file while the game has it mapped can crash the game.
+extern bool fake_iso_use_mmap;
+
+class FakeIsoFile {
+ public:
+  // returns nullptr if the file can't be opened.
+  static std::unique_ptr<FakeIsoFile> open(const char* path);
+  ~FakeIsoFile();
+  FakeIsoFile(const FakeIsoFile&) = delete;
+  FakeIsoFile& operator=(const FakeIsoFile&) = delete;
+
+  u64 size() const { return m_size; }
+
+  // read up to len bytes starting at offset. Returns the number of bytes read, which is less than
+  // len if the end of the file is reached.
+  u64 read(void* dest, u64 offset, u64 len);
+
+  // hint that this range will be read soon, so the OS can start loading it in the background.
+  void prefetch(u64 offset, u64 len);
+
+ private:
+  FakeIsoFile() = default;
+  int m_fd = -1;
+  u64 m_size = 0;
+  std::unique_ptr<MappedFile> m_map;
+};
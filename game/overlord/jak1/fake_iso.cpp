@@ -6,6 +6,7 @@
 #include "common/util/FileUtil.h"
 
 #include "game/overlord/common/fake_iso.h"
+#include "game/overlord/common/fake_iso_file.h"
 #include "game/overlord/common/overlord.h"
 #include "game/overlord/common/soundcommon.h"
 #include "game/overlord/jak1/isocommon.h"
@@ -39,20 +40,22 @@ void fake_iso_init_globals() {
   fake_iso.load_sound_bank = FS_LoadSoundBank;
   fake_iso.load_music = FS_LoadMusic;
 
-  memset(sLoadStack, 0, sizeof(sLoadStack));
+  for (auto& entry : sLoadStack) {
+    entry = LoadStackEntry();
+  }
   sReadInfo = nullptr;
 }
 
-static FILE* open_fr(FileRecord* fr, s32 thread_to_wake) {
+static std::unique_ptr<FakeIsoFile> open_fr(FileRecord* fr, s32 thread_to_wake) {
   const char* path = get_file_path(fr);
-  FILE* fp = file_util::open_file(path, "rb");
-  if (!fp) {
+  auto file = FakeIsoFile::open(path);
+  if (!file) {
     lg::error("[OVERLORD] fake iso could not open the file \"{}\"", path);
   }
 
   iop::iWakeupThread(thread_to_wake);
 
-  return fp;
+  return file;
 }
 
 /*!
@@ -76,7 +79,7 @@ LoadStackEntry* FS_Open(FileRecord* fr, int32_t offset) {
 
       auto future = thpool.submit(open_fr, fr, iop::GetThreadId());
       iop::SleepThread();
-      selected->fp = future.get();
+      selected->file = future.get();
 
       return selected;
     }
@@ -102,7 +105,7 @@ LoadStackEntry* FS_OpenWad(FileRecord* fr, int32_t offset) {
 
       auto future = thpool.submit(open_fr, fr, iop::GetThreadId());
       iop::SleepThread();
-      selected->fp = future.get();
+      selected->file = future.get();
 
       return selected;
     }
@@ -121,7 +124,7 @@ void FS_Close(LoadStackEntry* fd) {
 
   // close the FD
   fd->fr = nullptr;
-  fclose(fd->fp);
+  fd->file.reset();
   if (fd == sReadInfo) {
     sReadInfo = nullptr;
   }
@@ -138,23 +141,13 @@ void fs_read(LoadStackEntry* fd, void* buffer, int32_t len, s32 thread_to_wake)
   real_size = sectors * SECTOR_SIZE;
   u32 offset_into_file = SECTOR_SIZE * fd->location;
 
-  ASSERT(fd->fp);
-  fseek(fd->fp, 0, SEEK_END);
-  uint32_t file_len = ftell(fd->fp);
-  rewind(fd->fp);
-
-  if (offset_into_file < file_len) {
-    if (offset_into_file) {
-      fseek(fd->fp, offset_into_file, SEEK_SET);
-    }
-
-    if (offset_into_file + real_size > file_len) {
-      real_size = (file_len - offset_into_file);
-    }
-
-    if (fread(buffer, real_size, 1, fd->fp) != 1) {
-      ASSERT(false);
-    }
+  ASSERT(fd->file);
+  // the file size was found when it was opened, so this is a single read with no seeking.
+  u64 file_len = fd->file->size();
+  u64 expected =
+      offset_into_file < file_len ? std::min<u64>(real_size, file_len - offset_into_file) : 0;
+  if (fd->file->read(buffer, offset_into_file, real_size) != expected) {
+    ASSERT(false);
   }
 
   if (len < 0) {
@@ -164,14 +157,15 @@ void fs_read(LoadStackEntry* fd, void* buffer, int32_t len, s32 thread_to_wake)
   fd->location += (len / SECTOR_SIZE);
   sReadInfo = fd;
 
+  // reads are usually sequential, so start loading the next batch now.
+  fd->file->prefetch(SECTOR_SIZE * fd->location, real_size);
+
   iop::iWakeupThread(thread_to_wake);
 }
 
 /*!
  * Begin reading!  Returns FS_READ_OK on success (always)
  * This is an ISO FS API Function
- *
- * Idea: do the fopen in FS_Open and keep the file open?  It would be faster.
  */
 uint32_t FS_BeginRead(LoadStackEntry* fd, void* buffer, int32_t len) {
   ASSERT(fd->fr->location < fake_iso_entry_count);
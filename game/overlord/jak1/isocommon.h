@@ -5,12 +5,14 @@
  * Common ISO utilities.
  */
 
+#include <memory>
 #include <string>
 
 #include "common/common_types.h"
 #include "common/link_types.h"
 
 #include "game/common/overlord_common.h"
+#include "game/overlord/common/fake_iso_file.h"
 #include "game/overlord/common/isocommon.h"
 #include "game/overlord/jak1/ssound.h"
 
@@ -39,9 +41,9 @@ constexpr int SET_DIALOG_VOLUME = 0x406;    // Command to set the volume of vag
  * Record for an open file.
  */
 struct LoadStackEntry {
-  FileRecord* fr;
-  uint32_t location;  // sectors.
-  FILE* fp;
+  FileRecord* fr = nullptr;
+  uint32_t location = 0;              // sectors.
+  std::unique_ptr<FakeIsoFile> file;  // kept open until the entry is closed.
 };
 
 /*!
@@ -9,6 +9,7 @@
 
 #include "game/common/overlord_common.h"
 #include "game/overlord/common/fake_iso.h"
+#include "game/overlord/common/fake_iso_file.h"
 #include "game/overlord/common/isocommon.h"
 #include "game/overlord/common/sbank.h"
 #include "game/overlord/jak2/iso_queue.h"
@@ -82,7 +83,7 @@ u32 FS_SyncRead();
 
 struct FakeCd {
   int offset_into_file = 0;
-  FILE* fp = nullptr;
+  std::unique_ptr<FakeIsoFile> file;
   void (*callback)(int) = nullptr;
   FileRecord* last_fr = nullptr;
 } gFakeCd;
@@ -118,14 +119,15 @@ void iso_cd_init_globals() {
   iso_cd.load_music = FS_LoadMusic;
   iso_cd.sync_read = FS_SyncRead;
   gFakeCd.last_fr = nullptr;
+  gFakeCd.file.reset();
 }
 
-static FILE* open_fr(FileRecord* fr, s32 thread_to_wake) {
+static FakeIsoFile* open_fr(FileRecord* fr, s32 thread_to_wake) {
   const char* path = get_file_path(fr);
-  FILE* fp = file_util::open_file(path, "rb");
+  auto file = FakeIsoFile::open(path);
   iop::iWakeupThread(thread_to_wake);
 
-  return fp;
+  return file.release();
 }
 
 ///////////////////////////
@@ -142,15 +144,17 @@ int sceCdRead(int lsn, int num_sectors, void* dest, void* mode) {
   (void)mode;
   auto do_read = [lsn, num_sectors, dest](s32 thid) {
     // printf("sceCdRead %d, %d -> %p\n", lsn, num_sectors, dest);
-    ASSERT(gFakeCd.fp);
-    if (fseek(gFakeCd.fp, lsn * SECTOR_SIZE, SEEK_SET)) {
-      ASSERT_MSG(false, "Failed to fseek");
-    }
-    if (fread(dest, num_sectors * SECTOR_SIZE, 1, gFakeCd.fp) < 0) {
+    ASSERT(gFakeCd.file);
+    u64 offset = (u64)lsn * SECTOR_SIZE;
+    u64 len = (u64)num_sectors * SECTOR_SIZE;
+    // reading past the end of the file is allowed, the rest of dest is left as-is.
+    u64 expected = offset < gFakeCd.file->size() ? std::min(len, gFakeCd.file->size() - offset) : 0;
+    if (gFakeCd.file->read(dest, offset, len) != expected) {
       printf("dest is %p, num_sectors %d, lsn %d\n", dest, num_sectors, lsn);
-      printf("err: %s\n", strerror(errno));
-      ASSERT_MSG(false, "Failed to fread");
+      ASSERT_MSG(false, "Failed to read");
     }
+    // pages are read in order, so start loading the next ones now.
+    gFakeCd.file->prefetch(offset + len, len);
     ASSERT(gFakeCd.callback);
 
     iWakeupThread(thid);
@@ -613,19 +617,16 @@ int FS_PageBeginRead(LoadStackEntry* lse, Buffer* buffer) {
     if (gFakeCd.last_fr != lse->fr) {
       auto future = thpool.submit(open_fr, lse->fr, GetThreadId());
       SleepThread();
-      FILE* fp = future.get();
-      if (!fp) {
+      std::unique_ptr<FakeIsoFile> file(future.get());
+      if (!file) {
         lg::error("[OVERLORD] fake iso could not open the file \"{}\"", get_file_path(lse->fr));
       } else {
         // printf("PAGE READING %s\n", path);
       }
 
-      ASSERT(fp);
+      ASSERT(file);
 
-      if (gFakeCd.fp) {
-        fclose(gFakeCd.fp);
-      }
-      gFakeCd.fp = fp;
+      gFakeCd.file = std::move(file);
       gFakeCd.last_fr = lse->fr;
     }
 
@@ -353,6 +353,12 @@ void iop_runner(SystemThreadInterface& iface, GameVersion version) {
     }
   }
 
+  for (auto& stats : iop.kernel.thread_stats()) {
+    lg::debug("[IOP] thread {} ({}, prio {}): {} runs, {:.2f} ms, latency {:.1f} us avg {} us max",
+              stats.name, stats.id, stats.priority, stats.run_count, stats.run_time_us / 1000.,
+              (double)stats.total_latency_us / stats.run_count, stats.max_latency_us);
+  }
+
   Gfx::clear_vsync_callback();
 }
 }  // namespace
@@ -59,6 +59,15 @@ void LIBRARY_sceDeci2_register(::Deci2Server* s) {
   server = s;
 }
 
+/*!
+ * Let the server deliver the next message. Call once the last received message is no longer needed.
+ */
+void LIBRARY_sceDeci2_recv_done() {
+  if (server) {
+    server->send_recv_done();
+  }
+}
+
 /*!
  * Open a new socket with given protocol number and handler.
  * The "opt" pointer is passed to the handler function.
@@ -14,6 +14,7 @@ namespace ee {
 void LIBRARY_INIT_sceDeci2();
 void LIBRARY_sceDeci2_run_sends();
 void LIBRARY_sceDeci2_register(::Deci2Server* server);
+void LIBRARY_sceDeci2_recv_done();
 
 s32 sceDeci2Open(u16 protocol, void* opt, void (*handler)(s32 event, s32 param, void* opt));
 s32 sceDeci2Close(s32 s);
@@ -83,8 +83,8 @@ s32 sceSifCallRpc(sceSifClientData* bd,
   ASSERT(!end_func);
   ASSERT(!end_para);
   ASSERT(mode == 1);  // async
+  // this wakes up the IOP.
   iop->kernel.sif_rpc(bd->rpcd.id, fno, mode, send, ssize, recv, rsize);
-  iop->signal_run_iop();
   return 0;
 }
 
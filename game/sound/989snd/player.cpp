@@ -98,7 +98,7 @@ void Player::Tick(s16Output* stream, int samples) {
   std::scoped_lock lock(mTickLock);
   static int htick = 200;
   static int stick = 48000;
-  for (int i = 0; i < samples; i++) {
+  while (samples > 0) {
     // The handlers expect to tick at 240hz
     // 48000/240 = 200
     if (htick == 200) {
@@ -123,9 +123,13 @@ void Player::Tick(s16Output* stream, int samples) {
       stick = 0;
     }
 
-    stick++;
-    htick++;
-    *stream++ = mSynth.Tick();
+    // mix everything up to the next handler tick in one go.
+    int block = std::min(samples, 200 - htick);
+    stick += block;
+    htick += block;
+    mSynth.Tick(stream, block);
+    stream += block;
+    samples -= block;
   }
 }
 
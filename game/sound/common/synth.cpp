@@ -2,8 +2,15 @@
 // SPDX-License-Identifier: ISC
 #include "synth.h"
 
+#include <algorithm>
 #include <stdexcept>
 
+#ifdef __aarch64__
+#include "third-party/sse2neon/sse2neon.h"
+#else
+#include <immintrin.h>
+#endif
+
 namespace snd {
 
 static s16 ApplyVolume(s16 sample, s32 volume) {
@@ -26,6 +33,69 @@ s16Output Synth::Tick() {
   return out;
 }
 
+void Synth::Tick(s16Output* out, int count) {
+  while (count > 0) {
+    int block = std::min(count, kBlockSize);
+    MixBlock(out, block);
+    out += block;
+    count -= block;
+  }
+}
+
+void Synth::MixBlock(s16Output* out, int count) {
+  static_assert(sizeof(s16Output) == 4);
+  std::fill(out, out + count, s16Output{});
+
+  int vec_count = count / 4;  // 4 stereo samples per vector
+  auto prev = mVoices.before_begin();
+  for (auto it = mVoices.begin(); it != mVoices.end();) {
+    int ran = (*it)->Run(mVoiceBuf.data(), count);
+    if (ran > 0) {
+      // saturating add, done in the same voice order as Tick(), so clipping is identical.
+      for (int i = 0; i < vec_count; i++) {
+        auto* dst = (__m128i*)(out + i * 4);
+        auto src = _mm_loadu_si128((const __m128i*)(mVoiceBuf.data() + i * 4));
+        _mm_storeu_si128(dst, _mm_adds_epi16(_mm_loadu_si128(dst), src));
+      }
+      for (int i = vec_count * 4; i < count; i++) {
+        out[i] += mVoiceBuf[i];
+      }
+    }
+
+    // a voice that died before the end of the block would have been removed by Tick(). One that
+    // died on the last sample is left until the next block, in case it is keyed on again first.
+    if (ran < count) {
+      it = mVoices.erase_after(prev);
+    } else {
+      prev = it++;
+    }
+  }
+
+  // the master volume register (not the swept level) is applied, so it's constant over the block.
+  u16 vol_l = mVolume.left.Get();
+  u16 vol_r = mVolume.right.Get();
+  // (sample * volume) >> 15 for a signed sample and unsigned volume, from the low and high halves
+  // of the 16x16 bit product. mulhi_epi16 treats the volume as signed, so correct the high half
+  // by adding the sample back when the volume's top bit is set.
+  const __m128i vol = _mm_setr_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r);
+  const __m128i vol_sign = _mm_srai_epi16(vol, 15);
+  for (int i = 0; i < vec_count; i++) {
+    auto* ptr = (__m128i*)(out + i * 4);
+    auto sample = _mm_loadu_si128(ptr);
+    auto lo = _mm_mullo_epi16(sample, vol);
+    auto hi = _mm_add_epi16(_mm_mulhi_epi16(sample, vol), _mm_and_si128(sample, vol_sign));
+    _mm_storeu_si128(ptr, _mm_or_si128(_mm_slli_epi16(hi, 1), _mm_srli_epi16(lo, 15)));
+  }
+  for (int i = vec_count * 4; i < count; i++) {
+    out[i].left = ApplyVolume(out[i].left, vol_l);
+    out[i].right = ApplyVolume(out[i].right, vol_r);
+  }
+
+  for (int i = 0; i < count; i++) {
+    mVolume.Run();
+  }
+}
+
 void Synth::AddVoice(std::shared_ptr<Voice> voice) {
   mVoices.emplace_front(voice);
 }
@@ -1,6 +1,7 @@
 // Copyright: 2021 - 2024, Ziemas
 // SPDX-License-Identifier: ISC
 #pragma once
+#include <array>
 #include <forward_list>
 #include <memory>
 #include <unordered_map>
@@ -26,11 +27,18 @@ class Synth {
   }
 
   s16Output Tick();
+  // Produce count samples. Matches calling Tick() count times.
+  void Tick(s16Output* out, int count);
   void AddVoice(std::shared_ptr<Voice> voice);
   void SetMasterVol(u32 volume);
 
  private:
+  static constexpr int kBlockSize = 256;
+
+  void MixBlock(s16Output* out, int count);
+
   std::forward_list<std::shared_ptr<Voice>> mVoices;
+  std::array<s16Output, kBlockSize> mVoiceBuf{};
 
   VolumePair mVolume{};
 };
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: ISC
 #include "voice.h"
 
+#include <algorithm>
 #include <array>
 
 namespace snd {
@@ -134,4 +135,18 @@ s16Output Voice::Run() {
 
   return s16Output{left, right};
 }
+
+int Voice::Run(s16Output* out, int count) {
+  // ADPCM decoding and the envelopes have to stay per-sample: the decoder runs a fixed distance
+  // ahead of playback and may stop the voice at a loop end, so decoding further ahead would change
+  // when the voice stops.
+  for (int i = 0; i < count; i++) {
+    if (Dead()) {
+      std::fill(out + i, out + count, s16Output{});
+      return i;
+    }
+    out[i] = Run();
+  }
+  return count;
+}
 }  // namespace snd
@@ -19,6 +19,9 @@ class Voice {
 
   Voice(AllocationType alloc = AllocationType::Managed) : mAlloc(alloc) {}
   s16Output Run();
+  // Run for a block of samples. Once the voice is dead, the rest of the block is silent, like a
+  // voice that has been removed from the synth. Returns how many samples were run.
+  int Run(s16Output* out, int count);
 
   void KeyOn();
 
@@ -7,6 +7,8 @@
 // clang-format off
 #include "Deci2Server.h"
 
+#include <algorithm>
+
 #include "common/cross_sockets/XSocket.h"
 #include "common/versions/versions.h"
 #include "common/listener_common.h"
@@ -98,11 +100,38 @@ void Deci2Server::send_proto_ready(Deci2Driver* drivers, int* driver_count) {
   cv.notify_all();
 }
 
+/*!
+ * Inform server that the protocol is done with the last message it received.
+ * The listener may send several messages without waiting for a reply, so the next one is left in
+ * the socket until the target is finished with the previous one.
+ */
+void Deci2Server::send_recv_done() {
+  lock();
+  awaiting_recv_done = false;
+  unlock();
+  cv.notify_all();
+}
+
+/*!
+ * Wait for the protocol to finish with the last message. Gives up after a short timeout so the
+ * caller can check if it should exit. Returns true if it's ok to receive the next message.
+ */
+bool Deci2Server::wait_for_recv_done() {
+  std::unique_lock<std::mutex> lk(server_mutex);
+  return cv.wait_for(lk, std::chrono::milliseconds(100),
+                     [&] { return !awaiting_recv_done || want_shutdown; }) &&
+         !want_shutdown;
+}
+
 void Deci2Server::read_data() {
   if (!is_client_connected()) {
     return;
   }
 
+  if (!wait_for_recv_done()) {
+    return;
+  }
+
   int desired_size = (int)sizeof(Deci2Header);
   int got = 0;
 
@@ -150,7 +179,8 @@ void Deci2Server::read_data() {
       //      driver.next_recv_size = 0;
       //      driver.next_recv = nullptr;
       driver.recv_buffer = buffer.data() + sent_to_program;
-      driver.available_to_receive = hdr->rsvd - sent_to_program;
+      // sceDeci2ExRecv takes a u16 size, so don't offer more than that at once.
+      driver.available_to_receive = std::min(hdr->rsvd - sent_to_program, 0xffffu);
       (driver.handler)(DECI2_READ, driver.available_to_receive, driver.opt);
       //      memcpy(driver.next_recv, buffer + sent_to_program, driver.next_recv_size);
       sent_to_program += driver.recv_size;
@@ -168,6 +198,7 @@ void Deci2Server::read_data() {
   }
 
   (driver.handler)(DECI2_READDONE, 0, driver.opt);
+  awaiting_recv_done = true;
   unlock();
 }
 
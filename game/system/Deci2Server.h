@@ -22,16 +22,19 @@ class Deci2Server : public XSocketServer {
   bool wait_for_protos_ready();  // return true if ready, false if we should shut down.
   void send_proto_ready(Deci2Driver* drivers, int* driver_count);
   void send_shutdown();
+  void send_recv_done();
 
   void lock();
   void unlock();
 
  protected:
   void accept_thread_func();
+  bool wait_for_recv_done();
 
  private:
   bool want_shutdown = false;
   bool protocols_ready = false;
+  bool awaiting_recv_done = false;  // protocol still has the last message in its buffer
   std::condition_variable cv;
   Deci2Driver* d2_drivers = nullptr;
   int* d2_driver_count = nullptr;
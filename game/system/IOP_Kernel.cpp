@@ -1,5 +1,6 @@
 #include "IOP_Kernel.h"
 
+#include <algorithm>
 #include <cstring>
 
 #include "common/log/log.h"
@@ -56,7 +57,7 @@ s32 IOP_Kernel::CreateThread(std::string name, void (*func)(), u32 priority) {
  * Start a thread. Marking it to run on each dispatch of the IOP kernel.
  */
 void IOP_Kernel::StartThread(s32 id) {
-  threads.at(id).state = IopThread::State::Ready;
+  makeReady(&threads.at(id), time_point_cast<microseconds>(steady_clock::now()));
 }
 
 s32 IOP_Kernel::ExitThread() {
@@ -76,6 +77,7 @@ void IOP_Kernel::DelayThread(u32 usec) {
   _currentThread->waitType = IopThread::Wait::Delay;
   _currentThread->resumeTime =
       time_point_cast<microseconds>(steady_clock::now()) + microseconds(usec);
+  delay_queue.emplace(_currentThread->resumeTime, _currentThread->thID);
   leaveThread();
 }
 
@@ -94,13 +96,20 @@ void IOP_Kernel::SleepThread() {
  */
 void IOP_Kernel::WakeupThread(s32 id) {
   ASSERT(id > 0);
-  threads.at(id).state = IopThread::State::Ready;
+  makeReady(&threads.at(id), time_point_cast<microseconds>(steady_clock::now()));
 }
 
+/*!
+ * Wake up a thread from outside of the IOP threads. The IOP is signaled so it runs the thread
+ * right away instead of at its next timeout.
+ */
 void IOP_Kernel::iWakeupThread(s32 id) {
   ASSERT(id > 0);
-  std::scoped_lock lock(wakeup_mtx);
-  wakeup_queue.push(id);
+  {
+    std::scoped_lock lock(wakeup_mtx);
+    wakeup_queue.push(id);
+  }
+  signal_event();
 }
 
 s32 IOP_Kernel::WaitSema(s32 id) {
@@ -143,8 +152,7 @@ s32 IOP_Kernel::SignalSema(s32 id) {
     sema.wait_list.erase(it);
   }
 
-  to_run->waitType = IopThread::Wait::None;
-  to_run->state = IopThread::State::Ready;
+  makeReady(to_run, time_point_cast<microseconds>(steady_clock::now()));
   return KE_OK;
 }
 
@@ -183,45 +191,66 @@ void IOP_Kernel::runThread(IopThread* thread) {
   ASSERT(_currentThread == nullptr);  // should run in the kernel thread
   _currentThread = thread;
   thread->state = IopThread::State::Run;
+
+  auto start = time_point_cast<microseconds>(steady_clock::now());
+  u64 latency = std::max<s64>(0, (start - thread->readyTime).count());
+  thread->totalLatencyUs += latency;
+  thread->maxLatencyUs = std::max(thread->maxLatencyUs, latency);
+  thread->runCount++;
+
   co_switch(thread->thread);
+
+  thread->runTimeUs += (time_point_cast<microseconds>(steady_clock::now()) - start).count();
   _currentThread = nullptr;
 }
 
+/*!
+ * Mark a thread as ready to run. The ready time is used for the latency stats.
+ */
+void IOP_Kernel::makeReady(IopThread* thread, time_stamp ready_time) {
+  if (thread->state == IopThread::State::Ready) {
+    return;
+  }
+  thread->waitType = IopThread::Wait::None;
+  thread->state = IopThread::State::Ready;
+  thread->readyTime = ready_time;
+  ready_queue.emplace(thread->priority, thread->thID);
+}
+
 /*!
 ** Update wait states for delayed threads
 */
 void IOP_Kernel::updateDelay() {
-  for (auto& t : threads) {
-    if (t.waitType == IopThread::Wait::Delay) {
-      if (steady_clock::now() > t.resumeTime) {
-        t.waitType = IopThread::Wait::None;
-        t.state = IopThread::State::Ready;
-      }
+  auto now = time_point_cast<microseconds>(steady_clock::now());
+  while (!delay_queue.empty() && delay_queue.top().first <= now) {
+    auto [resume_time, id] = delay_queue.top();
+    delay_queue.pop();
+    auto& t = threads.at(id);
+    // skip threads that were woken up early, or delayed again since.
+    if (t.waitType == IopThread::Wait::Delay && t.resumeTime == resume_time) {
+      makeReady(&t, resume_time);
     }
   }
 }
 
 std::optional<time_stamp> IOP_Kernel::nextWakeup() {
-  bool found_ready = false;
-  time_stamp lowest = time_point_cast<microseconds>(steady_clock::now()) + microseconds(1000);
-
-  for (auto& t : threads) {
-    if (t.waitType == IopThread::Wait::Delay) {
-      if (t.resumeTime < lowest) {
-        lowest = t.resumeTime;
-      }
-    }
-
-    if (t.state == IopThread::State::Ready) {
-      found_ready = true;
-    }
+  if (!ready_queue.empty()) {
+    return {};
   }
 
-  if (found_ready) {
-    return {};
-  } else {
-    return lowest;
+  // wakeups from other threads and vblanks signal the event, so this can sleep for a while when
+  // nothing is delayed. It still wakes up now and then to check for exit.
+  time_stamp lowest = time_point_cast<microseconds>(steady_clock::now()) + milliseconds(100);
+  while (!delay_queue.empty()) {
+    auto [resume_time, id] = delay_queue.top();
+    auto& t = threads.at(id);
+    if (t.waitType == IopThread::Wait::Delay && t.resumeTime == resume_time) {
+      lowest = std::min(lowest, resume_time);
+      break;
+    }
+    delay_queue.pop();
   }
+  return lowest;
 }
 
 /*!
@@ -229,22 +258,15 @@ std::optional<time_stamp> IOP_Kernel::nextWakeup() {
 ** i.e. Highest prio in ready state.
 */
 IopThread* IOP_Kernel::schedNext() {
-  IopThread* highest_prio = nullptr;
-
-  for (auto& t : threads) {
+  while (!ready_queue.empty()) {
+    auto& t = threads.at(ready_queue.begin()->second);
+    ready_queue.erase(ready_queue.begin());
+    // skip threads that went back to waiting without running, or were already run.
     if (t.state == IopThread::State::Ready) {
-      if (highest_prio == nullptr) {
-        highest_prio = &t;
-      }
-
-      // Lower number = higher priority
-      if (t.priority < highest_prio->priority) {
-        highest_prio = &t;
-      }
+      return &t;
     }
   }
-
-  return highest_prio;
+  return nullptr;
 };
 
 void IOP_Kernel::processWakeups() {
@@ -264,18 +286,20 @@ std::optional<time_stamp> IOP_Kernel::dispatch() {
   processWakeups();
 
   // Run until all threads are idle
-  IopThread* next = schedNext();
-  while (next != nullptr) {
-    // Check vblank interrupt
-    if (vblank_handler != nullptr && vblank_recieved) {
+  while (true) {
+    // Check vblank interrupt. This is done even if no threads are ready, the handler is usually
+    // what wakes them up.
+    if (vblank_handler != nullptr && vblank_recieved.exchange(false)) {
       vblank_handler(nullptr);
-      vblank_recieved = false;
+    }
+    IopThread* next = schedNext();
+    if (next == nullptr) {
+      break;
     }
     // printf("[IOP Kernel] Dispatch %s (%d)\n", next->name.c_str(), next->thID);
     runThread(next);
     updateDelay();
     processWakeups();
-    next = schedNext();
     // printf("[IOP Kernel] back to kernel!\n");
   }
 
@@ -283,6 +307,45 @@ std::optional<time_stamp> IOP_Kernel::dispatch() {
   return nextWakeup();
 }
 
+/*!
+ * Signal the IOP thread that it has something to do. Can be called from any thread. If the IOP
+ * isn't waiting, the next wait_for_event returns right away.
+ */
+void IOP_Kernel::signal_event() {
+  {
+    std::scoped_lock lock(event_mtx);
+    event_pending = true;
+  }
+  event_cv.notify_one();
+}
+
+/*!
+ * Wait until signal_event is called, or until the timeout.
+ */
+void IOP_Kernel::wait_for_event(time_stamp timeout) {
+  std::unique_lock lock(event_mtx);
+  event_cv.wait_until(lock, timeout, [&] { return event_pending; });
+  event_pending = false;
+}
+
+std::vector<IopThreadStats> IOP_Kernel::thread_stats() const {
+  std::vector<IopThreadStats> result;
+  for (auto& t : threads) {
+    if (!t.runCount) {
+      continue;
+    }
+    auto& stats = result.emplace_back();
+    stats.name = t.name;
+    stats.id = t.thID;
+    stats.priority = t.priority;
+    stats.run_count = t.runCount;
+    stats.run_time_us = t.runTimeUs;
+    stats.total_latency_us = t.totalLatencyUs;
+    stats.max_latency_us = t.maxLatencyUs;
+  }
+  return result;
+}
+
 void IOP_Kernel::set_rpc_queue(iop::sceSifQueueData* qd, u32 thread) {
   sif_mtx.lock();
   for (const auto& r : sif_records) {
@@ -2,10 +2,12 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <functional>
 #include <list>
 #include <mutex>
 #include <optional>
 #include <queue>
+#include <set>
 #include <string>
 #include <thread>
 #include <utility>
@@ -75,6 +77,27 @@ struct IopThread {
   time_stamp resumeTime = {};
   u32 priority = 0;
   s32 thID = -1;
+
+  // when the thread last became ready, for the wakeup latency stats.
+  time_stamp readyTime = {};
+  u64 runCount = 0;
+  u64 runTimeUs = 0;
+  u64 totalLatencyUs = 0;
+  u64 maxLatencyUs = 0;
+};
+
+/*!
+ * How much an IOP thread has run, and how long it waited between being ready and running.
+ * For threads woken by DelayThread, the latency is measured from the requested resume time.
+ */
+struct IopThreadStats {
+  std::string name;
+  s32 id = -1;
+  u32 priority = 0;
+  u64 run_count = 0;
+  u64 run_time_us = 0;
+  u64 total_latency_us = 0;
+  u64 max_latency_us = 0;
 };
 
 struct Semaphore {
@@ -177,7 +200,14 @@ class IOP_Kernel {
     return 0;
   }
 
-  void signal_vblank() { vblank_recieved = true; };
+  void signal_vblank() {
+    vblank_recieved = true;
+    signal_event();
+  };
+
+  void signal_event();
+  void wait_for_event(time_stamp timeout);
+  std::vector<IopThreadStats> thread_stats() const;
 
   bool sif_busy(u32 id);
 
@@ -194,6 +224,7 @@ class IOP_Kernel {
   void leaveThread();
   void updateDelay();
   void processWakeups();
+  void makeReady(IopThread* thread, time_stamp ready_time);
 
   IopThread* schedNext();
   std::optional<time_stamp> nextWakeup();
@@ -211,4 +242,19 @@ class IOP_Kernel {
   std::queue<int> wakeup_queue;
   bool mainThreadSleep = false;
   std::mutex sif_mtx, wakeup_mtx;
+
+  // threads that may be ready, ordered by priority (lower number first), then id.
+  // entries for threads that are no longer ready are skipped when they come up.
+  std::set<std::pair<u32, s32>> ready_queue;
+  // delayed threads, ordered by resume time. entries for threads that were woken some other way
+  // are skipped when they come up.
+  std::priority_queue<std::pair<time_stamp, s32>,
+                      std::vector<std::pair<time_stamp, s32>>,
+                      std::greater<>>
+      delay_queue;
+
+  // set by other threads when the IOP has something to do, so it doesn't sleep through it.
+  std::mutex event_mtx;
+  std::condition_variable event_cv;
+  bool event_pending = false;
 };
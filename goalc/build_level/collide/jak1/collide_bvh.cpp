@@ -1,17 +1,26 @@
 #include "collide_bvh.h"
 
 #include <algorithm>
+#include <limits>
 #include <map>
+#include <thread>
 #include <unordered_set>
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/Timer.h"
 
 // Collision BVH algorithm
 // We start with all the points in a single node, then recursively split nodes in 8 until no nodes
 // have too many faces.
-// The splitting is done by doing median cuts along the x, y, or z axis.
+// The splitting is done by cutting along the x, y, or z axis, at the plane with the lowest surface
+// area heuristic cost that still splits the faces fairly evenly. The faces are sorted into bins by
+// their center to find this plane in a single pass.
+
+// The top of the tree is split on one thread, then the subtrees below it are split (and get their
+// bspheres) in parallel. Each subtree is split the same way no matter which thread does it, so the
+// result doesn't depend on the number of threads.
 
 // The bspheres are built at the end.
 
@@ -98,54 +107,144 @@ void compute_my_bsphere_ritters(CNode& node) {
 }
 
 /*!
- * Split faces in two along a coordinate plane.
- * Will clear the input faces
+ * Axis-aligned bounding box, used for the split heuristic.
  */
-void split_along_dim(std::vector<jak1::CollideFace>& faces,
-                     int dim,
-                     std::vector<jak1::CollideFace>* out0,
-                     std::vector<jak1::CollideFace>* out1) {
-  std::sort(faces.begin(), faces.end(),
-            [=](const jak1::CollideFace& a, const jak1::CollideFace& b) {
-              return a.bsphere[dim] < b.bsphere[dim];
-            });
-  lg::print("splitting with size: {}\n", faces.size());
-  size_t split_idx = faces.size() / 2;
-  out0->insert(out0->end(), faces.begin(), faces.begin() + split_idx);
-  out1->insert(out1->end(), faces.begin() + split_idx, faces.end());
-}
+struct Bounds {
+  math::Vector3f min = math::Vector3f::zero();
+  math::Vector3f max = math::Vector3f::zero();
+  bool empty = true;
+
+  void add(const math::Vector3f& pt) {
+    if (empty) {
+      min = pt;
+      max = pt;
+      empty = false;
+    } else {
+      min.min_in_place(pt);
+      max.max_in_place(pt);
+    }
+  }
+
+  void add(const Bounds& other) {
+    if (!other.empty) {
+      add(other.min);
+      add(other.max);
+    }
+  }
+
+  float surface_area() const {
+    if (empty) {
+      return 0;
+    }
+    const math::Vector3f size = max - min;
+    return 2.f * (size.x() * size.y() + size.y() * size.z() + size.z() * size.x());
+  }
+};
+
+constexpr int kSplitBins = 32;
+
+// don't consider planes that put less than this fraction of the faces on one side. Uneven splits
+// make deeper trees and more frags, because the bigger side is still too big.
+constexpr float kMinSplitFraction = 0.4f;
 
 /*!
- * Split a node into two nodes. The outputs should be uninitialized nodes
+ * Pick a split plane along each axis by binning the faces, and return the one with the lowest
+ * surface area heuristic cost. Faces with bin <= *split_bin along *split_dim go in the first
+ * node. Returns false if there's no plane that splits the faces evenly enough.
  */
-void split_node_once(CNode& node, CNode* out0, CNode* out1) {
-  compute_my_bsphere_ritters(node);
-  CNode temps[6];
-  split_along_dim(node.faces, 0, &temps[0].faces, &temps[1].faces);
-  split_along_dim(node.faces, 1, &temps[2].faces, &temps[3].faces);
-  split_along_dim(node.faces, 2, &temps[4].faces, &temps[5].faces);
-  node.faces.clear();
-  for (auto& t : temps) {
-    compute_my_bsphere_ritters(t);
-  }
+bool pick_split(const std::vector<jak1::CollideFace>& faces,
+                const Bounds& centers,
+                int* split_dim,
+                int* split_bin) {
+  float best_cost = std::numeric_limits<float>::max();
+  bool found = false;
+  const int min_count = std::max(1, (int)(faces.size() * kMinSplitFraction));
+
+  for (int dim = 0; dim < 3; dim++) {
+    const float extent = centers.max[dim] - centers.min[dim];
+    if (!(extent > 0)) {
+      continue;
+    }
+    const float scale = kSplitBins / extent;
+
+    Bounds bin_bounds[kSplitBins];
+    int bin_counts[kSplitBins] = {};
+    for (auto& face : faces) {
+      int bin = std::min(kSplitBins - 1, (int)((face.bsphere[dim] - centers.min[dim]) * scale));
+      bin_counts[bin]++;
+      for (auto& v : face.v) {
+        bin_bounds[bin].add(v);
+      }
+    }
+
+    // sweep from the right to get the cost of everything above each plane
+    float right_cost[kSplitBins];
+    Bounds right;
+    int right_count = 0;
+    for (int bin = kSplitBins - 1; bin > 0; bin--) {
+      right.add(bin_bounds[bin]);
+      right_count += bin_counts[bin];
+      right_cost[bin - 1] = right.surface_area() * right_count;
+    }
 
-  float max_bspheres[3] = {0, 0, 0};
+    Bounds left;
+    int left_count = 0;
+    for (int bin = 0; bin < kSplitBins - 1; bin++) {
+      left.add(bin_bounds[bin]);
+      left_count += bin_counts[bin];
+      if (left_count < min_count || (int)faces.size() - left_count < min_count) {
+        continue;
+      }
+      float cost = left.surface_area() * left_count + right_cost[bin];
+      if (cost < best_cost) {
+        best_cost = cost;
+        *split_dim = dim;
+        *split_bin = bin;
+        found = true;
+      }
+    }
+  }
+  return found;
+}
 
-  for (int i = 0; i < 3; i++) {
-    max_bspheres[i] = std::max(temps[i * 2].bsphere.w(), temps[i * 2 + 1].bsphere.w());
+/*!
+ * Split a node into two nodes. The outputs should be uninitialized nodes.
+ * Will clear the input faces. The faces keep their order within each output.
+ */
+void split_node_once(CNode& node, CNode* out0, CNode* out1) {
+  Bounds centers;
+  for (auto& face : node.faces) {
+    centers.add(face.bsphere.xyz());
   }
 
-  int best_dim = 0;
-  float best_w = max_bspheres[0];
-  for (int i = 0; i < 3; i++) {
-    if (max_bspheres[i] < best_w) {
-      best_dim = i;
-      best_w = max_bspheres[i];
+  int dim = 0, split_bin = 0;
+  if (pick_split(node.faces, centers, &dim, &split_bin)) {
+    const float scale = kSplitBins / (centers.max[dim] - centers.min[dim]);
+    for (auto& face : node.faces) {
+      int bin = std::min(kSplitBins - 1, (int)((face.bsphere[dim] - centers.min[dim]) * scale));
+      if (bin <= split_bin) {
+        out0->faces.push_back(face);
+      } else {
+        out1->faces.push_back(face);
+      }
     }
+  } else {
+    // the faces are bunched up in a few bins, do a median cut along the longest axis instead.
+    const math::Vector3f extent = centers.max - centers.min;
+    dim = extent.x() >= extent.y() ? (extent.x() >= extent.z() ? 0 : 2)
+                                   : (extent.y() >= extent.z() ? 1 : 2);
+    std::stable_sort(node.faces.begin(), node.faces.end(),
+                     [=](const jak1::CollideFace& a, const jak1::CollideFace& b) {
+                       return a.bsphere[dim] < b.bsphere[dim];
+                     });
+    size_t split_idx = node.faces.size() / 2;
+    out0->faces.insert(out0->faces.end(), node.faces.begin(), node.faces.begin() + split_idx);
+    out1->faces.insert(out1->faces.end(), node.faces.begin() + split_idx, node.faces.end());
   }
+  node.faces.clear();
 
-  *out0 = temps[best_dim * 2];
-  *out1 = temps[best_dim * 2 + 1];
+  compute_my_bsphere_ritters(*out0);
+  compute_my_bsphere_ritters(*out1);
 }
 
 bool needs_split(const CNode& node) {
@@ -169,10 +268,23 @@ bool needs_split(const CNode& node) {
   return unique_verts.size() >= MAX_UNIQUE_VERTS_IN_FRAG;
 }
 
-void split_recursive(CNode& to_split) {
+/*!
+ * Split a node into up to 8 children, then recursively split the children that still need it.
+ * If subtrees is set, the children with at most defer_faces faces are added to it instead of being
+ * split here, so they can be split in parallel.
+ */
+void split_recursive(CNode& to_split, size_t defer_faces, std::vector<CNode*>* subtrees) {
   ASSERT(to_split.child_nodes.empty());
   ASSERT(!to_split.faces.empty());
 
+  // children, and if they need to be split again.
+  std::vector<CNode> children;
+  std::vector<bool> needs_recursion;
+  auto add_child = [&](CNode& child, bool recurse) {
+    children.push_back(std::move(child));
+    needs_recursion.push_back(recurse);
+  };
+
   CNode level0[2];
   split_node_once(to_split, &level0[0], &level0[1]);
   for (int i = 0; i < 2; i++) {
@@ -184,48 +296,61 @@ void split_recursive(CNode& to_split) {
           CNode level2[2];
           split_node_once(level1[j], &level2[0], &level2[1]);
           for (int k = 0; k < 2; k++) {
-            if (needs_split(level2[k])) {
-              to_split.child_nodes.push_back(std::move(level2[k]));
-              split_recursive(to_split.child_nodes.back());
-            } else {
-              to_split.child_nodes.push_back(std::move(level2[k]));
-            }
+            add_child(level2[k], needs_split(level2[k]));
           }
         } else {
-          to_split.child_nodes.push_back(std::move(level1[j]));
+          add_child(level1[j], false);
         }
       }
     } else {
-      to_split.child_nodes.push_back(std::move(level0[i]));
+      add_child(level0[i], false);
     }
   }
 
-  ASSERT(to_split.child_nodes.size() <= 8);
+  ASSERT(children.size() <= 8);
 
   bool has_leaves = false;
   bool has_not_leaves = false;
-  for (auto& child : to_split.child_nodes) {
-    if (!child.faces.empty()) {
-      has_leaves = true;
-    }
-    if (!child.child_nodes.empty()) {
+  for (bool recurse : needs_recursion) {
+    if (recurse) {
       has_not_leaves = true;
+    } else {
+      has_leaves = true;
     }
   }
 
+  // children are either all leaves, or all nodes: split the leaves once more.
+  std::vector<bool> child_needs_recursion;
   if (has_leaves && has_not_leaves) {
-    std::vector<CNode> temp_children = std::move(to_split.child_nodes);
-    to_split.child_nodes = {};
-    for (auto& c : temp_children) {
-      if (!c.faces.empty()) {
+    for (size_t i = 0; i < children.size(); i++) {
+      if (needs_recursion[i]) {
+        to_split.child_nodes.push_back(std::move(children[i]));
+        child_needs_recursion.push_back(true);
+      } else {
         to_split.child_nodes.emplace_back();
         to_split.child_nodes.emplace_back();
-        split_node_once(c, &to_split.child_nodes[to_split.child_nodes.size() - 1],
+        split_node_once(children[i], &to_split.child_nodes[to_split.child_nodes.size() - 1],
                         &to_split.child_nodes[to_split.child_nodes.size() - 2]);
-      } else {
-        to_split.child_nodes.push_back(std::move(c));
+        child_needs_recursion.push_back(false);
+        child_needs_recursion.push_back(false);
       }
     }
+  } else {
+    to_split.child_nodes = std::move(children);
+    child_needs_recursion = std::move(needs_recursion);
+  }
+
+  // the child list won't change anymore, so it's safe to hand out pointers to the children.
+  for (size_t i = 0; i < to_split.child_nodes.size(); i++) {
+    if (!child_needs_recursion[i]) {
+      continue;
+    }
+    auto& child = to_split.child_nodes[i];
+    if (subtrees && child.faces.size() <= defer_faces) {
+      subtrees->push_back(&child);
+    } else {
+      split_recursive(child, defer_faces, subtrees);
+    }
   }
 }
 
@@ -240,6 +365,19 @@ void bsphere_recursive(CNode& node) {
   }
 }
 
+/*!
+ * Compute bspheres for the top of the tree, skipping the subtrees that already have them.
+ */
+void bsphere_recursive_top(CNode& node, const std::unordered_set<const CNode*>& done) {
+  if (done.count(&node)) {
+    return;
+  }
+  compute_my_bsphere_ritters(node);
+  for (auto& child : node.child_nodes) {
+    bsphere_recursive_top(child, done);
+  }
+}
+
 void drawable_layout_helper(const CNode& node_in,
                             CollideTree& tree_out,
                             DrawNode& parent_to_add_to) {
@@ -279,19 +417,42 @@ void debug_stats(const CollideTree& tree) {
 
 }  // namespace
 
-CollideTree construct_collide_bvh(const std::vector<jak1::CollideFace>& tris) {
+CollideTree construct_collide_bvh(const std::vector<jak1::CollideFace>& tris, int num_workers) {
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
+  }
+
   // part 1: build the tree
   Timer bvh_timer;
-  lg::info("Building collide bvh from {} triangles", tris.size());
+  lg::info("Building collide bvh from {} triangles with {} threads", tris.size(), num_workers);
   CNode root;
   root.faces = tris;
-  split_recursive(root);
-  lg::info("BVH tree constructed in {:.2f} ms", bvh_timer.getMs());
 
-  // part 2: compute bspheres
+  // split the top of the tree here until the subtrees are small enough that there are plenty of
+  // them for the workers.
+  constexpr size_t kMinSubtreeFaces = 512;
+  const size_t defer_faces = std::max(kMinSubtreeFaces, tris.size() / (8 * num_workers));
+  std::vector<CNode*> subtrees;
+  if (tris.size() <= defer_faces) {
+    subtrees.push_back(&root);
+  } else {
+    split_recursive(root, defer_faces, &subtrees);
+  }
+  lg::info("BVH top levels constructed in {:.2f} ms, {} subtrees", bvh_timer.getMs(),
+           subtrees.size());
+
+  // part 2: split subtrees and compute their bspheres
   bvh_timer.start();
-  bsphere_recursive(root);
-  lg::info("Found bspheres in {:.2f} ms", bvh_timer.getMs());
+  SimpleThreadGroup threads;
+  threads.run_dynamic(
+      [&](int i) {
+        split_recursive(*subtrees[i], 0, nullptr);
+        bsphere_recursive(*subtrees[i]);
+      },
+      subtrees.size(), std::min(num_workers, (int)subtrees.size()));
+  threads.join();
+  bsphere_recursive_top(root, {subtrees.begin(), subtrees.end()});
+  lg::info("Subtrees and bspheres done in {:.2f} ms", bvh_timer.getMs());
 
   // part 3: layout tree
   bvh_timer.start();
@@ -36,5 +36,6 @@ struct CollideTree {
   DrawableInlineArrayCollideFrag frags;
 };
 
-CollideTree construct_collide_bvh(const std::vector<jak1::CollideFace>& tris);
+// num_workers = 0 uses one thread per core. The tree doesn't depend on the number of threads.
+CollideTree construct_collide_bvh(const std::vector<jak1::CollideFace>& tris, int num_workers = 0);
 }  // namespace collide
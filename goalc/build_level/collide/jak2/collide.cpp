@@ -1,12 +1,17 @@
 #include "collide.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "common/log/log.h"
 #include "common/util/Assert.h"
+#include "common/util/SimpleThreadGroup.h"
+#include "common/util/Timer.h"
 
 #include "goalc/data_compiler/DataObjectGenerator.h"
 
@@ -267,7 +272,7 @@ jak2::PatSurface jak2_pat(jak1::PatSurface jak1) {
 /*!
  * Construct a collide hash from a jak1 format mesh by converting to jak 2.
  */
-CollideHash construct_collide_hash(const std::vector<jak1::CollideFace>& tris) {
+CollideHash construct_collide_hash(const std::vector<jak1::CollideFace>& tris, int num_workers) {
   std::vector<jak2::CollideFace> jak2_tris;
   jak2_tris.reserve(tris.size());
 
@@ -279,7 +284,7 @@ CollideHash construct_collide_hash(const std::vector<jak1::CollideFace>& tris) {
     }
   }
 
-  return construct_collide_hash(jak2_tris);
+  return construct_collide_hash(jak2_tris, num_workers);
 }
 
 /*!
@@ -335,6 +340,11 @@ float overlap_volume(const BoundingBox& a, const BoundingBox& b) {
   return ret;
 }
 
+float surface_area(const BoundingBox& box) {
+  const math::Vector3f size = box.max - box.min;
+  return 2.f * (size[0] * size[1] + size[1] * size[2] + size[2] * size[0]);
+}
+
 /*!
  * A portion of a mesh, used in the fragment_mesh function.
  */
@@ -348,11 +358,16 @@ struct Frag {
 struct FragStats {
   BoundingBox bbox;
   math::Vector3f average_vertex_position;
-  math::Vector3f median_vertex_position;
+};
+
+struct FragAndStats {
+  Frag f;
+  FragStats s;
 };
 
 /*!
  * Find bounding box and average position for the triangles selected by indices.
+ * This is only needed for the whole mesh: the stats of split frags come from the split.
  */
 FragStats compute_frag_stats(const std::vector<jak2::CollideFace>& tris,
                              const std::vector<s32>& indices) {
@@ -372,18 +387,6 @@ FragStats compute_frag_stats(const std::vector<jak2::CollideFace>& tris,
     }
   }
 
-  for (int i = 0; i < 3; i++) {
-    std::vector<float> vx;
-    vx.reserve(tris.size() * 3);
-    for (auto idx : indices) {
-      for (const auto& vtx : tris[idx].v) {
-        vx.push_back(vtx[i]);
-      }
-    }
-    std::sort(vx.begin(), vx.end());
-    ret.median_vertex_position[i] = vx[vx.size() / 2];
-  }
-
   ret.bbox = bbox.box;
   return ret;
 }
@@ -455,7 +458,7 @@ struct FragSplit {
 };
 
 /*!
- * Info about a split
+ * Info about a split. Side 0 is above the plane, side 1 is below.
  */
 struct SplitStats {
   // how many tris on each side
@@ -464,6 +467,9 @@ struct SplitStats {
   // the bounding box of those tris. only valid if nonzero tris.
   BoundingBox bboxes[2];
 
+  // sum of the vertices of those tris, to find the average position.
+  math::Vector3f vertex_sums[2] = {math::Vector3f::zero(), math::Vector3f::zero()};
+
   float overlap_volume = 0;
   float imbalance = 0;
   bool had_zero = false;
@@ -478,9 +484,10 @@ SplitStats compute_split_stats(const Frag& frag,
   for (auto i : frag.tri_indices) {
     const auto& tri = tris[i];
     const math::Vector3f average_pt = (tri.v[0] + tri.v[1] + tri.v[2]) / 3.f;
-    const int out_bin = (average_pt[split.axis] > split.value) ? 1 : 0;
+    const int out_bin = (average_pt[split.axis] > split.value) ? 0 : 1;
     bbox[out_bin].add_tri(tri);
     stats.tri_count[out_bin]++;
+    stats.vertex_sums[out_bin] += tri.v[0] + tri.v[1] + tri.v[2];
   }
   stats.bboxes[0] = bbox[0].box;
   stats.bboxes[1] = bbox[1].box;
@@ -516,14 +523,105 @@ int idx_of_max(float a, float b, float c) {
   }
 }
 
+constexpr int kSplitBins = 16;
+
+// don't consider planes that put less than this fraction of the triangles on one side. Uneven
+// splits make more frags, because the bigger side is still too big.
+constexpr float kMinSplitFraction = 0.4f;
+
+/*!
+ * Sort the triangles into bins by their center along the axis, and find the plane between bins
+ * with the lowest surface area heuristic cost. The plane is placed at the highest center below it,
+ * so split_frag puts the triangles on the same sides as the bins.
+ * Returns false if the axis has no plane that splits the triangles evenly enough.
+ */
+bool pick_binned_split(const Frag& frag,
+                       const std::vector<math::Vector3f>& centers,
+                       const BoundingBox& center_box,
+                       const std::vector<jak2::CollideFace>& tris,
+                       int axis,
+                       float* best_cost,
+                       FragSplit* split,
+                       SplitStats* split_stats) {
+  const float extent = center_box.max[axis] - center_box.min[axis];
+  if (!(extent > 0)) {
+    return false;
+  }
+  const float scale = kSplitBins / extent;
+
+  struct Bin {
+    BBoxBuilder bbox;
+    int count = 0;
+    math::Vector3f vertex_sum = math::Vector3f::zero();
+    float max_center = -std::numeric_limits<float>::max();
+  };
+  Bin bins[kSplitBins];
+
+  for (size_t i = 0; i < frag.tri_indices.size(); i++) {
+    const auto& tri = tris[frag.tri_indices[i]];
+    const float center = centers[i][axis];
+    auto& bin = bins[std::min(kSplitBins - 1, (int)((center - center_box.min[axis]) * scale))];
+    bin.bbox.add_tri(tri);
+    bin.count++;
+    bin.vertex_sum += tri.v[0] + tri.v[1] + tri.v[2];
+    bin.max_center = std::max(bin.max_center, center);
+  }
+
+  // sweep down to find what's above each plane
+  Bin above[kSplitBins];
+  Bin sum;
+  for (int i = kSplitBins - 1; i > 0; i--) {
+    if (bins[i].count) {
+      sum.bbox.add_box(bins[i].bbox.box);
+      sum.count += bins[i].count;
+      sum.vertex_sum += bins[i].vertex_sum;
+    }
+    above[i - 1] = sum;
+  }
+
+  const int min_count = std::max(1, (int)(frag.tri_indices.size() * kMinSplitFraction));
+  bool found = false;
+  Bin below;
+  for (int i = 0; i < kSplitBins - 1; i++) {
+    if (bins[i].count) {
+      below.bbox.add_box(bins[i].bbox.box);
+      below.count += bins[i].count;
+      below.vertex_sum += bins[i].vertex_sum;
+      below.max_center = bins[i].max_center;
+    }
+    if (below.count < min_count || above[i].count < min_count) {
+      continue;
+    }
+
+    const float cost = surface_area(below.bbox.box) * below.count +
+                       surface_area(above[i].bbox.box) * above[i].count;
+    if (cost < *best_cost) {
+      *best_cost = cost;
+      split->axis = axis;
+      split->value = below.max_center;
+      split_stats->tri_count[0] = above[i].count;
+      split_stats->tri_count[1] = below.count;
+      split_stats->bboxes[0] = above[i].bbox.box;
+      split_stats->bboxes[1] = below.bbox.box;
+      split_stats->vertex_sums[0] = above[i].vertex_sum;
+      split_stats->vertex_sums[1] = below.vertex_sum;
+      found = true;
+    }
+  }
+  return found;
+}
+
 FragSplit pick_best_frag_split(const Frag& frag,
                                const FragStats& stats,
-                               const std::vector<jak2::CollideFace>& tris) {
+                               const std::vector<jak2::CollideFace>& tris,
+                               SplitStats* split_stats_out) {
   // this is the tricky part.
 
   // I think the most important thing about splitting is that we should try to minimize overlapping
   // fragments in the final mesh. Overlapping fragments means that we'll need more space for
-  // buckets, and the engine will need to check more fragments.
+  // buckets, and the engine will need to check more fragments. The surface area heuristic
+  // prefers splits where the two sides are small and don't overlap, and it can be computed for
+  // many planes in a single pass over the triangles.
 
   // Based on what I learned with Jak 1, we also want to avoid:
   // - fragments with bad (large) aspect ratio. Although the Jak 2 code is likely _much_ better at
@@ -544,40 +642,50 @@ FragSplit pick_best_frag_split(const Frag& frag,
 
   const float aspect = max_box_size / min_box_size;
 
-  FragSplit splits[3];
-  SplitStats split_stats[3];
-
-  for (int i = 0; i < 3; i++) {
-    splits[i].axis = i;
-    splits[i].value = stats.average_vertex_position[i];
-    split_stats[i] = compute_split_stats(frag, tris, splits[i]);
-  }
+  FragSplit average_split;
+  average_split.axis = max_idx;
+  average_split.value = stats.average_vertex_position[max_idx];
 
   if (aspect > 25) {
-    if (split_stats[max_idx].imbalance < 4) {
+    SplitStats average_stats = compute_split_stats(frag, tris, average_split);
+    if (average_stats.imbalance < 4) {
       printf(
           "pick best frag split splitting a frag of size %d due to bad aspect (%f), with imbalance "
           "%f\n",
-          (int)frag.tri_indices.size(), aspect, split_stats[max_idx].imbalance);
-      return splits[max_idx];
+          (int)frag.tri_indices.size(), aspect, average_stats.imbalance);
+      *split_stats_out = average_stats;
+      return average_split;
     } else {
       printf(
           "weird: there's a bad aspect frag (%f, %f), but splitting along the worst axis causes "
           "imbalance %f.\n",
-          max_box_size / 4096.f, min_box_size / 4096.f, split_stats[max_idx].imbalance);
+          max_box_size / 4096.f, min_box_size / 4096.f, average_stats.imbalance);
     }
   }
 
-  float scores[3];
+  std::vector<math::Vector3f> centers;
+  centers.reserve(frag.tri_indices.size());
+  BBoxBuilder center_box;
+  for (auto i : frag.tri_indices) {
+    const auto& tri = tris[i];
+    centers.push_back((tri.v[0] + tri.v[1] + tri.v[2]) / 3.f);
+    center_box.add_pt(centers.back());
+  }
+
+  FragSplit best;
+  float best_cost = std::numeric_limits<float>::max();
+  bool found = false;
   for (int i = 0; i < 3; i++) {
-    if (split_stats[i].had_zero) {
-      scores[i] = -std::numeric_limits<float>::max();
-    } else {
-      scores[i] = -split_stats[i].overlap_volume;
-    }
+    found |= pick_binned_split(frag, centers, center_box.box, tris, i, &best_cost, &best,
+                               split_stats_out);
   }
 
-  return splits[idx_of_max(scores[0], scores[1], scores[2])];
+  if (!found) {
+    // the triangles are bunched up in a few bins, fall back to splitting at the average.
+    *split_stats_out = compute_split_stats(frag, tris, average_split);
+    return average_split;
+  }
+  return best;
 }
 
 Frag add_all_to_frag(const std::vector<jak2::CollideFace>& tris) {
@@ -607,44 +715,81 @@ void split_frag(const Frag& in,
   }
 }
 
-std::vector<Frag> fragment_mesh(const std::vector<jak2::CollideFace>& tris) {
-  struct FragAndStats {
-    Frag f;
-    FragStats s;
-  };
-
-  auto initial_frag = add_all_to_frag(tris);
-  auto initial_stats = compute_frag_stats(tris, initial_frag.tri_indices);
-  if (frag_is_valid_for_packing(initial_frag, initial_stats, tris)) {
-    printf("initial is good!\n");
-    printf("%s\n%s\n\n", initial_stats.bbox.min.to_string_aligned().c_str(),
-           initial_stats.bbox.max.to_string_aligned().c_str());
-    return {initial_frag};
-  }
+/*!
+ * Get the stats of one side of a split.
+ */
+FragStats split_side_stats(const SplitStats& split_stats, int side) {
+  FragStats ret;
+  ret.bbox = split_stats.bboxes[side];
+  ret.average_vertex_position =
+      split_stats.vertex_sums[side] / (float)(split_stats.tri_count[side] * 3);
+  return ret;
+}
 
-  // split up all "too big" frags until they are good.
-  std::vector<FragAndStats> too_big_frags = {{initial_frag, initial_stats}};
-  std::vector<Frag> good_frags;
+/*!
+ * Split frags until they are all valid, adding them to out.
+ * If defer_tris is set, frags with at most that many triangles are added to out without being
+ * checked or split.
+ */
+void split_until_valid(FragAndStats&& in,
+                       const std::vector<jak2::CollideFace>& tris,
+                       size_t defer_tris,
+                       std::vector<FragAndStats>* out) {
+  std::vector<FragAndStats> too_big_frags;
+  too_big_frags.push_back(std::move(in));
 
   while (!too_big_frags.empty()) {
-    printf("sizes %zu %zu\n", too_big_frags.size(), good_frags.size());
-    auto& back = too_big_frags.back();
+    FragAndStats back = std::move(too_big_frags.back());
+    too_big_frags.pop_back();
+
+    if (back.f.tri_indices.size() <= defer_tris ||
+        frag_is_valid_for_packing(back.f, back.s, tris)) {
+      out->push_back(std::move(back));
+      continue;
+    }
 
-    // split it!
+    // split it! the second half goes on the stack first so the output is in order.
+    SplitStats split_stats;
+    auto split = pick_best_frag_split(back.f, back.s, tris, &split_stats);
     FragAndStats ab[2];
-    auto split = pick_best_frag_split(back.f, back.s, tris);
     split_frag(back.f, split, tris, &ab[0].f, &ab[1].f);
+    for (int i = 2; i-- > 0;) {
+      ASSERT((int)ab[i].f.tri_indices.size() == split_stats.tri_count[i]);
+      ab[i].s = split_side_stats(split_stats, i);
+      too_big_frags.push_back(std::move(ab[i]));
+    }
+  }
+}
 
-    too_big_frags.pop_back();  // invalidate back.
+std::vector<Frag> fragment_mesh(const std::vector<jak2::CollideFace>& tris, int num_workers) {
+  FragAndStats initial;
+  initial.f = add_all_to_frag(tris);
+  initial.s = compute_frag_stats(tris, initial.f.tri_indices);
+  if (frag_is_valid_for_packing(initial.f, initial.s, tris)) {
+    printf("initial is good!\n");
+    printf("%s\n%s\n\n", initial.s.bbox.min.to_string_aligned().c_str(),
+           initial.s.bbox.max.to_string_aligned().c_str());
+    return {initial.f};
+  }
 
-    // check if split frags are good or not.
-    for (auto& fs : ab) {
-      fs.s = compute_frag_stats(tris, fs.f.tri_indices);
-      if (frag_is_valid_for_packing(fs.f, fs.s, tris)) {
-        good_frags.push_back(std::move(fs.f));
-      } else {
-        too_big_frags.push_back(std::move(fs));
-      }
+  // split up the big frags here, until there are plenty of pieces for the workers. Each piece is
+  // split the same way no matter which thread does it.
+  constexpr size_t kMinPieceTris = 1024;
+  const size_t defer_tris = std::max(kMinPieceTris, tris.size() / (8 * num_workers));
+  std::vector<FragAndStats> pieces;
+  split_until_valid(std::move(initial), tris, defer_tris, &pieces);
+
+  std::vector<std::vector<FragAndStats>> piece_frags(pieces.size());
+  SimpleThreadGroup threads;
+  threads.run_dynamic(
+      [&](int i) { split_until_valid(std::move(pieces[i]), tris, 0, &piece_frags[i]); },
+      pieces.size(), std::min(num_workers, (int)pieces.size()));
+  threads.join();
+
+  std::vector<Frag> good_frags;
+  for (auto& frags : piece_frags) {
+    for (auto& frag : frags) {
+      good_frags.push_back(std::move(frag.f));
     }
   }
   return good_frags;
@@ -652,14 +797,52 @@ std::vector<Frag> fragment_mesh(const std::vector<jak2::CollideFace>& tris) {
 
 struct VectorIntHash {
   size_t operator()(const std::vector<int>& in) const {
-    size_t ret = 0;
-    for (size_t i = 0; i < in.size(); i++) {
-      ret ^= std::hash<size_t>()(i ^ in[i]);
+    // the cell lists are mostly runs of nearby indices, so mix well to avoid collisions.
+    size_t ret = in.size();
+    for (auto x : in) {
+      ret ^= std::hash<int>()(x) + 0x9e3779b9 + (ret << 6) + (ret >> 2);
     }
     return ret;
   }
 };
 
+/*!
+ * Get the box for a cell in a grid.
+ */
+BoundingBox grid_cell(const math::Vector3f& grid_min,
+                      const math::Vector3f& cell_size,
+                      int xi,
+                      int yi,
+                      int zi) {
+  BoundingBox cell;
+  cell.min = math::Vector3f(xi * cell_size[0], yi * cell_size[1], zi * cell_size[2]) + grid_min;
+  cell.max = cell.min + cell_size;
+  return cell;
+}
+
+/*!
+ * Find the cells [start, end) along one axis of a grid that might overlap [lo, hi].
+ * This includes an extra cell on each side, to be safe with rounding. The caller must still test
+ * each cell.
+ */
+void grid_cell_range(float lo,
+                     float hi,
+                     float grid_min,
+                     float cell_size,
+                     int dimension,
+                     int* start,
+                     int* end) {
+  if (!(cell_size > 0)) {
+    *start = 0;
+    *end = dimension;
+    return;
+  }
+  const float first = std::floor((lo - grid_min) / cell_size) - 1;
+  const float last = std::floor((hi - grid_min) / cell_size) + 2;
+  *start = (int)std::clamp(first, 0.f, (float)dimension);
+  *end = (int)std::clamp(last, 0.f, (float)dimension);
+}
+
 CollideHash build_grid_for_main_hash(std::vector<CollideFragment>&& frags) {
   lg::info("Creating main hash");
   CollideHash result;
@@ -689,35 +872,34 @@ CollideHash build_grid_for_main_hash(std::vector<CollideFragment>&& frags) {
                                       box_size[1] / grid_dimension[1],
                                       box_size[2] / grid_dimension[2]);
 
-  std::vector<std::vector<int>> frags_in_cells;
+  // per-cell, in yzx order to match game, a list of frags that intersect it.
+  std::vector<std::vector<int>> frags_in_cells(grid_dimension[0] * grid_dimension[1] *
+                                               grid_dimension[2]);
 
   // debug
   std::vector<bool> debug_found_flags(frags.size(), false);
   int debug_intersect_count = 0;
 
-  // yzx order to match game
-  for (int yi = 0; yi < grid_dimension[1]; yi++) {
-    for (int zi = 0; zi < grid_dimension[2]; zi++) {
-      for (int xi = 0; xi < grid_dimension[0]; xi++) {
-        auto& cell_list = frags_in_cells.emplace_back();
-
-        BoundingBox cell;
-        cell.min =
-            math::Vector3f(xi * grid_cell_size[0], yi * grid_cell_size[1], zi * grid_cell_size[2]) +
-            bbox.box.min;
-        cell.max = cell.min + grid_cell_size;
-
-        for (size_t fi = 0; fi < frags.size(); fi++) {
-          const auto& frag = frags[fi];
-          if (bounding_box_bounding_box(cell, {frag.bbox_min_corner, frag.bbox_max_corner})) {
+  // only check the cells near each frag. The frags are visited in order, so the lists are sorted.
+  for (size_t fi = 0; fi < frags.size(); fi++) {
+    const auto& frag = frags[fi];
+    int start[3], end[3];
+    for (int i = 0; i < 3; i++) {
+      grid_cell_range(frag.bbox_min_corner[i], frag.bbox_max_corner[i], bbox.box.min[i],
+                      grid_cell_size[i], grid_dimension[i], &start[i], &end[i]);
+    }
+
+    for (int yi = start[1]; yi < end[1]; yi++) {
+      for (int zi = start[2]; zi < end[2]; zi++) {
+        for (int xi = start[0]; xi < end[0]; xi++) {
+          if (bounding_box_bounding_box(grid_cell(bbox.box.min, grid_cell_size, xi, yi, zi),
+                                        {frag.bbox_min_corner, frag.bbox_max_corner})) {
             debug_found_flags[fi] = true;
             debug_intersect_count++;
-            cell_list.push_back(fi);
+            frags_in_cells[(yi * grid_dimension[2] + zi) * grid_dimension[0] + xi].push_back(fi);
           }
         }
-
-        std::sort(cell_list.begin(), cell_list.end());
-      };
+      }
     }
   }
 
@@ -848,36 +1030,35 @@ CollideFragment build_grid_for_frag(const std::vector<jak2::CollideFace>& tris,
   }
   ASSERT(grid_dimension[0] * grid_dimension[1] * grid_dimension[2] == 256);
 
-  // per-cell, a list of polys that intersect it.
-  std::vector<std::vector<int>> polys_in_cells;
+  // per-cell, in yzx order to match game, a list of polys that intersect it.
+  std::vector<std::vector<int>> polys_in_cells(256);
 
   // debug
   std::vector<bool> debug_found_flags(frag.tri_indices.size(), false);
   int debug_intersect_count = 0;
 
-  // yzx order to match game
-  for (int yi = 0; yi < grid_dimension[1]; yi++) {
-    for (int zi = 0; zi < grid_dimension[2]; zi++) {
-      for (int xi = 0; xi < grid_dimension[0]; xi++) {
-        auto& cell_list = polys_in_cells.emplace_back();
-
-        BoundingBox cell;
-        cell.min =
-            math::Vector3f(xi * grid_cell_size[0], yi * grid_cell_size[1], zi * grid_cell_size[2]) +
-            bbox.box.min;
-        cell.max = cell.min + grid_cell_size;
-
-        for (size_t ti = 0; ti < frag.tri_indices.size(); ti++) {
-          const auto& tri = tris[frag.tri_indices[ti]];
-          if (triangle_bounding_box(cell, tri.v[0], tri.v[1], tri.v[2])) {
+  // only check the cells near each tri. The tris are visited in order, so the lists are sorted.
+  for (size_t ti = 0; ti < frag.tri_indices.size(); ti++) {
+    const auto& tri = tris[frag.tri_indices[ti]];
+    BBoxBuilder tri_box;
+    tri_box.add_tri(tri);
+    int start[3], end[3];
+    for (int i = 0; i < 3; i++) {
+      grid_cell_range(tri_box.box.min[i], tri_box.box.max[i], bbox.box.min[i], grid_cell_size[i],
+                      grid_dimension[i], &start[i], &end[i]);
+    }
+
+    for (int yi = start[1]; yi < end[1]; yi++) {
+      for (int zi = start[2]; zi < end[2]; zi++) {
+        for (int xi = start[0]; xi < end[0]; xi++) {
+          if (triangle_bounding_box(grid_cell(bbox.box.min, grid_cell_size, xi, yi, zi), tri.v[0],
+                                    tri.v[1], tri.v[2])) {
             debug_found_flags[ti] = true;
             debug_intersect_count++;
-            cell_list.push_back(ti);
+            polys_in_cells[(yi * grid_dimension[2] + zi) * grid_dimension[0] + xi].push_back(ti);
           }
         }
-
-        std::sort(cell_list.begin(), cell_list.end());
-      };
+      }
     }
   }
 
@@ -933,15 +1114,24 @@ CollideFragment build_grid_for_frag(const std::vector<jak2::CollideFace>& tris,
   return result;
 }
 
-CollideHash construct_collide_hash(const std::vector<jak2::CollideFace>& tris) {
-  CollideHash collide_hash;
-
-  std::vector<Frag> frags = fragment_mesh(tris);
-  std::vector<CollideFragment> hashed_frags;
-  for (auto& frag : frags) {
-    hashed_frags.push_back(build_grid_for_frag(tris, frag));
+CollideHash construct_collide_hash(const std::vector<jak2::CollideFace>& tris, int num_workers) {
+  if (num_workers <= 0) {
+    num_workers = std::max(1u, std::thread::hardware_concurrency());
   }
 
+  Timer timer;
+  std::vector<Frag> frags = fragment_mesh(tris, num_workers);
+  lg::info("Split {} triangles into {} frags in {:.2f} ms", tris.size(), frags.size(),
+           timer.getMs());
+
+  timer.start();
+  std::vector<CollideFragment> hashed_frags(frags.size());
+  SimpleThreadGroup threads;
+  threads.run_dynamic([&](int i) { hashed_frags[i] = build_grid_for_frag(tris, frags[i]); },
+                      frags.size(), std::min(num_workers, (int)frags.size()));
+  threads.join();
+  lg::info("Hashed frags in {:.2f} ms", timer.getMs());
+
   // hash tris in frags
   // hash frags
   // ??
@@ -116,8 +116,9 @@ struct CollideHash {
   u32 dimension_array[3] = {0, 0, 0};
 };
 
-CollideHash construct_collide_hash(const std::vector<jak1::CollideFace>& tris);
-CollideHash construct_collide_hash(const std::vector<jak3::CollideFace>& tris);
+// num_workers = 0 uses one thread per core. The result doesn't depend on the number of threads.
+CollideHash construct_collide_hash(const std::vector<jak1::CollideFace>& tris, int num_workers = 0);
+CollideHash construct_collide_hash(const std::vector<jak3::CollideFace>& tris, int num_workers = 0);
 
 size_t add_to_object_file(const CollideHash& hash, DataObjectGenerator& gen);
 }  // namespace jak3
\ No newline at end of file
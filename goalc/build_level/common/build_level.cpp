@@ -5,8 +5,7 @@ void save_pc_data(const std::string& nickname,
                   const fs::path& fr3_output_dir) {
   Serializer ser;
   data.serialize(ser);
-  auto compressed =
-      compression::compress_zstd(ser.get_save_result().first, ser.get_save_result().second);
+  auto compressed = tfrag3::pack_fr3(ser.get_save_result().first, ser.get_save_result().second);
   lg::print("stats for {}\n", data.level_name);
   print_memory_usage(data, ser.get_save_result().second);
   lg::print("compressed: {} -> {} ({:.2f}%)\n", ser.get_save_result().second, compressed.size(),
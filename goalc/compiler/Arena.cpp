@@ -0,0 +1,25 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+void Arena::new_block(size_t min_size) {
+  size_t size = std::max(min_size, kBlockSize);
+  // not make_unique, which would zero the block.
+  m_blocks.emplace_back(new u8[size]);
+  m_next = m_blocks.back().get();
+  m_end = m_next + size;
+  m_stats.blocks++;
+  m_stats.block_bytes += size;
+}
+
+void Arena::release() {
+  while (m_dtors) {
+    auto* node = m_dtors;
+    m_dtors = node->next;
+    node->destroy(reinterpret_cast<u8*>(node) + sizeof(DtorNode));
+  }
+  m_blocks.clear();
+  m_next = nullptr;
+  m_end = nullptr;
+  m_stats = {};
+}
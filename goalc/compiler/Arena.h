@@ -0,0 +1,85 @@
+#pragma once
+
+/*!
+ * @file Arena.h
+ * A bump allocator for the many small objects (IR, Val, Env, Label) created while compiling a file.
+ * These all live until the file is done, so they are freed all at once instead of one at a time.
+ */
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+class Arena {
+ public:
+  struct Stats {
+    u64 objects = 0;      // objects allocated since the last release
+    u64 bytes = 0;        // bytes used by those objects, including alignment padding
+    u64 blocks = 0;       // blocks allocated since the last release
+    u64 block_bytes = 0;  // total size of those blocks
+  };
+
+  Arena() = default;
+  ~Arena() { release(); }
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+
+  /*!
+   * Construct a T in the arena. It is destroyed when the arena is released.
+   */
+  template <typename T, typename... Args>
+  T* alloc(Args&&... args) {
+    static_assert(alignof(T) <= kMaxAlign);
+    if constexpr (std::is_trivially_destructible_v<T>) {
+      return new (alloc_bytes(sizeof(T))) T(std::forward<Args>(args)...);
+    } else {
+      // the destructor list entry goes right before the object.
+      u8* mem = alloc_bytes(sizeof(DtorNode) + sizeof(T));
+      T* obj = new (mem + sizeof(DtorNode)) T(std::forward<Args>(args)...);
+      // only link in once constructed, so a throwing constructor isn't destroyed.
+      m_dtors = new (mem) DtorNode{[](void* p) { static_cast<T*>(p)->~T(); }, m_dtors};
+      return obj;
+    }
+  }
+
+  /*!
+   * Destroy all objects (newest first) and free all memory.
+   */
+  void release();
+
+  const Stats& stats() const { return m_stats; }
+
+ private:
+  static constexpr size_t kMaxAlign = 16;
+  static constexpr size_t kBlockSize = 64 * 1024;
+
+  struct alignas(kMaxAlign) DtorNode {
+    void (*destroy)(void*);
+    DtorNode* next;
+  };
+
+  u8* alloc_bytes(size_t size) {
+    size = (size + kMaxAlign - 1) & ~(kMaxAlign - 1);
+    m_stats.objects++;
+    m_stats.bytes += size;
+    if (size > size_t(m_end - m_next)) {
+      new_block(size);
+    }
+    u8* result = m_next;
+    m_next += size;
+    return result;
+  }
+
+  void new_block(size_t min_size);
+
+  std::vector<std::unique_ptr<u8[]>> m_blocks;
+  u8* m_next = nullptr;
+  u8* m_end = nullptr;
+  DtorNode* m_dtors = nullptr;
+  Stats m_stats;
+};
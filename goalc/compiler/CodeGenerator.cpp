@@ -24,11 +24,23 @@ CodeGenerator::CodeGenerator(FileEnv* env, DebugInfo* debug_info, GameVersion ve
 /*!
  * Generate an object file.
  */
-std::vector<u8> CodeGenerator::run(const TypeSystem* ts) {
+std::vector<u8> CodeGenerator::run(const TypeSystem* ts, int num_threads) {
   std::unordered_set<std::string> function_names;
 
+  // printing the IR for the debugger is the slow part of this, and each function is independent.
+  std::vector<std::vector<std::string>> ir_strings(m_fe->functions().size());
+  m_fe->run_per_function(num_threads, [&](int f_idx) {
+    const auto& code = m_fe->functions().at(f_idx)->code();
+    auto& strings = ir_strings.at(f_idx);
+    strings.reserve(code.size());
+    for (auto& x : code) {
+      strings.push_back(x->print());
+    }
+  });
+
   // first, add each function to the ObjectGenerator (but don't add any data)
-  for (auto& f : m_fe->functions()) {
+  for (size_t f_idx = 0; f_idx < m_fe->functions().size(); f_idx++) {
+    auto& f = m_fe->functions().at(f_idx);
     if (function_names.find(f->name()) == function_names.end()) {
       function_names.insert(f->name());
     } else {
@@ -41,9 +53,7 @@ std::vector<u8> CodeGenerator::run(const TypeSystem* ts) {
     for (auto& x : f->code_source()) {
       rec.debug->code_sources.push_back(x.heap_obj);
     }
-    for (auto& x : f->code()) {
-      rec.debug->ir_strings.push_back(x->print());
-    }
+    rec.debug->ir_strings = std::move(ir_strings.at(f_idx));
   }
 
   // next, add all static objects.
@@ -19,7 +19,7 @@ class TypeSystem;
 class CodeGenerator {
  public:
   CodeGenerator(FileEnv* env, DebugInfo* debug_info, GameVersion version);
-  std::vector<u8> run(const TypeSystem* ts);
+  std::vector<u8> run(const TypeSystem* ts, int num_threads = 1);
   emitter::ObjectGeneratorStats get_obj_stats() const { return m_gen.get_stats(); }
 
  private:
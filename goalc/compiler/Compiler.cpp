@@ -1,5 +1,6 @@
 #include "Compiler.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -95,6 +96,7 @@ ReplStatus Compiler::handle_repl_string(const std::string& input) {
   }
 
   try {
+    compile_deferred_object_files();
     // 1). read
     goos::Object code = m_goos.reader.read_from_string(input, true);
     // 2). compile
@@ -113,7 +115,7 @@ ReplStatus Compiler::handle_repl_string(const std::string& input) {
       // 4). send!
       if (m_listener.is_connected()) {
         m_listener.send_code(data);
-        if (!m_listener.most_recent_send_was_acked()) {
+        if (!m_listener.wait_for_pending_acks()) {
           print_compiler_warning("Runtime is not responding. Did it crash?\n");
         }
       }
@@ -248,9 +250,27 @@ Val* Compiler::compile_error_guard(const goos::Object& code, Env* env) {
   }
 }
 
+int Compiler::codegen_thread_count() const {
+  // the allocator prints are only readable from a single thread.
+  if (m_settings.debug_print_regalloc) {
+    return 1;
+  }
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
 void Compiler::color_object_file(FileEnv* env) {
-  int num_spills_in_file = 0;
-  for (auto& f : env->functions()) {
+  const auto& functions = env->functions();
+  struct ColorResult {
+    bool needed_v1 = false;
+    int num_spills = 0;
+    int num_spills_v1 = 0;
+  };
+  std::vector<ColorResult> results(functions.size());
+
+  // each function is allocated separately and only writes to its own FunctionEnv.
+  env->run_per_function(codegen_thread_count(), [&](int f_idx) {
+    auto& f = functions[f_idx];
+    auto& color_result = results[f_idx];
     AllocationInput input;
     input.is_asm_function = f->is_asm_func;
     for (auto& i : f->code()) {
@@ -276,8 +296,6 @@ void Compiler::color_object_file(FileEnv* env) {
       input.debug_settings.allocate_log_level = 2;
     }
 
-    m_debug_stats.total_funcs++;
-
     auto regalloc_result_2 = allocate_registers_v2(input);
 
     if (regalloc_result_2.ok) {
@@ -285,22 +303,31 @@ void Compiler::color_object_file(FileEnv* env) {
         // lg::print("Function {} has {} spilled vars.\n", f->name(),
         //  regalloc_result_2.num_spilled_vars);
       }
-      num_spills_in_file += regalloc_result_2.num_spills;
+      color_result.num_spills = regalloc_result_2.num_spills;
       f->set_allocations(std::move(regalloc_result_2));
     } else {
+      color_result.needed_v1 = true;
+      auto regalloc_result = allocate_registers(input);
+      color_result.num_spills_v1 = regalloc_result.num_spills;
+      color_result.num_spills = regalloc_result.num_spills;
+      f->set_allocations(std::move(regalloc_result));
+    }
+  });
+
+  // merge in function order, so the output doesn't depend on thread timing.
+  for (size_t f_idx = 0; f_idx < functions.size(); f_idx++) {
+    const auto& color_result = results[f_idx];
+    m_debug_stats.total_funcs++;
+    if (color_result.needed_v1) {
       lg::print(
           "Warning: function {} failed register allocation with the v2 allocator. Falling back to "
           "the v1 allocator.\n",
-          f->name());
+          functions[f_idx]->name());
       m_debug_stats.funcs_requiring_v1_allocator++;
-      auto regalloc_result = allocate_registers(input);
-      m_debug_stats.num_spills_v1 += regalloc_result.num_spills;
-      num_spills_in_file += regalloc_result.num_spills;
-      f->set_allocations(std::move(regalloc_result));
+      m_debug_stats.num_spills_v1 += color_result.num_spills_v1;
     }
+    m_debug_stats.num_spills += color_result.num_spills;
   }
-
-  m_debug_stats.num_spills += num_spills_in_file;
 }
 
 std::vector<u8> Compiler::codegen_object_file(FileEnv* env) {
@@ -309,7 +336,7 @@ std::vector<u8> Compiler::codegen_object_file(FileEnv* env) {
     debug_info->clear();
     CodeGenerator gen(env, debug_info, m_version);
     bool ok = true;
-    auto result = gen.run(&m_ts);
+    auto result = gen.run(&m_ts, codegen_thread_count());
     for (auto& f : env->functions()) {
       if (f->settings.print_asm) {
         lg::print("{}\n", debug_info->disassemble_function_by_name(f->name(), &ok, &m_goos.reader));
@@ -317,6 +344,12 @@ std::vector<u8> Compiler::codegen_object_file(FileEnv* env) {
     }
     auto stats = gen.get_obj_stats();
     m_debug_stats.num_moves_eliminated += stats.moves_eliminated;
+    const auto& arena_stats = env->arena().stats();
+    m_debug_stats.arena_objects += arena_stats.objects;
+    m_debug_stats.arena_bytes += arena_stats.bytes;
+    m_debug_stats.arena_blocks += arena_stats.blocks;
+    m_debug_stats.arena_max_file_bytes =
+        std::max(m_debug_stats.arena_max_file_bytes, arena_stats.block_bytes);
     env->cleanup_after_codegen();
     return result;
   } catch (std::exception& e) {
@@ -332,7 +365,7 @@ bool Compiler::codegen_and_disassemble_object_file(FileEnv* env,
   auto debug_info = &m_debugger.get_debug_info_for_object(env->name());
   debug_info->clear();
   CodeGenerator gen(env, debug_info, m_version);
-  *data_out = gen.run(&m_ts);
+  *data_out = gen.run(&m_ts, codegen_thread_count());
   bool ok = true;
   *asm_out = debug_info->disassemble_all_functions(&ok, &m_goos.reader, omit_ir);
   return ok;
@@ -384,7 +417,7 @@ void Compiler::typecheck_reg_type_allow_false(const goos::Object& form,
 
 void Compiler::setup_goos_forms() {
   m_goos.register_form("get-enum-vals", [&](const goos::Object& form, goos::Arguments& args,
-                                            const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                            const goos::HeapPtr<goos::EnvironmentObject>& env) {
     m_goos.eval_args(&args, env);
     va_check(form, args, {goos::ObjectType::SYMBOL}, {});
     std::vector<Object> enum_vals;
@@ -424,6 +457,8 @@ void Compiler::asm_file(const CompilationOptions& options) {
   //
   // If multiple candidates are found, abort
 
+  compile_deferred_object_files();
+
   std::string file_name = options.filename;
   std::string file_path = file_util::get_file_path({file_name});
 
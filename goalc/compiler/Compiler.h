@@ -3,6 +3,7 @@
 #include <functional>
 #include <mutex>
 #include <optional>
+#include <unordered_set>
 
 #include "common/goos/Interpreter.h"
 #include "common/repl/repl_wrapper.h"
@@ -74,6 +75,9 @@ class Compiler {
   void compile_and_send_from_string(const std::string& source_code);
   void run_front_end_on_string(const std::string& src);
   void run_front_end_on_file(const std::vector<std::string>& path);
+  void run_front_end_on_file_forms(const std::string& file_path,
+                                   const std::string& text,
+                                   const std::unordered_set<int>& line_idxs);
   void run_full_compiler_on_string_no_save(const std::string& src,
                                            const std::optional<std::string>& string_name);
   void shutdown_target();
@@ -100,9 +104,14 @@ class Compiler {
                      replxx::Replxx::colors_t& colors,
                      std::vector<std::pair<std::string, replxx::Replxx::Color>> const& user_data);
   bool knows_object_file(const std::string& name);
+  void defer_object_file(const std::string& filename);
+  void compile_deferred_object_files();
   MakeSystem& make_system() { return m_make; }
   std::vector<symbol_info::SymbolInfo*> lookup_symbol_info_by_file(
       const std::string& file_path) const;
+  void remap_symbol_info_in_file(
+      const std::string& file_path,
+      const std::function<std::optional<uint32_t>(uint32_t)>& new_line_idx);
   std::vector<symbol_info::SymbolInfo*> lookup_symbol_info_by_prefix(
       const std::string& prefix) const;
   std::set<std::string> lookup_symbol_names_starting_with(const std::string& prefix,
@@ -127,6 +136,9 @@ class Compiler {
   goos::Interpreter m_goos;
   Debugger m_debugger;
   MakeSystem m_make;
+  // files that the build cache didn't compile. They are compiled the next time the compiler needs
+  // their types, macros, or debug info.
+  std::vector<std::string> m_deferred_object_files;
   std::unique_ptr<REPL::Wrapper> m_repl;
   CompilerSettings m_settings;
   bool m_throw_on_define_extern_redefinition = false;  // TODO - move to settings
@@ -147,6 +159,10 @@ class Compiler {
     int num_moves_eliminated = 0;
     int total_funcs = 0;
     int funcs_requiring_v1_allocator = 0;
+    u64 arena_objects = 0;         // IR/Val/Env/Label objects allocated in file arenas
+    u64 arena_bytes = 0;           // bytes used by those objects
+    u64 arena_blocks = 0;          // arena blocks allocated
+    u64 arena_max_file_bytes = 0;  // largest arena for a single file
   } m_debug_stats;
 
   void setup_goos_forms();
@@ -224,6 +240,7 @@ class Compiler {
                              Env* env);
 
   SymbolVal* compile_get_sym_obj(const std::string& name, Env* env);
+  int codegen_thread_count() const;
   void color_object_file(FileEnv* env);
   std::vector<u8> codegen_object_file(FileEnv* env);
   bool codegen_and_disassemble_object_file(FileEnv* env,
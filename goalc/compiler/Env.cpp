@@ -1,11 +1,14 @@
 #include "Env.h"
 
+#include <algorithm>
+#include <exception>
 #include <stdexcept>
 
 #include "IR.h"
 
 #include "common/goos/Reader.h"
 #include "common/log/log.h"
+#include "common/util/SimpleThreadGroup.h"
 
 #include "fmt/core.h"
 
@@ -54,10 +57,10 @@ std::unordered_map<std::string, Label>& Env::get_label_map() {
   return parent()->get_label_map();
 }
 
-void Env::emit(const goos::Object& form, std::unique_ptr<IR> ir) {
+void Env::emit(const goos::Object& form, IR* ir) {
   auto e = function_env();
   ASSERT(e);
-  e->emit(form, std::move(ir), this);
+  e->emit(form, ir, this);
 }
 
 ///////////////////
@@ -184,11 +187,53 @@ bool FileEnv::is_empty() {
          m_top_level_func->code().empty();
 }
 
+/*!
+ * Run func(i) for each function in the file, on up to num_threads threads if there are enough
+ * functions to make it worthwhile. Larger functions are started first, so a huge function isn't
+ * left running alone at the end. If any throw, the exception from the first function is rethrown.
+ */
+void FileEnv::run_per_function(int num_threads, const std::function<void(int)>& func) const {
+  int count = m_functions.size();
+  if (num_threads <= 1 || count < 8) {
+    for (int i = 0; i < count; i++) {
+      func(i);
+    }
+    return;
+  }
+
+  std::vector<int> order(count);
+  for (int i = 0; i < count; i++) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+    return m_functions[a]->code().size() > m_functions[b]->code().size();
+  });
+
+  std::vector<std::exception_ptr> errors(count);
+  SimpleThreadGroup threads;
+  threads.run_dynamic(
+      [&](int i) {
+        try {
+          func(order[i]);
+        } catch (...) {
+          errors[order[i]] = std::current_exception();
+        }
+      },
+      count, std::min(num_threads, count));
+  threads.join();
+
+  for (auto& e : errors) {
+    if (e) {
+      std::rethrow_exception(e);
+    }
+  }
+}
+
 void FileEnv::cleanup_after_codegen() {
   m_top_level_func = nullptr;
   m_functions.clear();
   m_statics.clear();
-  m_vals.clear();
+  m_arena.release();
 }
 
 ///////////////////
@@ -196,15 +241,18 @@ void FileEnv::cleanup_after_codegen() {
 ///////////////////
 
 FunctionEnv::FunctionEnv(Env* parent, std::string name, const goos::Reader* reader)
-    : DeclareEnv(EnvKind::FUNCTION_ENV, parent), m_name(std::move(name)), m_reader(reader) {}
+    : DeclareEnv(EnvKind::FUNCTION_ENV, parent), m_name(std::move(name)), m_reader(reader) {
+  ASSERT(file_env());
+  m_arena = &file_env()->arena();
+}
 
 std::string FunctionEnv::print() {
   return "function-" + m_name;
 }
 
-void FunctionEnv::emit(const goos::Object& form, std::unique_ptr<IR> ir, Env* lowest_env) {
+void FunctionEnv::emit(const goos::Object& form, IR* ir, Env* lowest_env) {
   ir->add_constraints(&m_constraints, m_code.size());
-  m_code.push_back(std::move(ir));
+  m_code.push_back(ir);
   if (m_reader->db.has_info(form)) {
     // if we have info, it means we came from real code and we can just use that.
     m_code_debug_source.push_back(form);
@@ -258,10 +306,8 @@ RegVal* FunctionEnv::make_ireg(const TypeSpec& ts, RegClass reg_class) {
   IRegister ireg;
   ireg.reg_class = reg_class;
   ireg.id = m_iregs.size();
-  auto rv = std::make_unique<RegVal>(ireg, ts);
-  m_iregs.push_back(std::move(rv));
   ASSERT(reg_class != RegClass::INVALID);
-  return m_iregs.back().get();
+  return push_reg_val(ireg, ts);
 }
 
 std::unordered_map<std::string, Label>& FunctionEnv::get_label_map() {
@@ -323,9 +369,9 @@ StackVarAddrVal* FunctionEnv::allocate_aligned_stack_variable(const TypeSpec& ts
   return alloc_val<StackVarAddrVal>(ts, space.start_slot, space.slot_count);
 }
 
-RegVal* FunctionEnv::push_reg_val(std::unique_ptr<RegVal> in) {
-  m_iregs.push_back(std::move(in));
-  return m_iregs.back().get();
+RegVal* FunctionEnv::push_reg_val(const IRegister& ireg, const TypeSpec& ts) {
+  m_iregs.push_back(m_arena->alloc<RegVal>(ireg, ts));
+  return m_iregs.back();
 }
 
 StackVarAddrVal* FunctionEnv::allocate_stack_singleton(const TypeSpec& ts,
@@ -6,10 +6,12 @@
  * manages the memory for stuff generated during compiling.
  */
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "Arena.h"
 #include "Label.h"
 #include "StaticObject.h"
 #include "Val.h"
@@ -35,7 +37,7 @@ class Env {
  public:
   explicit Env(EnvKind kind, Env* parent);
   virtual std::string print() = 0;
-  void emit(const goos::Object& form, std::unique_ptr<IR> ir);
+  void emit(const goos::Object& form, IR* ir);
   virtual RegVal* make_ireg(const TypeSpec& ts, RegClass reg_class);
   virtual void constrain_reg(IRegConstraint constraint);  // todo, remove!
   virtual RegVal* lexical_lookup(goos::Object sym);
@@ -48,8 +50,13 @@ class Env {
   Env* parent() { return m_parent; }
 
   template <typename IR_Type, typename... Args>
-  void emit_ir(const goos::Object& form, Args&&... args) {
-    emit(form, std::make_unique<IR_Type>(std::forward<Args>(args)...));
+  IR_Type* alloc_ir(Args&&... args);
+
+  template <typename IR_Type, typename... Args>
+  IR_Type* emit_ir(const goos::Object& form, Args&&... args) {
+    auto ir = alloc_ir<IR_Type>(std::forward<Args>(args)...);
+    emit(form, ir);
+    return ir;
   }
 
   FileEnv* file_env() { return m_lowest_envs.file_env; }
@@ -117,13 +124,16 @@ class FileEnv : public Env {
   bool is_empty();
   ~FileEnv() = default;
 
+  void run_per_function(int num_threads, const std::function<void(int)>& func) const;
+
   template <typename T, class... Args>
   T* alloc_val(Args&&... args) {
-    std::unique_ptr<T> new_obj = std::make_unique<T>(std::forward<Args>(args)...);
-    m_vals.push_back(std::move(new_obj));
-    return (T*)m_vals.back().get();
+    return m_arena.alloc<T>(std::forward<Args>(args)...);
   }
 
+  // owns the IR, Vals, Envs and Labels of this file's functions, until cleanup_after_codegen.
+  Arena& arena() { return m_arena; }
+
   int default_segment() const { return m_default_segment; }
   void set_nondebug_file() { m_default_segment = MAIN_SEGMENT; }
   void set_debug_file() { m_default_segment = DEBUG_SEGMENT; }
@@ -136,11 +146,12 @@ class FileEnv : public Env {
   std::unordered_set<std::string> m_missing_required_files;  // TODO - a string for now
 
  protected:
+  // first, so it's destroyed after the functions that point into it.
+  Arena m_arena;
   std::string m_name;
   std::vector<std::unique_ptr<FunctionEnv>> m_functions;
   std::vector<std::unique_ptr<StaticObject>> m_statics;
   int m_anon_func_counter = 0;
-  std::vector<std::unique_ptr<Val>> m_vals;
   int m_default_segment = MAIN_SEGMENT;
 
   // statics
@@ -185,10 +196,10 @@ class FunctionEnv : public DeclareEnv {
   std::string print() override;
   std::unordered_map<std::string, Label>& get_label_map() override;
   void set_segment(int seg) { segment = seg; }
-  void emit(const goos::Object& form, std::unique_ptr<IR> ir, Env* lowest_env);
+  void emit(const goos::Object& form, IR* ir, Env* lowest_env);
   void finish();
   RegVal* make_ireg(const TypeSpec& ts, RegClass reg_class) override;
-  const std::vector<std::unique_ptr<IR>>& code() const { return m_code; }
+  const std::vector<IR*>& code() const { return m_code; }
   const std::vector<goos::Object>& code_source() const { return m_code_debug_source; }
   int max_vars() const { return m_iregs.size(); }
   const std::vector<IRegConstraint>& constraints() { return m_constraints; }
@@ -198,10 +209,7 @@ class FunctionEnv : public DeclareEnv {
   const AllocationResult& alloc_result() { return m_regalloc_result; }
   bool needs_aligned_stack() const { return m_aligned_stack_required; }
   void require_aligned_stack() { m_aligned_stack_required = true; }
-  Label* alloc_unnamed_label() {
-    m_unnamed_labels.emplace_back(std::make_unique<Label>());
-    return m_unnamed_labels.back().get();
-  }
+  Label* alloc_unnamed_label() { return m_arena->alloc<Label>(); }
   const std::string& name() const { return m_name; }
 
   struct StackSpace {
@@ -225,23 +233,25 @@ class FunctionEnv : public DeclareEnv {
 
   int idx_in_file = -1;
 
+  // these all live in the file's arena.
   template <typename T, class... Args>
   T* alloc_val(Args&&... args) {
-    std::unique_ptr<T> new_obj = std::make_unique<T>(std::forward<Args>(args)...);
-    m_vals.push_back(std::move(new_obj));
-    return (T*)m_vals.back().get();
+    return m_arena->alloc<T>(std::forward<Args>(args)...);
   }
 
   template <typename T, class... Args>
   T* alloc_env(Args&&... args) {
-    std::unique_ptr<T> new_obj = std::make_unique<T>(std::forward<Args>(args)...);
-    m_envs.push_back(std::move(new_obj));
-    return (T*)m_envs.back().get();
+    return m_arena->alloc<T>(std::forward<Args>(args)...);
   }
 
-  const std::vector<std::unique_ptr<RegVal>>& reg_vals() const { return m_iregs; }
+  template <typename T, class... Args>
+  T* alloc_ir(Args&&... args) {
+    return m_arena->alloc<T>(std::forward<Args>(args)...);
+  }
+
+  const std::vector<RegVal*>& reg_vals() const { return m_iregs; }
 
-  RegVal* push_reg_val(std::unique_ptr<RegVal> in);
+  RegVal* push_reg_val(const IRegister& ireg, const TypeSpec& ts);
 
   int segment = -1;
   std::string method_of_type_name = "#f";
@@ -257,12 +267,11 @@ class FunctionEnv : public DeclareEnv {
  protected:
   void resolve_gotos();
   std::string m_name;
-  std::vector<std::unique_ptr<IR>> m_code;
+  Arena* m_arena = nullptr;
+  std::vector<IR*> m_code;
   std::vector<goos::Object> m_code_debug_source;
 
-  std::vector<std::unique_ptr<RegVal>> m_iregs;
-  std::vector<std::unique_ptr<Val>> m_vals;
-  std::vector<std::unique_ptr<Env>> m_envs;
+  std::vector<RegVal*> m_iregs;
   std::vector<IRegConstraint> m_constraints;
 
   AllocationResult m_regalloc_result;
@@ -270,7 +279,6 @@ class FunctionEnv : public DeclareEnv {
   bool m_aligned_stack_required = false;
   int m_stack_var_slots_used = 0;
   std::unordered_map<std::string, Label> m_labels;
-  std::vector<std::unique_ptr<Label>> m_unnamed_labels;
   std::unordered_map<std::string, StackSpace> m_stack_singleton_slots;
 
   const goos::Reader* m_reader = nullptr;
@@ -388,3 +396,10 @@ inline Env::Env(EnvKind kind, Env* parent) : m_kind(kind), m_parent(parent) {
     m_lowest_envs.macro_expand_env = m_parent ? m_parent->m_lowest_envs.macro_expand_env : nullptr;
   }
 }
+
+template <typename IR_Type, typename... Args>
+IR_Type* Env::alloc_ir(Args&&... args) {
+  auto e = function_env();
+  ASSERT(e);
+  return e->alloc_ir<IR_Type>(std::forward<Args>(args)...);
+}
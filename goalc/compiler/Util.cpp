@@ -1,5 +1,6 @@
 #include "common/goos/ParseHelpers.h"
 #include "common/type_system/deftype.h"
+#include "common/util/FileUtil.h"
 #include "common/util/json_util.h"
 #include "common/util/string_util.h"
 
@@ -49,7 +50,7 @@ void Compiler::compile_and_send_from_string(const std::string& source_code) {
   color_object_file(compiled);
   auto data = codegen_object_file(compiled);
   m_listener.send_code(data);
-  if (!m_listener.most_recent_send_was_acked()) {
+  if (!m_listener.wait_for_pending_acks()) {
     print_compiler_warning("Runtime is not responding after sending test code. Did it crash?\n");
   }
 }
@@ -69,7 +70,7 @@ std::vector<std::string> Compiler::run_test_from_file(const std::string& source_
     auto data = codegen_object_file(compiled);
     m_listener.record_messages(ListenerMessageKind::MSG_PRINT);
     m_listener.send_code(data);
-    if (!m_listener.most_recent_send_was_acked()) {
+    if (!m_listener.wait_for_pending_acks()) {
       print_compiler_warning("Runtime is not responding after sending test code. Did it crash?\n");
     }
     return m_listener.stop_recording_messages();
@@ -95,7 +96,7 @@ std::vector<std::string> Compiler::run_test_from_string(const std::string& src,
     auto data = codegen_object_file(compiled);
     m_listener.record_messages(ListenerMessageKind::MSG_PRINT);
     m_listener.send_code(data);
-    if (!m_listener.most_recent_send_was_acked()) {
+    if (!m_listener.wait_for_pending_acks()) {
       print_compiler_warning("Runtime is not responding after sending test code. Did it crash?\n");
     }
     return m_listener.stop_recording_messages();
@@ -123,6 +124,31 @@ void Compiler::run_front_end_on_file(const std::vector<std::string>& path) {
   compile_object_file("run-on-file", code, true);
 }
 
+/*!
+ * Run the front end on only some of the top-level forms of a file, reading the file from text
+ * instead of from disk. Only the forms that start on one of the given lines are compiled, the rest
+ * of the file is assumed to be compiled already. The text is read under the file's path so the
+ * symbols defined by these forms get the right definition locations.
+ */
+void Compiler::run_front_end_on_file_forms(const std::string& file_path,
+                                           const std::string& text,
+                                           const std::unordered_set<int>& line_idxs) {
+  auto code = m_goos.reader.read_from_string(text, true, file_path);
+  std::vector<goos::Object> forms;
+  for_each_in_list(code.as_pair()->cdr, [&](const goos::Object& form) {
+    const auto info = m_goos.reader.db.get_short_info_for(form);
+    if (info && line_idxs.count(info->line_idx_to_display)) {
+      forms.push_back(form);
+    }
+  });
+  if (forms.empty()) {
+    return;
+  }
+  compile_object_file(file_util::base_name_no_ext(file_path),
+                      goos::PairObject::make_new(code.as_pair()->car, goos::build_list(forms)),
+                      true);
+}
+
 /*!
  * Run the entire compilation process on the input source code. Will generate an object file, but
  * won't save it anywhere.
@@ -155,6 +181,32 @@ bool Compiler::knows_object_file(const std::string& name) {
   return m_debugger.knows_object(name);
 }
 
+/*!
+ * Remember a file whose compile was skipped because its output is already up to date.
+ */
+void Compiler::defer_object_file(const std::string& filename) {
+  m_deferred_object_files.push_back(filename);
+}
+
+/*!
+ * Compile the deferred files, in order, without writing them. This is done before compiling
+ * anything else, so later files see the same state as if nothing had been skipped.
+ */
+void Compiler::compile_deferred_object_files() {
+  if (m_deferred_object_files.empty()) {
+    return;
+  }
+  auto files = std::move(m_deferred_object_files);
+  m_deferred_object_files.clear();
+  lg::print("Compiling {} files skipped by the build cache...\n", files.size());
+  for (auto& file : files) {
+    CompilationOptions options;
+    options.filename = file;
+    options.color = true;
+    asm_file(options);
+  }
+}
+
 /*!
  * Parse arguments into a goos::Arguments format.
  */
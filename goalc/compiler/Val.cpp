@@ -14,7 +14,7 @@ RegVal* Val::to_gpr(const goos::Object& form, Env* fe) {
     return rv;
   } else {
     auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-    fe->emit(form, std::make_unique<IR_RegSet>(re, rv));
+    fe->emit_ir<IR_RegSet>(form, re, rv);
     return re;
   }
 }
@@ -28,7 +28,7 @@ RegVal* Val::to_fpr(const goos::Object& form, Env* fe) {
     return rv;
   } else {
     auto re = fe->make_fpr(coerce_to_reg_type(m_ts));
-    fe->emit(form, std::make_unique<IR_RegSet>(re, rv));
+    fe->emit_ir<IR_RegSet>(form, re, rv);
     return re;
   }
 }
@@ -42,7 +42,7 @@ RegVal* Val::to_xmm128(const goos::Object& form, Env* fe) {
     return rv;
   } else {
     auto re = fe->make_ireg(coerce_to_reg_type(m_ts), RegClass::INT_128);
-    fe->emit(form, std::make_unique<IR_RegSet>(re, rv));
+    fe->emit_ir<IR_RegSet>(form, re, rv);
     return re;
   }
 }
@@ -57,7 +57,7 @@ RegVal* RegVal::to_gpr(const goos::Object& form, Env* fe) {
     return this;
   } else {
     auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-    fe->emit(form, std::make_unique<IR_RegSet>(re, this));
+    fe->emit_ir<IR_RegSet>(form, re, this);
     return re;
   }
 }
@@ -67,7 +67,7 @@ RegVal* RegVal::to_fpr(const goos::Object& form, Env* fe) {
     return this;
   } else {
     auto re = fe->make_fpr(coerce_to_reg_type(m_ts));
-    fe->emit(form, std::make_unique<IR_RegSet>(re, this));
+    fe->emit_ir<IR_RegSet>(form, re, this);
     return re;
   }
 }
@@ -77,7 +77,7 @@ RegVal* RegVal::to_xmm128(const goos::Object& form, Env* fe) {
     return this;
   } else {
     auto re = fe->make_ireg(coerce_to_reg_type(m_ts), RegClass::INT_128);
-    fe->emit(form, std::make_unique<IR_RegSet>(re, this));
+    fe->emit_ir<IR_RegSet>(form, re, this);
     return re;
   }
 }
@@ -93,7 +93,7 @@ const std::optional<emitter::Register>& RegVal::rlet_constraint() const {
 RegVal* IntegerConstantVal::to_reg(const goos::Object& form, Env* fe) {
   if (m_value.uses_gpr()) {
     auto rv = fe->make_gpr(coerce_to_reg_type(m_ts));
-    fe->emit(form, std::make_unique<IR_LoadConstant64>(rv, m_value.value_64()));
+    fe->emit_ir<IR_LoadConstant64>(form, rv, m_value.value_64());
     return rv;
   } else {
     auto rv = fe->make_ireg(m_ts, RegClass::INT_128);
@@ -125,7 +125,7 @@ RegVal* IntegerConstantVal::to_xmm128(const goos::Object& form, Env* fe) {
     } else {
       // but we got only an integer, need to promote. we're a constant, so this is safe.
       auto re = fe->make_ireg(coerce_to_reg_type(m_ts), RegClass::INT_128);
-      fe->emit(form, std::make_unique<IR_RegSet>(re, rv));
+      fe->emit_ir<IR_RegSet>(form, re, rv);
       return re;
     }
   }
@@ -133,26 +133,26 @@ RegVal* IntegerConstantVal::to_xmm128(const goos::Object& form, Env* fe) {
 
 RegVal* SymbolVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_LoadSymbolPointer>(re, m_name));
+  fe->emit_ir<IR_LoadSymbolPointer>(form, re, m_name);
   return re;
 }
 
 RegVal* SymbolValueVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_GetSymbolValue>(re, m_sym, m_sext));
+  fe->emit_ir<IR_GetSymbolValue>(form, re, m_sym, m_sext);
   return re;
 }
 
 RegVal* StaticVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_StaticVarAddr>(re, obj));
+  fe->emit_ir<IR_StaticVarAddr>(form, re, obj);
   return re;
 }
 
 RegVal* LambdaVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
   ASSERT(func);
-  fe->emit(form, std::make_unique<IR_FunctionAddr>(re, func));
+  fe->emit_ir<IR_FunctionAddr>(form, re, func);
   return re;
 }
 
@@ -163,7 +163,7 @@ RegVal* InlinedLambdaVal::to_reg(const goos::Object&, Env*) {
 
 RegVal* FloatConstantVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_fpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_StaticVarLoad>(re, m_value));
+  fe->emit_ir<IR_StaticVarLoad>(form, re, m_value);
   return re;
 }
 
@@ -192,9 +192,8 @@ RegVal* MemoryOffsetConstantVal::to_reg(const goos::Object& form, Env* fe) {
   if (final_offset == 0) {
     fe->emit_ir<IR_RegSet>(form, re, final_base->to_gpr(form, fe));
   } else {
-    fe->emit(form, std::make_unique<IR_LoadConstant64>(re, int64_t(final_offset)));
-    fe->emit(form, std::make_unique<IR_IntegerMath>(IntegerMathKind::ADD_64, re,
-                                                    final_base->to_gpr(form, fe)));
+    fe->emit_ir<IR_LoadConstant64>(form, re, int64_t(final_offset));
+    fe->emit_ir<IR_IntegerMath>(form, IntegerMathKind::ADD_64, re, final_base->to_gpr(form, fe));
   }
 
   return re;
@@ -202,9 +201,8 @@ RegVal* MemoryOffsetConstantVal::to_reg(const goos::Object& form, Env* fe) {
 
 RegVal* MemoryOffsetVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_RegSet>(re, offset->to_gpr(form, fe)));
-  fe->emit(form,
-           std::make_unique<IR_IntegerMath>(IntegerMathKind::ADD_64, re, base->to_gpr(form, fe)));
+  fe->emit_ir<IR_RegSet>(form, re, offset->to_gpr(form, fe));
+  fe->emit_ir<IR_IntegerMath>(form, IntegerMathKind::ADD_64, re, base->to_gpr(form, fe));
   return re;
 }
 
@@ -217,7 +215,7 @@ RegVal* MemoryDerefVal::to_reg(const goos::Object& form, Env* fe) {
     fe->emit_ir<IR_LoadConstOffset>(form, re, (int)offset, final_base->to_gpr(form, fe), info);
   } else {
     auto addr = base->to_gpr(form, fe);
-    fe->emit(form, std::make_unique<IR_LoadConstOffset>(re, 0, addr, info));
+    fe->emit_ir<IR_LoadConstOffset>(form, re, 0, addr, info);
   }
   return re;
 }
@@ -231,7 +229,7 @@ RegVal* MemoryDerefVal::to_fpr(const goos::Object& form, Env* fe) {
     fe->emit_ir<IR_LoadConstOffset>(form, re, offset, final_base->to_gpr(form, fe), info);
   } else {
     auto addr = base->to_gpr(form, fe);
-    fe->emit(form, std::make_unique<IR_LoadConstOffset>(re, 0, addr, info));
+    fe->emit_ir<IR_LoadConstOffset>(form, re, 0, addr, info);
   }
   return re;
 }
@@ -239,14 +237,14 @@ RegVal* MemoryDerefVal::to_fpr(const goos::Object& form, Env* fe) {
 RegVal* AliasVal::to_reg(const goos::Object& form, Env* fe) {
   auto as_old_type = base->to_reg(form, fe);
   auto result = fe->make_ireg(m_ts, as_old_type->ireg().reg_class);
-  fe->emit(form, std::make_unique<IR_RegSet>(result, as_old_type));
+  fe->emit_ir<IR_RegSet>(form, result, as_old_type);
   return result;
 }
 
 RegVal* AliasVal::to_xmm128(const goos::Object& form, Env* fe) {
   auto as_old_type = base->to_xmm128(form, fe);
   auto result = fe->make_ireg(m_ts, as_old_type->ireg().reg_class);
-  fe->emit(form, std::make_unique<IR_RegSet>(result, as_old_type));
+  fe->emit_ir<IR_RegSet>(form, result, as_old_type);
   return result;
 }
 
@@ -265,13 +263,13 @@ RegVal* PairEntryVal::to_reg(const goos::Object& form, Env* fe) {
   info.reg = RegClass::GPR_64;
   info.sign_extend = true;
   info.size = 4;
-  fe->emit(form, std::make_unique<IR_LoadConstOffset>(re, offset, base->to_gpr(form, fe), info));
+  fe->emit_ir<IR_LoadConstOffset>(form, re, offset, base->to_gpr(form, fe), info);
   return re;
 }
 
 RegVal* StackVarAddrVal::to_reg(const goos::Object& form, Env* fe) {
   auto re = fe->make_gpr(coerce_to_reg_type(m_ts));
-  fe->emit(form, std::make_unique<IR_GetStackAddr>(re, m_slot));
+  fe->emit_ir<IR_GetStackAddr>(form, re, m_slot);
   return re;
 }
 
@@ -290,7 +288,7 @@ RegVal* BitFieldVal::to_reg(const goos::Object& form, Env* env) {
     // accessing in the lower 64 bits, we can just get the value in a GPR.
     start_bit = m_offset;
     RegVal* gpr = m_parent->to_gpr(form, env);
-    env->emit(form, std::make_unique<IR_RegSet>(result, gpr));
+    env->emit_ir<IR_RegSet>(form, result, gpr);
   } else {
     // we need to get the value as a 128-bit integer
     auto xmm = m_parent->to_reg(form, env);
@@ -311,7 +309,7 @@ RegVal* BitFieldVal::to_reg(const goos::Object& form, Env* env) {
 
   // shift left as much as possible to kill upper bits
   if (epad > 0) {
-    env->emit(form, std::make_unique<IR_IntegerMath>(IntegerMathKind::SHL_64, result, epad));
+    env->emit_ir<IR_IntegerMath>(form, IntegerMathKind::SHL_64, result, epad);
   }
 
   int next_shift = epad + spad;
@@ -320,11 +318,9 @@ RegVal* BitFieldVal::to_reg(const goos::Object& form, Env* env) {
 
   if (next_shift > 0) {
     if (m_sign_extend) {
-      env->emit(form,
-                std::make_unique<IR_IntegerMath>(IntegerMathKind::SAR_64, result, next_shift));
+      env->emit_ir<IR_IntegerMath>(form, IntegerMathKind::SAR_64, result, next_shift);
     } else {
-      env->emit(form,
-                std::make_unique<IR_IntegerMath>(IntegerMathKind::SHR_64, result, next_shift));
+      env->emit_ir<IR_IntegerMath>(form, IntegerMathKind::SHR_64, result, next_shift);
     }
   }
 
@@ -81,8 +81,7 @@ Val* Compiler::compile_rlet(const goos::Object& form, const goos::Object& rest,
       // we want to see if we already created a variable for this register, and reuse it.
       for (auto& constr : fenv->constraints()) {
         if (constr.desired_register == desired_register && constr.contrain_everywhere) {
-          auto reg_val_ptr = std::make_unique<RegVal>(constr.ireg, ts);
-          new_place_reg = fenv->push_reg_val(std::move(reg_val_ptr));
+          new_place_reg = fenv->push_reg_val(constr.ireg, ts);
           new_place_reg->mark_as_settable();
           break;
         }
@@ -91,8 +90,7 @@ Val* Compiler::compile_rlet(const goos::Object& form, const goos::Object& rest,
       if (!new_place_reg) {
         for (auto& constr : constraints) {
           if (constr.desired_register == desired_register && constr.contrain_everywhere) {
-            auto reg_val_ptr = std::make_unique<RegVal>(constr.ireg, ts);
-            new_place_reg = fenv->push_reg_val(std::move(reg_val_ptr));
+            new_place_reg = fenv->push_reg_val(constr.ireg, ts);
             new_place_reg->mark_as_settable();
             break;
           }
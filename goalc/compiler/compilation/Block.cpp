@@ -87,13 +87,12 @@ Val* Compiler::compile_block(const goos::Object& form, const goos::Object& _rest
   if (!dynamic_cast<None*>(result)) {
     // an IR to move the result of the block into the block's return register (if no return-from's
     // are taken)
-    auto ir_move_rv =
-        std::make_unique<IR_RegSet>(block_env->return_value, result->to_gpr(form, fe));
+    auto ir_move_rv = env->alloc_ir<IR_RegSet>(block_env->return_value, result->to_gpr(form, fe));
 
     // note - one drawback of doing this single pass is that a block always evaluates to a gpr.
     // so we may have an unneeded xmm -> gpr move that could have been an xmm -> xmm that could have
     // been eliminated.
-    env->emit(form, std::move(ir_move_rv));
+    env->emit(form, ir_move_rv);
   }
 
   // now we know the end of the block, so we set the label index to be on whatever comes after the
@@ -127,16 +126,16 @@ Val* Compiler::compile_return_from(const goos::Object& form, const goos::Object&
   }
 
   // move result into return register
-  auto ir_move_rv = std::make_unique<IR_RegSet>(block->return_value, result->to_gpr(form, fe));
+  auto ir_move_rv = env->alloc_ir<IR_RegSet>(block->return_value, result->to_gpr(form, fe));
 
   // inform block of our possible return type
   block->return_types.push_back(result->type());
 
-  env->emit(form, std::move(ir_move_rv));
+  env->emit(form, ir_move_rv);
 
   // jump to end of block (by label object)
-  auto ir_jump = std::make_unique<IR_GotoLabel>(&block->end_label);
-  env->emit(form, std::move(ir_jump));
+  auto ir_jump = env->alloc_ir<IR_GotoLabel>(&block->end_label);
+  env->emit(form, ir_jump);
 
   // In the real GOAL, there is likely a bug here where a non-none value is returned and to_gpr'd
   // todo, determine if we should replicate this bug and if it can have side effects.
@@ -177,14 +176,14 @@ Val* Compiler::compile_goto(const goos::Object& form, const goos::Object& rest,
   auto label_name = symbol_string(pair_car(rest));
   expect_empty_list(pair_cdr(rest));
 
-  auto ir_goto = std::make_unique<IR_GotoLabel>();
+  auto ir_goto = env->alloc_ir<IR_GotoLabel>();
   // this requires looking up the label by name after, as it may be a goto to a label which has not
   // yet been defined.
 
   // add this goto to the list of gotos to resolve after the function is done.
   // it's safe to have this reference, as the FunctionEnv also owns the goto.
-  env->function_env()->unresolved_gotos.push_back({ir_goto.get(), label_name});
-  env->emit(form, std::move(ir_goto));
+  env->function_env()->unresolved_gotos.push_back({ir_goto, label_name});
+  env->emit(form, ir_goto);
   return get_none();
 }
 
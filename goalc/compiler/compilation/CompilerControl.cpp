@@ -298,6 +298,7 @@ Val* Compiler::compile_set_config(const goos::Object& form, const goos::Object&
   auto args = get_va(form, rest);
   va_check(form, args, {goos::ObjectType::SYMBOL, {}}, {});
   m_settings.set(symbol_string(args.unnamed.at(0)), args.unnamed.at(1));
+  m_listener.set_compress_code(m_settings.listener_compress_code);
   return get_none();
 }
 
@@ -612,6 +613,12 @@ std::vector<symbol_info::SymbolInfo*> Compiler::lookup_symbol_info_by_file(
   return m_symbol_info.lookup_symbols_by_file(file_path);
 }
 
+void Compiler::remap_symbol_info_in_file(
+    const std::string& file_path,
+    const std::function<std::optional<uint32_t>(uint32_t)>& new_line_idx) {
+  m_symbol_info.remap_symbols_in_file(file_path, new_line_idx);
+}
+
 std::vector<symbol_info::SymbolInfo*> Compiler::lookup_symbol_info_by_prefix(
     const std::string& prefix) const {
   return m_symbol_info.lookup_symbols_starting_with(prefix);
@@ -825,7 +832,8 @@ Val* Compiler::compile_make(const goos::Object& form, const goos::Object& rest,
   va_check(form, args, {goos::ObjectType::STRING},
            {{"force", {false, {goos::ObjectType::SYMBOL}}},
             {"verbose", {false, {goos::ObjectType::SYMBOL}}},
-            {"report", {false, {goos::ObjectType::SYMBOL}}}});
+            {"report", {false, {goos::ObjectType::SYMBOL}}},
+            {"jobs", {false, {goos::ObjectType::INTEGER}}}});
   bool force = false;
   if (args.has_named("force")) {
     force = get_true_or_false(form, args.get_named("force"));
@@ -841,7 +849,12 @@ Val* Compiler::compile_make(const goos::Object& form, const goos::Object& rest,
     report = get_true_or_false(form, args.get_named("report"));
   }
 
-  m_make.make(args.unnamed.at(0).as_string()->data, force, verbose, report);
+  std::optional<int> jobs;
+  if (args.has_named("jobs")) {
+    jobs = args.get_named("jobs").as_int();
+  }
+
+  m_make.make(args.unnamed.at(0).as_string()->data, force, verbose, report, jobs);
   return get_none();
 }
 
@@ -856,6 +869,11 @@ Val* Compiler::compile_print_debug_compiler_stats(const goos::Object& form,
   lg::print("Eliminated moves: {}\n", m_debug_stats.num_moves_eliminated);
   lg::print("Total functions: {}\n", m_debug_stats.total_funcs);
   lg::print("Functions requiring v1: {}\n", m_debug_stats.funcs_requiring_v1_allocator);
+  lg::print("Arena objects: {}\n", m_debug_stats.arena_objects);
+  lg::print("Arena bytes: {:.2f} MB in {} blocks\n", m_debug_stats.arena_bytes / (1024. * 1024.),
+            m_debug_stats.arena_blocks);
+  lg::print("Largest file arena: {:.2f} MB\n",
+            m_debug_stats.arena_max_file_bytes / (1024. * 1024.));
   lg::print("Size of autocomplete prefix tree: {}\n", m_symbol_info.symbol_count());
 
   return get_none();
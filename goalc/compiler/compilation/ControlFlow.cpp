@@ -138,13 +138,11 @@ Val* Compiler::compile_condition_as_bool(const goos::Object& form,
   auto c = compile_condition(form, env, true);
   auto result = compile_get_sym_obj("#f", env)->to_gpr(form, env);  // todo - can be optimized.
   Label label(env->function_env(), -5);
-  auto branch_ir = std::make_unique<IR_ConditionalBranch>(c, label);
-  auto branch_ir_ref = branch_ir.get();
-  env->emit(form, std::move(branch_ir));
+  auto branch_ir_ref = env->emit_ir<IR_ConditionalBranch>(form, c, label);
 
   // move true
-  env->emit(form, std::make_unique<IR_RegSet>(result, compile_get_sym_obj("#t", env)->to_gpr(
-                                                          form, env)));  // todo, can be optimized
+  // todo, can be optimized
+  env->emit_ir<IR_RegSet>(form, result, compile_get_sym_obj("#t", env)->to_gpr(form, env));
   branch_ir_ref->label.idx = branch_ir_ref->label.func->code().size();
   branch_ir_ref->mark_as_resolved();
 
@@ -166,9 +164,9 @@ Val* Compiler::compile_when_goto(const goos::Object& form, const goos::Object& _
 
   // compile as condition (will set flags register with a cmp instruction)
   auto condition = compile_condition(condition_code, env, false);
-  auto branch = std::make_unique<IR_ConditionalBranch>(condition, Label());
-  env->function_env()->unresolved_cond_gotos.push_back({branch.get(), label});
-  env->emit(form, std::move(branch));
+  auto branch = env->alloc_ir<IR_ConditionalBranch>(condition, Label());
+  env->function_env()->unresolved_cond_gotos.push_back({branch, label});
+  env->emit(form, branch);
   return get_none();
 }
 
@@ -217,7 +215,7 @@ Val* Compiler::compile_cond(const goos::Object& form, const goos::Object& rest,
       // optimization - if we get junk, don't bother moving it, just leave junk in return.
       if (!is_none(case_result)) {
         // todo, what does GOAL do here? does it matter?
-        env->emit(o, std::make_unique<IR_RegSet>(result, case_result->to_reg(o, env)));
+        env->emit_ir<IR_RegSet>(o, result, case_result->to_reg(o, env));
       }
 
     } else {
@@ -225,10 +223,9 @@ Val* Compiler::compile_cond(const goos::Object& form, const goos::Object& rest,
       auto condition = compile_condition(test, env, true);
 
       // BRANCH FWD
-      auto branch_ir = std::make_unique<IR_ConditionalBranch>(condition, Label());
-      auto branch_ir_ref = branch_ir.get();
-      branch_ir->mark_as_resolved();
-      env->emit(test, std::move(branch_ir));
+      auto branch_ir_ref = env->alloc_ir<IR_ConditionalBranch>(condition, Label());
+      branch_ir_ref->mark_as_resolved();
+      env->emit(test, branch_ir_ref);
 
       // CODE
       Val* case_result = get_none();
@@ -244,12 +241,12 @@ Val* Compiler::compile_cond(const goos::Object& form, const goos::Object& rest,
       case_result_types.push_back(case_result->type());
       if (!is_none(case_result)) {
         // todo, what does GOAL do here?
-        env->emit(o, std::make_unique<IR_RegSet>(result, case_result->to_reg(o, env)));
+        env->emit_ir<IR_RegSet>(o, result, case_result->to_reg(o, env));
       }
 
       // GO TO END
-      auto ir_goto_end = std::make_unique<IR_GotoLabel>(end_label);
-      env->emit(o, std::move(ir_goto_end));
+      auto ir_goto_end = env->alloc_ir<IR_GotoLabel>(end_label);
+      env->emit(o, ir_goto_end);
 
       // PATCH BRANCH FWD
       branch_ir_ref->label.idx = fenv->code().size();
@@ -258,8 +255,8 @@ Val* Compiler::compile_cond(const goos::Object& form, const goos::Object& rest,
 
   if (!got_else) {
     // if no else clause, return #f.
-    auto get_false = std::make_unique<IR_LoadSymbolPointer>(result, "#f");
-    env->emit(form, std::move(get_false));
+    auto get_false = env->alloc_ir<IR_LoadSymbolPointer>(result, "#f");
+    env->emit(form, get_false);
   }
 
   if (case_result_types.empty()) {
@@ -338,9 +335,9 @@ Val* Compiler::compile_and_or(const goos::Object& form, const goos::Object& rest
         gc.kind = ConditionKind::NOT_EQUAL;
       }
       // jump to end
-      auto branch = std::make_unique<IR_ConditionalBranch>(gc, Label());
-      branch_irs.push_back(branch.get());
-      env->emit(o, std::move(branch));
+      auto branch = env->alloc_ir<IR_ConditionalBranch>(gc, Label());
+      branch_irs.push_back(branch);
+      env->emit(o, branch);
     }
     i++;
   });
@@ -92,7 +92,7 @@ Val* Compiler::compile_define(const goos::Object& form, const goos::Object& rest
     m_symbol_info.add_global(symbol_string(sym), in_gpr->type().base_type(), form, docstring);
   }
 
-  env->emit(form, std::make_unique<IR_SetSymbolValue>(sym_val, in_gpr));
+  env->emit_ir<IR_SetSymbolValue>(form, sym_val, in_gpr);
   return in_gpr;
 }
 
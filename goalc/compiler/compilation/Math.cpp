@@ -392,9 +392,7 @@ Val* Compiler::compile_floating_point_division(const goos::Object& form,
     zero_check.is_float = true;
 
     // check for divide by zero
-    auto branch_ir = std::make_unique<IR_ConditionalBranch>(zero_check, Label());
-    auto branch_ir_ref = branch_ir.get();
-    env->emit(form, std::move(branch_ir));
+    auto branch_ir_ref = env->emit_ir<IR_ConditionalBranch>(form, zero_check, Label());
 
     // code for not dividing by zero
     env->emit_ir<IR_RegSet>(form, result, a);
@@ -389,4 +389,26 @@ void SymbolInfoMap::evict_symbols_using_file_index(const std::string& file_path)
     m_file_symbol_index.erase(standardized_path);
   }
 }
+
+void SymbolInfoMap::remap_symbols_in_file(
+    const std::string& file_path,
+    const std::function<std::optional<uint32_t>(uint32_t)>& new_line_idx) {
+  const auto standardized_path = file_util::convert_to_unix_path_separators(file_path);
+  const auto it = m_file_symbol_index.find(standardized_path);
+  if (it == m_file_symbol_index.end()) {
+    return;
+  }
+  std::vector<SymbolInfo*> kept_symbols;
+  for (const auto& symbol : it->second) {
+    // only symbols with a definition location are in the file index
+    const auto line_idx = new_line_idx(symbol->m_def_location->line_idx);
+    if (line_idx) {
+      symbol->m_def_location->line_idx = *line_idx;
+      kept_symbols.push_back(symbol);
+    } else {
+      m_symbol_map.remove(symbol->m_name, symbol);
+    }
+  }
+  it->second = std::move(kept_symbols);
+}
 }  // namespace symbol_info
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+#include <optional>
 #include <set>
 #include <string>
 #include <vector>
@@ -189,6 +191,12 @@ class SymbolInfoMap {
   // This should be done before re-compiling a file, symbols will be re-added to the DB if they are
   // found again
   void evict_symbols_using_file_index(const std::string& file_path);
+  // Moves the symbols defined in a file after it was edited, without re-compiling it.
+  // new_line_idx is given the line a symbol was defined on and returns the line it is on now, or
+  // nothing if that definition was changed or removed, in which case the symbol is evicted.
+  void remap_symbols_in_file(
+      const std::string& file_path,
+      const std::function<std::optional<uint32_t>(uint32_t)>& new_line_idx);
 };
 
 }  // namespace symbol_info
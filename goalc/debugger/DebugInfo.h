@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/goos/Object.h"
 #include "common/util/Assert.h"
 
 #include "goalc/debugger/disassemble.h"
@@ -14,11 +15,6 @@
 
 class FunctionEnv;
 
-namespace goos {
-class Object;
-class HeapObject;
-}  // namespace goos
-
 /*!
  * FunctionDebugInfo stores per-function debugging information.
  * For now, it is pretty basic, but it will eventually contain stuff like stack frame info
@@ -33,7 +29,7 @@ struct FunctionDebugInfo {
 
   std::vector<InstructionInfo> instructions;  // contains mapping to IRs
 
-  std::vector<std::shared_ptr<goos::HeapObject>> code_sources;
+  std::vector<goos::HeapPtr<goos::HeapObject>> code_sources;
   std::vector<std::string> ir_strings;
 
   // the actual bytes in the object file.
@@ -28,6 +28,7 @@
 
 #include "common/cross_sockets/XSocket.h"
 #include "common/util/Assert.h"
+#include "common/util/compress.h"
 #include "common/versions/versions.h"
 #include "common/log/log.h"
 
@@ -178,6 +179,9 @@ bool Listener::connect_to_target(int n_tries, const std::string& ip, int port) {
   printf("Got version %d.%d", version_buffer[0], version_buffer[1]);
   if (version_buffer[0] == GOAL_VERSION_MAJOR && version_buffer[1] == GOAL_VERSION_MINOR) {
     printf(" OK!\n");
+    last_recvd_id = 0;
+    last_sent_id = 0;
+    m_pending_listener_loads.clear();
     m_connected = true;
     rcv_thread = std::thread(&Listener::receive_func, this);
     receive_thread_running = true;
@@ -188,9 +192,6 @@ bool Listener::connect_to_target(int n_tries, const std::string& ip, int port) {
     listen_socket = -1;
     return false;
   }
-
-  last_recvd_id = 0;
-  last_sent_id = 0;
 }
 
 /*!
@@ -226,18 +227,14 @@ void Listener::receive_func() {
     switch (hdr->msg_kind) {
       case ListenerMessageKind::MSG_ACK:
         // an "ack" message, sent by the target to indicate it got something.
-        if (!waiting_for_ack) {
-          if (hdr->msg_id == last_sent_id) {
-            printf("[Listener] Received ACK for most recent message late.\n");
-            if (last_recvd_id != hdr->msg_id - 1) {
-              lg::print(
-                  "[Listener] WARNING: message ID jumped from {} to {}. Some messages may have "
-                  "been lost. You must wait for an ACK before sending the next message.\n",
-                  last_recvd_id, hdr->msg_id);
-            }
-          } else {
-            printf("[Listener] Got an unexpcted ACK message.");
-          }
+        // the target handles messages in order, so these should arrive in the order we sent.
+        if (hdr->msg_id <= last_recvd_id) {
+          printf("[Listener] Got an unexpcted ACK message.\n");
+        } else if (hdr->msg_id != last_recvd_id + 1) {
+          lg::print(
+              "[Listener] WARNING: message ID jumped from {} to {}. Some messages may have "
+              "been lost.\n",
+              last_recvd_id.load(), hdr->msg_id);
         }
 
         if (hdr->deci2_header.len < 512) {
@@ -254,13 +251,21 @@ void Listener::receive_func() {
           }
           ack_recv_buff[ack_recv_prog] = '\0';
           ASSERT(ack_recv_prog < 512);
-          got_ack = true;
-          last_recvd_id = hdr->msg_id;
-          if (last_recvd_id > last_sent_id) {
+          if (hdr->msg_id > last_sent_id) {
             lg::print(
                 "[Listener] ERROR: Got an ack message with id of {}, but the last message sent "
                 "had an ID of {}.\n",
-                last_recvd_id, last_sent_id);
+                hdr->msg_id, last_sent_id.load());
+          } else if (hdr->msg_id > last_recvd_id) {
+            // the load message for code arrives before its ack, so code that is acked now
+            // without a load failed to link.
+            rcv_mtx.lock();
+            while (!m_pending_listener_loads.empty() &&
+                   m_pending_listener_loads.front().msg_id <= hdr->msg_id) {
+              m_pending_listener_loads.pop_front();
+            }
+            rcv_mtx.unlock();
+            last_recvd_id = hdr->msg_id;
           }
         } else {
           printf("[Listener] got invalid ack!\n");
@@ -345,37 +350,40 @@ int Listener::get_received_message_count() {
 
 /*!
  * Send a "CODE" message for the target to execute as the Listener Function.
- * Returns once the target acks the code.
+ * Returns once the code is sent. Up to MAX_UNACKED_MESSAGES sends may be waiting for the target,
+ * use wait_for_pending_acks to wait for the code to run.
+ *
+ * Objects larger than LISTENER_CODE_CHUNK_SIZE are sent in pieces. If compression is enabled,
+ * objects larger than MIN_COMPRESS_SIZE are compressed first.
  *
  * The load name is not actually sent to the target.  Instead, if the target loads successfully
  * and outputs a *listener* load message, this will be remapped to a load of the given name.
  */
 void Listener::send_code(std::vector<uint8_t>& code, const std::optional<std::string>& load_name) {
-  got_ack = false;
-  int total_size = code.size() + sizeof(ListenerMessageHeader);
-  if (total_size > BUFFER_SIZE) {
-    printf("[ERROR] Listener send_code got too big of a message\n");
-    return;
+  const u8* data = code.data();
+  size_t size = code.size();
+  auto kind = LTT_MSG_CODE;
+
+  std::vector<u8> compressed;
+  if (m_compress_code && size >= MIN_COMPRESS_SIZE) {
+    compressed = compression::compress_zstd(data, size);
+    data = compressed.data();
+    size = compressed.size();
+    kind = LTT_MSG_CODE_ZSTD;
+  }
+
+  // the target holds on to the chunks and loads once the final message arrives.
+  while (size > LISTENER_CODE_CHUNK_SIZE) {
+    send_message(LTT_MSG_CODE_CHUNK, data, LISTENER_CODE_CHUNK_SIZE);
+    data += LISTENER_CODE_CHUNK_SIZE;
+    size -= LISTENER_CODE_CHUNK_SIZE;
   }
 
+  // this is the only thread that sends, so the final message gets the next id.
   rcv_mtx.lock();
-  m_pending_listener_load_object_name = load_name;
+  m_pending_listener_loads.push_back({last_sent_id + 1, load_name});
   rcv_mtx.unlock();
-
-  auto* header = (ListenerMessageHeader*)m_buffer;
-  auto* buffer_data = (char*)(header + 1);
-  header->deci2_header.rsvd = 0;
-  header->deci2_header.len = total_size;
-  header->deci2_header.proto = DECI2_PROTOCOL;
-  header->deci2_header.src = 'H';
-  header->deci2_header.dst = 'E';
-  header->msg_size = code.size();
-  header->ltt_msg_kind = LTT_MSG_CODE;
-  header->u6 = 0;
-  last_sent_id++;
-  header->msg_id = last_sent_id;
-  memcpy(buffer_data, code.data(), code.size());
-  send_buffer(total_size);
+  send_message(kind, data, size);
 }
 
 /*!
@@ -393,18 +401,8 @@ void Listener::send_reset(bool shutdown) {
     m_debugger->detach();
   }
 
-  auto* header = (ListenerMessageHeader*)m_buffer;
-  header->deci2_header.rsvd = 0;
-  header->deci2_header.len = sizeof(ListenerMessageHeader);
-  header->deci2_header.proto = DECI2_PROTOCOL;
-  header->deci2_header.src = 'H';
-  header->deci2_header.dst = 'E';
-  header->msg_size = 0;
-  header->ltt_msg_kind = shutdown ? LTT_MSG_SHUTDOWN : LTT_MSG_RESET;
-  header->u6 = 0;
-  last_sent_id++;
-  header->msg_id = last_sent_id;
-  send_buffer(sizeof(ListenerMessageHeader));
+  send_message(shutdown ? LTT_MSG_SHUTDOWN : LTT_MSG_RESET, nullptr, 0);
+  wait_for_pending_acks();
   disconnect();
   close_socket(listen_socket);
   printf("[Listener] Closed connection to target\n");
@@ -419,72 +417,98 @@ void Listener::send_poke() {
     printf("Not connected, so cannot poke target.\n");
     return;
   }
+  send_message(LTT_MSG_POKE, nullptr, 0);
+  wait_for_pending_acks();
+}
+
+/*!
+ * Low level send of a message to the target.
+ * If too many messages are waiting for an ack, waits for the target to catch up first.
+ */
+void Listener::send_message(ListenerToTargetMsgKind kind, const u8* data, u32 size) {
+  if (!m_connected) {
+    printf("Not connected, so cannot send to target.\n");
+    return;
+  }
+
+  u32 total_size = size + sizeof(ListenerMessageHeader);
+  ASSERT(total_size <= BUFFER_SIZE);
+
+  if (!wait_for_acks(MAX_UNACKED_MESSAGES - 1)) {
+    printf("  Timed out waiting for ack.\n");
+  }
+
   auto* header = (ListenerMessageHeader*)m_buffer;
   header->deci2_header.rsvd = 0;
-  header->deci2_header.len = sizeof(ListenerMessageHeader);
+  header->deci2_header.len = total_size;
   header->deci2_header.proto = DECI2_PROTOCOL;
   header->deci2_header.src = 'H';
   header->deci2_header.dst = 'E';
-  header->msg_size = 0;
-  header->ltt_msg_kind = LTT_MSG_POKE;
+  header->msg_size = size;
+  header->ltt_msg_kind = kind;
   header->u6 = 0;
+  header->msg_id = last_sent_id + 1;
+  // count it as sent before writing, the ack can arrive before the write returns.
   last_sent_id++;
-  header->msg_id = last_sent_id;
-  send_buffer(sizeof(ListenerMessageHeader));
-}
-
-/*!
- * Low level send of the m_buffer.
- * Waits for the target to respond or times out and prints an error.
- */
-void Listener::send_buffer(int sz) {
-  int wrote = 0;
+  if (size) {
+    memcpy(header + 1, data, size);
+  }
 
   if (debug_listener) {
-    fprintf(stderr, "[L -> T] sending %d bytes...\n", sz);
+    fprintf(stderr, "[L -> T] sending %d bytes...\n", total_size);
   }
 
-  got_ack = false;
-  waiting_for_ack = true;
-  while (wrote < sz) {
-    auto to_send = std::min(512, sz - wrote);
+  u32 wrote = 0;
+  while (wrote < total_size) {
+    auto to_send = std::min(512u, total_size - wrote);
     auto x = write_to_socket(listen_socket, m_buffer + wrote, to_send);
     wrote += x > 0 ? x : 0;
   }
+}
 
-  if (debug_listener) {
-    printf("  waiting for ack...\n");
+/*!
+ * Wait for the target to ack everything that has been sent.
+ * Returns false if the target stopped responding.
+ */
+bool Listener::wait_for_pending_acks() {
+  if (!wait_for_acks(0)) {
+    printf("  Timed out waiting for ack.\n");
+    return false;
   }
 
-  if (wait_for_ack()) {
-    if (debug_listener) {
-      printf("ack buff:\n");
-      printf("%s\n", ack_recv_buff);
-      printf("  OK\n");
-    }
-  } else {
-    printf("  Timed out waiting for ack.\n");
+  if (debug_listener) {
+    printf("ack buff:\n");
+    printf("%s\n", ack_recv_buff);
+    printf("  OK\n");
   }
+  return true;
 }
 
 /*!
- * Wait for the target to send an ack.
+ * Wait until at most max_unacked messages are waiting for an ack.
+ * Gives up if the target doesn't ack anything for 2 seconds.
  */
-bool Listener::wait_for_ack() {
-  // todo, check the message ID.
+bool Listener::wait_for_acks(u64 max_unacked) {
   if (!m_connected) {
-    printf("wait_for_ack called when not connected!\n");
+    printf("wait_for_acks called when not connected!\n");
     return false;
   }
 
-  for (int i = 0; i < 2000; i++) {
-    if (got_ack)
-      return true;
+  uint64_t last_progress = last_recvd_id;
+  int idle_ms = 0;
+  while (last_sent_id - last_recvd_id > max_unacked) {
+    if (idle_ms >= 2000) {
+      return false;
+    }
     std::this_thread::sleep_for(std::chrono::microseconds(1000));
+    if (last_recvd_id != last_progress) {
+      last_progress = last_recvd_id;
+      idle_ms = 0;
+    } else {
+      idle_ms++;
+    }
   }
-
-  waiting_for_ack = false;
-  return false;
+  return true;
 }
 
 /*!
@@ -571,9 +595,16 @@ void Listener::handle_output_message(const char* msg) {
 void Listener::add_load(const std::string& name, const LoadEntry& le) {
   // if we load a file through the listener, the compiler will set the pending load name,
   // and the runtime will send a load message with *listener*.
-  if (name == "*listener*" && m_pending_listener_load_object_name) {
-    m_load_entries[*m_pending_listener_load_object_name] = le;
-    m_pending_listener_load_object_name = {};
+  // the target runs code in order, so this is the load for the first message that isn't acked.
+  std::optional<std::string> pending_name;
+  if (name == "*listener*" && !m_pending_listener_loads.empty() &&
+      m_pending_listener_loads.front().msg_id == last_recvd_id + 1) {
+    pending_name = m_pending_listener_loads.front().name;
+    m_pending_listener_loads.pop_front();
+  }
+
+  if (pending_name) {
+    m_load_entries[*pending_name] = le;
   } else {
     // if we load over an existing thing, kick it out.
     for (auto it = m_load_entries.begin(); it != m_load_entries.end();) {
@@ -9,6 +9,8 @@
 #ifndef JAK1_LISTENER_H
 #define JAK1_LISTENER_H
 
+#include <atomic>
+#include <deque>
 #include <mutex>
 #include <string>
 #include <thread>
@@ -29,6 +31,8 @@ namespace listener {
 class Listener {
  public:
   static constexpr int BUFFER_SIZE = 32 * 1024 * 1024;
+  static constexpr u64 MAX_UNACKED_MESSAGES = 8;  //! how many sends can be in flight at once
+  static constexpr size_t MIN_COMPRESS_SIZE = 4096;  //! don't bother compressing tiny objects
   Listener();
   ~Listener();
   bool connect_to_target(int n_tries = 1, const std::string& ip = "127.0.0.1", int port = -1);
@@ -40,8 +44,9 @@ class Listener {
   void send_poke();
   void disconnect();
   void send_code(std::vector<uint8_t>& code, const std::optional<std::string>& load_name = {});
+  bool wait_for_pending_acks();
+  void set_compress_code(bool compress) { m_compress_code = compress; }
   void add_debugger(Debugger* debugger);
-  bool most_recent_send_was_acked() const { return got_ack; }
   void set_default_port(GameVersion v) { m_default_port = DECI2_PORT - 1 + (int)v; }
   MemoryMap build_memory_map();
 
@@ -49,8 +54,8 @@ class Listener {
   void add_load(const std::string& name, const LoadEntry& le);
   void do_unload(const std::string& name);
 
-  void send_buffer(int sz);
-  bool wait_for_ack();
+  void send_message(ListenerToTargetMsgKind kind, const u8* data, u32 size);
+  bool wait_for_acks(u64 max_unacked);
   void handle_output_message(const char* msg);
 
   int m_default_port = DECI2_PORT;
@@ -58,8 +63,7 @@ class Listener {
   bool m_connected = false;             //! do we think we are connected?
   bool receive_thread_running = false;  //! is the receive thread unjoined?
   int listen_socket = -1;               //! socket
-  bool got_ack = false;
-  bool waiting_for_ack = false;
+  bool m_compress_code = false;         //! send large code objects compressed
 
   Debugger* m_debugger = nullptr;
 
@@ -70,10 +74,15 @@ class Listener {
   std::vector<std::string> message_record;
   std::unordered_map<std::string, LoadEntry> m_load_entries;
 
-  std::optional<std::string> m_pending_listener_load_object_name;
+  // names for the *listener* loads of code that has been sent, but not acked yet, in send order.
+  struct PendingLoad {
+    u64 msg_id = 0;  // the message that finishes sending the code
+    std::optional<std::string> name;
+  };
+  std::deque<PendingLoad> m_pending_listener_loads;
   char ack_recv_buff[512];
-  uint64_t last_sent_id = 0;
-  uint64_t last_recvd_id = 0;
+  std::atomic<uint64_t> last_sent_id = 0;
+  std::atomic<uint64_t> last_recvd_id = 0;
 };
 }  // namespace listener
 
@@ -0,0 +1,233 @@
+#include "BuildCache.h"
+
+#include "common/log/log.h"
+#include "common/util/json_util.h"
+#include "common/versions/versions.h"
+
+#include "fmt/core.h"
+#include "third-party/zstd/lib/common/xxhash.h"
+
+namespace {
+// increment this if the way steps are hashed changes.
+constexpr int BUILD_CACHE_VERSION = 2;
+}  // namespace
+
+/*!
+ * Identify the goalc that is running, so a different compiler doesn't reuse outputs from this one.
+ * This is the git revision plus a hash of the executable, which also catches uncommitted changes.
+ */
+std::string BuildCache::goalc_build_identity() {
+  static const std::string identity = [] {
+    auto result = build_revision();
+    try {
+      auto exe = file_util::read_binary_file(file_util::get_current_executable_path());
+      result += fmt::format(" {:x}", XXH64(exe.data(), exe.size(), 0));
+    } catch (std::exception& e) {
+      lg::warn("Failed to hash goalc for the build cache: {}", e.what());
+    }
+    return result;
+  }();
+  return identity;
+}
+
+void BuildCache::load(const fs::path& db_path, const std::string& build_identity) {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_db_path = db_path;
+  m_build_identity = build_identity;
+  m_entries.clear();
+  m_dirty = false;
+  m_hits = 0;
+
+  if (!fs::exists(db_path)) {
+    return;
+  }
+
+  auto j = safe_parse_json(file_util::read_text_file(db_path));
+  if (!j || !j->is_object() || j->value("version", -1) != BUILD_CACHE_VERSION) {
+    lg::warn("Ignoring invalid or outdated build cache {}", db_path.string());
+    return;
+  }
+
+  try {
+    for (auto& [key, val] : j->at("steps").items()) {
+      Entry entry;
+      entry.step_hash = val.at("hash").get<u64>();
+      for (auto& [out, out_hash] : val.at("outputs").items()) {
+        entry.output_hashes[out] = out_hash.get<u64>();
+      }
+      m_entries[key] = std::move(entry);
+    }
+    // file hashes from last time, so unmodified files don't need to be read again.
+    for (auto& [name, val] : j->at("files").items()) {
+      FileHash file_hash;
+      file_hash.time = fs::file_time_type(fs::file_time_type::duration(val.at(0).get<s64>()));
+      file_hash.size = val.at(1).get<uintmax_t>();
+      file_hash.hash = val.at(2).get<u64>();
+      m_file_hashes.try_emplace(name, file_hash);
+    }
+  } catch (std::exception& e) {
+    lg::warn("Failed to read build cache {}: {}", db_path.string(), e.what());
+    m_entries.clear();
+  }
+}
+
+void BuildCache::save() {
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (!m_dirty || m_db_path.empty()) {
+    return;
+  }
+
+  nlohmann::json steps = nlohmann::json::object();
+  for (auto& [key, entry] : m_entries) {
+    nlohmann::json outputs = nlohmann::json::object();
+    for (auto& [out, out_hash] : entry.output_hashes) {
+      outputs[out] = out_hash;
+    }
+    steps[key] = {{"hash", entry.step_hash}, {"outputs", outputs}};
+  }
+  nlohmann::json files = nlohmann::json::object();
+  for (auto& [name, file_hash] : m_file_hashes) {
+    files[name] = {(s64)file_hash.time.time_since_epoch().count(), file_hash.size, file_hash.hash};
+  }
+  nlohmann::json j = {{"version", BUILD_CACHE_VERSION}, {"steps", steps}, {"files", files}};
+
+  file_util::create_dir_if_needed_for_file(m_db_path);
+  file_util::write_text_file(m_db_path, j.dump());
+  m_dirty = false;
+}
+
+/*!
+ * Hash the contents of a file. Returns nothing if the file doesn't exist.
+ * The hash is remembered until the file is modified, so checking the same file for several steps
+ * only reads it once.
+ */
+std::optional<u64> BuildCache::hash_file(const std::string& name) {
+  auto path = fs::path(file_util::get_file_path({name}));
+  std::error_code ec;
+  auto time = fs::last_write_time(path, ec);
+  if (ec) {
+    return {};
+  }
+  auto size = fs::file_size(path, ec);
+  if (ec) {
+    return {};
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_file_hashes.find(name);
+    if (it != m_file_hashes.end() && it->second.time == time && it->second.size == size) {
+      return it->second.hash;
+    }
+  }
+
+  // read outside of the lock, so other steps can check their files at the same time.
+  auto data = file_util::read_binary_file(path);
+  u64 hash = XXH64(data.data(), data.size(), 0);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_file_hashes[name] = {time, size, hash};
+  return hash;
+}
+
+/*!
+ * Hash everything that determines the outputs of a step.
+ * Returns nothing if one of the files is missing.
+ */
+std::optional<u64> BuildCache::hash_step(const ToolInput& task,
+                                         Tool& tool,
+                                         const PathMap& path_map) {
+  std::string desc = fmt::format("{}.{}.{}\n{}\n{}\n{}\n", versions::GOAL_VERSION_MAJOR,
+                                 versions::GOAL_VERSION_MINOR, BUILD_CACHE_VERSION,
+                                 m_build_identity, tool.name(), task.arg.print());
+  for (auto& out : task.output) {
+    desc += fmt::format("out {}\n", out);
+  }
+  for (auto& file : tool.get_content_dependencies(task, path_map)) {
+    auto hash = hash_file(file);
+    if (!hash) {
+      return {};
+    }
+    desc += fmt::format("{} {:x}\n", file, *hash);
+  }
+  return XXH64(desc.data(), desc.size(), 0);
+}
+
+/*!
+ * Check if a step was already built from the same contents, and its outputs haven't changed since.
+ * If so, the outputs are touched.
+ */
+bool BuildCache::is_up_to_date(const ToolInput& task, Tool& tool, const PathMap& path_map) {
+  if (task.output.empty() || !tool.can_use_build_cache(task)) {
+    return false;
+  }
+
+  Entry entry;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.find(task.output.at(0));
+    if (it == m_entries.end()) {
+      return false;
+    }
+    entry = it->second;
+  }
+
+  for (auto& out : task.output) {
+    auto expected = entry.output_hashes.find(out);
+    if (expected == entry.output_hashes.end() || hash_file(out) != expected->second) {
+      return false;
+    }
+  }
+
+  if (hash_step(task, tool, path_map) != entry.step_hash) {
+    return false;
+  }
+
+  // make the outputs newer than the inputs, so this step isn't stale by timestamp next time.
+  auto now = fs::file_time_type::clock::now();
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (auto& out : task.output) {
+    auto path = fs::path(file_util::get_file_path({out}));
+    std::error_code ec;
+    fs::last_write_time(path, now, ec);
+    // the file system may round the time, so read it back for the next hash_file.
+    auto time = fs::last_write_time(path, ec);
+    auto it = m_file_hashes.find(out);
+    if (!ec && it != m_file_hashes.end()) {
+      it->second.time = time;
+    }
+  }
+  m_hits++;
+  m_dirty = true;
+  return true;
+}
+
+/*!
+ * Remember the contents used to build a step, after it runs successfully.
+ */
+void BuildCache::record(const ToolInput& task, Tool& tool, const PathMap& path_map) {
+  if (task.output.empty()) {
+    return;
+  }
+
+  Entry entry;
+  auto step_hash = hash_step(task, tool, path_map);
+  for (auto& out : task.output) {
+    auto out_hash = hash_file(out);
+    if (!out_hash) {
+      // some tools (like group) don't produce real files, there's no point in caching these.
+      step_hash = {};
+      break;
+    }
+    entry.output_hashes[out] = *out_hash;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (step_hash) {
+    entry.step_hash = *step_hash;
+    m_entries[task.output.at(0)] = std::move(entry);
+  } else {
+    m_entries.erase(task.output.at(0));
+  }
+  m_dirty = true;
+}
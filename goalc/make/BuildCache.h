@@ -0,0 +1,56 @@
+#pragma once
+
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "common/util/FileUtil.h"
+
+#include "goalc/make/Tool.h"
+
+/*!
+ * Persistent database of the contents used to build each step.
+ * A step that is stale by timestamp (from a git checkout, branch switch, or restored CI cache) can
+ * be skipped if its inputs, dependencies, argument, tool, and outputs are all identical to the
+ * last successful build, with the same build of goalc.
+ * Skipped steps have their outputs touched, so the next make sees them as up to date by timestamp.
+ * This is safe to use from multiple threads.
+ */
+class BuildCache {
+ public:
+  void load(const fs::path& db_path, const std::string& build_identity = goalc_build_identity());
+  void save();
+
+  bool is_up_to_date(const ToolInput& task, Tool& tool, const PathMap& path_map);
+  void record(const ToolInput& task, Tool& tool, const PathMap& path_map);
+
+  int hits() const { return m_hits; }
+
+  static std::string goalc_build_identity();
+
+ private:
+  struct Entry {
+    u64 step_hash = 0;
+    std::unordered_map<std::string, u64> output_hashes;
+  };
+
+  struct FileHash {
+    fs::file_time_type time;
+    uintmax_t size = 0;
+    u64 hash = 0;
+  };
+
+  std::optional<u64> hash_step(const ToolInput& task, Tool& tool, const PathMap& path_map);
+  std::optional<u64> hash_file(const std::string& name);
+
+  std::mutex m_mutex;
+  fs::path m_db_path;
+  std::string m_build_identity;
+  std::unordered_map<std::string, Entry> m_entries;
+  // contents of files that haven't been modified since they were last hashed.
+  std::unordered_map<std::string, FileHash> m_file_hashes;
+  bool m_dirty = false;
+  int m_hits = 0;
+};
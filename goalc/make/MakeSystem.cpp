@@ -1,5 +1,10 @@
 #include "MakeSystem.h"
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #include "common/goos/ParseHelpers.h"
 #include "common/log/log.h"
 #include "common/util/FileUtil.h"
@@ -42,50 +47,50 @@ std::string MakeStep::print() const {
 MakeSystem::MakeSystem(const std::optional<REPL::Config> repl_config, const std::string& username)
     : m_goos(username), m_repl_config(repl_config) {
   m_goos.register_form("defstep", [=](const goos::Object& obj, goos::Arguments& args,
-                                      const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                      const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_defstep(obj, args, env);
   });
 
   m_goos.register_form("basename", [=](const goos::Object& obj, goos::Arguments& args,
-                                       const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                       const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_basename(obj, args, env);
   });
 
   m_goos.register_form("stem", [=](const goos::Object& obj, goos::Arguments& args,
-                                   const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                   const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_stem(obj, args, env);
   });
 
   m_goos.register_form("get-gsrc-path", [=](const goos::Object& obj, goos::Arguments& args,
-                                            const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                            const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_get_gsrc_path(obj, args, env);
   });
 
   m_goos.register_form("map-path!", [=](const goos::Object& obj, goos::Arguments& args,
-                                        const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                        const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_map_path(obj, args, env);
   });
 
   m_goos.register_form("set-output-prefix",
                        [=](const goos::Object& obj, goos::Arguments& args,
-                           const std::shared_ptr<goos::EnvironmentObject>& env) {
+                           const goos::HeapPtr<goos::EnvironmentObject>& env) {
                          return handle_set_output_prefix(obj, args, env);
                        });
 
   m_goos.register_form("set-gsrc-folder!",
                        [=](const goos::Object& obj, goos::Arguments& args,
-                           const std::shared_ptr<goos::EnvironmentObject>& env) {
+                           const goos::HeapPtr<goos::EnvironmentObject>& env) {
                          return handle_set_gsrc_folder(obj, args, env);
                        });
 
   m_goos.register_form("get-gsrc-folder", [=](const goos::Object& obj, goos::Arguments& args,
-                                              const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                              const goos::HeapPtr<goos::EnvironmentObject>& env) {
     return handle_get_gsrc_folder(obj, args, env);
   });
 
   m_goos.register_form("get-game-version-folder",
                        [=](const goos::Object& obj, goos::Arguments& args,
-                           const std::shared_ptr<goos::EnvironmentObject>& env) {
+                           const goos::HeapPtr<goos::EnvironmentObject>& env) {
                          return handle_get_game_version_folder(obj, args, env);
                        });
 
@@ -126,7 +131,7 @@ void MakeSystem::load_project_file(const std::string& file_path) {
 
 goos::Object MakeSystem::handle_defstep(const goos::Object& form,
                                         goos::Arguments& args,
-                                        const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                        const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {},
            {{"out", {true, {goos::ObjectType::PAIR}}},
@@ -206,7 +211,7 @@ void MakeSystem::va_check(
 
 goos::Object MakeSystem::handle_basename(const goos::Object& form,
                                          goos::Arguments& args,
-                                         const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                         const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {goos::ObjectType::STRING}, {});
   fs::path input(args.unnamed.at(0).as_string()->data);
@@ -216,7 +221,7 @@ goos::Object MakeSystem::handle_basename(const goos::Object& form,
 
 goos::Object MakeSystem::handle_stem(const goos::Object& form,
                                      goos::Arguments& args,
-                                     const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                     const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {goos::ObjectType::STRING}, {});
   fs::path input(args.unnamed.at(0).as_string()->data);
@@ -226,7 +231,7 @@ goos::Object MakeSystem::handle_stem(const goos::Object& form,
 
 goos::Object MakeSystem::handle_get_gsrc_path(const goos::Object& form,
                                               goos::Arguments& args,
-                                              const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                              const goos::HeapPtr<goos::EnvironmentObject>& env) {
   if (m_gsrc_folder.empty()) {
     throw std::runtime_error("`set-gsrc-folder!` was not called before a `get-gsrc-path`");
   }
@@ -244,7 +249,7 @@ goos::Object MakeSystem::handle_get_gsrc_path(const goos::Object& form,
 
 goos::Object MakeSystem::handle_map_path(const goos::Object& form,
                                          goos::Arguments& args,
-                                         const std::shared_ptr<goos::EnvironmentObject>& env) {
+                                         const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {goos::ObjectType::STRING, goos::ObjectType::STRING}, {});
   auto old_path = args.unnamed.at(0).as_string()->data;
@@ -259,7 +264,7 @@ goos::Object MakeSystem::handle_map_path(const goos::Object& form,
 goos::Object MakeSystem::handle_set_output_prefix(
     const goos::Object& form,
     goos::Arguments& args,
-    const std::shared_ptr<goos::EnvironmentObject>& env) {
+    const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {goos::ObjectType::STRING}, {});
   m_path_map.output_prefix = args.unnamed.at(0).as_string()->data;
@@ -269,7 +274,7 @@ goos::Object MakeSystem::handle_set_output_prefix(
 goos::Object MakeSystem::handle_set_gsrc_folder(
     const goos::Object& form,
     goos::Arguments& args,
-    const std::shared_ptr<goos::EnvironmentObject>& env) {
+    const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {goos::ObjectType::STRING}, {});
 
@@ -295,7 +300,7 @@ goos::Object MakeSystem::handle_set_gsrc_folder(
 goos::Object MakeSystem::handle_get_gsrc_folder(
     const goos::Object& form,
     goos::Arguments& args,
-    const std::shared_ptr<goos::EnvironmentObject>& env) {
+    const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {}, {});
 
@@ -313,7 +318,7 @@ goos::Object MakeSystem::handle_get_gsrc_folder(
 goos::Object MakeSystem::handle_get_game_version_folder(
     const goos::Object& form,
     goos::Arguments& args,
-    const std::shared_ptr<goos::EnvironmentObject>& env) {
+    const goos::HeapPtr<goos::EnvironmentObject>& env) {
   m_goos.eval_args(&args, env);
   va_check(form, args, {}, {});
   if (m_repl_config) {
@@ -443,7 +448,220 @@ void print_input(const std::vector<std::string>& in, char end) {
 }
 }  // namespace
 
-bool MakeSystem::make(const std::string& target_in, bool force, bool verbose, bool gen_report) {
+bool MakeSystem::run_step(MakeStep& rule, Tool& tool, bool use_cache) {
+  bool success = false;
+  const ToolInput task = {rule.input, rule.deps, rule.outputs, rule.arg};
+  try {
+    if (use_cache && m_build_cache.is_up_to_date(task, tool, m_path_map)) {
+      tool.skipped(task);
+      return true;
+    }
+    success = tool.run(task, m_path_map);
+    if (success) {
+      m_build_cache.record(task, tool, m_path_map);
+    }
+  } catch (std::exception& e) {
+    lg::print("\n");
+    lg::print("Error: {}\n", e.what());
+  }
+  if (!success) {
+    lg::print("Build failed on {}{}\n", rule.input.at(0), rule.input.size() > 1 ? ", ..." : "");
+  }
+  return success;
+}
+
+void MakeSystem::print_step_done(const MakeStep& rule,
+                                 const Tool& tool,
+                                 int percent,
+                                 double seconds,
+                                 bool verbose) const {
+  if (verbose) {
+    if (seconds > 0.05) {
+      lg::print(fg(fmt::color::yellow), " {:.3f}\n", seconds);
+    } else {
+      lg::print(" {:.3f}\n", seconds);
+    }
+  } else {
+    if (seconds > 0.05) {
+      lg::print("[{:3d}%] [{:8s}] ", percent, tool.name());
+      lg::print(fg(fmt::color::yellow), "{:.3f} ", seconds);
+      print_input(rule.input, '\n');
+    } else {
+      lg::print("[{:3d}%] [{:8s}] {:.3f} ", percent, tool.name(), seconds);
+      print_input(rule.input, '\n');
+    }
+  }
+}
+
+/*!
+ * Run steps as soon as the steps they depend on are done.
+ * Steps using a thread safe tool are run on worker threads. All other steps (like the compiler)
+ * are run on this thread, in the same order as a serial build, so they see the same state.
+ */
+void MakeSystem::make_parallel(const std::vector<std::string>& steps,
+                               bool verbose,
+                               int jobs,
+                               bool use_cache,
+                               std::vector<double>* step_seconds) {
+  struct StepState {
+    MakeStep* rule = nullptr;
+    Tool* tool = nullptr;
+    int remaining_deps = 0;
+    std::vector<int> dependents;
+    bool done = false;
+  };
+
+  // build the graph, only including steps that need to run.
+  std::vector<StepState> states(steps.size());
+  std::unordered_map<const MakeStep*, int> step_to_idx;
+  std::vector<int> serial_steps;
+  for (size_t i = 0; i < steps.size(); i++) {
+    auto& state = states[i];
+    state.rule = m_output_to_step.at(steps[i]).get();
+    state.tool = m_tools.at(state.rule->tool).get();
+    step_to_idx[state.rule] = i;
+    if (!state.tool->is_thread_safe()) {
+      serial_steps.push_back(i);
+    }
+  }
+
+  for (size_t i = 0; i < steps.size(); i++) {
+    auto& state = states[i];
+    const ToolInput task = {state.rule->input, state.rule->deps, state.rule->outputs,
+                            state.rule->arg};
+    std::unordered_set<int> prereqs;
+    auto add_prereq = [&](const std::string& dep) {
+      auto step_it = m_output_to_step.find(dep);
+      if (step_it == m_output_to_step.end()) {
+        return;
+      }
+      auto idx_it = step_to_idx.find(step_it->second.get());
+      if (idx_it != step_to_idx.end() && idx_it->second != (int)i) {
+        prereqs.insert(idx_it->second);
+      }
+    };
+    for (auto& dep : state.rule->deps) {
+      add_prereq(dep);
+    }
+    for (auto& dep : state.tool->get_additional_dependencies(task, m_path_map)) {
+      add_prereq(dep);
+    }
+    state.remaining_deps = prereqs.size();
+    for (auto p : prereqs) {
+      states[p].dependents.push_back(i);
+    }
+  }
+
+  std::mutex mutex;
+  std::condition_variable cv;
+  std::deque<int> ready;  // thread safe steps that can run now
+  int num_done = 0;
+  int num_running = 0;
+  bool failed = false;
+
+  // must hold the lock.
+  auto finish_step = [&](int idx, double seconds) {
+    auto& state = states[idx];
+    state.done = true;
+    num_done++;
+    (*step_seconds)[idx] = seconds;
+    int percent = (100.0 * num_done / steps.size()) + 0.5;
+    if (verbose) {
+      lg::print("[{:3d}%] [{:8s}] {}{}", percent, state.tool->name(), state.rule->input.at(0),
+                state.rule->input.size() > 1 ? ", ..." : "");
+    }
+    print_step_done(*state.rule, *state.tool, percent, seconds, verbose);
+    for (auto dependent : state.dependents) {
+      auto& dep_state = states[dependent];
+      if (--dep_state.remaining_deps == 0 && dep_state.tool->is_thread_safe()) {
+        ready.push_back(dependent);
+      }
+    }
+    cv.notify_all();
+  };
+
+  for (size_t i = 0; i < steps.size(); i++) {
+    if (states[i].remaining_deps == 0 && states[i].tool->is_thread_safe()) {
+      ready.push_back(i);
+    }
+  }
+
+  std::vector<std::thread> workers;
+  for (int w = 0; w < jobs - 1; w++) {
+    workers.emplace_back([&]() {
+      std::unique_lock<std::mutex> lock(mutex);
+      while (true) {
+        cv.wait(lock, [&] { return failed || num_done == (int)steps.size() || !ready.empty(); });
+        if (failed || ready.empty()) {
+          return;
+        }
+        int idx = ready.front();
+        ready.pop_front();
+        num_running++;
+        lock.unlock();
+        Timer step_timer;
+        bool success = run_step(*states[idx].rule, *states[idx].tool, use_cache);
+        lock.lock();
+        num_running--;
+        if (success) {
+          finish_step(idx, step_timer.getSeconds());
+        } else {
+          failed = true;
+          cv.notify_all();
+        }
+      }
+    });
+  }
+
+  // run steps that aren't thread safe on this thread, in order.
+  // if there are no workers, this thread runs everything.
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    size_t next_serial = 0;
+    while (!failed && num_done < (int)steps.size()) {
+      int idx = -1;
+      if (next_serial < serial_steps.size() &&
+          states[serial_steps[next_serial]].remaining_deps == 0) {
+        idx = serial_steps[next_serial++];
+      } else if (workers.empty() && !ready.empty()) {
+        idx = ready.front();
+        ready.pop_front();
+      }
+
+      if (idx < 0) {
+        cv.wait(lock);
+        continue;
+      }
+
+      lock.unlock();
+      Timer step_timer;
+      bool success = run_step(*states[idx].rule, *states[idx].tool, use_cache);
+      lock.lock();
+      if (success) {
+        finish_step(idx, step_timer.getSeconds());
+      } else {
+        failed = true;
+        cv.notify_all();
+      }
+    }
+    cv.notify_all();
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (failed) {
+    m_build_cache.save();
+    throw std::runtime_error("Build failed.");
+  }
+}
+
+bool MakeSystem::make(const std::string& target_in,
+                      bool force,
+                      bool verbose,
+                      bool gen_report,
+                      std::optional<int> jobs) {
   std::string target = m_path_map.apply_remaps(target_in);
   auto deps = get_dependencies(target);
   //  lg::print("All deps:\n");
@@ -475,62 +693,57 @@ bool MakeSystem::make(const std::string& target_in, bool force, bool verbose, bo
                                    str_util::current_isotimestamp());
   }
 
-  Timer make_timer;
-  lg::print("Building {} targets...\n", deps.size());
-  int i = 0;
-  for (auto& to_make : deps) {
-    Timer step_timer;
-    auto& rule = m_output_to_step.at(to_make);
-    auto& tool = m_tools.at(rule->tool);
-    int percent = (100.0 * (1 + (i++)) / (deps.size())) + 0.5;
-    if (verbose) {
-      lg::print("[{:3d}%] [{:8s}] {}{}\n", percent, tool->name(), rule->input.at(0),
-                rule->input.size() > 1 ? ", ..." : "");
-    } else {
-      lg::print("[{:3d}%] [{:8s}]       ", percent, tool->name());
-      print_input(rule->input, '\r');
-    }
+  // remember what each step was built from, so a checkout that only changes timestamps doesn't
+  // require a full rebuild.
+  m_build_cache.load(file_util::get_jak_project_dir() / "out" / m_path_map.output_prefix /
+                     "build-cache.json");
 
-    bool success = false;
-    try {
-      success = tool->run({rule->input, rule->deps, rule->outputs, rule->arg}, m_path_map);
-    } catch (std::exception& e) {
-      lg::print("\n");
-      lg::print("Error: {}\n", e.what());
-    }
-    if (!success) {
-      lg::print("Build failed on {}{}\n", rule->input.at(0), rule->input.size() > 1 ? ", ..." : "");
-      throw std::runtime_error("Build failed.");
-      return false;
-    }
+  int num_jobs = jobs.value_or(m_repl_config ? m_repl_config->make_jobs : 1);
+  std::vector<double> step_seconds(deps.size());
 
-    const auto seconds = step_timer.getSeconds();
-    if (verbose) {
-      if (seconds > 0.05) {
-        lg::print(fg(fmt::color::yellow), " {:.3f}\n", seconds);
+  Timer make_timer;
+  if (num_jobs > 1) {
+    lg::print("Building {} targets with {} jobs...\n", deps.size(), num_jobs);
+    make_parallel(deps, verbose, num_jobs, !force, &step_seconds);
+  } else {
+    lg::print("Building {} targets...\n", deps.size());
+    int i = 0;
+    for (auto& to_make : deps) {
+      Timer step_timer;
+      auto& rule = m_output_to_step.at(to_make);
+      auto& tool = m_tools.at(rule->tool);
+      int percent = (100.0 * (1 + (i++)) / (deps.size())) + 0.5;
+      if (verbose) {
+        lg::print("[{:3d}%] [{:8s}] {}{}\n", percent, tool->name(), rule->input.at(0),
+                  rule->input.size() > 1 ? ", ..." : "");
       } else {
-        lg::print(" {:.3f}\n", seconds);
+        lg::print("[{:3d}%] [{:8s}]       ", percent, tool->name());
+        print_input(rule->input, '\r');
       }
-    } else {
-      if (seconds > 0.05) {
-        lg::print("[{:3d}%] [{:8s}] ", percent, tool->name());
-        lg::print(fg(fmt::color::yellow), "{:.3f} ", seconds);
-        print_input(rule->input, '\n');
-      } else {
-        lg::print("[{:3d}%] [{:8s}] {:.3f} ", percent, tool->name(), seconds);
-        print_input(rule->input, '\n');
+
+      if (!run_step(*rule, *tool, !force)) {
+        m_build_cache.save();
+        throw std::runtime_error("Build failed.");
+        return false;
       }
-    }
 
-    if (gen_report) {
-      report_contents +=
-          fmt::format("\"{}\": {}{}", str_util::split_string(rule->input.at(0), "/").back(),
-                      seconds, i == deps.size() ? "" : ",");
+      step_seconds[i - 1] = step_timer.getSeconds();
+      print_step_done(*rule, *tool, percent, step_seconds[i - 1], verbose);
     }
   }
   lg::print("\nSuccessfully built all {} targets in {:.3f}s\n", deps.size(),
             make_timer.getSeconds());
+  if (m_build_cache.hits() > 0) {
+    lg::print("Skipped {} targets with unchanged contents\n", m_build_cache.hits());
+  }
+  m_build_cache.save();
   if (gen_report) {
+    for (size_t i = 0; i < deps.size(); i++) {
+      auto& rule = m_output_to_step.at(deps[i]);
+      report_contents +=
+          fmt::format("\"{}\": {}{}", str_util::split_string(rule->input.at(0), "/").back(),
+                      step_seconds[i], i + 1 == deps.size() ? "" : ",");
+    }
     report_contents += fmt::format("}}, 'total': {}}});", make_timer.getSeconds());
     str_util::replace(report_output, "// DATA ENDS\n",
                       fmt::format("{}\n// DATA ENDS\n", report_contents));
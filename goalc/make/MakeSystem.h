@@ -2,6 +2,7 @@
 
 #include "common/goos/Interpreter.h"
 
+#include "goalc/make/BuildCache.h"
 #include "goalc/make/Tool.h"
 
 struct MakeStep {
@@ -20,44 +21,48 @@ class MakeSystem {
 
   goos::Object handle_defstep(const goos::Object& obj,
                               goos::Arguments& args,
-                              const std::shared_ptr<goos::EnvironmentObject>& env);
+                              const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_basename(const goos::Object& obj,
                                goos::Arguments& args,
-                               const std::shared_ptr<goos::EnvironmentObject>& env);
+                               const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_stem(const goos::Object& obj,
                            goos::Arguments&,
-                           const std::shared_ptr<goos::EnvironmentObject>& env);
+                           const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_get_gsrc_path(const goos::Object& obj,
                                     goos::Arguments&,
-                                    const std::shared_ptr<goos::EnvironmentObject>& env);
+                                    const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_map_path(const goos::Object& obj,
                                goos::Arguments& args,
-                               const std::shared_ptr<goos::EnvironmentObject>& env);
+                               const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_set_output_prefix(const goos::Object& obj,
                                         goos::Arguments& args,
-                                        const std::shared_ptr<goos::EnvironmentObject>& env);
+                                        const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_set_gsrc_folder(const goos::Object& obj,
                                       goos::Arguments& args,
-                                      const std::shared_ptr<goos::EnvironmentObject>& env);
+                                      const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_get_gsrc_folder(const goos::Object& obj,
                                       goos::Arguments& args,
-                                      const std::shared_ptr<goos::EnvironmentObject>& env);
+                                      const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   goos::Object handle_get_game_version_folder(const goos::Object& obj,
                                               goos::Arguments&,
-                                              const std::shared_ptr<goos::EnvironmentObject>& env);
+                                              const goos::HeapPtr<goos::EnvironmentObject>& env);
 
   std::vector<std::string> get_dependencies(const std::string& target) const;
   std::vector<std::string> filter_dependencies(const std::vector<std::string>& all_deps);
 
-  bool make(const std::string& target, bool force, bool verbose, bool gen_report);
+  bool make(const std::string& target,
+            bool force,
+            bool verbose,
+            bool gen_report,
+            std::optional<int> jobs = {});
 
   void add_tool(std::shared_ptr<Tool> tool);
   void set_constant(const std::string& name, const std::string& value);
@@ -89,6 +94,18 @@ class MakeSystem {
                         std::vector<std::string>* result_order,
                         std::unordered_set<std::string>* result_set) const;
 
+  bool run_step(MakeStep& rule, Tool& tool, bool use_cache);
+  void print_step_done(const MakeStep& rule,
+                       const Tool& tool,
+                       int percent,
+                       double seconds,
+                       bool verbose) const;
+  void make_parallel(const std::vector<std::string>& steps,
+                     bool verbose,
+                     int jobs,
+                     bool use_cache,
+                     std::vector<double>* step_seconds);
+
   goos::Interpreter m_goos;
 
   std::optional<REPL::Config> m_repl_config;
@@ -97,6 +114,7 @@ class MakeSystem {
   std::unordered_map<std::string, std::shared_ptr<MakeStep>> m_output_to_step;
   std::unordered_map<std::string, std::shared_ptr<Tool>> m_tools;
   PathMap m_path_map;
+  BuildCache m_build_cache;
   std::vector<std::string> m_gsrc_folder;
   std::map<std::string, std::string> m_gsrc_files = {};
 };
@@ -60,6 +60,16 @@ bool Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return false;
 }
 
+std::vector<std::string> Tool::get_content_dependencies(const ToolInput& task,
+                                                        const PathMap& path_map) {
+  std::vector<std::string> result = task.input;
+  result.insert(result.end(), task.deps.begin(), task.deps.end());
+  for (auto& dep : get_additional_dependencies(task, path_map)) {
+    result.push_back(dep);
+  }
+  return result;
+}
+
 std::string PathMap::apply_remaps(const std::string& input) const {
   if (!input.empty() && input[0] == '$') {
     std::string prefix = "$";
@@ -28,6 +28,18 @@ class Tool {
     return {};
   }
   virtual bool needs_run(const ToolInput& task, const PathMap& path_map);
+  // the files whose contents determine the outputs of this step. If these are the same as the last
+  // build, the build cache can skip the step, even if the timestamps say it is stale.
+  virtual std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                            const PathMap& path_map);
+  // if false, the step must run even if its contents are unchanged.
+  virtual bool can_use_build_cache(const ToolInput&) { return true; }
+  // called instead of run when the build cache skips the step.
+  virtual void skipped(const ToolInput&) {}
+  // if true, run may be called from a worker thread, at the same time as other steps (including
+  // other steps using this tool). Tools that aren't thread safe are run one at a time, in the
+  // original build order, on the thread that called make.
+  virtual bool is_thread_safe() const { return false; }
   virtual ~Tool() = default;
 
   const std::string& name() const { return m_name; }
@@ -1,5 +1,7 @@
 #include "Tools.h"
 
+#include <unordered_set>
+
 #include "common/goos/ParseHelpers.h"
 #include "common/util/DgoWriter.h"
 #include "common/util/FileUtil.h"
@@ -28,6 +30,57 @@ bool CompilerTool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return Tool::needs_run(task, path_map);
 }
 
+namespace {
+/*!
+ * Find the files loaded with (import "file") in a GOAL source file.
+ */
+std::vector<std::string> find_imports(const std::string& file) {
+  std::vector<std::string> result;
+  auto path = file_util::get_file_path({file});
+  if (!file_util::file_exists(path)) {
+    // the build cache will see that it's missing.
+    return result;
+  }
+  const std::string text = file_util::read_text_file(path);
+  const std::string prefix = "(import \"";
+  for (size_t pos = text.find(prefix); pos != std::string::npos; pos = text.find(prefix, pos)) {
+    pos += prefix.size();
+    auto end = text.find('"', pos);
+    if (end == std::string::npos) {
+      break;
+    }
+    result.push_back(text.substr(pos, end - pos));
+  }
+  return result;
+}
+}  // namespace
+
+std::vector<std::string> CompilerTool::get_content_dependencies(const ToolInput& task,
+                                                                const PathMap& path_map) {
+  auto deps = Tool::get_content_dependencies(task, path_map);
+  // the libraries loaded by every compiler, and the files that this one imports (recursively).
+  deps.push_back("goal_src/goal-lib.gc");
+  deps.push_back("goal_src/goos-lib.gs");
+  std::vector<std::string> to_scan = {task.input.at(0)};
+  std::unordered_set<std::string> imported;
+  while (!to_scan.empty()) {
+    auto file = to_scan.back();
+    to_scan.pop_back();
+    for (auto& import : find_imports(file)) {
+      if (imported.insert(import).second) {
+        deps.push_back(import);
+        to_scan.push_back(import);
+      }
+    }
+  }
+  return deps;
+}
+
+void CompilerTool::skipped(const ToolInput& task) {
+  // the compiler still needs the types and macros from this file for the files after it.
+  m_compiler->defer_object_file(task.input.at(0));
+}
+
 bool CompilerTool::run(const ToolInput& task, const PathMap& /*path_map*/) {
   // todo check inputs
   try {
@@ -88,7 +141,11 @@ bool DgoTool::run(const ToolInput& task, const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
   }
-  auto desc = parse_desc_file(task.input.at(0), m_reader);
+  DgoDescription desc;
+  {
+    std::lock_guard<std::mutex> lock(m_reader_mutex);
+    desc = parse_desc_file(task.input.at(0), m_reader);
+  }
   build_dgo(desc, path_map.output_prefix);
   return true;
 }
@@ -96,6 +153,7 @@ bool DgoTool::run(const ToolInput& task, const PathMap& path_map) {
 std::vector<std::string> DgoTool::get_additional_dependencies(const ToolInput& task,
                                                               const PathMap& path_map) {
   std::vector<std::string> result;
+  std::lock_guard<std::mutex> lock(m_reader_mutex);
   auto desc = parse_desc_file(task.input.at(0), m_reader);
   for (auto& x : desc.entries) {
     // todo out
@@ -139,20 +197,34 @@ bool GameCntTool::run(const ToolInput& task, const PathMap& path_map) {
 
 TextTool::TextTool() : Tool("text") {}
 
-bool TextTool::needs_run(const ToolInput& task, const PathMap& path_map) {
-  if (task.input.size() != 1) {
-    throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
-  }
-
+namespace {
+std::vector<std::string> text_project_deps(const std::string& file_path, const PathMap& path_map) {
   std::vector<std::string> deps;
   std::vector<GameTextDefinitionFile> files;
-  open_text_project("text", task.input.at(0), files);
+  open_text_project("text", file_path, files);
   for (auto& file : files) {
     deps.push_back(path_map.apply_remaps(file.file_path));
   }
+  return deps;
+}
+}  // namespace
+
+bool TextTool::needs_run(const ToolInput& task, const PathMap& path_map) {
+  if (task.input.size() != 1) {
+    throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
+  }
+
+  auto deps = text_project_deps(task.input.at(0), path_map);
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> TextTool::get_content_dependencies(const ToolInput& task,
+                                                            const PathMap& path_map) {
+  auto deps = text_project_deps(task.input.at(0), path_map);
+  deps.insert(deps.begin(), task.input.begin(), task.input.end());
+  return deps;
+}
+
 bool TextTool::run(const ToolInput& task, const PathMap& path_map) {
   GameTextDB db;
   std::vector<GameTextDefinitionFile> files;
@@ -217,6 +289,14 @@ bool SubtitleTool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> SubtitleTool::get_content_dependencies(const ToolInput& task,
+                                                                const PathMap& path_map) {
+  std::vector<GameSubtitleDefinitionFile> files;
+  std::vector<std::string> deps = task.input;
+  enumerate_subtitle_project_files(name(), task.input.at(0), path_map, files, deps);
+  return deps;
+}
+
 bool SubtitleTool::run(const ToolInput& task, const PathMap& path_map) {
   GameSubtitleDB db;
   db.m_subtitle_version = GameSubtitleDB::SubtitleFormat::V1;
@@ -238,6 +318,14 @@ bool SubtitleV2Tool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> SubtitleV2Tool::get_content_dependencies(const ToolInput& task,
+                                                                  const PathMap& path_map) {
+  std::vector<GameSubtitleDefinitionFile> files;
+  std::vector<std::string> deps = task.input;
+  enumerate_subtitle_project_files(name(), task.input.at(0), path_map, files, deps);
+  return deps;
+}
+
 bool SubtitleV2Tool::run(const ToolInput& task, const PathMap& path_map) {
   GameSubtitleDB db;
   db.m_subtitle_version = GameSubtitleDB::SubtitleFormat::V2;
@@ -257,6 +345,13 @@ bool BuildLevelTool::needs_run(const ToolInput& task, const PathMap& path_map) {
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> BuildLevelTool::get_content_dependencies(const ToolInput& task,
+                                                                  const PathMap& /*path_map*/) {
+  auto deps = get_build_level_deps(task.input.at(0));
+  deps.insert(deps.begin(), task.input.begin(), task.input.end());
+  return deps;
+}
+
 bool BuildLevelTool::run(const ToolInput& task, const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
@@ -274,6 +369,13 @@ bool BuildLevel2Tool::needs_run(const ToolInput& task, const PathMap& path_map)
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> BuildLevel2Tool::get_content_dependencies(const ToolInput& task,
+                                                                   const PathMap& /*path_map*/) {
+  auto deps = get_build_level_deps(task.input.at(0));
+  deps.insert(deps.begin(), task.input.begin(), task.input.end());
+  return deps;
+}
+
 bool BuildLevel2Tool::run(const ToolInput& task, const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
@@ -291,6 +393,13 @@ bool BuildLevel3Tool::needs_run(const ToolInput& task, const PathMap& path_map)
   return Tool::needs_run({task.input, deps, task.output, task.arg}, path_map);
 }
 
+std::vector<std::string> BuildLevel3Tool::get_content_dependencies(const ToolInput& task,
+                                                                   const PathMap& /*path_map*/) {
+  auto deps = get_build_level_deps(task.input.at(0));
+  deps.insert(deps.begin(), task.input.begin(), task.input.end());
+  return deps;
+}
+
 bool BuildLevel3Tool::run(const ToolInput& task, const PathMap& path_map) {
   if (task.input.size() != 1) {
     throw std::runtime_error(fmt::format("Invalid amount of inputs to {} tool", name()));
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "common/goos/Reader.h"
 
 #include "goalc/make/Tool.h"
@@ -11,6 +13,9 @@ class CompilerTool : public Tool {
   CompilerTool(Compiler* compiler);
   bool run(const ToolInput& task, const PathMap& path_map) override;
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
+  void skipped(const ToolInput& task) override;
 
  private:
   Compiler* m_compiler = nullptr;
@@ -20,56 +25,71 @@ class DgoTool : public Tool {
  public:
   DgoTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
   std::vector<std::string> get_additional_dependencies(const ToolInput&,
                                                        const PathMap& path_map) override;
 
  private:
   goos::Reader m_reader;
+  std::mutex m_reader_mutex;
 };
 
 class TpageDirTool : public Tool {
  public:
   TpageDirTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
 };
 
 class CopyTool : public Tool {
  public:
   CopyTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
 };
 
 class GameCntTool : public Tool {
  public:
   GameCntTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
 };
 
 class TextTool : public Tool {
  public:
   TextTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class GroupTool : public Tool {
  public:
   GroupTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
 };
 
 class SubtitleTool : public Tool {
  public:
   SubtitleTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class SubtitleV2Tool : public Tool {
  public:
   SubtitleV2Tool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
+  bool is_thread_safe() const override { return true; }
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class BuildLevelTool : public Tool {
@@ -77,6 +97,8 @@ class BuildLevelTool : public Tool {
   BuildLevelTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class BuildLevel2Tool : public Tool {
@@ -84,6 +106,8 @@ class BuildLevel2Tool : public Tool {
   BuildLevel2Tool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class BuildLevel3Tool : public Tool {
@@ -91,6 +115,8 @@ class BuildLevel3Tool : public Tool {
   BuildLevel3Tool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  std::vector<std::string> get_content_dependencies(const ToolInput& task,
+                                                    const PathMap& path_map) override;
 };
 
 class BuildActorTool : public Tool {
@@ -98,4 +124,5 @@ class BuildActorTool : public Tool {
   BuildActorTool();
   bool run(const ToolInput& task, const PathMap& path_map) override;
   bool needs_run(const ToolInput& task, const PathMap& path_map) override;
+  bool can_use_build_cache(const ToolInput&) override { return false; }
 };
@@ -11,7 +11,7 @@ void did_open(Workspace& workspace, json raw_params) {
 void did_change(Workspace& workspace, json raw_params) {
   auto params = raw_params.get<LSPSpec::DidChangeTextDocumentParams>();
   for (const auto& change : params.m_contentChanges) {
-    workspace.update_tracked_file(params.m_textDocument.m_uri, change.m_text);
+    workspace.update_tracked_file(params.m_textDocument.m_uri, change);
   }
 }
 
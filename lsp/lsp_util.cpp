@@ -1,5 +1,6 @@
 #include "lsp_util.h"
 
+#include <algorithm>
 #include <sstream>
 
 #include "common/util/string_util.h"
@@ -80,4 +81,51 @@ std::string uri_to_path(const LSPSpec::DocumentUri& uri) {
   }
   return decoded_uri;
 }
+
+uint32_t byte_offset_of_position(const std::string& content, const LSPSpec::Position& position) {
+  size_t offset = 0;
+  for (uint32_t line = 0; line < position.m_line; line++) {
+    offset = content.find('\n', offset);
+    if (offset == std::string::npos) {
+      return content.size();
+    }
+    offset++;
+  }
+  uint32_t code_units = 0;
+  while (offset < content.size() && code_units < position.m_character &&
+         content.at(offset) != '\n' && content.at(offset) != '\r') {
+    const uint8_t c = content.at(offset);
+    const int utf8_length = c < 0x80 ? 1 : c < 0xe0 ? 2 : c < 0xf0 ? 3 : 4;
+    code_units += utf8_length == 4 ? 2 : 1;
+    offset += utf8_length;
+  }
+  return std::min(offset, content.size());
+}
+
+TSPoint point_of_byte_offset(const std::string& content, uint32_t offset) {
+  TSPoint point = {0, 0};
+  for (uint32_t i = 0; i < offset; i++) {
+    if (content.at(i) == '\n') {
+      point.row++;
+      point.column = 0;
+    } else {
+      point.column++;
+    }
+  }
+  return point;
+}
+
+TSInputEdit apply_change_to_content(std::string& content,
+                                    const LSPSpec::Range& range,
+                                    const std::string& new_text) {
+  TSInputEdit edit;
+  edit.start_byte = byte_offset_of_position(content, range.m_start);
+  edit.old_end_byte = std::max(edit.start_byte, byte_offset_of_position(content, range.m_end));
+  edit.start_point = point_of_byte_offset(content, edit.start_byte);
+  edit.old_end_point = point_of_byte_offset(content, edit.old_end_byte);
+  content.replace(edit.start_byte, edit.old_end_byte - edit.start_byte, new_text);
+  edit.new_end_byte = edit.start_byte + new_text.size();
+  edit.new_end_point = point_of_byte_offset(content, edit.new_end_byte);
+  return edit;
+}
 }  // namespace lsp_util
@@ -4,10 +4,18 @@
 #include "common/util/FileUtil.h"
 
 #include "protocol/common_types.h"
+#include "tree_sitter/api.h"
 
 namespace lsp_util {
 std::string url_encode(const std::string& value);
 std::string url_decode(const std::string& input);
 LSPSpec::DocumentUri uri_from_path(fs::path path);
 std::string uri_to_path(const LSPSpec::DocumentUri& uri);
+// LSP positions count UTF-16 code units within a line, but tree-sitter and the content count bytes.
+uint32_t byte_offset_of_position(const std::string& content, const LSPSpec::Position& position);
+TSPoint point_of_byte_offset(const std::string& content, uint32_t offset);
+// Apply an incremental change from the client to the content, and describe it for tree-sitter.
+TSInputEdit apply_change_to_content(std::string& content,
+                                    const LSPSpec::Range& range,
+                                    const std::string& new_text);
 };  // namespace lsp_util
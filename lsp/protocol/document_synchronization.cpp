@@ -10,10 +10,16 @@ void LSPSpec::from_json(const json& j, DidOpenTextDocumentParams& obj) {
 
 void LSPSpec::to_json(json& j, const TextDocumentContentChangeEvent& obj) {
   j = json{{"text", obj.m_text}};
+  if (obj.m_range) {
+    j["range"] = obj.m_range.value();
+  }
 }
 
 void LSPSpec::from_json(const json& j, TextDocumentContentChangeEvent& obj) {
   j.at("text").get_to(obj.m_text);
+  if (j.contains("range")) {
+    obj.m_range = std::make_optional(j.at("range").get<Range>());
+  }
 }
 
 void LSPSpec::to_json(json& j, const DidChangeTextDocumentParams& obj) {
@@ -11,6 +11,8 @@ void to_json(json& j, const DidOpenTextDocumentParams& obj);
 void from_json(const json& j, DidOpenTextDocumentParams& obj);
 
 struct TextDocumentContentChangeEvent {
+  // The range of the document that changed. If not set, m_text is the whole new document.
+  std::optional<Range> m_range;
   std::string m_text;
 };
 
@@ -1,5 +1,6 @@
 #include "workspace.h"
 
+#include <deque>
 #include <regex>
 
 #include "common/log/log.h"
@@ -323,12 +324,17 @@ void Workspace::start_tracking_file(const LSPSpec::DocumentUri& file_uri,
 }
 
 void Workspace::update_tracked_file(const LSPSpec::DocumentUri& file_uri,
-                                    const std::string& content) {
+                                    const LSPSpec::TextDocumentContentChangeEvent& change) {
   lg::debug("potentially updating - {}", file_uri);
   // Check if the file is already tracked or not, this is done because change events don't give
   // language details it's assumed you are keeping track of that!
   if (m_tracked_ir_files.find(file_uri) != m_tracked_ir_files.end()) {
     lg::debug("updating tracked IR file - {}", file_uri);
+    std::string content = change.m_text;
+    if (change.m_range) {
+      content = m_tracked_ir_files[file_uri].m_content;
+      lsp_util::apply_change_to_content(content, change.m_range.value(), change.m_text);
+    }
     WorkspaceIRFile file(content);
     m_tracked_ir_files[file_uri] = file;
     // There is the potential for the all-types to have changed, albeit this is probably never going
@@ -348,12 +354,10 @@ void Workspace::update_tracked_file(const LSPSpec::DocumentUri& file_uri,
     m_tracked_all_types_files[file_uri]->update_type_system();
   } else if (m_tracked_og_files.find(file_uri) != m_tracked_og_files.end()) {
     lg::debug("updating tracked OG file - {}", file_uri);
-    m_tracked_og_files[file_uri].parse_content(content);
-    // re-`ml` the file
-    const auto game_version = m_tracked_og_files[file_uri].m_game_version;
-    if (m_compiler_instances.find(game_version) == m_compiler_instances.end()) {
-      lg::debug("No compiler initialized for - {}", version_to_game_name(game_version));
-      return;
+    if (change.m_range) {
+      m_tracked_og_files[file_uri].apply_content_change(change.m_range.value(), change.m_text);
+    } else {
+      m_tracked_og_files[file_uri].parse_content(change.m_text);
     }
   }
 }
@@ -361,21 +365,69 @@ void Workspace::update_tracked_file(const LSPSpec::DocumentUri& file_uri,
 void Workspace::tracked_file_will_save(const LSPSpec::DocumentUri& file_uri) {
   lg::debug("file will be saved - {}", file_uri);
   if (m_tracked_og_files.find(file_uri) != m_tracked_og_files.end()) {
-    // goalc is not an incremental compiler (yet) so I believe it will be a better UX
-    // to re-compile on the file save, rather than as the user is typing
-    const auto game_version = m_tracked_og_files[file_uri].m_game_version;
+    // re-compiling on save rather than as the user is typing means we don't compile forms that
+    // are only half written.
+    auto& file = m_tracked_og_files[file_uri];
+    const auto game_version = file.m_game_version;
     if (m_compiler_instances.find(game_version) == m_compiler_instances.end()) {
       lg::debug("No compiler initialized for - {}", version_to_game_name(game_version));
       return;
     }
-    CompilationOptions options;
-    options.filename = lsp_util::uri_to_path(file_uri);
-    // re-compile the file
-    m_compiler_instances.at(game_version)->asm_file(options);
-    // Update symbols for this specific file
-    const auto symbol_infos =
-        m_compiler_instances.at(game_version)->lookup_symbol_info_by_file(options.filename);
-    m_tracked_og_files[file_uri].update_symbols(symbol_infos);
+    auto& compiler = m_compiler_instances.at(game_version);
+    const auto file_path = lsp_util::uri_to_path(file_uri);
+
+    // Only re-compile the top-level forms that changed since the last compile. Forms that are
+    // unchanged but have moved just get their symbols moved with them.
+    auto forms = file.get_top_level_forms();
+    std::unordered_map<std::string, std::deque<size_t>> unmatched_old_forms;
+    for (size_t i = 0; i < file.m_compiled_forms.size(); i++) {
+      unmatched_old_forms[file.m_compiled_forms.at(i).text].push_back(i);
+    }
+    std::vector<std::optional<size_t>> old_to_new_form(file.m_compiled_forms.size());
+    std::vector<size_t> changed_forms;
+    std::unordered_set<int> changed_lines;
+    for (size_t i = 0; i < forms.size(); i++) {
+      auto& candidates = unmatched_old_forms[forms.at(i).text];
+      if (candidates.empty()) {
+        changed_forms.push_back(i);
+        changed_lines.insert(forms.at(i).start_line);
+      } else {
+        old_to_new_form.at(candidates.front()) = i;
+        candidates.pop_front();
+      }
+    }
+    lg::debug("re-compiling {} of {} forms in {}", changed_forms.size(), forms.size(), file_path);
+
+    const auto& old_forms = file.m_compiled_forms;
+    compiler->remap_symbol_info_in_file(
+        file_path, [&](uint32_t line_idx) -> std::optional<uint32_t> {
+          auto it = std::upper_bound(
+              old_forms.begin(), old_forms.end(), line_idx,
+              [](uint32_t line, const OpenGOALTopLevelForm& form) { return line < form.start_line; });
+          if (it == old_forms.begin() || (it - 1)->end_line < line_idx) {
+            // not from a form we compiled, so it's from the project index. All forms are
+            // re-compiled when there are no compiled forms yet, so it'll be defined again.
+            return {};
+          }
+          const auto old_idx = std::distance(old_forms.begin(), it) - 1;
+          const auto& new_idx = old_to_new_form.at(old_idx);
+          if (!new_idx) {
+            return {};
+          }
+          return line_idx - old_forms.at(old_idx).start_line + forms.at(*new_idx).start_line;
+        });
+
+    try {
+      compiler->run_front_end_on_file_forms(file_path, file.m_content, changed_lines);
+    } catch (std::exception& e) {
+      // forget the forms we tried, so they are evicted and tried again on the next save.
+      lg::debug("error when re-compiling {} - {}", file_path, e.what());
+      for (const auto idx : changed_forms) {
+        forms.at(idx).text.clear();
+      }
+    }
+    file.m_compiled_forms = std::move(forms);
+    file.update_symbols(compiler->lookup_symbol_info_by_file(file_path));
   }
 }
 
@@ -402,21 +454,53 @@ WorkspaceOGFile::WorkspaceOGFile(const LSPSpec::DocumentUri& uri,
   lg::info("Added new OG file. {} symbols and {} diagnostics", m_symbols.size(),
            m_diagnostics.size());
   parse_content(content);
+  // m_compiled_forms is left empty. The project index compiled the file from disk, which may not
+  // match this content, so every form is re-compiled on the first save.
 }
 
 void WorkspaceOGFile::parse_content(const std::string& content) {
   m_content = content;
+  m_ast.reset();
+  reparse_content();
+}
+
+void WorkspaceOGFile::apply_content_change(const LSPSpec::Range& range,
+                                           const std::string& new_text) {
+  const auto edit = lsp_util::apply_change_to_content(m_content, range, new_text);
+  if (m_ast) {
+    ts_tree_edit(m_ast.get(), &edit);
+  }
+  reparse_content();
+}
+
+void WorkspaceOGFile::reparse_content() {
   auto parser = ts_parser_new();
   if (ts_parser_set_language(parser, g_opengoalLang)) {
-    // Get the AST for the current state of the file
-    // TODO - eventually, we should consider doing partial updates of the AST
-    // but right now the LSP just receives the entire document so that's a larger change.
-    m_ast.reset(ts_parser_parse_string(parser, NULL, m_content.c_str(), m_content.length()),
+    // Get the AST for the current state of the file. If we have an edited tree from before the
+    // change, tree-sitter reuses the parts of it that are unchanged.
+    m_ast.reset(ts_parser_parse_string(parser, m_ast.get(), m_content.c_str(), m_content.length()),
                 TreeSitterTreeDeleter());
   }
   ts_parser_delete(parser);
 }
 
+std::vector<OpenGOALTopLevelForm> WorkspaceOGFile::get_top_level_forms() const {
+  std::vector<OpenGOALTopLevelForm> forms = {};
+  if (!m_ast) {
+    return forms;
+  }
+  TSNode root_node = ts_tree_root_node(m_ast.get());
+  for (uint32_t i = 0; i < ts_node_named_child_count(root_node); i++) {
+    const auto node = ts_node_named_child(root_node, i);
+    if (std::string(ts_node_type(node)) != "list_lit") {
+      continue;
+    }
+    forms.push_back({ast_util::get_source_code(m_content, node), ts_node_start_point(node).row,
+                     ts_node_end_point(node).row});
+  }
+  return forms;
+}
+
 void WorkspaceOGFile::update_symbols(const std::vector<symbol_info::SymbolInfo*>& symbol_infos) {
   m_symbols.clear();
   // TODO - sorting by definition location would be nice (maybe VSCode already does this?)
@@ -548,7 +632,7 @@ std::vector<OpenGOALFormResult> WorkspaceOGFile::search_for_forms_that_begin_wit
   return results;
 }
 
-WorkspaceIRFile::WorkspaceIRFile(const std::string& content) {
+WorkspaceIRFile::WorkspaceIRFile(const std::string& content) : m_content(content) {
   const auto line_ending = file_util::get_majority_file_line_endings(content);
   m_lines = str_util::split_string(content, line_ending);
 
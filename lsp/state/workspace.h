@@ -13,6 +13,7 @@
 #include "lsp/protocol/common_types.h"
 #include "lsp/protocol/document_diagnostics.h"
 #include "lsp/protocol/document_symbols.h"
+#include "lsp/protocol/document_synchronization.h"
 #include "lsp/state/lsp_requester.h"
 
 #include "third-party/tree-sitter/tree-sitter/lib/src/tree.h"
@@ -30,6 +31,13 @@ struct OpenGOALFormResult {
   std::pair<int, int> end_point;
 };
 
+// A top-level form in an OpenGOAL file, used to tell which forms changed between compiles.
+struct OpenGOALTopLevelForm {
+  std::string text;
+  uint32_t start_line;
+  uint32_t end_line;
+};
+
 struct OGGlobalIndex {
   std::unordered_map<std::string, Docs::SymbolDocumentation> global_symbols = {};
   std::unordered_map<std::string, Docs::FileDocumentation> per_file_symbols = {};
@@ -48,8 +56,12 @@ class WorkspaceOGFile {
   GameVersion m_game_version;
   std::vector<LSPSpec::DocumentSymbol> m_symbols;
   std::vector<LSPSpec::Diagnostic> m_diagnostics;
+  // the top-level forms as of the last time the compiler saw this file. Empty until the first save.
+  std::vector<OpenGOALTopLevelForm> m_compiled_forms;
 
   void parse_content(const std::string& new_content);
+  void apply_content_change(const LSPSpec::Range& range, const std::string& new_text);
+  std::vector<OpenGOALTopLevelForm> get_top_level_forms() const;
   void update_symbols(const std::vector<symbol_info::SymbolInfo*>& symbol_infos);
   std::optional<std::string> get_symbol_at_position(const LSPSpec::Position position) const;
   std::vector<OpenGOALFormResult> search_for_forms_that_begin_with(
@@ -58,6 +70,8 @@ class WorkspaceOGFile {
  private:
   int32_t version;
   std::shared_ptr<TSTree> m_ast;
+
+  void reparse_content();
 };
 
 class WorkspaceIRFile {
@@ -66,6 +80,7 @@ class WorkspaceIRFile {
   WorkspaceIRFile(const std::string& content);
   // TODO - make private
   int32_t version;
+  std::string m_content;
   std::vector<std::string> m_lines;
   std::vector<LSPSpec::DocumentSymbol> m_symbols;
   std::vector<LSPSpec::Diagnostic> m_diagnostics;
@@ -128,7 +143,8 @@ class Workspace {
   void start_tracking_file(const LSPSpec::DocumentUri& file_uri,
                            const std::string& language_id,
                            const std::string& content);
-  void update_tracked_file(const LSPSpec::DocumentUri& file_uri, const std::string& content);
+  void update_tracked_file(const LSPSpec::DocumentUri& file_uri,
+                           const LSPSpec::TextDocumentContentChangeEvent& change);
   void tracked_file_will_save(const LSPSpec::DocumentUri& file_uri);
   void update_global_index(const GameVersion game_version);
   void stop_tracking_file(const LSPSpec::DocumentUri& file_uri);
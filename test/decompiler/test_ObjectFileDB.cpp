@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <memory>
+#include <random>
+
+#include "common/link_types.h"
+#include "common/util/FileUtil.h"
+#include "common/util/crc32.h"
+
+#include "decompiler/ObjectFile/ObjectFileDB.h"
+#include "decompiler/config.h"
+#include "gtest/gtest.h"
+
+#include "fmt/core.h"
+#include "third-party/lzokay/lzokay.hpp"
+
+using namespace decompiler;
+
+namespace {
+std::vector<u8> make_obj(int seed, int size, const std::string& art_group_name = "") {
+  std::mt19937 rng(seed);
+  std::vector<u8> result(size);
+  for (auto& b : result) {
+    b = rng();
+  }
+  LinkHeaderV4 header{0xffffffff, 16, 4, (u32)size - 64};
+  memcpy(result.data(), &header, sizeof(header));
+  if (!art_group_name.empty()) {
+    std::string info = "/src/next/data/art-group6/" + art_group_name + "-ag.go";
+    memcpy(result.data() + 40, info.c_str(), info.size() + 1);
+  }
+  return result;
+}
+
+std::vector<u8> make_dgo(const std::string& name,
+                         const std::vector<std::pair<std::string, std::vector<u8>>>& objs) {
+  std::vector<u8> result;
+  auto add = [&](const void* data, size_t size) {
+    result.insert(result.end(), (const u8*)data, (const u8*)data + size);
+  };
+  DgoHeader header{};
+  header.object_count = objs.size();
+  strcpy(header.name, name.c_str());
+  add(&header, sizeof(header));
+  for (auto& [obj_name, data] : objs) {
+    DgoHeader obj_header{};
+    obj_header.object_count = data.size();
+    strcpy(obj_header.name, obj_name.c_str());
+    add(&obj_header, sizeof(obj_header));
+    add(data.data(), data.size());
+    while (result.size() % 16) {
+      result.push_back(0);
+    }
+  }
+  return result;
+}
+
+// compress the way the game's oZlB DGOs are: LZO chunks, each aligned to 4 bytes.
+std::vector<u8> compress_dgo(const std::vector<u8>& data) {
+  constexpr size_t kChunkSize = 0x4000;
+  std::vector<u8> result = {'o', 'Z', 'l', 'B'};
+  u32 size = data.size();
+  result.insert(result.end(), (const u8*)&size, (const u8*)&size + 4);
+  auto dict = std::make_unique<lzokay::Dict<>>();
+  for (size_t offset = 0; offset < data.size(); offset += kChunkSize) {
+    size_t in_size = std::min(kChunkSize, data.size() - offset);
+    std::vector<u8> chunk(lzokay::compress_worst_size(in_size));
+    size_t out_size = 0;
+    EXPECT_EQ(lzokay::compress(data.data() + offset, in_size, chunk.data(), chunk.size(),
+                               out_size, *dict),
+              lzokay::EResult::Success);
+    u32 chunk_size = out_size;
+    result.insert(result.end(), (const u8*)&chunk_size, (const u8*)&chunk_size + 4);
+    result.insert(result.end(), chunk.begin(), chunk.begin() + out_size);
+    while (result.size() % 4) {
+      result.push_back(0);
+    }
+  }
+  return result;
+}
+
+// everything about the loaded objects that shouldn't depend on how they were loaded.
+std::string describe_db(ObjectFileDB& db) {
+  std::string result = db.generate_dgo_listing();
+  for (auto& name : db.obj_file_order) {
+    for (auto& obj : db.obj_files_by_name.at(name)) {
+      result += fmt::format("{} {} {} {:x} {} {} {:x}", name, obj.record.version,
+                            obj.to_unique_name(), obj.record.hash, obj.reference_count,
+                            obj.has_multiple_versions, crc32(obj.data.data(), obj.data.size()));
+      for (auto& dgo : obj.dgo_names) {
+        result += " " + dgo;
+      }
+      result += "\n";
+    }
+  }
+  result += fmt::format("{} {} {} {}\n", db.stats.total_dgo_bytes, db.stats.total_obj_files,
+                        db.stats.unique_obj_files, db.stats.unique_obj_bytes);
+  return result;
+}
+}  // namespace
+
+TEST(ObjectFileDB, LoadDgosIndependentOfJobs) {
+  auto dir = fs::temp_directory_path() / "object_file_db_test";
+  fs::create_directories(dir);
+
+  std::vector<fs::path> dgos;
+  for (int d = 0; d < 8; d++) {
+    std::vector<std::pair<std::string, std::vector<u8>>> objs;
+    objs.push_back({"common", make_obj(1, 512)});
+    objs.push_back({"thing", make_obj(2 + d % 3, 304)});
+    objs.push_back({fmt::format("only-{}", d), make_obj(100 + d, 400)});
+    auto ag = make_obj(7, 608, "babak");
+    if (d % 2) {
+      // differs only in uninitialized padding before the link data, so it's the same object.
+      ag[608 - 48 - 3] ^= 0xff;
+    }
+    objs.push_back({"babak", ag});
+    auto ag2 = make_obj(8, 608, "other");
+    if (d == 5) {
+      ag2[100] ^= 1;
+    }
+    objs.push_back({"other", ag2});
+
+    auto name = fmt::format("D{}.DGO", d);
+    auto data = make_dgo(name, objs);
+    if (d % 3 == 1) {
+      data = compress_dgo(data);
+    }
+    file_util::write_binary_file(dir / name, data.data(), data.size());
+    dgos.push_back(dir / name);
+  }
+
+  Config config;
+  config.game_version = GameVersion::Jak1;
+  config.all_types_file = "decompiler/config/jak1/all-types.gc";
+
+  {
+    config.dgo_load_jobs = 1;
+    ObjectFileDB serial(dgos, "", {}, {}, {}, {}, config);
+    config.dgo_load_jobs = 3;
+    ObjectFileDB parallel(dgos, "", {}, {}, {}, {}, config);
+
+    EXPECT_EQ(serial.obj_files_by_name.at("common").size(), 1u);
+    EXPECT_EQ(serial.obj_files_by_name.at("thing").size(), 3u);
+    EXPECT_EQ(serial.obj_files_by_name.at("babak-ag").size(), 1u);
+    EXPECT_EQ(serial.obj_files_by_name.at("other-ag").size(), 2u);
+    EXPECT_EQ(serial.stats.total_obj_files, 40u);
+    EXPECT_EQ(serial.stats.unique_obj_files, 8u + 1 + 3 + 1 + 2);
+
+    // the objects from compressed DGOs outlive the decompressed DGO.
+    auto& only1 = serial.obj_files_by_name.at("only-1").at(0);
+    auto expected = make_obj(101, 400);
+    EXPECT_TRUE(
+        std::equal(expected.begin(), expected.end(), only1.data.begin(), only1.data.end()));
+
+    EXPECT_EQ(describe_db(serial), describe_db(parallel));
+  }
+  fs::remove_all(dir);
+}
@@ -0,0 +1,61 @@
+#include <array>
+#include <string>
+#include <vector>
+
+#include "goalc/compiler/Arena.h"
+#include "gtest/gtest.h"
+
+namespace {
+struct Tracked {
+  Tracked(std::vector<int>* log, int id) : log(log), id(id) {}
+  ~Tracked() { log->push_back(id); }
+  std::vector<int>* log;
+  int id;
+  std::string name = "a string long enough to need its own heap allocation";
+};
+
+struct alignas(16) Aligned {
+  float data[4];
+};
+}  // namespace
+
+TEST(Arena, DestroysNewestFirst) {
+  std::vector<int> log;
+  Arena arena;
+  for (int i = 0; i < 3; i++) {
+    arena.alloc<Tracked>(&log, i);
+  }
+  EXPECT_TRUE(log.empty());
+  arena.release();
+  EXPECT_EQ(log, std::vector<int>({2, 1, 0}));
+
+  // reusable after release.
+  arena.alloc<Tracked>(&log, 3);
+  EXPECT_EQ(arena.stats().objects, 1u);
+  arena.release();
+  EXPECT_EQ(log.back(), 3);
+}
+
+TEST(Arena, ManyObjects) {
+  std::vector<int> log;
+  {
+    Arena arena;
+    std::vector<Tracked*> objs;
+    for (int i = 0; i < 10000; i++) {
+      auto* aligned = arena.alloc<Aligned>();
+      EXPECT_EQ(reinterpret_cast<uintptr_t>(aligned) % 16, 0u);
+      objs.push_back(arena.alloc<Tracked>(&log, i));
+    }
+    // a big one that needs its own block.
+    auto* big = arena.alloc<std::array<u8, 1024 * 1024>>();
+    (*big)[1024 * 1024 - 1] = 1;
+
+    for (int i = 0; i < 10000; i++) {
+      EXPECT_EQ(objs[i]->id, i);
+    }
+    EXPECT_EQ(arena.stats().objects, 20001u);
+    EXPECT_GT(arena.stats().blocks, 1u);
+  }
+  // destroyed by the arena destructor.
+  EXPECT_EQ(log.size(), 10000u);
+}
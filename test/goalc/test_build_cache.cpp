@@ -0,0 +1,142 @@
+#include "common/util/FileUtil.h"
+
+#include "goalc/make/BuildCache.h"
+#include "gtest/gtest.h"
+
+namespace {
+// copies its input to its output.
+class CopyTestTool : public Tool {
+ public:
+  CopyTestTool() : Tool("copy-test") {}
+  bool run(const ToolInput& task, const PathMap&) override {
+    runs++;
+    fs::copy_file(task.input.at(0), task.output.at(0), fs::copy_options::overwrite_existing);
+    return true;
+  }
+  bool can_use_build_cache(const ToolInput&) override { return use_cache; }
+  int runs = 0;
+  bool use_cache = true;
+};
+
+class BuildCacheTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    dir = fs::temp_directory_path() / "build_cache_test";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    db = dir / "build-cache.json";
+    input = {(dir / "in.txt").string()};
+    output = {(dir / "out.txt").string()};
+    file_util::write_text_file(input.at(0), "input");
+  }
+
+  void TearDown() override { fs::remove_all(dir); }
+
+  // build the step unless the cache says it's up to date, like MakeSystem::run_step.
+  bool build(BuildCache& cache) {
+    ToolInput task = {input, deps, output, goos::Object::make_empty_list()};
+    if (cache.is_up_to_date(task, tool, path_map)) {
+      return false;
+    }
+    tool.run(task, path_map);
+    cache.record(task, tool, path_map);
+    return true;
+  }
+
+  // build once, then make the output look stale by timestamp.
+  void build_and_make_stale() {
+    BuildCache cache;
+    cache.load(db, "goalc-a");
+    EXPECT_TRUE(build(cache));
+    cache.save();
+    fs::last_write_time(output.at(0), fs::last_write_time(input.at(0)) - std::chrono::hours(1));
+  }
+
+  fs::path dir;
+  fs::path db;
+  std::vector<std::string> input, deps, output;
+  CopyTestTool tool;
+  PathMap path_map;
+};
+}  // namespace
+
+TEST_F(BuildCacheTest, Hit) {
+  build_and_make_stale();
+
+  BuildCache cache;
+  cache.load(db, "goalc-a");
+  EXPECT_FALSE(build(cache));
+  EXPECT_EQ(cache.hits(), 1);
+  EXPECT_EQ(tool.runs, 1);
+
+  // the skipped step has its output touched, so it isn't stale by timestamp anymore.
+  ToolInput task = {input, deps, output, goos::Object::make_empty_list()};
+  EXPECT_FALSE(tool.needs_run(task, path_map));
+  EXPECT_EQ(file_util::read_text_file(output.at(0)), file_util::read_text_file(input.at(0)));
+}
+
+TEST_F(BuildCacheTest, Miss) {
+  BuildCache cache;
+  cache.load(db, "goalc-a");
+  EXPECT_TRUE(build(cache));
+
+  // not saved, so a new cache has never seen it.
+  BuildCache other;
+  other.load(db, "goalc-a");
+  EXPECT_TRUE(build(other));
+  EXPECT_EQ(other.hits(), 0);
+
+  // and a tool can opt out.
+  cache.save();
+  tool.use_cache = false;
+  BuildCache no_cache;
+  no_cache.load(db, "goalc-a");
+  EXPECT_TRUE(build(no_cache));
+  EXPECT_EQ(tool.runs, 3);
+}
+
+TEST_F(BuildCacheTest, InvalidatedByInput) {
+  build_and_make_stale();
+  file_util::write_text_file(input.at(0), "changed");
+
+  BuildCache cache;
+  cache.load(db, "goalc-a");
+  EXPECT_TRUE(build(cache));
+  EXPECT_EQ(file_util::read_text_file(output.at(0)), file_util::read_text_file(input.at(0)));
+}
+
+TEST_F(BuildCacheTest, InvalidatedByDep) {
+  deps = {(dir / "dep.txt").string()};
+  file_util::write_text_file(deps.at(0), "dep");
+  build_and_make_stale();
+
+  file_util::write_text_file(deps.at(0), "new dep");
+  BuildCache cache;
+  cache.load(db, "goalc-a");
+  EXPECT_TRUE(build(cache));
+
+  // a missing dep is never up to date.
+  cache.save();
+  fs::remove(deps.at(0));
+  BuildCache missing;
+  missing.load(db, "goalc-a");
+  EXPECT_TRUE(build(missing));
+}
+
+TEST_F(BuildCacheTest, InvalidatedByOutput) {
+  build_and_make_stale();
+  file_util::write_text_file(output.at(0), "edited by hand");
+
+  BuildCache cache;
+  cache.load(db, "goalc-a");
+  EXPECT_TRUE(build(cache));
+  EXPECT_EQ(file_util::read_text_file(output.at(0)), file_util::read_text_file(input.at(0)));
+}
+
+TEST_F(BuildCacheTest, InvalidatedByBuildIdentity) {
+  build_and_make_stale();
+
+  BuildCache cache;
+  cache.load(db, "goalc-b");
+  EXPECT_TRUE(build(cache));
+}
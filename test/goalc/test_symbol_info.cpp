@@ -0,0 +1,49 @@
+#include <map>
+
+#include "common/goos/ParseHelpers.h"
+#include "common/goos/Reader.h"
+
+#include "goalc/compiler/symbol_info.h"
+#include "gtest/gtest.h"
+
+namespace {
+// the line each symbol is defined on, by name.
+std::map<std::string, uint32_t> symbol_lines(const symbol_info::SymbolInfoMap& map,
+                                             const std::string& file) {
+  std::map<std::string, uint32_t> result;
+  for (auto* symbol : map.lookup_symbols_by_file(file)) {
+    result[symbol->m_name] = symbol->m_def_location->line_idx;
+  }
+  return result;
+}
+}  // namespace
+
+TEST(SymbolInfo, RemapSymbolsInFile) {
+  const std::string file = "goal_src/test/remap.gc";
+  goos::Reader reader;
+  auto code = reader.read_from_string("(define a 1)\n(define b 2)\n\n(define c 3)\n", true, file);
+  symbol_info::SymbolInfoMap map(&reader.db);
+  int i = 0;
+  for_each_in_list(code.as_pair()->cdr, [&](const goos::Object& form) {
+    map.add_global(std::string(1, 'a' + i++), "int", form);
+  });
+  EXPECT_EQ(symbol_lines(map, file),
+            (std::map<std::string, uint32_t>{{"a", 0}, {"b", 1}, {"c", 3}}));
+
+  // b was edited, and a line was added before c.
+  map.remap_symbols_in_file(file, [](uint32_t line) -> std::optional<uint32_t> {
+    if (line == 1) {
+      return {};
+    }
+    return line == 3 ? 4 : line;
+  });
+  EXPECT_EQ(symbol_lines(map, file), (std::map<std::string, uint32_t>{{"a", 0}, {"c", 4}}));
+  EXPECT_TRUE(map.lookup_exact_name("b").empty());
+  ASSERT_EQ(map.lookup_exact_name("c").size(), 1u);
+  EXPECT_EQ(map.lookup_exact_name("c").at(0)->m_def_location->line_idx, 4u);
+
+  // other files are left alone.
+  map.remap_symbols_in_file("goal_src/test/other.gc",
+                            [](uint32_t) -> std::optional<uint32_t> { return {}; });
+  EXPECT_EQ(map.lookup_symbols_by_file(file).size(), 2u);
+}
@@ -0,0 +1,97 @@
+#include "gtest/gtest.h"
+#include "lsp/lsp_util.h"
+
+using lsp_util::apply_change_to_content;
+using lsp_util::byte_offset_of_position;
+
+TEST(LSPUtil, ByteOffsetOfPosition) {
+  const std::string content = "ab\ncd\n";
+  EXPECT_EQ(byte_offset_of_position(content, {0, 0}), 0u);
+  EXPECT_EQ(byte_offset_of_position(content, {0, 2}), 2u);
+  EXPECT_EQ(byte_offset_of_position(content, {1, 1}), 4u);
+  // past the end of a line stops at the end of that line.
+  EXPECT_EQ(byte_offset_of_position(content, {0, 10}), 2u);
+  // past the last line is the end of the content.
+  EXPECT_EQ(byte_offset_of_position(content, {5, 0}), content.size());
+}
+
+TEST(LSPUtil, ByteOffsetOfPositionCRLF) {
+  const std::string content = "ab\r\ncd\r\n";
+  EXPECT_EQ(byte_offset_of_position(content, {0, 2}), 2u);
+  // the \r isn't part of the line.
+  EXPECT_EQ(byte_offset_of_position(content, {0, 3}), 2u);
+  EXPECT_EQ(byte_offset_of_position(content, {1, 0}), 4u);
+  EXPECT_EQ(byte_offset_of_position(content, {1, 2}), 6u);
+  EXPECT_EQ(byte_offset_of_position(content, {2, 0}), content.size());
+}
+
+TEST(LSPUtil, ByteOffsetOfPositionUTF16) {
+  // é is 2 bytes and 1 UTF-16 code unit, € is 3 bytes and 1 code unit, and the emoji is 4 bytes
+  // and a surrogate pair of 2 code units.
+  const std::string content = "é€\xF0\x9F\x98\x80x\nx";
+  EXPECT_EQ(byte_offset_of_position(content, {0, 1}), 2u);
+  EXPECT_EQ(byte_offset_of_position(content, {0, 2}), 5u);
+  EXPECT_EQ(byte_offset_of_position(content, {0, 4}), 9u);
+  EXPECT_EQ(byte_offset_of_position(content, {0, 5}), 10u);
+  EXPECT_EQ(byte_offset_of_position(content, {1, 1}), 12u);
+}
+
+TEST(LSPUtil, ApplyChange) {
+  std::string content = "(define x 1)\n(define y 2)\n";
+  auto edit = apply_change_to_content(content, {{1, 8}, {1, 9}}, "zz");
+  EXPECT_EQ(content, "(define x 1)\n(define zz 2)\n");
+  EXPECT_EQ(edit.start_byte, 21u);
+  EXPECT_EQ(edit.old_end_byte, 22u);
+  EXPECT_EQ(edit.new_end_byte, 23u);
+  EXPECT_EQ(edit.start_point.row, 1u);
+  EXPECT_EQ(edit.start_point.column, 8u);
+  EXPECT_EQ(edit.old_end_point.column, 9u);
+  EXPECT_EQ(edit.new_end_point.row, 1u);
+  EXPECT_EQ(edit.new_end_point.column, 10u);
+
+  // inserting lines moves the end point down.
+  edit = apply_change_to_content(content, {{0, 0}, {0, 0}}, ";; a\n;; b\n");
+  EXPECT_EQ(content, ";; a\n;; b\n(define x 1)\n(define zz 2)\n");
+  EXPECT_EQ(edit.old_end_byte, 0u);
+  EXPECT_EQ(edit.new_end_point.row, 2u);
+  EXPECT_EQ(edit.new_end_point.column, 0u);
+}
+
+TEST(LSPUtil, ApplyMultipleChanges) {
+  // the changes in one notification are applied in order, each to the result of the last.
+  std::string content = "(define a 1)\n(define b 2)\n(define c 3)\n";
+  apply_change_to_content(content, {{2, 10}, {2, 11}}, "30");
+  apply_change_to_content(content, {{0, 0}, {1, 0}}, "");
+  apply_change_to_content(content, {{1, 8}, {1, 9}}, "cc");
+  EXPECT_EQ(content, "(define b 2)\n(define cc 30)\n");
+
+  // a change spanning lines.
+  auto edit = apply_change_to_content(content, {{0, 10}, {1, 12}}, "22");
+  EXPECT_EQ(content, "(define b 220)\n");
+  EXPECT_EQ(edit.start_point.row, 0u);
+  EXPECT_EQ(edit.old_end_point.row, 1u);
+  EXPECT_EQ(edit.new_end_point.row, 0u);
+  EXPECT_EQ(edit.new_end_point.column, 12u);
+}
+
+TEST(LSPUtil, ApplyChangeCRLF) {
+  std::string content = "a\r\nb\r\nc\r\n";
+  // join the first two lines.
+  auto edit = apply_change_to_content(content, {{0, 1}, {1, 0}}, "");
+  EXPECT_EQ(content, "ab\r\nc\r\n");
+  EXPECT_EQ(edit.start_byte, 1u);
+  EXPECT_EQ(edit.old_end_byte, 3u);
+  // the end of a line is before its \r.
+  apply_change_to_content(content, {{1, 1}, {1, 1}}, "d");
+  EXPECT_EQ(content, "ab\r\ncd\r\n");
+}
+
+TEST(LSPUtil, ApplyChangeUTF16) {
+  std::string content = "x\xF0\x9F\x98\x80y";
+  // replace the surrogate pair.
+  auto edit = apply_change_to_content(content, {{0, 1}, {0, 3}}, "z");
+  EXPECT_EQ(content, "xzy");
+  EXPECT_EQ(edit.start_byte, 1u);
+  EXPECT_EQ(edit.old_end_byte, 5u);
+  EXPECT_EQ(edit.old_end_point.column, 5u);
+}
@@ -0,0 +1,95 @@
+#include <random>
+
+#include "common/util/Timer.h"
+
+#include "game/graphics/opengl_renderer/background/background_common.h"
+#include "gtest/gtest.h"
+
+#include "fmt/core.h"
+
+namespace {
+std::vector<tfrag3::VisNode> random_nodes(std::mt19937& rng, int count) {
+  std::uniform_real_distribution<float> pos(-100000.f, 100000.f);
+  std::uniform_real_distribution<float> rad(0.f, 20000.f);
+  std::vector<tfrag3::VisNode> result(count);
+  for (int i = 0; i < count; i++) {
+    auto& node = result[i];
+    node.bsphere = math::Vector4f(pos(rng), pos(rng), pos(rng), rad(rng));
+    node.my_id = (i % 17 == 0) ? 0xffff : i;
+  }
+  return result;
+}
+
+void random_planes(std::mt19937& rng, math::Vector4f* planes) {
+  std::uniform_real_distribution<float> dir(-1.f, 1.f);
+  std::uniform_real_distribution<float> dist(-50000.f, 50000.f);
+  for (int plane = 0; plane < 4; plane++) {
+    math::Vector3f n(dir(rng), dir(rng), dir(rng));
+    n.normalize();
+    for (int c = 0; c < 3; c++) {
+      planes[c][plane] = n[c];
+    }
+    planes[3][plane] = dist(rng);
+  }
+}
+}  // namespace
+
+TEST(BackgroundCull, MatchesScalar) {
+  std::mt19937 rng(12345);
+  for (int count : {0, 1, 7, 8, 9, 100, 1237}) {
+    auto nodes = random_nodes(rng, count);
+    // some spheres exactly on a plane
+    if (count > 3) {
+      nodes[3].bsphere = math::Vector4f(0, 0, 0, 0);
+    }
+    VisNodeCullData cull_data;
+    cull_data.init(nodes);
+    std::vector<u8> occlusion((count + 7) / 8 + 1);
+    for (auto& x : occlusion) {
+      x = rng();
+    }
+
+    for (int trial = 0; trial < 20; trial++) {
+      math::Vector4f planes[4];
+      random_planes(rng, planes);
+      planes[3][0] = 0;
+      for (const u8* occ : {(const u8*)nullptr, (const u8*)occlusion.data()}) {
+        // fill with junk so we notice anything that isn't written.
+        std::vector<u8> expected(count, 0xcd), actual(count, 0xcd);
+        cull_check_all_slow(planes, nodes, occ, expected.data());
+        cull_check_all(planes, cull_data, occ, actual.data());
+        ASSERT_EQ(expected, actual) << count << " " << trial;
+      }
+    }
+  }
+}
+
+// not a real benchmark, but prints the speedup over the scalar version.
+TEST(BackgroundCull, Benchmark) {
+  std::mt19937 rng(1);
+  constexpr int kNodes = 20000;
+  constexpr int kIterations = 50;
+  auto nodes = random_nodes(rng, kNodes);
+  VisNodeCullData cull_data;
+  cull_data.init(nodes);
+  std::vector<u8> occlusion(kNodes / 8 + 1, 0xff);
+  std::vector<u8> expected(kNodes), actual(kNodes);
+  math::Vector4f planes[4];
+  random_planes(rng, planes);
+
+  Timer slow_timer;
+  for (int i = 0; i < kIterations; i++) {
+    cull_check_all_slow(planes, nodes, occlusion.data(), expected.data());
+  }
+  double slow = slow_timer.getSeconds();
+
+  Timer fast_timer;
+  for (int i = 0; i < kIterations; i++) {
+    cull_check_all(planes, cull_data, occlusion.data(), actual.data());
+  }
+  double fast = fast_timer.getSeconds();
+
+  EXPECT_EQ(expected, actual);
+  fmt::print("cull {} nodes: scalar {:.3f} us, simd {:.3f} us ({:.1f}x)\n", kNodes,
+             1e6 * slow / kIterations, 1e6 * fast / kIterations, slow / fast);
+}
@@ -0,0 +1,140 @@
+#include <random>
+#include <unordered_set>
+
+#include "common/math/geometry.h"
+
+#include "goalc/build_level/collide/jak1/collide_drawable.h"
+#include "goalc/build_level/collide/jak2/collide.h"
+#include "goalc/build_level/collide/jak3/collide.h"
+#include "goalc/data_compiler/DataObjectGenerator.h"
+#include "gtest/gtest.h"
+
+namespace {
+/*!
+ * A bumpy slope of size x size quads, 2 meters apart, with a few different pats.
+ */
+std::vector<jak1::CollideFace> make_terrain(int size, int seed) {
+  std::mt19937 rng(seed);
+  std::uniform_real_distribution<float> height(0.f, 4096.f);
+  const float spacing = 2 * 4096.f;
+
+  std::vector<float> heights((size + 1) * (size + 1));
+  for (auto& h : heights) {
+    h = height(rng);
+  }
+  auto vertex = [&](int x, int z) {
+    return math::Vector3f(x * spacing, heights[z * (size + 1) + x] + x * 2048.f, z * spacing);
+  };
+
+  std::vector<jak1::CollideFace> result;
+  for (int z = 0; z < size; z++) {
+    for (int x = 0; x < size; x++) {
+      for (int tri = 0; tri < 2; tri++) {
+        auto& face = result.emplace_back();
+        face.v[0] = vertex(x, z);
+        face.v[1] = tri ? vertex(x + 1, z + 1) : vertex(x + 1, z);
+        face.v[2] = tri ? vertex(x, z + 1) : vertex(x + 1, z + 1);
+        face.bsphere = math::bsphere_of_triangle(face.v);
+        face.pat.set_material((jak1::PatSurface::Material)((x / 16 + z / 16) % 4));
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<u8> jak1_object_file(const collide::CollideTree& bvh) {
+  DrawableTreeCollideFragment tree;
+  tree.bvh = bvh;
+  tree.packed_frags = pack_collide_frags(tree.bvh.frags.frags);
+  DataObjectGenerator gen;
+  tree.add_to_object_file(gen);
+  return gen.generate_v2();
+}
+
+std::vector<u8> jak2_object_file(const jak2::CollideHash& hash) {
+  DataObjectGenerator gen;
+  add_to_object_file(hash, gen);
+  return gen.generate_v2();
+}
+
+std::vector<u8> jak3_object_file(const jak3::CollideHash& hash) {
+  DataObjectGenerator gen;
+  add_to_object_file(hash, gen);
+  return gen.generate_v2();
+}
+
+struct VectorHash {
+  size_t operator()(const math::Vector3f& in) const {
+    return std::hash<float>()(in.x()) ^ std::hash<float>()(in.y()) ^ std::hash<float>()(in.z());
+  }
+};
+}  // namespace
+
+TEST(BuildCollide, Jak1BvhFrags) {
+  auto tris = make_terrain(100, 1);
+  auto bvh = collide::construct_collide_bvh(tris, 4);
+
+  size_t face_count = 0;
+  for (auto& frag : bvh.frags.frags) {
+    EXPECT_LE(frag.faces.size(), 100u);
+    EXPECT_LE(frag.bsphere.w(), 125.f * 4096.f);
+    std::unordered_set<math::Vector3f, VectorHash> verts;
+    for (auto& face : frag.faces) {
+      for (auto& v : face.v) {
+        EXPECT_LE((v - frag.bsphere.xyz()).length(), frag.bsphere.w() * 1.0001f);
+        verts.insert(v);
+      }
+    }
+    EXPECT_LT(verts.size(), 128u);
+    face_count += frag.faces.size();
+  }
+  EXPECT_EQ(face_count, tris.size());
+}
+
+TEST(BuildCollide, Jak1BvhSameForAnyThreadCount) {
+  auto tris = make_terrain(120, 2);
+  auto expected = jak1_object_file(collide::construct_collide_bvh(tris, 1));
+  for (int threads : {2, 3, 8}) {
+    EXPECT_EQ(jak1_object_file(collide::construct_collide_bvh(tris, threads)), expected);
+  }
+}
+
+TEST(BuildCollide, Jak2HashFrags) {
+  auto tris = make_terrain(100, 3);
+  auto hash = jak2::construct_collide_hash(tris, 4);
+
+  size_t poly_count = 0;
+  for (auto& frag : hash.fragments) {
+    EXPECT_LT(frag.poly_array.size(), 255u);
+    EXPECT_LT(frag.vert_array.size(), 255u);
+    poly_count += frag.poly_array.size();
+  }
+  EXPECT_EQ(poly_count, tris.size());
+
+  // every frag is in at least one cell of the main hash
+  std::vector<bool> found(hash.fragments.size(), false);
+  for (auto& bucket : hash.buckets) {
+    for (int i = 0; i < bucket.count; i++) {
+      found.at(hash.index_array.at(bucket.index + i)) = true;
+    }
+  }
+  for (bool x : found) {
+    EXPECT_TRUE(x);
+  }
+}
+
+TEST(BuildCollide, Jak2HashSameForAnyThreadCount) {
+  auto tris = make_terrain(120, 4);
+  auto expected = jak2_object_file(jak2::construct_collide_hash(tris, 1));
+  for (int threads : {2, 3, 8}) {
+    EXPECT_EQ(jak2_object_file(jak2::construct_collide_hash(tris, threads)), expected);
+  }
+}
+
+TEST(BuildCollide, Jak3HashSameForAnyThreadCount) {
+  auto tris = make_terrain(120, 5);
+  auto expected = jak3_object_file(jak3::construct_collide_hash(tris, 1));
+  for (int threads : {2, 3, 8}) {
+    EXPECT_EQ(jak3_object_file(jak3::construct_collide_hash(tris, threads)), expected);
+  }
+}
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <limits>
 #include <string>
 #include <unordered_set>
@@ -7,7 +8,9 @@
 #include "common/util/BitUtils.h"
 #include "common/util/CopyOnWrite.h"
 #include "common/util/FileUtil.h"
+#include "common/util/MappedFile.h"
 #include "common/util/Range.h"
+#include "common/util/SimpleThreadGroup.h"
 #include "common/util/SmallVector.h"
 #include "common/util/Trie.h"
 #include "common/util/crc32.h"
@@ -154,6 +157,47 @@ TEST(CommonUtil, PowerOfTwo) {
   EXPECT_EQ(get_power_of_two(u64(1) << 63), 63);
 }
 
+TEST(CommonUtil, SimpleThreadGroupDynamic) {
+  std::vector<int> results(1000, 0);
+  SimpleThreadGroup threads;
+  threads.run_dynamic([&](int i) { results[i] += i * 2; }, results.size(), 4);
+  threads.join();
+  for (int i = 0; i < (int)results.size(); i++) {
+    EXPECT_EQ(results[i], i * 2);
+  }
+
+  // more workers than work
+  int count = 0;
+  threads.run_dynamic([&](int) { count++; }, 1, 8);
+  threads.join();
+  EXPECT_EQ(count, 1);
+}
+
+TEST(CommonUtil, MappedFile) {
+  auto path = fs::temp_directory_path() / "mapped_file_test.bin";
+  std::vector<u8> data(10000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = i * 7;
+  }
+  file_util::write_binary_file(path, data.data(), data.size());
+  {
+    MappedFile file(path);
+    ASSERT_EQ(file.size(), data.size());
+    EXPECT_TRUE(std::equal(data.begin(), data.end(), file.span().begin()));
+    EXPECT_FALSE(file_util::dgo_header_is_compressed(file.span()));
+  }
+
+  file_util::write_binary_file(path, data.data(), 0);
+  {
+    MappedFile empty(path);
+    EXPECT_TRUE(empty.span().empty());
+    EXPECT_FALSE(file_util::dgo_header_is_compressed(empty.span()));
+  }
+  fs::remove(path);
+
+  EXPECT_THROW(MappedFile file(path), std::runtime_error);
+}
+
 TEST(CommonUtil, CopyOnWrite) {
   CopyOnWrite<int> x(2);
 
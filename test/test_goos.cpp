@@ -3,10 +3,18 @@
  * Tests for the GOOS macro language.
  */
 
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
 #include "common/goos/Interpreter.h"
+#include "common/goos/ParseHelpers.h"
+#include "common/util/Timer.h"
 
 #include "gtest/gtest.h"
 
+#include "fmt/core.h"
+
 using namespace goos;
 
 namespace {
@@ -1304,4 +1312,237 @@ TEST(GoosBuiltins, HashTable) {
   EXPECT_EQ(e(i, "(cdr (hash-table-try-ref ht \"foo\"))"), "123");
   e(i, "(hash-table-set! ht \"foo\" 456)");
   EXPECT_EQ(e(i, "(cdr (hash-table-try-ref ht \"foo\"))"), "456");
-}
\ No newline at end of file
+}
+
+namespace {
+class CountedObject : public HeapObject {
+ public:
+  explicit CountedObject(int* destroyed) : m_destroyed(destroyed) {}
+  std::string print() const override { return "counted"; }
+  std::string inspect() const override { return "counted"; }
+  ~CountedObject() override { (*m_destroyed)++; }
+
+ private:
+  int* m_destroyed;
+};
+
+// the addresses of the pairs in a list.
+std::unordered_set<const void*> pair_addresses(const Object& list) {
+  std::unordered_set<const void*> result;
+  for (Object it = list; it.is_pair(); it = it.as_pair()->cdr) {
+    result.insert(it.as_pair());
+  }
+  return result;
+}
+
+Object make_int_list(int count) {
+  std::vector<Object> elts;
+  for (int i = 0; i < count; i++) {
+    elts.push_back(Object::make_integer(i));
+  }
+  return build_list(std::move(elts));
+}
+}  // namespace
+
+TEST(GoosHeap, HeapPtrCounts) {
+  int destroyed = 0;
+  HeapPtr<CountedObject> a = make_heap<CountedObject>(&destroyed);
+  EXPECT_EQ(a.use_count(), 1u);
+  {
+    HeapPtr<CountedObject> b = a;
+    EXPECT_EQ(a.use_count(), 2u);
+    EXPECT_EQ(a, b);
+
+    // converting to the base class shares the count.
+    HeapPtr<HeapObject> base = b;
+    EXPECT_EQ(a.use_count(), 3u);
+    EXPECT_EQ(static_heap_cast<CountedObject>(base), a);
+    EXPECT_EQ(a.use_count(), 3u);
+
+    // moving doesn't change the count.
+    HeapPtr<HeapObject> moved = std::move(base);
+    EXPECT_EQ(base, nullptr);
+    EXPECT_EQ(base.use_count(), 0u);
+    EXPECT_EQ(a.use_count(), 3u);
+
+    // copying the object itself doesn't copy its count.
+    CountedObject copy = *a;
+    HeapPtr<CountedObject> c = make_heap<CountedObject>(copy);
+    EXPECT_EQ(c.use_count(), 1u);
+    EXPECT_NE(c, a);
+  }
+  // c and copy were destroyed. b and moved only dropped their references.
+  EXPECT_EQ(destroyed, 2);
+  EXPECT_EQ(a.use_count(), 1u);
+
+  HeapPtr<CountedObject> d = a;
+  a.reset();
+  EXPECT_EQ(a, nullptr);
+  EXPECT_EQ(destroyed, 2);
+  EXPECT_EQ(d.use_count(), 1u);
+  d = nullptr;
+  EXPECT_EQ(destroyed, 3);
+}
+
+TEST(GoosHeap, PairFreedOnOtherThread) {
+  Object list = make_int_list(100);
+  auto addresses = pair_addresses(list);
+  ASSERT_EQ(addresses.size(), 100u);
+
+  std::thread other([&]() {
+    // the pairs go on this thread's free list, and are reused by the next allocations here.
+    list = Object();
+    Object reused = make_int_list(100);
+    EXPECT_EQ(pair_addresses(reused), addresses);
+  });
+  other.join();
+
+  // this thread can still allocate.
+  EXPECT_EQ(make_int_list(3).print(), "(0 1 2)");
+}
+
+TEST(GoosHeap, ThreadPoolReturnedOnExit) {
+  std::unordered_set<const void*> freed;
+  std::thread first([&]() {
+    Object list = make_int_list(10);
+    freed = pair_addresses(list);
+  });
+  first.join();
+  ASSERT_EQ(freed.size(), 10u);
+
+  // a new thread has no pairs, so it refills from the shared list, starting with the pairs that
+  // the first thread returned.
+  std::thread second([&]() {
+    Object pair = PairObject::make_new(Object::make_integer(1), Object::make_empty_list());
+    EXPECT_TRUE(freed.count(pair.as_pair()));
+  });
+  second.join();
+}
+
+TEST(GoosHeap, DestroyLongList) {
+  constexpr int kLength = 500000;
+  Object list = make_int_list(kLength);
+
+  // keep a reference to the tail, which must outlive the head.
+  Object tail = list;
+  for (int i = 0; i < kLength - 3; i++) {
+    tail = tail.as_pair()->cdr;
+  }
+
+  // this would overflow the stack if freeing recursed once per cdr.
+  list = Object();
+  for (int i = kLength - 3; i < kLength; i++) {
+    ASSERT_TRUE(tail.is_pair());
+    EXPECT_EQ(tail.as_pair()->car.as_int(), i);
+    tail = tail.as_pair()->cdr;
+  }
+  EXPECT_TRUE(tail.is_empty_list());
+}
+
+namespace {
+/*!
+ * Expand GOAL macros everywhere in form, the same way the compiler does.
+ * Macros that need the compiler to expand are left alone.
+ */
+Object expand_goal_macros(Interpreter& interp, const Object& form, int* count) {
+  if (!form.is_pair()) {
+    return form;
+  }
+
+  auto& head = form.as_pair()->car;
+  if (head.is_symbol()) {
+    if (head.as_symbol() == "quote" || head.as_symbol() == "seval") {
+      // not GOAL code.
+      return form;
+    }
+    Object macro_obj;
+    if (interp.eval_symbol(head, interp.goal_env.as_env_ptr(), &macro_obj) &&
+        macro_obj.is_macro()) {
+      auto macro = macro_obj.as_macro();
+      try {
+        Arguments args = interp.get_args(form, form.as_pair()->cdr, macro->args);
+        auto mac_env_obj = EnvironmentObject::make_new();
+        auto mac_env = mac_env_obj.as_env_ptr();
+        mac_env->parent_env = interp.global_environment.as_env_ptr();
+        interp.set_args_in_env(form, args, macro->args, mac_env);
+        auto result = interp.eval_list_return_last(macro->body, macro->body, mac_env);
+        (*count)++;
+        return expand_goal_macros(interp, result, count);
+      } catch (std::exception&) {
+        return form;
+      }
+    }
+  }
+
+  std::vector<Object> elts;
+  Object it = form;
+  while (it.is_pair()) {
+    elts.push_back(expand_goal_macros(interp, it.as_pair()->car, count));
+    it = it.as_pair()->cdr;
+  }
+  if (!it.is_empty_list()) {
+    // improper list, just leave it.
+    return form;
+  }
+  return build_list(std::move(elts));
+}
+}  // namespace
+
+// not a real benchmark, but prints how long startup (loading goos-lib.gs) and expanding the
+// macros from goal-lib.gc over real game code take.
+TEST(GoosEval, MacroExpansionBenchmark) {
+  constexpr int kStartups = 10;
+  constexpr int kIterations = 10;
+
+  Timer startup_timer;
+  for (int i = 0; i < kStartups; i++) {
+    Interpreter interp;
+  }
+  double startup = startup_timer.getSeconds();
+
+  Interpreter interp;
+  interp.disable_printfs();
+
+  // define the GOAL macros like the compiler does when it loads goal-lib.gc.
+  auto goal_lib = interp.reader.read_from_file({"goal_src", "goal-lib.gc"});
+  for_each_in_list(goal_lib.as_pair()->cdr, [&](const Object& form) {
+    if (!form.is_pair() || !form.as_pair()->car.is_symbol()) {
+      return;
+    }
+    auto& head = form.as_pair()->car;
+    if (head.as_symbol() == "defmacro") {
+      auto body = form.as_pair()->cdr.as_pair()->cdr.as_pair()->cdr;
+      if (body.is_pair() && body.as_pair()->car.is_string() && body.as_pair()->cdr.is_pair()) {
+        body = body.as_pair()->cdr;  // docstring
+      }
+      auto name_and_args = form.as_pair()->cdr;
+      auto def = PairObject::make_new(
+          interp.intern("defgmacro"),
+          PairObject::make_new(name_and_args.as_pair()->car,
+                               PairObject::make_new(name_and_args.as_pair()->cdr.as_pair()->car,
+                                                    body)));
+      interp.eval(def, interp.global_environment.as_env_ptr());
+    } else if (head.as_symbol() == "desfun") {
+      interp.eval(form, interp.global_environment.as_env_ptr());
+    }
+  });
+
+  std::vector<Object> code;
+  for (auto file : {"vector.gc", "matrix.gc", "quaternion.gc", "transform.gc"}) {
+    code.push_back(interp.reader.read_from_file({"goal_src", "jak1", "engine", "math", file}));
+  }
+
+  int expansions = 0;
+  Timer expand_timer;
+  for (int i = 0; i < kIterations; i++) {
+    expansions = 0;
+    for (auto& file : code) {
+      expand_goal_macros(interp, file, &expansions);
+    }
+  }
+  double expand = expand_timer.getSeconds();
+
+  EXPECT_GT(expansions, 0);
+  fmt::print("goos startup {:.3f} ms, {} macro expansions in engine/math {:.3f} ms\n",
+             1e3 * startup / kStartups, expansions, 1e3 * expand / kIterations);
+}
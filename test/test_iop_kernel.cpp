@@ -0,0 +1,125 @@
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "game/system/IOP_Kernel.h"
+#include "gtest/gtest.h"
+
+using namespace std::chrono;
+
+namespace {
+IOP_Kernel* kernel = nullptr;
+std::vector<s32> run_order;
+
+// IOP threads must not return, so these all sleep forever at the end.
+void record_and_sleep() {
+  while (true) {
+    run_order.push_back(kernel->getCurrentThread());
+    kernel->SleepThread();
+  }
+}
+
+void delay_then_record() {
+  while (true) {
+    kernel->DelayThread(2000);
+    run_order.push_back(kernel->getCurrentThread());
+    kernel->SleepThread();
+  }
+}
+
+s32 sema = -1;
+void wait_sema_and_record() {
+  while (true) {
+    kernel->WaitSema(sema);
+    run_order.push_back(kernel->getCurrentThread());
+  }
+}
+
+time_stamp now() {
+  return time_point_cast<microseconds>(steady_clock::now());
+}
+}  // namespace
+
+TEST(IopKernel, RunsReadyThreadsInPriorityOrder) {
+  IOP_Kernel k;
+  kernel = &k;
+  run_order.clear();
+  s32 a = k.CreateThread("a", record_and_sleep, 30);
+  s32 b = k.CreateThread("b", record_and_sleep, 10);
+  s32 c = k.CreateThread("c", record_and_sleep, 20);
+  s32 d = k.CreateThread("d", record_and_sleep, 10);
+  for (s32 id : {a, b, c, d}) {
+    k.StartThread(id);
+  }
+  EXPECT_TRUE(k.dispatch().has_value());
+  EXPECT_EQ(run_order, std::vector<s32>({b, d, c, a}));
+
+  // waking a thread twice only runs it once.
+  run_order.clear();
+  k.WakeupThread(c);
+  k.WakeupThread(a);
+  k.WakeupThread(c);
+  k.dispatch();
+  EXPECT_EQ(run_order, std::vector<s32>({c, a}));
+}
+
+TEST(IopKernel, DelayAndSemaphore) {
+  IOP_Kernel k;
+  kernel = &k;
+  run_order.clear();
+  sema = k.CreateSema(0, 0, 0, 1);
+  s32 delayed = k.CreateThread("delayed", delay_then_record, 10);
+  s32 waiter = k.CreateThread("waiter", wait_sema_and_record, 20);
+  k.StartThread(delayed);
+  k.StartThread(waiter);
+
+  auto start = now();
+  auto wakeup = k.dispatch();
+  ASSERT_TRUE(wakeup.has_value());
+  EXPECT_GE(*wakeup, start + microseconds(1000));
+  EXPECT_LE(*wakeup, now() + microseconds(2000));
+  EXPECT_TRUE(run_order.empty());
+
+  k.SignalSema(sema);
+  k.dispatch();
+  EXPECT_EQ(run_order, std::vector<s32>({waiter}));
+
+  std::this_thread::sleep_until(*wakeup);
+  k.dispatch();
+  EXPECT_EQ(run_order, std::vector<s32>({waiter, delayed}));
+
+  auto stats = k.thread_stats();
+  ASSERT_EQ(stats.size(), 2u);
+  EXPECT_EQ(stats[0].id, delayed);
+  EXPECT_EQ(stats[0].run_count, 2u);
+  EXPECT_EQ(stats[1].id, waiter);
+  EXPECT_EQ(stats[1].run_count, 2u);
+}
+
+TEST(IopKernel, WakeupFromOtherThreadEndsWait) {
+  IOP_Kernel k;
+  kernel = &k;
+  run_order.clear();
+  s32 id = k.CreateThread("sleeper", record_and_sleep, 10);
+  k.StartThread(id);
+  k.dispatch();
+  run_order.clear();
+
+  auto start = steady_clock::now();
+  std::thread waker([&]() {
+    std::this_thread::sleep_for(milliseconds(5));
+    k.iWakeupThread(id);
+  });
+  k.wait_for_event(now() + seconds(10));
+  EXPECT_LT(steady_clock::now() - start, seconds(5));
+  waker.join();
+
+  k.dispatch();
+  EXPECT_EQ(run_order, std::vector<s32>({id}));
+
+  // a signal that comes before the wait isn't lost.
+  k.signal_event();
+  start = steady_clock::now();
+  k.wait_for_event(now() + seconds(10));
+  EXPECT_LT(steady_clock::now() - start, seconds(5));
+}
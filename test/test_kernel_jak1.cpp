@@ -9,6 +9,7 @@
 #include "all_jak1_symbols.h"
 #include "game/kernel/common/fileio.h"
 #include "game/kernel/common/kboot.h"
+#include "game/kernel/common/klink.h"
 #include "game/kernel/common/kprint.h"
 #include "game/kernel/common/kscheme.h"
 #include "game/kernel/common/memory_layout.h"
@@ -306,6 +307,7 @@ void setup_hack_heaps(void* mem, int size) {
   kinitheap(kdebugheap, Ptr<u8>(HEAP_START + heap_size), heap_size);
   init_output();
   init_crc();
+  kscheme_init_globals();
 
   // create a fake symbol table
   auto symbol_table =
@@ -394,3 +396,89 @@ TEST(Kernel, HashTable) {
 
   delete[] mem;
 }
+
+TEST(Kernel, SymbolIndex) {
+  constexpr int size = 32 * 1024 * 1024;
+  auto mem = new u8[size];
+  setup_hack_heaps(mem, size);
+
+  // interned symbols are found through the index, at the same place the table probe finds them.
+  auto sym = intern_from_c("test-symbol");
+  ASSERT_EQ(g_symbol_index.count("test-symbol"), 1u);
+  EXPECT_EQ(g_symbol_index.at("test-symbol"), (int)(sym.offset - s7.offset));
+  EXPECT_EQ(find_symbol_from_c("test-symbol"), sym);
+  EXPECT_EQ(find_symbol_from_c_probe("test-symbol"), sym);
+  EXPECT_EQ(find_symbol_from_c("global").offset - s7.offset, FIX_SYM_GLOBAL_HEAP);
+
+  // missing symbols aren't added.
+  EXPECT_EQ(find_symbol_from_c("not-a-symbol").offset, 0u);
+  EXPECT_EQ(g_symbol_index.count("not-a-symbol"), 0u);
+
+  // after the symbol table is reset, the old symbols are gone and new ones are indexed again.
+  setup_hack_heaps(mem, size);
+  EXPECT_EQ(g_symbol_index.count("test-symbol"), 0u);
+  EXPECT_EQ(find_symbol_from_c("test-symbol").offset, 0u);
+  auto again = intern_from_c("test-symbol");
+  EXPECT_EQ(find_symbol_from_c("test-symbol"), again);
+  EXPECT_EQ(find_symbol_from_c_probe("test-symbol"), again);
+
+  delete[] mem;
+}
+
+TEST(Kernel, LinkV2PointerTable) {
+  constexpr int size = 256 * 1024;
+  auto mem = new u8[size]();
+  g_ee_main_mem = mem;
+
+  // skip 1, fix 255 then flip to seek 2 with a 0xff, 0 pair, fix 1, skip 0xff + 3, fix 2, end.
+  const u8 table[] = {1, 0xff, 0, 2, 1, 0xff, 3, 2, 0, 0xaa};
+  Ptr<u8> table_ptr(0x100);
+  memcpy(table_ptr.c(), table, sizeof(table));
+
+  std::vector<LinkFixupRun> runs;
+  auto end = decode_v2_pointer_table(table_ptr, &runs);
+  EXPECT_EQ(end.offset, table_ptr.offset + sizeof(table) - 1);
+  ASSERT_EQ(runs.size(), 3u);
+  EXPECT_EQ(runs[0].offset, 1u);
+  EXPECT_EQ(runs[0].count, 255u);
+  EXPECT_EQ(runs[1].offset, 258u);
+  EXPECT_EQ(runs[1].count, 1u);
+  EXPECT_EQ(runs[2].offset, 517u);
+  EXPECT_EQ(runs[2].count, 2u);
+
+  // a continued run in fixing mode should be merged with the previous one.
+  const u8 merged[] = {1, 0xff, 3, 0};
+  memcpy(table_ptr.c(), merged, sizeof(merged));
+  decode_v2_pointer_table(table_ptr, &runs);
+  ASSERT_EQ(runs.size(), 1u);
+  EXPECT_EQ(runs[0].offset, 1u);
+  EXPECT_EQ(runs[0].count, 258u);
+
+  // apply the fixups and check that only the words in the runs moved.
+  Ptr<u32> data(0x1000);
+  for (int i = 0; i < 600; i++) {
+    data.c()[i] = i;
+  }
+  memcpy(table_ptr.c(), table, sizeof(table));
+  link_v2_pointer_table(data.cast<u8>(), table_ptr);
+  for (u32 i = 0; i < 600; i++) {
+    bool fixed = (i >= 1 && i < 256) || i == 258 || i == 517 || i == 518;
+    EXPECT_EQ(data.c()[i], fixed ? i + data.offset : i);
+  }
+
+  // symbol links: offsets of 8, 8 + 0x100 (2 bytes), 8 + 0x100 + 0x10000 (3 bytes).
+  constexpr u32 n_words = 0x4100;
+  for (u32 i = 0; i < n_words; i++) {
+    data.c()[i] = 0xffffffff;
+  }
+  const u8 sym_table[] = {8, 0x01, 0x01, 0x02, 0x00, 0x01, 0, 0xaa};
+  memcpy(table_ptr.c(), sym_table, sizeof(sym_table));
+  end = c_symlink2(data.cast<u8>(), Ptr<u8>(0x1234), table_ptr);
+  EXPECT_EQ(end.offset, table_ptr.offset + sizeof(sym_table) - 1);
+  for (u32 i = 0; i < n_words; i++) {
+    bool linked = i == 2 || i == 2 + 0x40 || i == 2 + 0x40 + 0x4000;
+    EXPECT_EQ(data.c()[i], linked ? 0x1234u : 0xffffffff);
+  }
+
+  delete[] mem;
+}
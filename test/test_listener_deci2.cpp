@@ -1,13 +1,132 @@
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <random>
+#include <thread>
+
+#include "common/util/compress.h"
+
 #include "game/system/Deci2Server.h"
 #include "goalc/listener/Listener.h"
 #include "gtest/gtest.h"
 
+#include "fmt/core.h"
+
 using namespace listener;
 
 namespace {
 bool always_false() {
   return false;
 }
+
+/*!
+ * Stands in for the runtime: reassembles the code objects sent by the listener, and replies with
+ * a load message (if the object "links") and an ack, like the kernel does.
+ */
+class FakeTarget {
+ public:
+  FakeTarget() : m_server([this] { return m_stop.load(); }, DECI2_PORT) {
+    m_driver.protocol = DECI2_PROTOCOL;
+    m_driver.active = true;
+    m_driver.opt = this;
+    m_driver.handler = [](s32 event, s32 param, void* opt) {
+      auto* target = (FakeTarget*)opt;
+      if (event == DECI2_READ) {
+        auto* data = (const u8*)target->m_driver.recv_buffer;
+        target->m_incoming.insert(target->m_incoming.end(), data, data + param);
+        target->m_driver.recv_size = param;
+      }
+    };
+    EXPECT_TRUE(m_server.init_server());
+    m_server.send_proto_ready(&m_driver, &m_driver_count);
+    m_thread = std::thread([this] {
+      while (!m_stop) {
+        m_server.read_data();
+        if (!m_incoming.empty()) {
+          handle_message();
+          m_incoming.clear();
+          m_server.send_recv_done();
+        } else {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+    });
+  }
+
+  ~FakeTarget() {
+    m_stop = true;
+    m_thread.join();
+  }
+
+  // called for each code object, returns if it should link successfully.
+  std::function<bool(int)> links = [](int) { return true; };
+  std::vector<std::vector<u8>> objects;
+  std::vector<ListenerToTargetMsgKind> code_message_kinds;
+
+  static u32 load_address(int object_idx) { return 0x100000 * (object_idx + 1); }
+
+ private:
+  void handle_message() {
+    const auto* hdr = (const ListenerMessageHeader*)m_incoming.data();
+    const u8* data = m_incoming.data() + sizeof(ListenerMessageHeader);
+    switch (hdr->ltt_msg_kind) {
+      case LTT_MSG_CODE_CHUNK:
+        code_message_kinds.push_back(hdr->ltt_msg_kind);
+        m_chunks.insert(m_chunks.end(), data, data + hdr->msg_size);
+        break;
+      case LTT_MSG_CODE:
+      case LTT_MSG_CODE_ZSTD: {
+        code_message_kinds.push_back(hdr->ltt_msg_kind);
+        m_chunks.insert(m_chunks.end(), data, data + hdr->msg_size);
+        if (hdr->ltt_msg_kind == LTT_MSG_CODE_ZSTD) {
+          m_chunks = compression::decompress_zstd(m_chunks.data(), m_chunks.size());
+        }
+        objects.push_back(std::move(m_chunks));
+        m_chunks.clear();
+        int idx = objects.size() - 1;
+        if (links(idx)) {
+          send(ListenerMessageKind::MSG_OUTPUT, 0,
+               fmt::format("load \"*listener*\" t #x{:x} #x0 #x0 #x100 #x0 #x0\n",
+                           load_address(idx)));
+        }
+      } break;
+      default:
+        break;
+    }
+    send(ListenerMessageKind::MSG_ACK, hdr->msg_id, "ack");
+  }
+
+  void send(ListenerMessageKind kind, u64 msg_id, const std::string& text) {
+    std::vector<u8> msg(sizeof(ListenerMessageHeader) + text.size());
+    auto* hdr = (ListenerMessageHeader*)msg.data();
+    hdr->deci2_header.len = msg.size();
+    hdr->deci2_header.proto = DECI2_PROTOCOL;
+    hdr->deci2_header.src = 'E';
+    hdr->deci2_header.dst = 'H';
+    hdr->msg_kind = kind;
+    hdr->msg_size = text.size();
+    hdr->msg_id = msg_id;
+    memcpy(msg.data() + sizeof(ListenerMessageHeader), text.data(), text.size());
+    m_server.send_data(msg.data(), msg.size());
+  }
+
+  std::atomic<bool> m_stop = false;
+  Deci2Server m_server;
+  Deci2Driver m_driver;
+  int m_driver_count = 1;
+  std::vector<u8> m_incoming;
+  std::vector<u8> m_chunks;
+  std::thread m_thread;
+};
+
+std::vector<u8> random_code(size_t size, int seed) {
+  std::mt19937 rng(seed);
+  std::vector<u8> result(size);
+  for (auto& b : result) {
+    b = rng();
+  }
+  return result;
+}
 }  // namespace
 
 TEST(Listener, ListenerCreation) {
@@ -111,3 +230,63 @@ TEST(Listener, ListenerThenDeci) {
     }
   }
 }
+
+TEST(Listener, SendCodeChunkedAndCompressed) {
+  FakeTarget target;
+  Listener l;
+  ASSERT_TRUE(l.connect_to_target());
+
+  // random data doesn't compress, so the compressed objects still need several chunks.
+  std::vector<std::vector<u8>> sent = {
+      random_code(100, 1), random_code(LISTENER_CODE_CHUNK_SIZE, 2),
+      random_code(2 * LISTENER_CODE_CHUNK_SIZE + 123, 3),
+      std::vector<u8>(3 * LISTENER_CODE_CHUNK_SIZE, 0x42)};
+  for (bool compress : {false, true}) {
+    l.set_compress_code(compress);
+    for (auto& code : sent) {
+      l.send_code(code);
+    }
+  }
+  EXPECT_TRUE(l.wait_for_pending_acks());
+  l.disconnect();
+
+  ASSERT_EQ(target.objects.size(), 2 * sent.size());
+  for (size_t i = 0; i < target.objects.size(); i++) {
+    EXPECT_TRUE(target.objects[i] == sent[i % sent.size()]) << i;
+  }
+  using K = ListenerToTargetMsgKind;
+  std::vector<K> expected_kinds = {
+      // uncompressed
+      K::LTT_MSG_CODE, K::LTT_MSG_CODE, K::LTT_MSG_CODE_CHUNK, K::LTT_MSG_CODE_CHUNK,
+      K::LTT_MSG_CODE, K::LTT_MSG_CODE_CHUNK, K::LTT_MSG_CODE_CHUNK, K::LTT_MSG_CODE,
+      // compressed, except for the tiny one. The constant one compresses to a single message.
+      K::LTT_MSG_CODE, K::LTT_MSG_CODE_CHUNK, K::LTT_MSG_CODE_ZSTD, K::LTT_MSG_CODE_CHUNK,
+      K::LTT_MSG_CODE_CHUNK, K::LTT_MSG_CODE_ZSTD, K::LTT_MSG_CODE_ZSTD};
+  EXPECT_EQ(target.code_message_kinds, expected_kinds);
+}
+
+TEST(Listener, LoadNamesSkipFailedLinks) {
+  FakeTarget target;
+  target.links = [](int idx) { return idx != 1 && idx != 2; };
+  Listener l;
+  ASSERT_TRUE(l.connect_to_target());
+
+  std::vector<std::string> names = {"first", "fails", "fails-too", "fourth", "fifth"};
+  for (size_t i = 0; i < names.size(); i++) {
+    // the middle one is big enough to be sent in chunks.
+    auto code = random_code(i == 3 ? LISTENER_CODE_CHUNK_SIZE + 1 : 64, i);
+    l.send_code(code, names[i]);
+  }
+  EXPECT_TRUE(l.wait_for_pending_acks());
+  l.disconnect();
+
+  auto map = l.build_memory_map();
+  for (size_t i = 0; i < names.size(); i++) {
+    MemoryMapEntry entry;
+    bool loaded = map.lookup(names[i], 0, &entry);
+    EXPECT_EQ(loaded, target.links(i)) << names[i];
+    if (loaded) {
+      EXPECT_EQ(entry.start_addr, FakeTarget::load_address(i)) << names[i];
+    }
+  }
+}
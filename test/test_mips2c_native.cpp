@@ -0,0 +1,302 @@
+#include <cstring>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game/mips2c/mips2c_native.h"
+#include "game/mips2c/mips2c_private.h"
+#include "game/runtime.h"
+#include "gtest/gtest.h"
+
+// The symbol caches are normally filled by the link() functions, which need a running kernel.
+// In these tests they point at fake symbols instead.
+extern const uint32_t* max_tri_count;
+
+namespace Mips2C::jak1 {
+namespace method_26_collide_cache {
+struct Cache {
+  void* already_printed_exeeded_max_cache_tris;  // *already-printed-exeeded-max-cache-tris*
+  void* cheat_mode;                              // *cheat-mode*
+  void* stdcon;                                  // *stdcon*
+  void* debug;                                   // debug
+  void* format;                                  // format
+  void* fake_scratchpad_data;                    // *fake-scratchpad-data*
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+}  // namespace method_26_collide_cache
+namespace native_load_mesh_from_spad_in_box {
+struct Cache {
+  void* already_printed_exeeded_max_cache_tris;  // *already-printed-exeeded-max-cache-tris*
+  void* cheat_mode;                              // *cheat-mode*
+  void* fake_scratchpad_data;                    // *fake-scratchpad-data*
+  void* collide_cache_max_tris;                  // *collide-cache-max-tris*
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+}  // namespace native_load_mesh_from_spad_in_box
+}  // namespace Mips2C::jak1
+
+namespace Mips2C::jak2 {
+namespace bones_mtx_calc {
+struct Cache {
+  void* fake_scratchpad_data;  // *fake-scratchpad-data*
+};
+extern Cache cache;
+u64 execute(void* ctxt);
+}  // namespace bones_mtx_calc
+namespace native_bones_mtx_calc {
+u64 execute(void* ctxt);
+}
+}  // namespace Mips2C::jak2
+
+namespace {
+constexpr u32 kMemSize = 4 * 1024 * 1024;
+constexpr u32 kStackAddr = 0x8000;
+constexpr u32 kSymbolsAddr = 0x9000;  // fake symbols, 4 bytes each
+constexpr u32 kSpadAddr = 0x10000;    // must be 16 kB aligned, the bones code masks addresses
+constexpr u32 kDataAddr = 0x20000;
+
+using Mips2C::ExecutionContext;
+
+class Mips2CNative : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    m_mem.assign(kMemSize, 0);
+    g_ee_main_mem = m_mem.data();
+  }
+
+  u32* symbol(int idx) { return (u32*)(g_ee_main_mem + kSymbolsAddr + 4 * idx); }
+
+  // run both versions from the same starting memory, and return the memory after each.
+  void run_both(Mips2C::Mips2CFunc mips2c,
+                Mips2C::Mips2CFunc native,
+                const ExecutionContext& args,
+                std::vector<u8>* expected,
+                std::vector<u8>* result) {
+    std::vector<u8> before = m_mem;
+    auto c = std::make_unique<ExecutionContext>(args);
+    mips2c(c.get());
+    *expected = m_mem;
+    m_mem = before;
+    c = std::make_unique<ExecutionContext>(args);
+    native(c.get());
+    *result = m_mem;
+    m_mem = before;
+  }
+
+  std::vector<u8> m_mem;
+};
+
+std::unique_ptr<ExecutionContext> make_args() {
+  auto c = std::make_unique<ExecutionContext>();
+  c->gprs[Mips2C::sp].du64[0] = kStackAddr;
+  return c;
+}
+
+struct BonesSetup {
+  u32 output, joints, bones, camera;
+};
+
+BonesSetup setup_bones(std::mt19937& rng, u32 count) {
+  std::uniform_real_distribution<float> dist(-2.f, 2.f);
+  BonesSetup setup;
+  setup.camera = kDataAddr;
+  // the joint data is read starting 68 bytes before the joints argument.
+  setup.joints = setup.camera + 64 + 68;
+  u32 joints_end = setup.joints - 68 + 80 * (count + 1);
+  setup.bones = (joints_end + 15) & ~15;
+  setup.output = setup.bones + 80 * count;
+
+  auto fill = [&](u32 addr, int n) {
+    float* data = (float*)(g_ee_main_mem + addr);
+    for (int i = 0; i < n; i++) {
+      data[i] = dist(rng);
+    }
+  };
+  fill(setup.camera, 16);
+  fill(setup.joints - 68, 20 * (count + 1));
+  fill(setup.bones, 20 * count);
+  fill(setup.output, 32 * count);
+
+  // the double buffered layout from bone-memory
+  u32* layout = (u32*)(g_ee_main_mem + kSpadAddr);
+  const u32 buffer_size = 16 * 64 + 16 * 80 + 16 * 128;
+  for (u32 i = 0; i < 2; i++) {
+    u32 buffer = kSpadAddr + 80 + i * buffer_size;
+    layout[i] = buffer;
+    layout[2 + i] = buffer + 16 * 64;
+    layout[4 + i] = buffer + 16 * 64 + 16 * 80;
+  }
+  return setup;
+}
+
+std::unique_ptr<ExecutionContext> bones_args(const BonesSetup& setup, u32 count) {
+  auto c = make_args();
+  c->gprs[Mips2C::a0].du64[0] = setup.output;
+  c->gprs[Mips2C::a1].du64[0] = setup.joints;
+  c->gprs[Mips2C::a2].du64[0] = setup.bones;
+  c->gprs[Mips2C::a3].du64[0] = count;
+  c->gprs[Mips2C::t0].du64[0] = setup.camera;
+  return c;
+}
+
+struct MeshSetup {
+  u32 ccache, mesh;
+};
+
+constexpr u32 kMaxTris = 460;
+
+// random triangle strips over random vertices in the scratchpad, in a random box.
+MeshSetup setup_mesh(std::mt19937& rng, u32 start_tris, u32 strip_count) {
+  constexpr int kVertexCount = 100;
+  std::uniform_int_distribution<s32> coord(-1000, 1000);
+  std::uniform_int_distribution<int> vertex(0, kVertexCount - 1);
+  std::uniform_int_distribution<int> strip_len(0, 12);
+
+  for (int i = 0; i < kVertexCount; i++) {
+    s32* v = (s32*)(g_ee_main_mem + kSpadAddr + 32 * i);
+    for (int j = 0; j < 8; j++) {
+      v[j] = coord(rng);
+    }
+  }
+
+  MeshSetup setup;
+  setup.ccache = kDataAddr + 4;
+  u8* cc = g_ee_main_mem + setup.ccache;
+  memcpy(cc, &start_tris, 4);
+  u32 ignore_mask = 0x10;
+  memcpy(cc + 8, &ignore_mask, 4);
+  s32* box = (s32*)(cc + 60);
+  for (int i = 0; i < 4; i++) {
+    s32 a = coord(rng), b = coord(rng);
+    box[i] = std::min(a, b);
+    box[4 + i] = std::max(a, b);
+  }
+
+  u32 pats = kDataAddr + 0x10000;
+  for (int i = 0; i < 256; i++) {
+    u32 pat = rng() & 0x3f;
+    memcpy(g_ee_main_mem + pats + 4 * i, &pat, 4);
+  }
+
+  std::vector<s8> strips;
+  std::vector<u8> pat_indices;
+  for (u32 s = 0; s < strip_count; s++) {
+    for (int i = 0; i < 3; i++) {
+      strips.push_back(vertex(rng));
+    }
+    pat_indices.push_back(rng());
+    int len = strip_len(rng);
+    for (int i = 0; i < len; i++) {
+      s8 idx = vertex(rng) + 1;
+      strips.push_back((rng() & 1) ? idx : -idx);
+      pat_indices.push_back(rng());
+    }
+    strips.push_back(0);
+  }
+  strips.push_back(-1);
+
+  u32 packed_data = kDataAddr + 0x11000;
+  u8 vertex_data_qwc = 3;
+  u32 strip_addr = packed_data + 16 * vertex_data_qwc;
+  memcpy(g_ee_main_mem + strip_addr, strips.data(), strips.size());
+  memcpy(g_ee_main_mem + strip_addr + strips.size(), pat_indices.data(), pat_indices.size());
+
+  setup.mesh = kDataAddr + 0x12004;
+  u8* mesh = g_ee_main_mem + setup.mesh;
+  u16 strip_data_len = strips.size();
+  memcpy(mesh, &packed_data, 4);
+  memcpy(mesh + 4, &pats, 4);
+  memcpy(mesh + 8, &strip_data_len, 2);
+  mesh[25] = vertex_data_qwc;
+  return setup;
+}
+
+std::unique_ptr<ExecutionContext> mesh_args(const MeshSetup& setup) {
+  auto c = make_args();
+  c->gprs[Mips2C::a0].du64[0] = setup.ccache;
+  c->gprs[Mips2C::a1].du64[0] = setup.mesh;
+  c->gprs[Mips2C::s7].du64[0] = kSymbolsAddr + 0x100;
+  return c;
+}
+}  // namespace
+
+TEST_F(Mips2CNative, BonesMtxCalc) {
+  // jak2 symbols are at an odd address.
+  *symbol(0) = kSpadAddr;
+  Mips2C::jak2::bones_mtx_calc::cache.fake_scratchpad_data = g_ee_main_mem + kSymbolsAddr + 1;
+
+  std::mt19937 rng(12345);
+  for (u32 count : {1, 2, 7, 8, 9, 16, 17, 31, 32, 33, 40, 100}) {
+    auto setup = setup_bones(rng, count);
+    auto args = bones_args(setup, count);
+    std::vector<u8> expected, result;
+    run_both(Mips2C::jak2::bones_mtx_calc::execute, Mips2C::jak2::native_bones_mtx_calc::execute,
+             *args, &expected, &result);
+    EXPECT_EQ(0, memcmp(expected.data() + setup.output, result.data() + setup.output, 128 * count))
+        << count;
+    // and nothing else was written, except for the stack and scratchpad by the mips2c version.
+    EXPECT_EQ(0, memcmp(expected.data() + kDataAddr, result.data() + kDataAddr,
+                        kMemSize - kDataAddr))
+        << count;
+  }
+}
+
+TEST_F(Mips2CNative, LoadMeshFromSpadInBox) {
+  u32 max_tris = kMaxTris;
+  max_tri_count = &max_tris;
+  const u32 s7 = kSymbolsAddr + 0x100;
+  *symbol(0) = kSpadAddr;
+  *symbol(1) = s7;  // *already-printed-exeeded-max-cache-tris*
+  *symbol(2) = s7;  // *cheat-mode*
+  *symbol(3) = max_tris;
+  auto& mips2c_cache = Mips2C::jak1::method_26_collide_cache::cache;
+  mips2c_cache.fake_scratchpad_data = symbol(0);
+  mips2c_cache.already_printed_exeeded_max_cache_tris = symbol(1);
+  mips2c_cache.cheat_mode = symbol(2);
+  auto& native_cache = Mips2C::jak1::native_load_mesh_from_spad_in_box::cache;
+  native_cache.fake_scratchpad_data = symbol(0);
+  native_cache.already_printed_exeeded_max_cache_tris = symbol(1);
+  native_cache.cheat_mode = symbol(2);
+  native_cache.collide_cache_max_tris = symbol(3);
+
+  std::mt19937 rng(12345);
+  for (int trial = 0; trial < 200; trial++) {
+    // some of these start almost full, to check the overflow.
+    u32 start_tris = (trial % 4 == 3) ? kMaxTris - (trial % 7) : trial % 50;
+    auto setup = setup_mesh(rng, start_tris, 1 + trial % 20);
+    auto args = mesh_args(setup);
+    std::vector<u8> expected, result;
+    run_both(Mips2C::jak1::method_26_collide_cache::execute,
+             Mips2C::jak1::native_load_mesh_from_spad_in_box::execute, *args, &expected, &result);
+    u32 num_tris;
+    memcpy(&num_tris, expected.data() + setup.ccache, 4);
+    EXPECT_EQ(0, memcmp(expected.data() + kDataAddr, result.data() + kDataAddr,
+                        kMemSize - kDataAddr))
+        << trial << " " << start_tris << " -> " << num_tris;
+  }
+}
+
+
+TEST(Mips2CNativeTable, ReregisterReusesSlot) {
+  auto old_version = g_game_version;
+  g_game_version = GameVersion::Jak2;
+  auto table = std::make_unique<Mips2C::NativeFunctionTable>();
+  Mips2C::Mips2CFunc first = [](void*) -> u64 { return 1; };
+  Mips2C::Mips2CFunc second = [](void*) -> u64 { return 2; };
+
+  auto dispatcher = table->wrap("bones-mtx-calc", first);
+  EXPECT_NE(dispatcher, first);
+  EXPECT_EQ(table->wrap("not-a-native-port", first), first);
+
+  // the runtime restarting registers everything again, more times than there are slots.
+  for (int i = 0; i < 2 * Mips2C::NativeFunctionTable::kMaxFunctions; i++) {
+    EXPECT_EQ(table->wrap("bones-mtx-calc", second), dispatcher);
+  }
+  ASSERT_EQ(table->stats().size(), 1u);
+  EXPECT_EQ(table->stats().at(0).name, "bones-mtx-calc");
+  // and the slot runs the latest mips2c function.
+  EXPECT_EQ(table->run(0, nullptr), 2u);
+  g_game_version = old_version;
+}
@@ -0,0 +1,51 @@
+#include "game/graphics/opengl_renderer/Profiler.h"
+#include "gtest/gtest.h"
+
+TEST(RollingSamples, Empty) {
+  RollingSamples samples;
+  EXPECT_TRUE(samples.empty());
+  EXPECT_EQ(samples.percentile(0.5f), 0.f);
+  EXPECT_EQ(samples.percentile(0.99f), 0.f);
+}
+
+TEST(RollingSamples, Percentiles) {
+  RollingSamples samples;
+  samples.push(5.f);
+  EXPECT_FALSE(samples.empty());
+  EXPECT_EQ(samples.percentile(0.f), 5.f);
+  EXPECT_EQ(samples.percentile(1.f), 5.f);
+
+  // push 2 to 100 out of order, so 1 to 100 with the 5 from above.
+  for (int i = 100; i > 1; i--) {
+    if (i != 5) {
+      samples.push(i);
+    }
+  }
+  samples.push(1.f);
+  EXPECT_EQ(samples.percentile(0.f), 1.f);
+  EXPECT_EQ(samples.percentile(0.5f), 51.f);
+  EXPECT_EQ(samples.percentile(0.99f), 100.f);
+  // out of range is clamped.
+  EXPECT_EQ(samples.percentile(1.f), 100.f);
+  EXPECT_EQ(samples.percentile(-1.f), 1.f);
+}
+
+TEST(RollingSamples, OldSamplesDropped) {
+  RollingSamples samples;
+  for (int i = 0; i < RollingSamples::SIZE; i++) {
+    samples.push(100.f);
+  }
+
+  // replace the oldest half.
+  for (int i = 0; i < RollingSamples::SIZE / 2; i++) {
+    samples.push(1.f);
+  }
+  EXPECT_EQ(samples.percentile(0.25f), 1.f);
+  EXPECT_EQ(samples.percentile(0.75f), 100.f);
+
+  // and then the rest.
+  for (int i = 0; i < RollingSamples::SIZE / 2; i++) {
+    samples.push(1.f);
+  }
+  EXPECT_EQ(samples.percentile(0.99f), 1.f);
+}
@@ -0,0 +1,111 @@
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "game/sound/common/synth.h"
+#include "gtest/gtest.h"
+
+namespace {
+// random ADPCM data, in blocks of a header and 28 samples. The last block ends the sample.
+std::vector<u16> make_adpcm(std::mt19937& rng, int blocks, bool loop) {
+  std::vector<u16> result;
+  for (int b = 0; b < blocks; b++) {
+    u16 header = (rng() % 13) | ((rng() % 5) << 4);
+    if (b == 0) {
+      header |= 1 << 10;  // loop start
+    }
+    if (b == blocks - 1) {
+      header |= 1 << 8;  // loop end
+      if (loop) {
+        header |= 1 << 9;  // loop repeat
+      }
+    }
+    result.push_back(header);
+    for (int i = 0; i < 7; i++) {
+      result.push_back(rng());
+    }
+  }
+  return result;
+}
+
+struct VoiceSettings {
+  u16 pitch, adsr1, adsr2, vol_left, vol_right;
+  int key_off_sample;
+};
+}  // namespace
+
+TEST(Sound, SynthBlockMatchesSingleSample) {
+  std::mt19937 rng(1234);
+  std::vector<std::vector<u16>> samples;
+  std::vector<VoiceSettings> settings;
+  for (int i = 0; i < 24; i++) {
+    samples.push_back(make_adpcm(rng, 4 + rng() % 40, i % 3 == 0));
+    VoiceSettings s;
+    s.pitch = 0x400 + rng() % 0x3C00;
+    s.adsr1 = rng() & 0x7fff;
+    s.adsr2 = (rng() & 0xdfc0) | (rng() % 8);
+    // some voices use volume sweeps
+    s.vol_left = (i % 4 == 0) ? (0x8000 | (rng() & 0x7f)) : (rng() & 0x3fff);
+    s.vol_right = rng() & 0x3fff;
+    s.key_off_sample = rng() % 20000;
+    settings.push_back(s);
+  }
+
+  snd::Synth single, block;
+  // 0xffff is used in game, and is large enough to overflow.
+  single.SetMasterVol(0xffff);
+  block.SetMasterVol(0xffff);
+  std::vector<std::shared_ptr<snd::Voice>> single_voices, block_voices;
+
+  auto start_voice = [&](snd::Synth& synth, std::vector<std::shared_ptr<snd::Voice>>& voices,
+                         int idx) {
+    auto voice = std::make_shared<snd::Voice>();
+    auto& s = settings.at(idx);
+    voice->SetVolume(s.vol_left, s.vol_right);
+    voice->SetPitch(s.pitch);
+    voice->SetAsdr1(s.adsr1);
+    voice->SetAsdr2(s.adsr2);
+    voice->SetSample(samples.at(idx).data());
+    voice->KeyOn();
+    synth.AddVoice(voice);
+    voices.push_back(voice);
+  };
+
+  constexpr int kTotal = 30000;
+  const int block_sizes[] = {1, 3, 64, 200, 257, 1000};
+  std::vector<snd::s16Output> expected, actual(kTotal);
+  int block_idx = 0;
+  int pos = 0;
+  while (pos < kTotal) {
+    // start/stop voices at block boundaries, like the sound handlers.
+    for (int i = 0; i < (int)settings.size(); i++) {
+      if (pos == (i * 937) % 12000 && (int)single_voices.size() == i) {
+        start_voice(single, single_voices, i);
+        start_voice(block, block_voices, i);
+      }
+      if (i < (int)single_voices.size() && pos >= settings[i].key_off_sample &&
+          settings[i].key_off_sample >= 0) {
+        single_voices[i]->KeyOff();
+        block_voices[i]->KeyOff();
+        settings[i].key_off_sample = -1;
+      }
+    }
+
+    int count = std::min(block_sizes[block_idx++ % 6], kTotal - pos);
+    for (int i = 0; i < count; i++) {
+      expected.push_back(single.Tick());
+    }
+    block.Tick(actual.data() + pos, count);
+    pos += count;
+  }
+
+  int nonzero = 0;
+  for (int i = 0; i < kTotal; i++) {
+    ASSERT_EQ(expected[i].left, actual[i].left) << i;
+    ASSERT_EQ(expected[i].right, actual[i].right) << i;
+    if (expected[i].left || expected[i].right) {
+      nonzero++;
+    }
+  }
+  EXPECT_GT(nonzero, kTotal / 5);
+}
@@ -0,0 +1,231 @@
+#include <random>
+#include <regex>
+#include <unordered_set>
+
+#include "common/texture/texture_conversion.h"
+#include "common/util/DgoReader.h"
+#include "common/util/FileUtil.h"
+#include "common/util/Timer.h"
+#include "common/util/string_util.h"
+
+#include "decompiler/ObjectFile/LinkedObjectFileCreation.h"
+#include "decompiler/util/DecompilerTypeSystem.h"
+
+#include "game/graphics/opengl_renderer/TextureAnimator.h"
+#include "game/graphics/texture/TextureConverter.h"
+#include "gtest/gtest.h"
+
+#include "fmt/core.h"
+
+namespace {
+constexpr u32 kVramWords = 1024 * 1024;
+constexpr u32 kTexAddr = 0x100;
+constexpr u32 kClutAddr = 0x3000;
+
+// fill all of VRAM with random data, so every texture has random pixels and CLUTs.
+void fill_vram(TextureConverter* converter, std::mt19937& rng) {
+  std::vector<u32> data(kVramWords);
+  for (auto& x : data) {
+    x = rng();
+  }
+  converter->upload((const u8*)data.data(), 0, kVramWords);
+}
+
+struct Format {
+  PSM psm;
+  u32 clut_psm;
+};
+
+const Format kFormats[] = {{PSM::PSMT8, (u32)CPSM::PSMCT32},
+                           {PSM::PSMT8, (u32)CPSM::PSMCT16},
+                           {PSM::PSMT4, (u32)CPSM::PSMCT32},
+                           {PSM::PSMT4, (u32)CPSM::PSMCT16},
+                           {PSM::PSMCT16, 0}};
+
+/*!
+ * The first 9 words of a GOAL texture, after the type tag. See texture in decompiler/data/tpage.
+ */
+struct GoalTextureInfo {
+  s16 w;
+  s16 h;
+  u8 num_mips;
+  u8 tex1_control;
+  u8 psm;
+  u8 mip_shift;
+  u16 clutpsm;
+  u16 dest[7];
+  u16 clutdest;
+  u8 width[8];
+  u8 pad;
+};
+static_assert(sizeof(GoalTextureInfo) == 9 * 4);
+
+/*!
+ * The upload of a tpage from the game's files: the block data that's copied to VRAM, and the
+ * textures that are read back out of it.
+ */
+struct RecordedTpage {
+  std::string name;
+  std::vector<u32> block_data;
+  std::vector<GoalTextureInfo> textures;
+};
+
+/*!
+ * Find all tpages in the jak 1 DGO and CGO files in iso_data. Empty if the game isn't extracted.
+ */
+std::vector<RecordedTpage> read_recorded_tpages() {
+  using namespace decompiler;
+  std::vector<RecordedTpage> result;
+  auto iso_dir = file_util::get_iso_dir_for_game(GameVersion::Jak1);
+  if (iso_dir.empty()) {
+    return result;
+  }
+
+  DecompilerTypeSystem dts(GameVersion::Jak1);
+  std::unordered_set<std::string> seen;
+  for (auto dir : {"DGO", "CGO"}) {
+    if (!fs::exists(iso_dir / dir)) {
+      continue;
+    }
+    for (auto& path : file_util::find_files_in_dir(iso_dir / dir, std::regex(".*\\.[CD]GO"))) {
+      DgoReader reader(path.filename().string(), file_util::read_binary_file(path));
+      for (auto& entry : reader.entries()) {
+        if (!str_util::starts_with(entry.internal_name, "tpage-") ||
+            !seen.insert(entry.internal_name).second) {
+          continue;
+        }
+        auto linked =
+            to_linked_object_file(entry.data, entry.internal_name, dts, GameVersion::Jak1);
+        const auto& words = linked.words_by_seg.at(0);
+        RecordedTpage tpage;
+        tpage.name = entry.internal_name;
+
+        // texture-page: type, info, name, id, length, mip0-size, size, segment[3], pad[16], data
+        int length = words.at(4).data;
+        int block_start = linked.labels.at(words.at(7).label_id()).offset / 4;
+        for (size_t i = block_start; i < words.size(); i++) {
+          tpage.block_data.push_back(words[i].data);
+        }
+        for (int i = 0; i < length; i++) {
+          const auto& ptr = words.at(32 + i);
+          if (ptr.kind() != LinkedWord::PTR) {
+            continue;  // #f
+          }
+          // the label of a basic points just past its type tag.
+          int tex_start = linked.labels.at(ptr.label_id()).offset / 4;
+          GoalTextureInfo info;
+          for (int j = 0; j < 9; j++) {
+            memcpy((u8*)&info + 4 * j, &words.at(tex_start + j).data, 4);
+          }
+          tpage.textures.push_back(info);
+        }
+        result.push_back(std::move(tpage));
+      }
+    }
+  }
+  return result;
+}
+}  // namespace
+
+TEST(TextureConverter, MatchesReference) {
+  std::mt19937 rng(12345);
+  TextureConverter converter;
+  fill_vram(&converter, rng);
+
+  struct Size {
+    u32 w, h, tbw;
+  };
+  // include widths that aren't a multiple of a block row, so the tail of each row is converted.
+  const Size sizes[] = {{1, 3, 1},   {8, 8, 1},     {16, 16, 1},   {24, 40, 1},   {32, 32, 1},
+                        {64, 64, 1}, {128, 128, 2}, {256, 256, 4}, {512, 256, 8}, {100, 60, 2}};
+
+  for (bool parallel : {false, true}) {
+    converter.set_parallel(parallel);
+    for (const auto& format : kFormats) {
+      for (const auto& size : sizes) {
+        u32 bytes = size.w * size.h * 4;
+        std::vector<u8> expected(bytes), result(bytes);
+        converter.download_rgba8888_reference(expected.data(), kTexAddr, size.tbw, size.w, size.h,
+                                              (u32)format.psm, format.clut_psm, kClutAddr, bytes);
+        converter.download_rgba8888(result.data(), kTexAddr, size.tbw, size.w, size.h,
+                                    (u32)format.psm, format.clut_psm, kClutAddr, bytes);
+        EXPECT_EQ(expected, result) << fmt::format("psm {} clut {} size {}x{}", (u32)format.psm,
+                                                   format.clut_psm, size.w, size.h);
+      }
+    }
+  }
+}
+
+// not a real benchmark, but prints the speedup over the reference version when converting the
+// textures in the game's tpages. Only runs if jak 1 is extracted to iso_data.
+TEST(TextureConverter, TpageBenchmark) {
+  auto tpages = read_recorded_tpages();
+  if (tpages.empty()) {
+    GTEST_SKIP() << "no jak 1 tpages in iso_data";
+  }
+
+  TextureConverter converter;
+  double reference_ms = 0, fast_ms = 0, parallel_ms = 0;
+  int texture_count = 0;
+  u64 pixel_count = 0;
+  for (const auto& tpage : tpages) {
+    converter.upload((const u8*)tpage.block_data.data(), 0, tpage.block_data.size());
+    for (const auto& tex : tpage.textures) {
+      u32 clut_psm = tex.psm == (u8)PSM::PSMCT16 ? 0 : tex.clutpsm;
+      bool supported = tex.psm == (u8)PSM::PSMCT16 ||
+                       ((tex.psm == (u8)PSM::PSMT8 || tex.psm == (u8)PSM::PSMT4) &&
+                        (clut_psm == (u32)CPSM::PSMCT32 || clut_psm == (u32)CPSM::PSMCT16));
+      if (!supported) {
+        continue;
+      }
+      u32 bytes = tex.w * tex.h * 4;
+      std::vector<u8> expected(bytes), result(bytes);
+
+      Timer reference_timer;
+      converter.download_rgba8888_reference(expected.data(), tex.dest[0], tex.width[0], tex.w,
+                                            tex.h, tex.psm, clut_psm, tex.clutdest, bytes);
+      reference_ms += reference_timer.getMs();
+
+      converter.set_parallel(false);
+      Timer fast_timer;
+      converter.download_rgba8888(result.data(), tex.dest[0], tex.width[0], tex.w, tex.h, tex.psm,
+                                  clut_psm, tex.clutdest, bytes);
+      fast_ms += fast_timer.getMs();
+      EXPECT_EQ(expected, result) << tpage.name;
+
+      converter.set_parallel(true);
+      Timer parallel_timer;
+      converter.download_rgba8888(result.data(), tex.dest[0], tex.width[0], tex.w, tex.h, tex.psm,
+                                  clut_psm, tex.clutdest, bytes);
+      parallel_ms += parallel_timer.getMs();
+      EXPECT_EQ(expected, result) << tpage.name;
+
+      texture_count++;
+      pixel_count += tex.w * tex.h;
+    }
+  }
+
+  fmt::print("{} tpages, {} textures, {} pixels: reference {:.3f} ms, simd {:.3f} ms ({:.1f}x), "
+             "parallel {:.3f} ms ({:.1f}x)\n",
+             tpages.size(), texture_count, pixel_count, reference_ms, fast_ms,
+             reference_ms / fast_ms, parallel_ms, reference_ms / parallel_ms);
+}
+
+TEST(ClutBlend, MatchesReference) {
+  std::mt19937 rng(12345);
+  Clut a, b, expected, result;
+  for (int trial = 0; trial < 20; trial++) {
+    for (int i = 0; i < 256; i++) {
+      for (int c = 0; c < 4; c++) {
+        a[i][c] = rng();
+        b[i][c] = rng();
+      }
+    }
+    for (int step = 0; step <= CLUT_BLEND_WEIGHT_STEPS; step += 7) {
+      float wb = (float)step / CLUT_BLEND_WEIGHT_STEPS;
+      blend_cluts_reference(&expected, a, b, 1.f - wb, wb);
+      blend_cluts(&result, a, b, 1.f - wb, wb);
+      EXPECT_EQ(expected, result) << wb;
+    }
+  }
+}
@@ -0,0 +1,108 @@
+#include <cstring>
+#include <memory>
+#include <random>
+
+#include "game/common/vu_batch.h"
+#include "game/graphics/opengl_renderer/ocean/OceanMid.h"
+#include "gtest/gtest.h"
+
+#include "fmt/core.h"
+#include "third-party/glad/include/glad/glad.h"
+
+namespace {
+Vf random_vf(std::mt19937& rng) {
+  std::uniform_real_distribution<float> dist(-1000.f, 1000.f);
+  Vf result(dist(rng), dist(rng), dist(rng), dist(rng));
+  // some exact zeros, to check signed zero handling.
+  if (rng() % 8 == 0) {
+    result.z() = (rng() % 2) ? 0.f : -0.f;
+  }
+  return result;
+}
+
+bool same_bits(const Vf& a, const Vf& b) {
+  return memcmp(a.data, b.data, 16) == 0;
+}
+}  // namespace
+
+/*!
+ * Runs OceanMid's call107 vertex loop with and without batching on the same input.
+ * OceanMid creates OpenGL buffers, so the few GL functions it uses are replaced with stubs.
+ */
+class OceanMidTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    glad_glGenBuffers = [](GLsizei, GLuint*) {};
+    glad_glGenVertexArrays = [](GLsizei, GLuint*) {};
+    glad_glBindVertexArray = [](GLuint) {};
+    glad_glBindBuffer = [](GLenum, GLuint) {};
+    glad_glBufferData = [](GLenum, GLsizeiptr, const void*, GLenum) {};
+    glad_glEnableVertexAttribArray = [](GLuint) {};
+    glad_glVertexAttribPointer = [](GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {};
+    glad_glVertexAttribIPointer = [](GLuint, GLint, GLenum, GLsizei, const void*) {};
+    glad_glDeleteBuffers = [](GLsizei, const GLuint*) {};
+    glad_glDeleteVertexArrays = [](GLsizei, const GLuint*) {};
+  }
+
+  void check_call107(int iterations, bool jak2, int seed) {
+    std::mt19937 rng(seed);
+    auto batched = std::make_unique<OceanMid>();
+    auto unbatched = std::make_unique<OceanMid>();
+    unbatched->m_use_vertex_batch = false;
+
+    u16 buffer = (rng() % 2) ? OceanMid::VU1_INPUT_BUFFER_BASE : OceanMid::VU1_INPUT_BUFFER_OFFSET;
+    for (int i = 0; i < 1024; i++) {
+      auto v = random_vf(rng);
+      batched->m_vu_data[i] = v;
+      unbatched->m_vu_data[i] = v;
+    }
+    for (auto reg : {&OceanMid::Vu::vf01, &OceanMid::Vu::vf05, &OceanMid::Vu::vf06,
+                     &OceanMid::Vu::vf08, &OceanMid::Vu::vf09, &OceanMid::Vu::vf10,
+                     &OceanMid::Vu::vf11, &OceanMid::Vu::vf12, &OceanMid::Vu::vf13,
+                     &OceanMid::Vu::vf14, &OceanMid::Vu::vf15}) {
+      auto v = random_vf(rng);
+      batched->vu.*reg = v;
+      unbatched->vu.*reg = v;
+    }
+    for (auto* mid : {batched.get(), unbatched.get()}) {
+      mid->vu.vi02 = buffer;
+      mid->vu.vi03 = buffer;
+      mid->vu.vi04 = 0;
+      mid->vu.vi05 = iterations;
+      if (jak2) {
+        mid->run_L17_vu2c_jak2();
+      } else {
+        mid->run_L17_vu2c();
+      }
+    }
+
+    for (int i = 0; i < 1024; i++) {
+      ASSERT_TRUE(same_bits(batched->m_vu_data[i], unbatched->m_vu_data[i]))
+          << i << " " << batched->m_vu_data[i].print() << " vs "
+          << unbatched->m_vu_data[i].print();
+    }
+    EXPECT_EQ(batched->vu.vi03, unbatched->vu.vi03);
+    EXPECT_EQ(batched->vu.vi04, unbatched->vu.vi04);
+    EXPECT_EQ(batched->vu.vi05, unbatched->vu.vi05);
+    for (auto reg : {&OceanMid::Vu::vf16, &OceanMid::Vu::vf18, &OceanMid::Vu::vf19,
+                     &OceanMid::Vu::vf20, &OceanMid::Vu::vf22, &OceanMid::Vu::vf23,
+                     &OceanMid::Vu::vf24, &OceanMid::Vu::vf25, &OceanMid::Vu::vf26,
+                     &OceanMid::Vu::vf27, &OceanMid::Vu::vf28, &OceanMid::Vu::vf29,
+                     &OceanMid::Vu::vf30, &OceanMid::Vu::vf31}) {
+      EXPECT_TRUE(same_bits(batched->vu.*reg, unbatched->vu.*reg));
+    }
+    EXPECT_EQ(0, memcmp(batched->vu.acc.data, unbatched->vu.acc.data, 16));
+    EXPECT_EQ(0, memcmp(&batched->vu.P, &unbatched->vu.P, 4));
+  }
+};
+
+TEST_F(OceanMidTest, Call107BatchedMatchesUnbatched) {
+  const int W = kVuBatchWidth;
+  // vi05 is a signed count, and the loop always runs at least once.
+  for (int iterations : {-3, 0, 1, W - 1, W, W + 1, 2 * W, 2 * W + 1, 7 * W}) {
+    for (bool jak2 : {false, true}) {
+      SCOPED_TRACE(fmt::format("iterations {} jak2 {}", iterations, jak2));
+      check_call107(iterations, jak2, 107 + iterations);
+    }
+  }
+}
@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "common/common_types.h"
+#include "common/custom_data/fr3_container.h"
 #include "common/util/compress.h"
 
 #include "gtest/gtest.h"
@@ -56,4 +57,41 @@ TEST(ZSTD, CommonLibrary) {
   }
 
   EXPECT_TRUE(compressed.size() < 0.5 * all.size());
-}
\ No newline at end of file
+}
+
+TEST(ZSTD, Fr3Container) {
+  std::string all;
+  for (auto& x : all_syms) {
+    all.append(x);
+    all.append("\n");
+  }
+  // add some data that doesn't compress, so some sections are stored without compression.
+  u32 rng = 1234;
+  for (int i = 0; i < 100000; i++) {
+    rng = rng * 1664525 + 1013904223;
+    all.push_back(rng >> 24);
+  }
+  const u8* data = (const u8*)all.data();
+
+  for (size_t section_size : {1000, 4096, 1024 * 1024}) {
+    auto file = tfrag3::pack_fr3(data, all.size(), section_size);
+    tfrag3::Fr3Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    EXPECT_EQ(header.section_count, (all.size() + section_size - 1) / section_size);
+    for (u32 i = 0; i < header.section_count; i++) {
+      tfrag3::Fr3Section sec;
+      memcpy(&sec, file.data() + sizeof(header) + i * sizeof(sec), sizeof(sec));
+      EXPECT_EQ(sec.file_offset % tfrag3::FR3_SECTION_ALIGN, 0);
+    }
+
+    auto unpacked = tfrag3::unpack_fr3(file.data(), file.size());
+    ASSERT_EQ(unpacked.size(), all.size());
+    EXPECT_EQ(0, memcmp(unpacked.data(), data, all.size()));
+  }
+
+  // files in the old format can still be read.
+  auto old_file = compression::compress_zstd(all.data(), all.size());
+  auto unpacked = tfrag3::unpack_fr3(old_file.data(), old_file.size());
+  ASSERT_EQ(unpacked.size(), all.size());
+  EXPECT_EQ(0, memcmp(unpacked.data(), data, all.size()));
+}
@@ -0,0 +1,680 @@
+#include "heap_profile.h"
+
+#include <algorithm>
+#include <optional>
+#include <unordered_set>
+
+#include "common/goal_constants.h"
+#include "common/log/log.h"
+#include "common/type_system/TypeSystem.h"
+#include "common/util/string_util.h"
+
+#include "fmt/core.h"
+
+namespace {
+u32 align16(u32 x) {
+  return (x + 15) & ~15;
+}
+
+/*!
+ * Reads fields of GOAL objects by name, with offsets from the type system.
+ * Object addresses are GOAL pointers, so basics include the basic offset.
+ */
+class ObjectReader {
+ public:
+  ObjectReader(const Ram& ram, const TypeSystem& ts) : m_ram(ram), m_ts(ts) {}
+
+  std::optional<u32> field_addr(u32 obj, const std::string& type, const std::string& field) const {
+    if (!m_ts.fully_defined_type_exists(type)) {
+      return {};
+    }
+    auto* structure = dynamic_cast<StructureType*>(m_ts.lookup_type(type));
+    Field f;
+    if (!structure || !structure->lookup_field(field, &f)) {
+      return {};
+    }
+    u32 start = dynamic_cast<BasicType*>(structure) ? obj - BASIC_OFFSET : obj;
+    return start + f.offset();
+  }
+
+  std::optional<u32> word(u32 obj, const std::string& type, const std::string& field) const {
+    auto addr = field_addr(obj, type, field);
+    if (!addr || !m_ram.word_in_memory(*addr)) {
+      return {};
+    }
+    return m_ram.word(*addr);
+  }
+
+  int size_of(const std::string& type) const {
+    if (!m_ts.fully_defined_type_exists(type)) {
+      return 0;
+    }
+    return m_ts.lookup_type(type)->get_size_in_memory();
+  }
+
+ private:
+  const Ram& m_ram;
+  const TypeSystem& m_ts;
+};
+
+struct KheapInfo {
+  u32 base, top, current, top_base;
+};
+
+std::optional<KheapInfo> read_kheap(const Ram& ram, const ObjectReader& reader, u32 addr) {
+  auto base = reader.word(addr, "kheap", "base");
+  auto top = reader.word(addr, "kheap", "top");
+  auto current = reader.word(addr, "kheap", "current");
+  auto top_base = reader.word(addr, "kheap", "top-base");
+  if (!base || !top || !current || !top_base) {
+    return {};
+  }
+  KheapInfo result{*base, *top, *current, *top_base};
+  if (!ram.in_memory<u8>(result.base) || result.top_base > ram.size ||
+      !(result.base <= result.current && result.current <= result.top &&
+        result.top <= result.top_base)) {
+    return {};
+  }
+  return result;
+}
+
+/*!
+ * Every object found in the dump, sorted by address. Objects with a fixed size know their size,
+ * dynamic ones (arrays, strings, functions...) are assumed to go until the next object.
+ */
+struct ObjectIndex {
+  struct Object {
+    u32 start;
+    u32 size;  // 0 if unknown
+    const std::string* type;
+  };
+  std::vector<Object> objects;
+
+  ObjectIndex(const std::unordered_map<std::string, std::vector<u32>>& found,
+              const TypeSystem& ts) {
+    for (const auto& [name, addrs] : found) {
+      u32 size = 0;
+      if (ts.fully_defined_type_exists(name)) {
+        auto* structure = dynamic_cast<StructureType*>(ts.lookup_type(name));
+        if (structure && !structure->is_dynamic()) {
+          size = align16(structure->get_size_in_memory());
+        }
+      }
+      for (auto addr : addrs) {
+        objects.push_back({addr, size, &name});
+      }
+    }
+    std::sort(objects.begin(), objects.end(), [](const Object& a, const Object& b) {
+      return a.start != b.start ? a.start < b.start : *a.type < *b.type;
+    });
+    objects.erase(std::unique(objects.begin(), objects.end(),
+                              [](const Object& a, const Object& b) { return a.start == b.start; }),
+                  objects.end());
+  }
+
+  /*!
+   * Add the bytes of [lo, hi) to the types of the objects in it.
+   */
+  void attribute(u32 lo, u32 hi, HeapRegion& region, HeapProfile& profile) const {
+    auto add = [&](const std::string& type, u32 bytes) {
+      region.type_bytes[type] += bytes;
+      profile.types[type].bytes += bytes;
+    };
+
+    u32 pos = lo;
+    auto it = std::lower_bound(objects.begin(), objects.end(), lo,
+                               [](const Object& o, u32 addr) { return o.start < addr; });
+    for (; it != objects.end() && it->start < hi; ++it) {
+      if (it->start < pos) {
+        continue;  // inside the previous object.
+      }
+      if (it->start > pos) {
+        add(kUnknownBytes, it->start - pos);
+      }
+      u32 end = hi;
+      if (it->size) {
+        end = std::min(hi, it->start + it->size);
+      } else if (it + 1 != objects.end()) {
+        end = std::min(hi, (it + 1)->start);
+      }
+      add(*it->type, end - it->start);
+      profile.types[*it->type].count++;
+      pos = end;
+    }
+    if (pos < hi) {
+      add(kUnknownBytes, hi - pos);
+    }
+  }
+};
+
+/*!
+ * Remove the blocks from the ranges. Both must be sorted and the blocks can't overlap each other.
+ */
+std::vector<std::pair<u32, u32>> subtract(const std::vector<std::pair<u32, u32>>& ranges,
+                                          const std::vector<std::pair<u32, u32>>& blocks) {
+  std::vector<std::pair<u32, u32>> result;
+  for (auto [lo, hi] : ranges) {
+    for (auto [block_lo, block_hi] : blocks) {
+      if (block_hi <= lo || block_lo >= hi) {
+        continue;
+      }
+      if (block_lo > lo) {
+        result.emplace_back(lo, block_lo);
+      }
+      lo = std::max(lo, block_hi);
+      if (lo >= hi) {
+        break;
+      }
+    }
+    if (lo < hi) {
+      result.emplace_back(lo, hi);
+    }
+  }
+  return result;
+}
+
+std::string region_frame_name(const std::string& name) {
+  // folded stacks use ; to separate frames
+  std::string result = name;
+  std::replace(result.begin(), result.end(), ';', ':');
+  return result;
+}
+
+/*!
+ * The names from the outermost region containing this one, down to the region.
+ * Processes also get the process-tree nodes above them.
+ */
+std::vector<std::string> region_stack(const HeapProfile& profile, int idx) {
+  std::vector<std::string> result;
+  for (int i = idx; i >= 0; i = profile.regions.at(i).parent) {
+    const auto& region = profile.regions.at(i);
+    result.push_back(region_frame_name(region.name));
+    for (auto it = region.tree_path.rbegin(); it != region.tree_path.rend(); ++it) {
+      result.push_back(region_frame_name(*it));
+    }
+  }
+  std::reverse(result.begin(), result.end());
+  return result;
+}
+
+const char* kind_name(HeapRegion::Kind kind) {
+  switch (kind) {
+    case HeapRegion::Kind::KHEAP:
+      return "kheap";
+    case HeapRegion::Kind::PROCESS_POOL:
+      return "process-pool";
+    case HeapRegion::Kind::PROCESS:
+      return "process";
+  }
+  return "?";
+}
+
+class HeapProfiler {
+ public:
+  HeapProfiler(const Ram& ram,
+               const SymbolMap& symbols,
+               const std::unordered_map<u32, std::string>& types,
+               const TypeSystem& type_system)
+      : m_ram(ram),
+        m_symbols(symbols),
+        m_types(types),
+        m_ts(type_system),
+        m_reader(ram, type_system) {}
+
+  std::vector<HeapRegion> find_regions() {
+    add_kheap("global", symbol_value("global"));
+    add_kheap("debug", symbol_value("debug"));
+    add_levels();
+    add_process_pools();
+    add_processes();
+    return std::move(m_regions);
+  }
+
+ private:
+  std::optional<u32> symbol_value(const std::string& name) const {
+    auto it = m_symbols.name_to_value.find(name);
+    if (it == m_symbols.name_to_value.end()) {
+      return {};
+    }
+    return it->second;
+  }
+
+  std::optional<std::string> type_of(u32 basic) const {
+    if (!m_ram.word_in_memory(basic - BASIC_OFFSET)) {
+      return {};
+    }
+    auto it = m_types.find(m_ram.word(basic - BASIC_OFFSET));
+    if (it == m_types.end()) {
+      return {};
+    }
+    return it->second;
+  }
+
+  std::optional<std::string> symbol_name(u32 sym) const {
+    auto it = m_symbols.addr_to_name.find(sym);
+    if (it == m_symbols.addr_to_name.end()) {
+      return {};
+    }
+    return it->second;
+  }
+
+  void add_kheap(const std::string& name, std::optional<u32> addr) {
+    if (!addr) {
+      lg::warn("no kheap for {}", name);
+      return;
+    }
+    auto heap = read_kheap(m_ram, m_reader, *addr);
+    if (!heap) {
+      lg::warn("kheap {} at 0x{:x} doesn't look valid", name, *addr);
+      return;
+    }
+    auto& region = m_regions.emplace_back();
+    region.kind = HeapRegion::Kind::KHEAP;
+    region.name = name;
+    region.start = heap->base;
+    region.end = heap->top_base;
+    if (heap->current < heap->top) {
+      region.free.emplace_back(heap->current, heap->top);
+    }
+  }
+
+  void add_levels() {
+    auto group = symbol_value("*level*");
+    if (!group || type_of(*group) != "level-group") {
+      lg::warn("couldn't find *level*, skipping level heaps");
+      return;
+    }
+    if (!m_ts.fully_defined_type_exists("level")) {
+      return;
+    }
+    Field levels_field;
+    auto* group_type = dynamic_cast<StructureType*>(m_ts.lookup_type("level-group"));
+    if (!group_type || !group_type->lookup_field("level", &levels_field) ||
+        !levels_field.is_array()) {
+      return;
+    }
+    auto* level_type = m_ts.lookup_type("level");
+    int stride = level_type->get_size_in_memory();
+    int alignment = level_type->get_inline_array_stride_alignment();
+    stride = (stride + alignment - 1) / alignment * alignment;
+
+    for (int i = 0; i < levels_field.array_size(); i++) {
+      u32 level = *group - BASIC_OFFSET + levels_field.offset() + i * stride + BASIC_OFFSET;
+      auto heap = m_reader.field_addr(level, "level", "heap");
+      auto name_sym = m_reader.word(level, "level", "name");
+      std::string name = fmt::format("level-{}", i);
+      if (name_sym) {
+        if (auto sym_name = symbol_name(*name_sym)) {
+          name = *sym_name;
+        }
+      }
+      if (heap && m_reader.word(*heap, "kheap", "base").value_or(0)) {
+        add_kheap(fmt::format("level {}", name), heap);
+      }
+    }
+  }
+
+  void add_process_pools() {
+    for (const auto& [name, value] : m_symbols.name_to_value) {
+      if (type_of(value) != "dead-pool-heap") {
+        continue;
+      }
+      auto heap_addr = m_reader.field_addr(value, "dead-pool-heap", "heap");
+      auto heap = heap_addr ? read_kheap(m_ram, m_reader, *heap_addr) : std::nullopt;
+      if (!heap) {
+        lg::warn("dead-pool-heap {} doesn't have a valid heap", name);
+        continue;
+      }
+      auto& region = m_regions.emplace_back();
+      region.kind = HeapRegion::Kind::PROCESS_POOL;
+      region.name = name;
+      region.start = heap->base;
+      region.end = heap->top;
+
+      // the processes in the pool are found by walking the process tree, but this also gets ones
+      // that were activated without a parent.
+      auto rec = m_reader.field_addr(value, "dead-pool-heap", "alive-list");
+      std::unordered_set<u32> visited;
+      while (rec && m_ram.word_in_memory(*rec) && visited.insert(*rec).second) {
+        auto proc = m_reader.word(*rec, "dead-pool-heap-rec", "process");
+        if (proc && *proc && type_of(*proc)) {
+          m_process_paths.try_emplace(*proc);
+        }
+        rec = m_reader.word(*rec, "dead-pool-heap-rec", "next");
+      }
+    }
+  }
+
+  std::string process_tree_name(u32 node) const {
+    auto name = m_reader.word(node, "process-tree", "name");
+    if (name && m_ram.word_in_memory(*name)) {
+      if (auto str = m_ram.try_string(*name + 4)) {
+        return *str;
+      }
+    }
+    return type_of(node).value_or("?");
+  }
+
+  // follow a (pointer process-tree)
+  std::optional<u32> deref_tree_pointer(std::optional<u32> ptr) const {
+    if (!ptr || !m_ram.word_in_memory(*ptr)) {
+      return {};
+    }
+    u32 node = m_ram.word(*ptr);
+    if (!type_of(node)) {
+      return {};
+    }
+    return node;
+  }
+
+  void walk_process_tree(u32 node, std::vector<std::string>& path, std::unordered_set<u32>& seen) {
+    if (!seen.insert(node).second) {
+      return;
+    }
+    auto type = type_of(node);
+    if (type != "process-tree" && type != "dead-pool" && type != "dead-pool-heap") {
+      m_process_paths[node] = path;
+    }
+    path.push_back(process_tree_name(node));
+    auto child = deref_tree_pointer(m_reader.word(node, "process-tree", "child"));
+    while (child) {
+      walk_process_tree(*child, path, seen);
+      child = deref_tree_pointer(m_reader.word(*child, "process-tree", "brother"));
+    }
+    path.pop_back();
+  }
+
+  void add_processes() {
+    auto root = symbol_value("*active-pool*");
+    if (root && type_of(*root)) {
+      std::vector<std::string> path;
+      std::unordered_set<u32> seen;
+      walk_process_tree(*root, path, seen);
+    } else {
+      lg::warn("couldn't find *active-pool*, processes won't have a path");
+    }
+
+    const u32 process_size = m_reader.size_of("process");
+    for (const auto& [proc, path] : m_process_paths) {
+      auto allocated_length = m_reader.word(proc, "process", "allocated-length");
+      auto heap_base = m_reader.word(proc, "process", "heap-base");
+      auto heap_top = m_reader.word(proc, "process", "heap-top");
+      auto heap_cur = m_reader.word(proc, "process", "heap-cur");
+      if (!allocated_length || !heap_base || !heap_top || !heap_cur || !process_size) {
+        continue;
+      }
+      u32 start = proc - BASIC_OFFSET;
+      u64 end = (u64)start + process_size + (s32)*allocated_length;
+      if ((s32)*allocated_length < 0 || end > m_ram.size) {
+        lg::warn("process at 0x{:x} has a bad allocated-length", proc);
+        continue;
+      }
+
+      auto& region = m_regions.emplace_back();
+      region.kind = HeapRegion::Kind::PROCESS;
+      region.name = process_tree_name(proc);
+      region.tree_path = path;
+      region.start = start;
+      region.end = end;
+      if (start <= *heap_base && *heap_base <= *heap_cur && *heap_cur <= *heap_top &&
+          *heap_top <= end && *heap_cur < *heap_top) {
+        region.free.emplace_back(*heap_cur, *heap_top);
+      }
+    }
+  }
+
+  const Ram& m_ram;
+  const SymbolMap& m_symbols;
+  const std::unordered_map<u32, std::string>& m_types;
+  const TypeSystem& m_ts;
+  ObjectReader m_reader;
+  std::vector<HeapRegion> m_regions;
+  std::unordered_map<u32, std::vector<std::string>> m_process_paths;
+};
+
+/*!
+ * Sort regions so parents come before children and find the parent of each. Regions that
+ * partially overlap a sibling are clipped.
+ */
+std::vector<HeapRegion> nest_regions(std::vector<HeapRegion> regions) {
+  std::stable_sort(regions.begin(), regions.end(), [](const HeapRegion& a, const HeapRegion& b) {
+    if (a.start != b.start) {
+      return a.start < b.start;
+    }
+    if (a.end != b.end) {
+      return a.end > b.end;
+    }
+    return a.kind < b.kind;
+  });
+
+  std::vector<HeapRegion> result;
+  std::vector<int> stack;
+  std::unordered_map<int, u32> last_child_end;  // by parent, -1 for the top level
+  for (auto& region : regions) {
+    while (!stack.empty() && region.end > result.at(stack.back()).end) {
+      stack.pop_back();
+    }
+    int parent = stack.empty() ? -1 : stack.back();
+    auto it = last_child_end.find(parent);
+    if (it != last_child_end.end() && region.start < it->second) {
+      region.start = it->second;
+    }
+    if (region.start >= region.end) {
+      lg::warn("skipping {} {}, it overlaps another region", kind_name(region.kind), region.name);
+      continue;
+    }
+    region.parent = parent;
+    last_child_end[parent] = region.end;
+    stack.push_back(result.size());
+    result.push_back(std::move(region));
+  }
+  return result;
+}
+}  // namespace
+
+HeapProfile build_heap_profile(const Ram& ram,
+                               const SymbolMap& symbols,
+                               const std::unordered_map<u32, std::string>& types,
+                               const std::unordered_map<std::string, std::vector<u32>>& objects,
+                               const TypeSystem& type_system) {
+  lg::info("finding heaps and processes...");
+  HeapProfile profile;
+  HeapProfiler profiler(ram, symbols, types, type_system);
+  profile.regions = nest_regions(profiler.find_regions());
+  lg::info("found {} heap regions", profile.regions.size());
+
+  std::vector<std::vector<std::pair<u32, u32>>> children(profile.regions.size());
+  for (size_t i = 0; i < profile.regions.size(); i++) {
+    int parent = profile.regions[i].parent;
+    if (parent >= 0) {
+      children[parent].emplace_back(profile.regions[i].start, profile.regions[i].end);
+    }
+  }
+
+  ObjectIndex index(objects, type_system);
+  for (size_t i = 0; i < profile.regions.size(); i++) {
+    auto& region = profile.regions[i];
+    if (region.kind == HeapRegion::Kind::PROCESS_POOL) {
+      // process pools hand out memory to processes, everything else is free.
+      region.free = subtract({{region.start, region.end}}, children[i]);
+    } else {
+      region.free = subtract(region.free, children[i]);
+    }
+
+    for (auto [lo, hi] : region.free) {
+      region.free_bytes += hi - lo;
+      region.largest_free = std::max<u64>(region.largest_free, hi - lo);
+    }
+
+    auto blocks = children[i];
+    blocks.insert(blocks.end(), region.free.begin(), region.free.end());
+    std::sort(blocks.begin(), blocks.end());
+    for (auto [lo, hi] : subtract({{region.start, region.end}}, blocks)) {
+      index.attribute(lo, hi, region, profile);
+    }
+  }
+  return profile;
+}
+
+void print_heap_profile(const HeapProfile& profile, int top_count) {
+  auto kb = [](u64 bytes) { return fmt::format("{:.1f}K", bytes / 1024.); };
+
+  fmt::print("Heaps:\n");
+  fmt::print("  {:40s} {:>10s} {:>10s} {:>10s} {:>12s} {:>6s}\n", "name", "size", "used", "free",
+             "largest free", "frag");
+  for (size_t i = 0; i < profile.regions.size(); i++) {
+    const auto& region = profile.regions[i];
+    if (region.kind == HeapRegion::Kind::PROCESS) {
+      continue;
+    }
+    int depth = 0;
+    for (int p = region.parent; p >= 0; p = profile.regions[p].parent) {
+      depth++;
+    }
+    fmt::print("  {:40s} {:>10s} {:>10s} {:>10s} {:>12s} {:>5.1f}%\n",
+               std::string(2 * depth, ' ') + region.name, kb(region.size()),
+               kb(region.size() - region.free_bytes), kb(region.free_bytes),
+               kb(region.largest_free), 100. * region.fragmentation());
+  }
+
+  std::vector<std::pair<std::string, HeapTypeTotal>> sorted_types(profile.types.begin(),
+                                                                  profile.types.end());
+  std::sort(sorted_types.begin(), sorted_types.end(),
+            [](const auto& a, const auto& b) { return a.second.bytes > b.second.bytes; });
+  fmt::print("\nTop types:\n");
+  for (int i = 0; i < std::min<int>(top_count, sorted_types.size()); i++) {
+    fmt::print("  {:40s} {:>10s} ({} objects)\n", sorted_types[i].first,
+               kb(sorted_types[i].second.bytes), sorted_types[i].second.count);
+  }
+
+  std::vector<const HeapRegion*> processes;
+  for (const auto& region : profile.regions) {
+    if (region.kind == HeapRegion::Kind::PROCESS) {
+      processes.push_back(&region);
+    }
+  }
+  std::sort(processes.begin(), processes.end(),
+            [](const auto* a, const auto* b) { return a->size() > b->size(); });
+  fmt::print("\nTop processes:\n");
+  for (int i = 0; i < std::min<int>(top_count, processes.size()); i++) {
+    fmt::print("  {:40s} {:>10s} ({} heap free)\n", processes[i]->name, kb(processes[i]->size()),
+               kb(processes[i]->free_bytes));
+  }
+}
+
+nlohmann::json heap_profile_to_json(const HeapProfile& profile) {
+  nlohmann::json result;
+  result["regions"] = nlohmann::json::array();
+  for (const auto& region : profile.regions) {
+    nlohmann::json r;
+    r["name"] = region.name;
+    r["kind"] = kind_name(region.kind);
+    r["parent"] = region.parent;
+    if (!region.tree_path.empty()) {
+      r["tree-path"] = region.tree_path;
+    }
+    r["start"] = region.start;
+    r["end"] = region.end;
+    r["size"] = region.size();
+    r["free"] = region.free_bytes;
+    r["largest-free"] = region.largest_free;
+    r["fragmentation"] = region.fragmentation();
+    r["types"] = region.type_bytes;
+    result["regions"].push_back(r);
+  }
+  for (const auto& [name, total] : profile.types) {
+    result["types"][name] = {{"bytes", total.bytes}, {"count", total.count}};
+  }
+  return result;
+}
+
+/*!
+ * One line per stack of regions and type, with the number of bytes. This is the "folded" format
+ * used by flamegraph.pl and speedscope. The diff of two of these can be made with difffolded.pl.
+ */
+std::string heap_profile_to_folded(const HeapProfile& profile) {
+  std::map<std::string, u64> lines;
+  for (size_t i = 0; i < profile.regions.size(); i++) {
+    const auto& region = profile.regions[i];
+    auto prefix = str_util::join(region_stack(profile, i), ";");
+    for (const auto& [type, bytes] : region.type_bytes) {
+      lines[prefix + ";" + region_frame_name(type)] += bytes;
+    }
+    if (region.free_bytes) {
+      lines[prefix + ";" + kFreeBytes] += region.free_bytes;
+    }
+  }
+
+  std::string result;
+  for (const auto& [stack, bytes] : lines) {
+    result += fmt::format("{} {}\n", stack, bytes);
+  }
+  return result;
+}
+
+nlohmann::json diff_heap_profiles(const HeapProfile& before,
+                                  const HeapProfile& after,
+                                  int top_count) {
+  struct Change {
+    std::string name;
+    s64 before = 0;
+    s64 after = 0;
+    s64 delta() const { return after - before; }
+  };
+  auto sorted_changes = [](const std::map<std::string, Change>& changes) {
+    std::vector<Change> result;
+    for (const auto& [name, change] : changes) {
+      if (change.delta()) {
+        result.push_back(change);
+      }
+    }
+    std::sort(result.begin(), result.end(), [](const Change& a, const Change& b) {
+      return std::abs(a.delta()) > std::abs(b.delta());
+    });
+    return result;
+  };
+
+  std::map<std::string, Change> type_changes;
+  for (const auto& [name, total] : before.types) {
+    type_changes[name].before = total.bytes;
+  }
+  for (const auto& [name, total] : after.types) {
+    type_changes[name].after = total.bytes;
+  }
+
+  // regions are matched by their stack, processes with the same name are added together.
+  std::map<std::string, Change> region_changes;
+  for (size_t i = 0; i < before.regions.size(); i++) {
+    region_changes[str_util::join(region_stack(before, i), ";")].before +=
+        before.regions[i].size() - before.regions[i].free_bytes;
+  }
+  for (size_t i = 0; i < after.regions.size(); i++) {
+    region_changes[str_util::join(region_stack(after, i), ";")].after +=
+        after.regions[i].size() - after.regions[i].free_bytes;
+  }
+
+  nlohmann::json result;
+  for (auto* changes : {&type_changes, &region_changes}) {
+    for (auto& [name, change] : *changes) {
+      change.name = name;
+    }
+  }
+
+  auto print_and_store = [&](const char* title, const std::map<std::string, Change>& changes) {
+    fmt::print("\n{} (used bytes, after - before):\n", title);
+    auto sorted = sorted_changes(changes);
+    for (int i = 0; i < (int)sorted.size(); i++) {
+      if (i < top_count) {
+        fmt::print("  {:+12d} {:>12d} -> {:<12d} {}\n", sorted[i].delta(), sorted[i].before,
+                   sorted[i].after, sorted[i].name);
+      }
+      result[title].push_back({{"name", sorted[i].name},
+                               {"before", sorted[i].before},
+                               {"after", sorted[i].after},
+                               {"delta", sorted[i].delta()}});
+    }
+  };
+  print_and_store("types", type_changes);
+  print_and_store("regions", region_changes);
+  return result;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+/*!
+ * @file heap_profile.h
+ * Attribute the memory of the kheaps and process heaps in a RAM dump to types and processes.
+ */
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_types.h"
+
+#include "tools/memory_dump_tool/memory_dump.h"
+
+#include "third-party/json.hpp"
+
+class TypeSystem;
+
+/*!
+ * A range of memory with its own allocator: a kheap, the kheap of a dead-pool-heap, or a process.
+ * Regions nest: a level heap is inside the global heap, a process is inside a process pool.
+ */
+struct HeapRegion {
+  enum class Kind { KHEAP, PROCESS_POOL, PROCESS };
+  Kind kind = Kind::KHEAP;
+  std::string name;
+  // for processes, the names of the process-tree nodes above it, starting at the root.
+  std::vector<std::string> tree_path;
+  u32 start = 0;
+  u32 end = 0;
+  // unallocated [start, end) ranges.
+  std::vector<std::pair<u32, u32>> free;
+  int parent = -1;
+
+  // bytes of this region that are not part of a child region, by type.
+  std::map<std::string, u64> type_bytes;
+  u64 free_bytes = 0;
+  u64 largest_free = 0;
+
+  u64 size() const { return end - start; }
+  double fragmentation() const {
+    return free_bytes ? 1. - (double)largest_free / free_bytes : 0.;
+  }
+};
+
+struct HeapTypeTotal {
+  u64 bytes = 0;
+  u64 count = 0;
+};
+
+struct HeapProfile {
+  std::vector<HeapRegion> regions;
+  std::map<std::string, HeapTypeTotal> types;
+};
+
+// bytes that aren't part of any object that was found.
+constexpr const char* kUnknownBytes = "(unknown)";
+constexpr const char* kFreeBytes = "(free)";
+
+HeapProfile build_heap_profile(const Ram& ram,
+                               const SymbolMap& symbols,
+                               const std::unordered_map<u32, std::string>& types,
+                               const std::unordered_map<std::string, std::vector<u32>>& objects,
+                               const TypeSystem& type_system);
+void print_heap_profile(const HeapProfile& profile, int top_count);
+nlohmann::json heap_profile_to_json(const HeapProfile& profile);
+std::string heap_profile_to_folded(const HeapProfile& profile);
+nlohmann::json diff_heap_profiles(const HeapProfile& before,
+                                  const HeapProfile& after,
+                                  int top_count);
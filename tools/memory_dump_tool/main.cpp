@@ -12,71 +12,13 @@
 #include "common/util/unicode_util.h"
 
 #include "decompiler/util/DecompilerTypeSystem.h"
+#include "tools/memory_dump_tool/heap_profile.h"
+#include "tools/memory_dump_tool/memory_dump.h"
 
 #include "fmt/core.h"
 #include "third-party/CLI11.hpp"
 #include "third-party/json.hpp"
 
-struct Ram {
-  const u8* data = nullptr;
-  u32 size = 0;
-
-  Ram(const u8* _data, u32 _size) : data(_data), size(_size) {}
-
-  template <typename T>
-  T read(u32 addr) const {
-    ASSERT(in_memory<T>(addr));
-    T result;
-    memcpy(&result, data + addr, sizeof(T));
-    return result;
-  }
-
-  template <typename T>
-  bool in_memory(u32 addr) const {
-    return addr > (1 << 19) && addr <= (size - sizeof(T));
-  }
-
-  u32 word(u32 addr) const { return read<u32>(addr); }
-
-  u8 byte(int addr) const { return read<u8>(addr); }
-
-  std::string string(u32 addr) const {
-    std::string result;
-    while (true) {
-      ASSERT(in_memory<u8>(addr));
-      auto next = read<u8>(addr++);
-      if (next) {
-        result.push_back(next);
-      } else {
-        return result;
-      }
-    }
-  }
-
-  std::optional<std::string> try_string(u32 addr, int max_len = 128) const {
-    std::string result;
-    for (int i = 0; i < max_len; i++) {
-      if (!in_memory<u8>(addr)) {
-        return {};
-      }
-      auto next = read<u8>(addr++);
-      if (next) {
-        result.push_back(next);
-      } else {
-        return result;
-      }
-    }
-    return {};
-  }
-
-  /*!
-   * addr, including basic offset.
-   */
-  std::string goal_string(u32 addr) { return string(addr + 4); }
-
-  bool word_in_memory(u32 addr) const { return in_memory<u32>(addr); }
-};
-
 u32 scan_for_symbol_table(const Ram& ram,
                           const GameVersion& game_version,
                           u32 start_addr,
@@ -140,12 +82,6 @@ u32 scan_for_symbol_table(const Ram& ram,
   return 0;
 }
 
-struct SymbolMap {
-  std::unordered_map<std::string, u32> name_to_addr;
-  std::unordered_map<std::string, u32> name_to_value;
-  std::unordered_map<u32, std::string> addr_to_name;
-};
-
 SymbolMap build_symbol_map(const GameVersion& game_version, const Ram& ram, u32 s7) {
   lg::info("building symbol map...");
   SymbolMap map;
@@ -180,7 +116,7 @@ SymbolMap build_symbol_map(const GameVersion& game_version, const Ram& ram, u32
           ASSERT(map.name_to_addr.find(name) == map.name_to_addr.end());
           map.name_to_addr[name] = sym;
           map.addr_to_name[sym] = name;
-          map.name_to_value[name] = ram.word(sym);
+          map.name_to_value[name] = ram.word(sym - 1);
         }
       }
     }
@@ -230,9 +166,13 @@ std::unordered_map<u32, std::string> build_type_map(const Ram& ram,
 const std::vector<std::string> ignored_types = {"symbol", "string", "function", "object",
                                                 "integer"};
 
+// the heap profile wants to count strings and code.
+const std::vector<std::string> heap_profile_ignored_types = {"symbol", "object", "integer"};
+
 std::unordered_map<std::string, std::vector<u32>> find_basics(
     const Ram& ram,
-    const std::unordered_map<u32, std::string>& type_map) {
+    const std::unordered_map<u32, std::string>& type_map,
+    const std::vector<std::string>& ignored = ignored_types) {
   lg::info("Scanning memory for objects. This may take a while...");
 
   std::unordered_map<std::string, std::vector<u32>> result;
@@ -242,8 +182,8 @@ std::unordered_map<std::string, std::vector<u32>> find_basics(
     u32 tag = ram.word(addr);
     auto iter = type_map.find(tag);
     // ignore the stupid types.
-    if (iter != type_map.end() && std::find(ignored_types.begin(), ignored_types.end(),
-                                            iter->second) == ignored_types.end()) {
+    if (iter != type_map.end() &&
+        std::find(ignored.begin(), ignored.end(), iter->second) == ignored.end()) {
       result[iter->second].push_back(addr);
       total_objects++;
     }
@@ -606,12 +546,65 @@ void inspect_symbols(const Ram& ram,
   }
 }
 
+std::optional<std::vector<u8>> load_dump(const fs::path& dump_path) {
+  if (dump_path.extension() == "p2s") {
+    lg::error("PCSX2 savestates are not directly supported. Please extract contents beforehand");
+    return {};
+  }
+
+  lg::info("Loading memory from '{}'", dump_path.string());
+  auto data = file_util::read_binary_file(dump_path);
+
+  u32 one_mb = (1 << 20);
+
+  if (data.size() == 32 * one_mb) {
+    lg::info("Got 32MB file");
+  } else if (data.size() == 128 * one_mb) {
+    lg::info("Got 128MB file");
+  } else if (data.size() == 127 * one_mb) {
+    lg::warn("Got a 127MB file. Assuming this is a dump with the first 1 MB missing.\n");
+    data.insert(data.begin(), one_mb, 0);
+    if (data.size() != 128 * one_mb) {
+      lg::error("it was not!");
+      return {};
+    }
+  } else {
+    lg::error("Invalid size: {} bytes", data.size());
+    return {};
+  }
+  return data;
+}
+
+std::optional<HeapProfile> profile_dump(const fs::path& dump_path,
+                                        const GameVersion& game_version,
+                                        const TypeSystem& type_system) {
+  auto data = load_dump(dump_path);
+  if (!data) {
+    return {};
+  }
+  Ram ram(data->data(), data->size());
+  u32 s7 = scan_for_symbol_table(ram, game_version, 1 << 20, 2 << 20);
+  if (!s7) {
+    lg::error("Failed to find symbol table");
+    return {};
+  }
+
+  auto symbol_map = build_symbol_map(game_version, ram, s7);
+  auto types = build_type_map(ram, symbol_map, game_version, s7);
+  auto basics = find_basics(ram, types, heap_profile_ignored_types);
+  follow_references_to_find_pointers(ram, type_system, basics, s7 + 0x100);
+  return build_heap_profile(ram, symbol_map, types, basics, type_system);
+}
+
 int main(int argc, char** argv) {
   ArgumentGuard u8_guard(argc, argv);
 
   fs::path dump_path;
   fs::path output_path;
+  fs::path diff_path;
   std::string game_name = "jak1";
+  bool heap_profile = false;
+  int top_count = 20;
 
   lg::initialize();
 
@@ -620,6 +613,12 @@ int main(int argc, char** argv) {
   app.add_option("--output-path", output_path,
                  "Where the output files should be sent, defaults to current directory otherwise");
   app.add_option("-g,--game", game_name, "Specify the game name, defaults to 'jak1'");
+  app.add_flag("--heap-profile", heap_profile,
+               "Attribute the memory of each heap and process to types, instead of inspecting "
+               "basics. Writes JSON and folded stacks for flame graphs");
+  app.add_option("--diff", diff_path,
+                 "An older dump to compare against. Implies --heap-profile");
+  app.add_option("--top", top_count, "How many types and processes to print, defaults to 20");
   app.validate_positionals();
   CLI11_PARSE(app, argc, argv);
 
@@ -634,9 +633,8 @@ int main(int argc, char** argv) {
 
   decompiler::DecompilerTypeSystem dts(game_version);
 
-  // TODO - this could be better (have a `jak1` folder)
   if (game_version == GameVersion::Jak1) {
-    dts.parse_type_defs({"decompiler", "config", "all-types.gc"});
+    dts.parse_type_defs({"decompiler", "config", "jak1", "all-types.gc"});
   } else if (game_version == GameVersion::Jak2) {
     dts.parse_type_defs({"decompiler", "config", "jak2", "all-types.gc"});
   } else {
@@ -644,40 +642,46 @@ int main(int argc, char** argv) {
     return 1;
   }
 
-  fs::path output_folder;
+  fs::path output_folder = output_path;
 
   if (output_folder.empty() || !fs::exists(output_folder)) {
     lg::warn("Output folder not found or not provided, defaulting to current directory");
     output_folder = "./";
   }
 
-  if (dump_path.extension() == "p2s") {
-    lg::error("PCSX2 savestates are not directly supported. Please extract contents beforehand");
-    return 1;
-  }
-
-  lg::info("Loading memory from '{}'", dump_path.string());
-  auto data = file_util::read_binary_file(dump_path);
-
-  u32 one_mb = (1 << 20);
-
-  if (data.size() == 32 * one_mb) {
-    lg::info("Got 32MB file");
-  } else if (data.size() == 128 * one_mb) {
-    lg::info("Got 128MB file");
-  } else if (data.size() == 127 * one_mb) {
-    lg::warn("Got a 127MB file. Assuming this is a dump with the first 1 MB missing.\n");
-    data.insert(data.begin(), one_mb, 0);
-    if (data.size() != 128 * one_mb) {
-      lg::error("it was not!");
+  if (heap_profile || !diff_path.empty()) {
+    auto profile = profile_dump(dump_path, game_version, dts.ts);
+    if (!profile) {
       return 1;
     }
-  } else {
-    lg::error("Invalid size: {} bytes", data.size());
-    return 1;
+    print_heap_profile(*profile, top_count);
+
+    auto name = fmt::format("heap-profile-{}", game_name);
+    std::ofstream json_out(output_folder / (name + ".json"));
+    json_out << std::setw(2) << heap_profile_to_json(*profile) << std::endl;
+    file_util::write_text_file(output_folder / (name + ".folded"),
+                               heap_profile_to_folded(*profile));
+
+    if (!diff_path.empty()) {
+      auto before = profile_dump(diff_path, game_version, dts.ts);
+      if (!before) {
+        return 1;
+      }
+      std::ofstream diff_out(output_folder / (name + "-diff.json"));
+      diff_out << std::setw(2) << diff_heap_profiles(*before, *profile, top_count) << std::endl;
+      file_util::write_text_file(output_folder / (name + "-before.folded"),
+                                 heap_profile_to_folded(*before));
+    }
+    lg::info("Wrote {}.json and {}.folded to {}", name, name, output_folder.string());
+    return 0;
   }
 
-  Ram ram(data.data(), data.size());
+  auto data = load_dump(dump_path);
+  if (!data) {
+    return 1;
+  }
+  u32 one_mb = (1 << 20);
+  Ram ram(data->data(), data->size());
 
   u32 s7 = scan_for_symbol_table(ram, game_version, one_mb, 2 * one_mb);
   if (!s7) {
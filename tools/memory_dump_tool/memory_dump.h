@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstring>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+#include "common/common_types.h"
+#include "common/util/Assert.h"
+
+struct Ram {
+  const u8* data = nullptr;
+  u32 size = 0;
+
+  Ram(const u8* _data, u32 _size) : data(_data), size(_size) {}
+
+  template <typename T>
+  T read(u32 addr) const {
+    ASSERT(in_memory<T>(addr));
+    T result;
+    memcpy(&result, data + addr, sizeof(T));
+    return result;
+  }
+
+  template <typename T>
+  bool in_memory(u32 addr) const {
+    return addr > (1 << 19) && addr <= (size - sizeof(T));
+  }
+
+  u32 word(u32 addr) const { return read<u32>(addr); }
+
+  u8 byte(int addr) const { return read<u8>(addr); }
+
+  std::string string(u32 addr) const {
+    std::string result;
+    while (true) {
+      ASSERT(in_memory<u8>(addr));
+      auto next = read<u8>(addr++);
+      if (next) {
+        result.push_back(next);
+      } else {
+        return result;
+      }
+    }
+  }
+
+  std::optional<std::string> try_string(u32 addr, int max_len = 128) const {
+    std::string result;
+    for (int i = 0; i < max_len; i++) {
+      if (!in_memory<u8>(addr)) {
+        return {};
+      }
+      auto next = read<u8>(addr++);
+      if (next) {
+        result.push_back(next);
+      } else {
+        return result;
+      }
+    }
+    return {};
+  }
+
+  /*!
+   * addr, including basic offset.
+   */
+  std::string goal_string(u32 addr) { return string(addr + 4); }
+
+  bool word_in_memory(u32 addr) const { return in_memory<u32>(addr); }
+};
+
+struct SymbolMap {
+  std::unordered_map<std::string, u32> name_to_addr;
+  std::unordered_map<std::string, u32> name_to_value;
+  std::unordered_map<u32, std::string> addr_to_name;
+};